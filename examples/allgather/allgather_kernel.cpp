@@ -23,7 +23,6 @@ using bfloat16 = op::bfloat16;
 
 constexpr int64_t SYNC_FLAG_INTERVAL = 16;
 constexpr int64_t UB_DMA_MAX_SIZE = 190 * 1024;
-constexpr int64_t GVA_BUFF_MAX_SIZE = 100 * 1024 * 1024;
 
 template <typename T>
 SHMEM_DEVICE void all_gather_origin(__gm__ T *input, __gm__ T *output, __gm__ T *gva, int64_t max_gva_num, int elements,
@@ -191,15 +190,17 @@ SHMEM_DEVICE void all_gather_origin(__gm__ T *input, __gm__ T *output, __gm__ T
     AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID1);
 }
 
-// all_gather
+// all_gather, the scratch of SHMEM_TEAM_WORLD holds the flags of the cores then the data, and is reused once per
+// chunk of the input, flags of a chunk are tagged with an epoch of its own
 template <typename T>
-SHMEM_DEVICE void all_gather_big_data(uint64_t fftsAddr, __gm__ T *input, __gm__ T *output, __gm__ T *gva, int elements,
-                                      int magic)
+SHMEM_DEVICE void all_gather_big_data(uint64_t fftsAddr, __gm__ T *input, __gm__ T *output, int elements)
 {
 #ifdef __DAV_C220_VEC__
     shmemx_set_ffts_config(fftsAddr);
 
-    const int64_t max_gva_num = GVA_BUFF_MAX_SIZE / sizeof(T);
+    __gm__ T *gva = (__gm__ T *)shmemx_team_scratch(SHMEM_TEAM_WORLD);
+    const int64_t flag_size = GetBlockNum() * SYNC_FLAG_INTERVAL * sizeof(int32_t);
+    const int64_t max_gva_num = (shmemx_team_scratch_size(SHMEM_TEAM_WORLD) - flag_size) / sizeof(T);
     int times = (elements + max_gva_num - 1) / max_gva_num;
     int total_num = elements;
 
@@ -210,7 +211,7 @@ SHMEM_DEVICE void all_gather_big_data(uint64_t fftsAddr, __gm__ T *input, __gm__
         int32_t len = total_num > max_gva_num ? max_gva_num : total_num;
         shmemx_barrier_all_vec();
         all_gather_origin(input + i * max_gva_num, output + i * max_gva_num, gva, max_gva_num, elements, len,
-                          (magic + i) * 1024);
+                          (int64_t)shmemx_team_epoch_next(SHMEM_TEAM_WORLD) * 1024);
         total_num -= max_gva_num;
         AscendC::PipeBarrier<PIPE_ALL>();
     }
@@ -219,10 +220,11 @@ SHMEM_DEVICE void all_gather_big_data(uint64_t fftsAddr, __gm__ T *input, __gm__
 
 // all_gather
 template <typename T>
-SHMEM_DEVICE void all_gather_small_data(uint64_t fftsAddr, __gm__ T *input, __gm__ T *output, __gm__ T *gva,
-                                        int elements, int magic)
+SHMEM_DEVICE void all_gather_small_data(uint64_t fftsAddr, __gm__ T *input, __gm__ T *output, int elements)
 {
 #ifdef __DAV_C220_VEC__
+    __gm__ T *gva = (__gm__ T *)shmemx_team_scratch(SHMEM_TEAM_WORLD);
+    const int32_t magic = shmemx_team_epoch_next(SHMEM_TEAM_WORLD);
     const int64_t aivNum = GetBlockNum();
     const int64_t aivIndex = GetBlockIdx();
 
@@ -279,14 +281,12 @@ SHMEM_DEVICE void all_gather_small_data(uint64_t fftsAddr, __gm__ T *input, __gm
 
 #define ALLGATHER_FUNC_DEF(type)                                                                                   \
     extern "C" __global__ __aicore__ void ShmemAllGather_##type(uint64_t fftsAddr, GM_ADDR input, GM_ADDR output,  \
-                                                                GM_ADDR gva, int elements, int magic)              \
+                                                                int elements)                                      \
     {                                                                                                              \
         if (elements * sizeof(type) < 2097152) {                                                                   \
-            all_gather_small_data<type>(fftsAddr, (__gm__ type *)input, (__gm__ type *)output, (__gm__ type *)gva, \
-                                        elements, magic);                                                          \
+            all_gather_small_data<type>(fftsAddr, (__gm__ type *)input, (__gm__ type *)output, elements);          \
         } else {                                                                                                   \
-            all_gather_big_data<type>(fftsAddr, (__gm__ type *)input, (__gm__ type *)output, (__gm__ type *)gva,   \
-                                      elements, magic);                                                            \
+            all_gather_big_data<type>(fftsAddr, (__gm__ type *)input, (__gm__ type *)output, elements);            \
         }                                                                                                          \
     }
 
@@ -299,23 +299,22 @@ SHMEM_DEVICE void all_gather_small_data(uint64_t fftsAddr, __gm__ T *input, __gm
 TYPE_FUNC(ALLGATHER_FUNC_DEF);
 
 template <class T>
-void allgather_demo(uint32_t block_dim, void *stream, uint64_t fftsAddr, uint8_t *input, uint8_t *output, uint8_t *gva,
-                    int elements, int magic)
+void allgather_demo(uint32_t block_dim, void *stream, uint64_t fftsAddr, uint8_t *input, uint8_t *output, int elements)
 {
     if (std::is_same<T, int>::value) {
-        ShmemAllGather_int<<<block_dim, nullptr, stream>>>(fftsAddr, input, output, gva, elements, magic);
+        ShmemAllGather_int<<<block_dim, nullptr, stream>>>(fftsAddr, input, output, elements);
     } else if (std::is_same<T, int32_t>::value) {
-        ShmemAllGather_int32_t<<<block_dim, nullptr, stream>>>(fftsAddr, input, output, gva, elements, magic);
+        ShmemAllGather_int32_t<<<block_dim, nullptr, stream>>>(fftsAddr, input, output, elements);
     } else if (std::is_same<T, fp16_t>::value) {
-        ShmemAllGather_float16_t<<<block_dim, nullptr, stream>>>(fftsAddr, input, output, gva, elements, magic);
+        ShmemAllGather_float16_t<<<block_dim, nullptr, stream>>>(fftsAddr, input, output, elements);
     } else if (std::is_same<T, bfloat16>::value) {
-        ShmemAllGather_bfloat16_t<<<block_dim, nullptr, stream>>>(fftsAddr, input, output, gva, elements, magic);
+        ShmemAllGather_bfloat16_t<<<block_dim, nullptr, stream>>>(fftsAddr, input, output, elements);
     }
 }
 
 template void allgather_demo<int>(uint32_t block_dim, void *stream, uint64_t fftsAddr, uint8_t *input, uint8_t *output,
-                                  uint8_t *gva, int elements, int magic);
+                                  int elements);
 template void allgather_demo<fp16_t>(uint32_t block_dim, void *stream, uint64_t fftsAddr, uint8_t *input,
-                                     uint8_t *output, uint8_t *gva, int elements, int magic);
+                                     uint8_t *output, int elements);
 template void allgather_demo<bfloat16>(uint32_t block_dim, void *stream, uint64_t fftsAddr, uint8_t *input,
-                                       uint8_t *output, uint8_t *gva, int elements, int magic);
\ No newline at end of file
+                                       uint8_t *output, int elements);
\ No newline at end of file
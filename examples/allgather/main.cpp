@@ -41,13 +41,12 @@ int f_rank = 0;
 int f_npu = 0;
 const char *data_type = "int";
 
-constexpr int64_t SYNC_FLAG_INTERVAL = 16;
-constexpr int64_t UB_DMA_MAX_SIZE = 190 * 1024;
-constexpr int64_t GVA_BUFF_MAX_SIZE = 100 * 1024 * 1024;
+// scratch of SHMEM_TEAM_WORLD used by the kernels, flags of the cores and data, fits the default arena of 64MB
+constexpr size_t SCRATCH_SIZE = 32 * 1024 * 1024;
 
 template <class T>
 extern void allgather_demo(uint32_t block_dim, void *stream, uint64_t fftsAddr, uint8_t *input, uint8_t *output,
-                           uint8_t *gva, int elements, int magic);
+                           int elements);
 
 template <class T>
 int test_shmem_all_gather(int rank_id, int n_ranks, uint64_t local_mem_size)
@@ -68,6 +67,17 @@ int test_shmem_all_gather(int rank_id, int n_ranks, uint64_t local_mem_size)
     // Prepare FFTS address
     uint64_t fftsAddr = shmemx_get_ffts_config();
 
+    // 内核使用SHMEM_TEAM_WORLD的scratch及epoch, 无需自行分配对称内存及传入magic; scratch在首次获取时分配
+    void *scratch = nullptr;
+    status = shmemx_team_set_scratch_size(SHMEM_TEAM_WORLD, SCRATCH_SIZE);
+    if (status == 0) {
+        status = shmemx_team_get_scratch(SHMEM_TEAM_WORLD, SCRATCH_SIZE, &scratch);
+    }
+    if (status != 0) {
+        std::cerr << "获取scratch失败: " << status << std::endl;
+        return 1;
+    }
+
     int PERF_TIMES = 50;
 
     int case_num = 24;
@@ -86,9 +96,6 @@ int test_shmem_all_gather(int rank_id, int n_ranks, uint64_t local_mem_size)
     }
     outFile << "M,N,Time(us)\n";
 
-    // magic is used to sync.
-    int magic = 1;
-
     for (int i = 0; i < test_cases.size(); i++) {
         if (rank_id == 0) {
             std::cout << "Case: " << test_cases[i] << " Started." << std::endl;
@@ -114,15 +121,9 @@ int test_shmem_all_gather(int rank_id, int n_ranks, uint64_t local_mem_size)
         void *output_ptr;
         aclrtMalloc(&output_ptr, trans_size * n_ranks * sizeof(T), ACL_MEM_MALLOC_HUGE_FIRST);
 
-        // sync Buffer + data Buffer
-        int aiv_num = BLOCK_NUM;
-        void *ptr = shmem_malloc(aiv_num * SYNC_FLAG_INTERVAL * sizeof(T) + GVA_BUFF_MAX_SIZE / sizeof(T));
-
         // AllGather
         for (int zz = 0; zz < PERF_TIMES; zz++) {
-            magic++;
-            allgather_demo<T>(BLOCK_NUM, stream, fftsAddr, (uint8_t *)input_ptr, (uint8_t *)output_ptr, (uint8_t *)ptr,
-                              trans_size, magic * 1024);
+            allgather_demo<T>(BLOCK_NUM, stream, fftsAddr, (uint8_t *)input_ptr, (uint8_t *)output_ptr, trans_size);
         }
         status = aclrtSynchronizeStream(stream);
 
@@ -151,7 +152,6 @@ int test_shmem_all_gather(int rank_id, int n_ranks, uint64_t local_mem_size)
         status = aclrtFreeHost(output_host);
         status = aclrtFreeHost(golden_host);
 
-        shmem_free(ptr);
         aclrtFree(input_ptr);
         aclrtFree(output_ptr);
 
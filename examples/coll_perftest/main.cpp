@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+#include <random>
+#include <cmath>
+#include <mpi.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+
+int g_npus = 8;
+const char *ipport = "tcp://127.0.0.1:8998";
+int f_rank = 0;
+int f_npu = 0;
+const char *mode = "perf";
+const char *tune_path = "coll_tune.txt";
+uint32_t quant_block = 128;
+
+// scratch of SHMEM_TEAM_WORLD used by the example kernels, same size as examples/allgather
+constexpr size_t SCRATCH_SIZE = 32 * 1024 * 1024;
+constexpr int PERF_TIMES = 50;
+constexpr int CASE_NUM = 17;
+
+template <class T>
+extern void allgather_demo(uint32_t block_dim, void *stream, uint64_t fftsAddr, uint8_t *input, uint8_t *output,
+                           int elements);
+extern void reduce_local_demo(uint32_t block_dim, void *stream, int dtype, int op, uint8_t *dest, uint8_t *source,
+                              int num, uint64_t nelems);
+
+// average time of one launch in us, the PEs start together and the stream is drained at the end
+static double time_launches(aclrtStream stream, const std::function<void()> &launch)
+{
+    launch();
+    aclrtSynchronizeStream(stream);
+    shmem_barrier_all();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PERF_TIMES; i++) {
+        launch();
+    }
+    aclrtSynchronizeStream(stream);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / PERF_TIMES;
+}
+
+// one launch of op on int32 elements, reductions sum
+static void launch_coll(int op, int *dest, int *source, size_t elements, aclrtStream stream)
+{
+    switch (op) {
+        case SHMEMX_COLL_ALLGATHER:
+            shmem_int32_allgather_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, stream);
+            break;
+        case SHMEMX_COLL_BROADCAST:
+            shmem_int32_broadcast_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, 0, stream);
+            break;
+        case SHMEMX_COLL_ALLTOALL:
+            shmem_int32_alltoall_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, stream);
+            break;
+        case SHMEMX_COLL_REDUCE_SCATTER:
+            shmem_int32_sum_reduce_scatter_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, stream);
+            break;
+        default:
+            shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, stream);
+            break;
+    }
+}
+
+/* Times every algorithm able to run each collective on SHMEM_TEAM_WORLD for every message size, and writes the
+   fastest one per size range to the tuning table. The slowest PE decides, so that all PEs pick the same rows. */
+static void tune_coll_algos(int rank_id, int n_ranks, aclrtStream stream)
+{
+    static const char *op_names[SHMEMX_COLL_OP_NUM] = {
+        "allgather", "broadcast", "alltoall", "reduce_scatter", "allreduce"
+    };
+    static const char *algo_names[SHMEMX_COLL_ALGO_NUM] = {
+        "auto", "one_shot", "two_shot", "ring", "recursive_doubling", "hier", "ll_one_shot", "ll_two_shot",
+        "pipe_ring"
+    };
+    size_t max_bytes = 16 * sizeof(int) << (CASE_NUM - 1);
+    int *source = (int *)shmem_malloc(max_bytes * n_ranks);
+    int *dest = (int *)shmem_malloc(max_bytes * n_ranks);
+    aclrtMemset(source, max_bytes * n_ranks, 0, max_bytes * n_ranks);
+
+    for (int op = 0; op < SHMEMX_COLL_OP_NUM; op++) {
+        int prev_algo = SHMEMX_COLL_AUTO;
+        size_t prev_bytes = 0;
+        for (int i = 0; i < CASE_NUM; i++) {
+            size_t elements = 16 * (1 << i);
+            size_t bytes = elements * sizeof(int);
+            int best_algo = SHMEMX_COLL_AUTO;
+            double best_us = 0;
+            for (int algo = SHMEMX_COLL_ONE_SHOT; algo < SHMEMX_COLL_ALGO_NUM; algo++) {
+                if (shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, op, algo) != 0) {
+                    continue;
+                }
+                double us = time_launches(stream, [&]() { launch_coll(op, dest, source, elements, stream); });
+                MPI_Allreduce(MPI_IN_PLACE, &us, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+                if (best_algo == SHMEMX_COLL_AUTO || us < best_us) {
+                    best_algo = algo;
+                    best_us = us;
+                }
+            }
+            if (rank_id == 0) {
+                std::cout << std::setw(16) << op_names[op] << std::setw(12) << bytes << std::setw(20)
+                          << algo_names[best_algo] << std::fixed << std::setprecision(2) << std::setw(12) << best_us
+                          << std::endl;
+            }
+            if (prev_algo != SHMEMX_COLL_AUTO && prev_algo != best_algo) {
+                shmemx_coll_tune_set(SHMEM_TEAM_WORLD, op, prev_bytes, prev_algo);
+            }
+            prev_algo = best_algo;
+            prev_bytes = bytes;
+        }
+        // the fastest algorithm of the largest size covers everything beyond
+        shmemx_coll_tune_set(SHMEM_TEAM_WORLD, op, SIZE_MAX, prev_algo);
+    }
+
+    shmem_free(dest);
+    shmem_free(source);
+    if (rank_id == 0 && shmemx_coll_tune_save(tune_path) == 0) {
+        std::cout << "tuning table written to " << tune_path << ", load it with SHMEM_COLL_TUNE_FILE" << std::endl;
+    }
+}
+
+/* Compares the low-latency allreduce with the barrier-based one-shot and two-shot on SHMEM_TEAM_WORLD, up to the
+   sizes the low-latency variants take before falling back. */
+static void compare_ll_algos(int rank_id, int n_ranks, aclrtStream stream)
+{
+    static const int algos[] = {
+        SHMEMX_COLL_ONE_SHOT, SHMEMX_COLL_LL_ONE_SHOT, SHMEMX_COLL_TWO_SHOT, SHMEMX_COLL_LL_TWO_SHOT
+    };
+    constexpr int ll_case_num = 13;
+    size_t max_bytes = 16 * sizeof(int) << (ll_case_num - 1);
+    int *source = (int *)shmem_malloc(max_bytes);
+    int *dest = (int *)shmem_malloc(max_bytes);
+    aclrtMemset(source, max_bytes, 0, max_bytes);
+
+    if (rank_id == 0) {
+        std::cout << std::setw(12) << "bytes/PE" << std::setw(16) << "one_shot(us)" << std::setw(16)
+                  << "ll_one_shot(us)" << std::setw(16) << "two_shot(us)" << std::setw(16) << "ll_two_shot(us)"
+                  << std::endl;
+    }
+    for (int i = 0; i < ll_case_num; i++) {
+        size_t elements = 16 * (1 << i);
+        double us[sizeof(algos) / sizeof(algos[0])] = {};
+        for (size_t a = 0; a < sizeof(algos) / sizeof(algos[0]); a++) {
+            if (shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, algos[a]) != 0) {
+                continue;
+            }
+            us[a] = time_launches(stream, [&]() {
+                shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, stream);
+            });
+            MPI_Allreduce(MPI_IN_PLACE, &us[a], 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        }
+        if (rank_id == 0) {
+            std::cout << std::setw(12) << elements * sizeof(int) << std::fixed << std::setprecision(2);
+            for (double t : us) {
+                std::cout << std::setw(16) << t;
+            }
+            std::cout << std::endl;
+        }
+    }
+    shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, SHMEMX_COLL_AUTO);
+
+    shmem_free(dest);
+    shmem_free(source);
+}
+
+// token copies every PE sends to PE j, uniform or Zipf-like with PE 0 holding the hottest experts
+static std::vector<uint32_t> moe_counts(int n_ranks, size_t tokens, bool skewed)
+{
+    std::vector<double> weights(n_ranks, 1.0);
+    if (skewed) {
+        for (int j = 0; j < n_ranks; j++) {
+            weights[j] = 1.0 / (j + 1);
+        }
+    }
+    double total = 0;
+    for (double w : weights) {
+        total += w;
+    }
+    std::vector<uint32_t> counts(n_ranks);
+    size_t assigned = 0;
+    for (int j = 0; j < n_ranks; j++) {
+        counts[j] = (uint32_t)(tokens * weights[j] / total);
+        assigned += counts[j];
+    }
+    counts[0] += (uint32_t)(tokens - assigned);
+    return counts;
+}
+
+/* MoE token dispatch, every PE sends tokens expanded copies of a bf16 hidden state of MOE_HIDDEN elements, moved
+   as uint16. alltoallv at uniform and skewed routing against an alltoall padded to the largest block, the capacity
+   layout a fixed-size alltoall needs. */
+static void compare_alltoallv(int rank_id, int n_ranks, aclrtStream stream)
+{
+    constexpr size_t MOE_HIDDEN = 7168;
+    static const size_t token_cases[] = {128, 512, 2048};
+    size_t max_tokens = token_cases[sizeof(token_cases) / sizeof(token_cases[0]) - 1];
+    size_t token_bytes = MOE_HIDDEN * sizeof(uint16_t);
+    auto *source = (uint16_t *)shmem_malloc(max_tokens * token_bytes);
+    auto *dest = (uint16_t *)shmem_malloc(n_ranks * max_tokens * token_bytes);
+    auto *counts = (uint32_t *)shmem_malloc(n_ranks * sizeof(uint32_t));
+    auto *padded_source = (uint16_t *)shmem_malloc(n_ranks * max_tokens * token_bytes);
+    aclrtMemset(source, max_tokens * token_bytes, 0, max_tokens * token_bytes);
+
+    if (rank_id == 0) {
+        std::cout << std::setw(12) << "tokens/PE" << std::setw(16) << "uniform(us)" << std::setw(16)
+                  << "uniform(GB/s)" << std::setw(16) << "skewed(us)" << std::setw(16) << "padded_a2a(us)"
+                  << std::endl;
+    }
+    for (size_t tokens : token_cases) {
+        double us[2] = {};
+        for (int skewed = 0; skewed < 2; skewed++) {
+            std::vector<uint32_t> host_counts = moe_counts(n_ranks, tokens, skewed != 0);
+            for (auto &count : host_counts) {
+                count *= MOE_HIDDEN;
+            }
+            aclrtMemcpy(counts, n_ranks * sizeof(uint32_t), host_counts.data(), n_ranks * sizeof(uint32_t),
+                        ACL_MEMCPY_HOST_TO_DEVICE);
+            us[skewed] = time_launches(stream, [&]() {
+                shmemx_uint16_alltoallv_on_stream(SHMEM_TEAM_WORLD, dest, 0, source, counts, nullptr, nullptr,
+                                                  nullptr, nullptr, stream);
+            });
+            MPI_Allreduce(MPI_IN_PLACE, &us[skewed], 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        }
+        // every block padded to the hottest one of the skewed routing
+        size_t capacity = moe_counts(n_ranks, tokens, true)[0];
+        size_t padded_elems = capacity * MOE_HIDDEN;
+        double padded_us = time_launches(stream, [&]() {
+            shmem_uint16_alltoall_on_stream(SHMEM_TEAM_WORLD, dest, padded_source, padded_elems, stream);
+        });
+        MPI_Allreduce(MPI_IN_PLACE, &padded_us, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+        // bytes every PE sends to the others at uniform routing
+        double uniform_bw = (double)tokens * token_bytes * (n_ranks - 1) / n_ranks / us[0] / 1e3;
+        if (rank_id == 0) {
+            std::cout << std::setw(12) << tokens << std::fixed << std::setprecision(2) << std::setw(16) << us[0]
+                      << std::setw(16) << uniform_bw << std::setw(16) << us[1] << std::setw(16) << padded_us
+                      << std::endl;
+        }
+    }
+
+    shmem_free(padded_source);
+    shmem_free(counts);
+    shmem_free(dest);
+    shmem_free(source);
+}
+
+// relative L2 error of out against exact
+static double relative_error(const std::vector<float> &out, const std::vector<float> &exact)
+{
+    double diff = 0;
+    double norm = 0;
+    for (size_t i = 0; i < exact.size(); i++) {
+        diff += ((double)out[i] - exact[i]) * ((double)out[i] - exact[i]);
+        norm += (double)exact[i] * exact[i];
+    }
+    return norm > 0 ? std::sqrt(diff / norm) : 0;
+}
+
+/* Quantized sum allreduce of normally distributed floats against the float allreduce, time and relative error of
+   bf16 and of int8 with quant_block elements per scale. ef_steps calls of the same source are averaged without and
+   with error feedback, feedback lets the average converge to the exact sum. */
+static void compare_quant(int rank_id, int n_ranks, aclrtStream stream)
+{
+    constexpr int quant_case_num = 6;
+    constexpr int ef_steps = 8;
+    size_t max_elems = (size_t)64 * 1024 << (quant_case_num - 1);
+    shmemx_quant_config_t config = {SHMEMX_QUANT_BF16, quant_block, 0, 0};
+    size_t work_size = shmemx_quant_work_size(max_elems, &config);
+    if (work_size == 0) {
+        if (rank_id == 0) {
+            std::cout << "block size " << quant_block << " is not a power of two in [32, 2048]" << std::endl;
+        }
+        return;
+    }
+    auto *source = (float *)shmem_malloc(max_elems * sizeof(float));
+    auto *dest = (float *)shmem_malloc(max_elems * sizeof(float));
+    auto *error = (float *)shmem_malloc(max_elems * sizeof(float));
+    void *work = shmem_malloc(work_size);
+    config.work = (uint64_t)work;
+
+    std::mt19937 gen(rank_id + 1);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> input(max_elems);
+    for (auto &x : input) {
+        x = dist(gen);
+    }
+    aclrtMemcpy(source, max_elems * sizeof(float), input.data(), max_elems * sizeof(float),
+                ACL_MEMCPY_HOST_TO_DEVICE);
+
+    if (rank_id == 0) {
+        std::cout << "int8 block size " << quant_block << std::endl;
+        std::cout << std::setw(12) << "bytes/PE" << std::setw(12) << "float(us)" << std::setw(12) << "bf16(us)"
+                  << std::setw(12) << "int8(us)" << std::setw(12) << "bf16_err" << std::setw(12) << "int8_err"
+                  << std::setw(12) << "int8_avg" << std::setw(12) << "int8_ef_avg" << std::endl;
+    }
+    for (int i = 0; i < quant_case_num; i++) {
+        size_t elements = (size_t)64 * 1024 << i;
+        std::vector<float> exact(input.begin(), input.begin() + elements);
+        MPI_Allreduce(MPI_IN_PLACE, exact.data(), (int)elements, MPI_FLOAT, MPI_SUM, MPI_COMM_WORLD);
+        std::vector<float> out(elements);
+        auto read_dest = [&]() {
+            aclrtMemcpy(out.data(), elements * sizeof(float), dest, elements * sizeof(float),
+                        ACL_MEMCPY_DEVICE_TO_HOST);
+        };
+
+        double us[3] = {};
+        double err[2] = {};
+        us[0] = time_launches(stream, [&]() {
+            shmem_float_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, stream);
+        });
+        for (int format = SHMEMX_QUANT_BF16; format < SHMEMX_QUANT_FORMAT_NUM; format++) {
+            config.format = format;
+            config.error = 0;
+            us[1 + format] = time_launches(stream, [&]() {
+                shmemx_float_sum_allreduce_quant_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, &config,
+                                                           stream);
+            });
+            read_dest();
+            err[format] = relative_error(out, exact);
+        }
+
+        // average of ef_steps int8 calls, without then with error feedback
+        double avg_err[2] = {};
+        for (int feedback = 0; feedback < 2; feedback++) {
+            config.error = feedback ? (uint64_t)error : 0;
+            aclrtMemset(error, elements * sizeof(float), 0, elements * sizeof(float));
+            std::vector<float> avg(elements, 0.0f);
+            for (int step = 0; step < ef_steps; step++) {
+                shmemx_float_sum_allreduce_quant_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, &config,
+                                                           stream);
+                aclrtSynchronizeStream(stream);
+                read_dest();
+                for (size_t e = 0; e < elements; e++) {
+                    avg[e] += out[e] / ef_steps;
+                }
+            }
+            avg_err[feedback] = relative_error(avg, exact);
+        }
+        for (double &t : us) {
+            MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        }
+
+        if (rank_id == 0) {
+            std::cout << std::setw(12) << elements * sizeof(float) << std::fixed << std::setprecision(2)
+                      << std::setw(12) << us[0] << std::setw(12) << us[1] << std::setw(12) << us[2]
+                      << std::scientific << std::setprecision(2) << std::setw(12) << err[SHMEMX_QUANT_BF16]
+                      << std::setw(12) << err[SHMEMX_QUANT_INT8] << std::setw(12) << avg_err[0] << std::setw(12)
+                      << avg_err[1] << std::defaultfloat << std::endl;
+        }
+    }
+
+    shmem_free(work);
+    shmem_free(error);
+    shmem_free(dest);
+    shmem_free(source);
+}
+
+// one sum allreduce of dtype, a shmemx_work_dtype_t
+static void launch_sum_allreduce(int dtype, void *dest, void *source, size_t elements, aclrtStream stream)
+{
+    switch (dtype) {
+        case SHMEMX_WORK_HALF:
+            shmem_half_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, (shmem_half_t *)dest, (shmem_half_t *)source,
+                                               elements, stream);
+            break;
+        case SHMEMX_WORK_BFLOAT16:
+            shmem_bfloat16_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, (shmem_bfloat16_t *)dest,
+                                                   (shmem_bfloat16_t *)source, elements, stream);
+            break;
+        case SHMEMX_WORK_FLOAT:
+            shmem_float_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, (float *)dest, (float *)source, elements, stream);
+            break;
+        case SHMEMX_WORK_INT16:
+            shmem_int16_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, (int16_t *)dest, (int16_t *)source, elements,
+                                                stream);
+            break;
+        default:
+            shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, (int32_t *)dest, (int32_t *)source, elements,
+                                                stream);
+            break;
+    }
+}
+
+/* Throughput of every reduction type, of the local vector reductions combining reduce_blocks blocks the way a
+   collective combines the blocks of its peers, and of the sum allreduce on SHMEM_TEAM_WORLD. half and bfloat16 are
+   accumulated in float, the conversions are part of their time. */
+static void compare_dtypes(int rank_id, int n_ranks, aclrtStream stream)
+{
+    static const char *dtype_names[SHMEMX_WORK_DTYPE_NUM] = {"half", "bfloat16", "float", "int16", "int32"};
+    static const size_t dtype_sizes[SHMEMX_WORK_DTYPE_NUM] = {2, 2, 4, 2, 4};
+    constexpr int reduce_ops = 4;
+    constexpr int reduce_blocks = 8;
+    constexpr uint32_t reduce_block_dim = 16;
+    constexpr int dtype_case_num = 5;
+    size_t max_bytes = (size_t)64 * 1024 << (dtype_case_num - 1);
+    void *blocks = nullptr;
+    void *result = nullptr;
+    aclrtMalloc(&blocks, reduce_blocks * max_bytes, ACL_MEM_MALLOC_HUGE_FIRST);
+    aclrtMalloc(&result, max_bytes, ACL_MEM_MALLOC_HUGE_FIRST);
+    aclrtMemset(blocks, reduce_blocks * max_bytes, 0, reduce_blocks * max_bytes);
+    void *source = shmem_malloc(max_bytes);
+    void *dest = shmem_malloc(max_bytes);
+    aclrtMemset(source, max_bytes, 0, max_bytes);
+
+    if (rank_id == 0) {
+        std::cout << std::setw(10) << "dtype" << std::setw(12) << "bytes" << std::setw(12) << "sum(GB/s)"
+                  << std::setw(12) << "max(GB/s)" << std::setw(12) << "min(GB/s)" << std::setw(12) << "prod(GB/s)"
+                  << std::setw(16) << "allreduce(us)" << std::setw(16) << "allreduce(GB/s)" << std::endl;
+    }
+    for (int dtype = 0; dtype < SHMEMX_WORK_DTYPE_NUM; dtype++) {
+        for (int i = 0; i < dtype_case_num; i++) {
+            size_t bytes = (size_t)64 * 1024 << i;
+            size_t elements = bytes / dtype_sizes[dtype];
+            double us[reduce_ops + 1] = {};
+            for (int op = SHMEMI_REDUCE_SUM; op <= SHMEMI_REDUCE_PROD; op++) {
+                us[op] = time_launches(stream, [&]() {
+                    reduce_local_demo(reduce_block_dim, stream, dtype, op, (uint8_t *)result, (uint8_t *)blocks,
+                                      reduce_blocks, elements);
+                });
+            }
+            us[reduce_ops] = time_launches(stream, [&]() {
+                launch_sum_allreduce(dtype, dest, source, elements, stream);
+            });
+            MPI_Allreduce(MPI_IN_PLACE, us, reduce_ops + 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+            if (rank_id == 0) {
+                std::cout << std::setw(10) << dtype_names[dtype] << std::setw(12) << bytes << std::fixed
+                          << std::setprecision(2);
+                // the blocks read and the result written
+                for (int op = 0; op < reduce_ops; op++) {
+                    std::cout << std::setw(12) << (double)bytes * (reduce_blocks + 1) / us[op] / 1e3;
+                }
+                std::cout << std::setw(16) << us[reduce_ops] << std::setw(16)
+                          << 2.0 * bytes * (n_ranks - 1) / n_ranks / us[reduce_ops] / 1e3 << std::endl;
+            }
+        }
+    }
+
+    shmem_free(dest);
+    shmem_free(source);
+    aclrtFree(result);
+    aclrtFree(blocks);
+}
+
+int test_coll_perf(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+
+    if (strcmp(mode, "perf") != 0) {
+        if (strcmp(mode, "tune") == 0) {
+            tune_coll_algos(rank_id, n_ranks, stream);
+        } else if (strcmp(mode, "ll") == 0) {
+            compare_ll_algos(rank_id, n_ranks, stream);
+        } else if (strcmp(mode, "alltoallv") == 0) {
+            compare_alltoallv(rank_id, n_ranks, stream);
+        } else if (strcmp(mode, "dtype") == 0) {
+            compare_dtypes(rank_id, n_ranks, stream);
+        } else {
+            compare_quant(rank_id, n_ranks, stream);
+        }
+        status = shmem_finalize();
+        status = aclrtDestroyStream(stream);
+        status = aclrtResetDevice(device_id);
+        status = aclFinalize();
+        return status;
+    }
+
+    uint64_t fftsAddr = shmemx_get_ffts_config();
+    // the example kernel owns the scratch of SHMEM_TEAM_WORLD, no quantized collective runs with work 0 here
+    void *scratch = nullptr;
+    status = shmemx_team_set_scratch_size(SHMEM_TEAM_WORLD, SCRATCH_SIZE);
+    if (status == 0) {
+        status = shmemx_team_get_scratch(SHMEM_TEAM_WORLD, SCRATCH_SIZE, &scratch);
+    }
+    if (status != 0) {
+        std::cerr << "[rank " << rank_id << "] scratch setup failed: " << status << std::endl;
+        shmem_finalize();
+        aclrtDestroyStream(stream);
+        aclrtResetDevice(device_id);
+        aclFinalize();
+        return 1;
+    }
+
+    if (rank_id == 0) {
+        std::cout << std::setw(12) << "bytes/PE" << std::setw(16) << "example_ag(us)" << std::setw(16)
+                  << "shmem_ag(us)" << std::setw(16) << "shmem_ag(GB/s)" << std::setw(16) << "shmem_ar(us)"
+                  << std::setw(16) << "shmem_ar(GB/s)" << std::endl;
+    }
+
+    for (int i = 0; i < CASE_NUM; i++) {
+        int elements = 16 * (1 << i);
+        size_t bytes = elements * sizeof(int);
+
+        // example kernel, same setting as examples/allgather
+        uint32_t block_num = bytes < 2097152 ? 8 : 16;
+        void *input_ptr;
+        void *output_ptr;
+        aclrtMalloc(&input_ptr, bytes, ACL_MEM_MALLOC_HUGE_FIRST);
+        aclrtMalloc(&output_ptr, bytes * n_ranks, ACL_MEM_MALLOC_HUGE_FIRST);
+        double example_us = time_launches(stream, [&]() {
+            allgather_demo<int>(block_num, stream, fftsAddr, (uint8_t *)input_ptr, (uint8_t *)output_ptr, elements);
+        });
+        aclrtFree(input_ptr);
+        aclrtFree(output_ptr);
+
+        // library collectives
+        int *source = (int *)shmem_malloc(bytes);
+        int *dest = (int *)shmem_malloc(bytes * n_ranks);
+        aclrtMemset(source, bytes, 0, bytes);
+        double allgather_us = time_launches(stream, [&]() {
+            shmem_int32_allgather_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, stream);
+        });
+        double allreduce_us = time_launches(stream, [&]() {
+            shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dest, source, elements, stream);
+        });
+        shmem_free(dest);
+        shmem_free(source);
+
+        // bus bandwidth, the bytes every PE receives from the others
+        double allgather_bw = (double)bytes * (n_ranks - 1) / allgather_us / 1e3;
+        double allreduce_bw = 2.0 * bytes * (n_ranks - 1) / n_ranks / allreduce_us / 1e3;
+        if (rank_id == 0) {
+            std::cout << std::setw(12) << bytes << std::fixed << std::setprecision(2) << std::setw(16) << example_us
+                      << std::setw(16) << allgather_us << std::setw(16) << allgather_bw << std::setw(16)
+                      << allreduce_us << std::setw(16) << allreduce_bw << std::endl;
+        }
+    }
+
+    status = shmem_finalize();
+    status = aclrtDestroyStream(stream);
+    status = aclrtResetDevice(device_id);
+    status = aclFinalize();
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    int status = 0;
+    MPI_Init(&argc, &argv);
+    int rank_id, n_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_id);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
+    if (argc > 4) {
+        ipport = argv[1];
+        g_npus = atoi(argv[2]);
+        f_rank = atoi(argv[3]);
+        f_npu = atoi(argv[4]);
+    }
+    if (argc > 5) {
+        mode = argv[5];
+    }
+    if (argc > 6) {
+        // the last argument is the block size of the int8 format in quant mode
+        if (strcmp(mode, "quant") == 0) {
+            quant_block = (uint32_t)atoi(argv[6]);
+        } else {
+            tune_path = argv[6];
+        }
+    }
+
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    status = test_coll_perf(rank_id, n_ranks, local_mem_size);
+    if (status) {
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::cout << "[SUCCESS] demo run success in rank " << rank_id << std::endl;
+
+    MPI_Finalize();
+    return 0;
+}
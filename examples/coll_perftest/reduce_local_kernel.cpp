@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+#include "shmem_api.h"
+
+// reduces num blocks of nelems elements, one after the other, into dest with op, a shmemi_reduce_op_t
+#define REDUCE_LOCAL_KERNEL(NAME, TYPE)                                                                            \
+    extern "C" SHMEM_GLOBAL void reduce_local_##NAME(GM_ADDR dest, GM_ADDR source, int num, uint64_t nelems,       \
+                                                     int op)                                                       \
+    {                                                                                                              \
+        auto dst = (__gm__ TYPE *)dest;                                                                            \
+        auto src = (__gm__ TYPE *)source;                                                                          \
+        switch (op) {                                                                                              \
+            case SHMEMI_REDUCE_SUM:                                                                                \
+                shmemx_##NAME##_sum_reduce_local(dst, src, num, nelems, nelems);                                   \
+                break;                                                                                             \
+            case SHMEMI_REDUCE_MAX:                                                                                \
+                shmemx_##NAME##_max_reduce_local(dst, src, num, nelems, nelems);                                   \
+                break;                                                                                             \
+            case SHMEMI_REDUCE_MIN:                                                                                \
+                shmemx_##NAME##_min_reduce_local(dst, src, num, nelems, nelems);                                   \
+                break;                                                                                             \
+            default:                                                                                               \
+                shmemx_##NAME##_prod_reduce_local(dst, src, num, nelems, nelems);                                  \
+                break;                                                                                             \
+        }                                                                                                          \
+    }
+
+SHMEM_REDUCE_TYPE_FUNC(REDUCE_LOCAL_KERNEL);
+#undef REDUCE_LOCAL_KERNEL
+
+// dtype is a shmemx_work_dtype_t
+void reduce_local_demo(uint32_t block_dim, void *stream, int dtype, int op, uint8_t *dest, uint8_t *source, int num,
+                       uint64_t nelems)
+{
+    switch (dtype) {
+        case SHMEMX_WORK_HALF:
+            reduce_local_half<<<block_dim, nullptr, stream>>>(dest, source, num, nelems, op);
+            break;
+        case SHMEMX_WORK_BFLOAT16:
+            reduce_local_bfloat16<<<block_dim, nullptr, stream>>>(dest, source, num, nelems, op);
+            break;
+        case SHMEMX_WORK_FLOAT:
+            reduce_local_float<<<block_dim, nullptr, stream>>>(dest, source, num, nelems, op);
+            break;
+        case SHMEMX_WORK_INT16:
+            reduce_local_int16<<<block_dim, nullptr, stream>>>(dest, source, num, nelems, op);
+            break;
+        default:
+            reduce_local_int32<<<block_dim, nullptr, stream>>>(dest, source, num, nelems, op);
+            break;
+    }
+}
@@ -102,12 +102,7 @@ python3 ./scripts/gen_data.py \
 echo "PROJECT_ROOT: $PROJECT_ROOT"
 echo "Test Case, M: ${M}, K: ${K}, N: ${N}"
 export LD_LIBRARY_PATH=${PROJECT_ROOT}/build/lib:${PROJECT_ROOT}/install/memfabric_hybrid/lib/:${ASCEND_HOME_PATH}/lib64:$LD_LIBRARY_PATH
-for (( idx =0; idx < ${RANK_SIZE}; idx = idx + 1 )); do
-    ${PROJECT_ROOT}/build/bin/matmul_allreduce "$RANK_SIZE" "$idx" "$IPPORT" "$FIRST_NPU" "$M" "$K" "$N" $DATA_DIR &
-done
-
-# Wait until all process exit
-wait
+mpirun -np ${RANK_SIZE} ${PROJECT_ROOT}/build/bin/matmul_allreduce "$IPPORT" "$FIRST_NPU" "$M" "$K" "$N" $DATA_DIR
 
 # Verify output
 python3 ./scripts/verify_result.py ${DATA_DIR}/shmem_output.bin ${DATA_DIR}/golden.bin 1 ${M} ${N} ${K}
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <acl/acl.h>
+#include <mpi.h>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+// from catlass
+#include "catlass/catlass.hpp"
+#include "catlass/gemm/kernel/basic_matmul.hpp"
+
+// from shmem-fusion
+#include "fusion/shmem_fusion.hpp"
+
+// shmem_host
+#include "shmem_api.h"
+
+using namespace Catlass;
+
+int g_npus = 8;
+const char *ipport = "tcp://127.0.0.1:8998";
+int f_npu = 0;
+const char *dtype = "all";
+
+constexpr uint32_t BLOCK_NUM = 20;
+constexpr int PERF_TIMES = 20;
+
+template <class Element>
+CATLASS_GLOBAL void FusedMatmulAllReduce(uint64_t fftsAddr, GM_ADDR a, GM_ADDR b, GM_ADDR c, GM_ADDR symmetricPtr,
+                                         Fusion::CocTiling tiling)
+{
+    shmemx_set_ffts_config(fftsAddr);
+    Fusion::MatmulAllReduce<Element>(a, b, c, symmetricPtr, tiling);
+}
+
+template <class Element>
+CATLASS_GLOBAL void FusedMatmulReduceScatter(uint64_t fftsAddr, GM_ADDR a, GM_ADDR b, GM_ADDR c,
+                                             GM_ADDR symmetricPtr, Fusion::CocTiling tiling)
+{
+    shmemx_set_ffts_config(fftsAddr);
+    Fusion::MatmulReduceScatter<Element>(a, b, c, symmetricPtr, tiling);
+}
+
+template <class Element>
+CATLASS_GLOBAL void FusedAllGatherMatmul(uint64_t fftsAddr, GM_ADDR a, GM_ADDR b, GM_ADDR gatheredA, GM_ADDR c,
+                                         Fusion::CocTiling tiling)
+{
+    shmemx_set_ffts_config(fftsAddr);
+    Fusion::AllGatherMatmul<Element>(a, b, gatheredA, c, tiling);
+}
+
+// the GEMM of the unfused baseline, same tile config as the fused kernels
+template <class Element>
+CATLASS_GLOBAL void BaselineMatmul(GemmCoord problemShape, GM_ADDR a, GM_ADDR b, GM_ADDR c)
+{
+    using Types = Fusion::CocGemmTypes<Element>;
+    using Kernel = Gemm::Kernel::BasicMatmul<typename Types::BlockMmad, void, typename Types::BlockScheduler>;
+    typename Kernel::Params params{problemShape,
+                                   a, layout::RowMajor(problemShape.m(), problemShape.k(), problemShape.k()),
+                                   b, layout::RowMajor(problemShape.k(), problemShape.n(), problemShape.n()),
+                                   c, layout::RowMajor(problemShape.m(), problemShape.n(), problemShape.n())};
+    Kernel matmul;
+    matmul(params);
+}
+
+// average time of one launch in us, the PEs start together and the stream is drained at the end
+static double time_launches(aclrtStream stream, const std::function<void()> &launch)
+{
+    launch();
+    aclrtSynchronizeStream(stream);
+    shmem_barrier_all();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PERF_TIMES; i++) {
+        launch();
+    }
+    aclrtSynchronizeStream(stream);
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count() / PERF_TIMES;
+    // the slowest PE decides
+    MPI_Allreduce(MPI_IN_PLACE, &us, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return us;
+}
+
+// collectives of the baseline on the host type carrying the bits of Element
+template <class Element>
+struct BaselineColl;
+
+template <>
+struct BaselineColl<half> {
+    static constexpr const char *name = "fp16";
+    static void AllReduce(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_half_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, (shmem_half_t *)dest, (shmem_half_t *)source, nelems,
+                                           stream);
+    }
+    static void ReduceScatter(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_half_sum_reduce_scatter_on_stream(SHMEM_TEAM_WORLD, (shmem_half_t *)dest, (shmem_half_t *)source,
+                                                nelems, stream);
+    }
+    static void AllGather(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_uint16_allgather_on_stream(SHMEM_TEAM_WORLD, (uint16_t *)dest, (uint16_t *)source, nelems, stream);
+    }
+};
+
+template <>
+struct BaselineColl<bfloat16_t> {
+    static constexpr const char *name = "bf16";
+    static void AllReduce(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_bfloat16_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, (shmem_bfloat16_t *)dest,
+                                               (shmem_bfloat16_t *)source, nelems, stream);
+    }
+    static void ReduceScatter(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_bfloat16_sum_reduce_scatter_on_stream(SHMEM_TEAM_WORLD, (shmem_bfloat16_t *)dest,
+                                                    (shmem_bfloat16_t *)source, nelems, stream);
+    }
+    static void AllGather(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_uint16_allgather_on_stream(SHMEM_TEAM_WORLD, (uint16_t *)dest, (uint16_t *)source, nelems, stream);
+    }
+};
+
+template <>
+struct BaselineColl<float> {
+    static constexpr const char *name = "fp32";
+    static void AllReduce(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_float_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, (float *)dest, (float *)source, nelems, stream);
+    }
+    static void ReduceScatter(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_float_sum_reduce_scatter_on_stream(SHMEM_TEAM_WORLD, (float *)dest, (float *)source, nelems, stream);
+    }
+    static void AllGather(void *dest, void *source, size_t nelems, aclrtStream stream)
+    {
+        shmem_float_allgather_on_stream(SHMEM_TEAM_WORLD, (float *)dest, (float *)source, nelems, stream);
+    }
+};
+
+static void print_row(const char *op, const char *type, double baseline_us, double fused_us)
+{
+    std::cout << std::setw(12) << op << std::setw(8) << type << std::fixed << std::setprecision(2) << std::setw(16)
+              << baseline_us << std::setw(16) << fused_us << std::setw(12) << baseline_us / fused_us << std::endl;
+}
+
+template <class Element>
+int run_case(int rank_id, int n_ranks, Fusion::CocTiling tiling, aclrtStream stream)
+{
+    using Coll = BaselineColl<Element>;
+    size_t elem_size = sizeof(Element);
+    Fusion::CocTilingSetTile(tiling, elem_size);
+    if (!Fusion::CocTilingValid(tiling, n_ranks, elem_size) || !Fusion::CocRowSplitValid(tiling, n_ranks)) {
+        if (rank_id == 0) {
+            std::cerr << "[ERROR] invalid " << Coll::name << " tiling: m must split over " << n_ranks
+                      << " ranks in whole " << tiling.m0 << "-row tiles" << std::endl;
+        }
+        return -1;
+    }
+    uint32_t m = tiling.m;
+    uint32_t n = tiling.n;
+    uint32_t k = tiling.k;
+    uint32_t m_per_rank = m / n_ranks;
+    uint64_t ffts_addr = shmemx_get_ffts_config();
+
+    // A, B and C of the full problem, symmetric so that every variant can run on them
+    size_t a_bytes = static_cast<size_t>(m) * k * elem_size;
+    size_t b_bytes = static_cast<size_t>(k) * n * elem_size;
+    size_t c_bytes = static_cast<size_t>(m) * n * elem_size;
+    uint8_t *a = (uint8_t *)shmem_malloc(a_bytes);
+    uint8_t *b = (uint8_t *)shmem_malloc(b_bytes);
+    uint8_t *c = (uint8_t *)shmem_malloc(c_bytes);
+    uint8_t *c_local = (uint8_t *)shmem_malloc(c_bytes);
+    uint8_t *a_gathered = (uint8_t *)shmem_malloc(a_bytes);
+    uint8_t *workspace = (uint8_t *)shmem_malloc(Fusion::CocWorkspaceBytes(tiling, BLOCK_NUM, elem_size));
+    if (a == nullptr || b == nullptr || c == nullptr || c_local == nullptr || a_gathered == nullptr ||
+        workspace == nullptr) {
+        std::cerr << "[ERROR] shmem_malloc failed in rank " << rank_id << std::endl;
+        return -1;
+    }
+    aclrtMemset(a, a_bytes, 0, a_bytes);
+    aclrtMemset(b, b_bytes, 0, b_bytes);
+
+    GemmCoord full_shape{m, n, k};
+    size_t slab_a_elems = static_cast<size_t>(m_per_rank) * k;
+    size_t slab_c_elems = static_cast<size_t>(m_per_rank) * n;
+
+    // GEMM + allreduce
+    double ar_base = time_launches(stream, [&]() {
+        BaselineMatmul<Element><<<BLOCK_NUM, nullptr, stream>>>(full_shape, a, b, c_local);
+        Coll::AllReduce(c, c_local, static_cast<size_t>(m) * n, stream);
+    });
+    double ar_fused = time_launches(stream, [&]() {
+        FusedMatmulAllReduce<Element><<<BLOCK_NUM, nullptr, stream>>>(ffts_addr, a, b, c, workspace, tiling);
+    });
+
+    // GEMM + reduce-scatter
+    double rs_base = time_launches(stream, [&]() {
+        BaselineMatmul<Element><<<BLOCK_NUM, nullptr, stream>>>(full_shape, a, b, c_local);
+        Coll::ReduceScatter(c, c_local, slab_c_elems, stream);
+    });
+    double rs_fused = time_launches(stream, [&]() {
+        FusedMatmulReduceScatter<Element><<<BLOCK_NUM, nullptr, stream>>>(ffts_addr, a, b, c, workspace, tiling);
+    });
+
+    // allgather + GEMM, the local slab of A is the first m / n_ranks rows
+    double ag_base = time_launches(stream, [&]() {
+        Coll::AllGather(a_gathered, a, slab_a_elems, stream);
+        BaselineMatmul<Element><<<BLOCK_NUM, nullptr, stream>>>(full_shape, a_gathered, b, c);
+    });
+    double ag_fused = time_launches(stream, [&]() {
+        FusedAllGatherMatmul<Element><<<BLOCK_NUM, nullptr, stream>>>(ffts_addr, a, b, a_gathered, c, tiling);
+    });
+
+    if (rank_id == 0) {
+        print_row("gemm_ar", Coll::name, ar_base, ar_fused);
+        print_row("gemm_rs", Coll::name, rs_base, rs_fused);
+        print_row("ag_gemm", Coll::name, ag_base, ag_fused);
+    }
+
+    shmem_free(workspace);
+    shmem_free(a_gathered);
+    shmem_free(c_local);
+    shmem_free(c);
+    shmem_free(b);
+    shmem_free(a);
+    return 0;
+}
+
+struct Options {
+    static constexpr auto helper =
+        "Usage: matmul_comm_perftest ipport g_npus f_npu m n k [fp16|bf16|fp32|all] [--pValue pValue --ubMoveNum "
+        "ubMoveNum --split commNpuSplit commDataSplit lenPerLoop --swizzle swizzleOffset swizzleDirect "
+        "--tile m0 n0]\n";
+
+    Fusion::CocTiling tiling;
+
+    int Parse(int argc, char **argv)
+    {
+        if (argc < 7) {
+            printf(helper);
+            return -1;
+        }
+
+        int argIndex = 1;
+        ipport = argv[argIndex++];
+        g_npus = std::atoi(argv[argIndex++]);
+        f_npu = std::atoi(argv[argIndex++]);
+        tiling.m = std::atoi(argv[argIndex++]);
+        tiling.n = std::atoi(argv[argIndex++]);
+        tiling.k = std::atoi(argv[argIndex++]);
+        if (argIndex < argc && argv[argIndex][0] != '-') {
+            dtype = argv[argIndex++];
+        }
+
+        while (argIndex < argc) {
+            std::string flag = std::string(argv[argIndex++]);
+
+            if (flag == "--pValue" && argIndex < argc) {
+                tiling.pValue = std::atoi(argv[argIndex++]);
+            } else if (flag == "--ubMoveNum" && argIndex < argc) {
+                tiling.ubMoveNum = std::atoi(argv[argIndex++]);
+            } else if (flag == "--split" && argIndex + 2 < argc) {
+                tiling.commNpuSplit = std::atoi(argv[argIndex++]);
+                tiling.commDataSplit = std::atoi(argv[argIndex++]);
+                tiling.lenPerLoop = std::atoi(argv[argIndex++]);
+            } else if (flag == "--swizzle" && argIndex + 1 < argc) {
+                tiling.swizzleOffset = std::atoi(argv[argIndex++]);
+                tiling.swizzleDirect = std::atoi(argv[argIndex++]);
+            } else if (flag == "--tile" && argIndex + 1 < argc) {
+                tiling.m0 = std::atoi(argv[argIndex++]);
+                tiling.n0 = std::atoi(argv[argIndex++]);
+            } else {
+                printf(helper);
+                return -1;
+            }
+        }
+
+        return 0;
+    }
+};
+
+int main(int argc, char **argv)
+{
+    int status = 0;
+    MPI_Init(&argc, &argv);
+    int rank_id;
+    int n_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_id);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
+
+    Options options;
+    if (options.Parse(argc, argv) != 0) {
+        MPI_Finalize();
+        return -1;
+    }
+
+    int32_t device_id = rank_id % g_npus + f_npu;
+    aclrtStream stream = nullptr;
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    uint64_t local_mem_size = 4UL * 1024UL * 1024UL * 1024UL;
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+
+    if (rank_id == 0) {
+        std::cout << "m " << options.tiling.m << " n " << options.tiling.n << " k " << options.tiling.k << " ranks "
+                  << n_ranks << std::endl;
+        std::cout << std::setw(12) << "op" << std::setw(8) << "dtype" << std::setw(16) << "unfused(us)"
+                  << std::setw(16) << "fused(us)" << std::setw(12) << "speedup" << std::endl;
+    }
+    std::string type = dtype;
+    if (status == 0 && (type == "fp16" || type == "all")) {
+        status = run_case<half>(rank_id, n_ranks, options.tiling, stream);
+    }
+    if (status == 0 && (type == "bf16" || type == "all")) {
+        status = run_case<bfloat16_t>(rank_id, n_ranks, options.tiling, stream);
+    }
+    if (status == 0 && (type == "fp32" || type == "all")) {
+        status = run_case<float>(rank_id, n_ranks, options.tiling, stream);
+    }
+
+    shmem_finalize();
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    MPI_Finalize();
+    if (status != 0) {
+        std::exit(EXIT_FAILURE);
+    }
+    std::cout << "[SUCCESS] demo run success in rank " << rank_id << std::endl;
+    return 0;
+}
@@ -12,6 +12,8 @@
 #include <cstdlib>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <chrono>
 #include <sys/file.h>
 #include <stdio.h>
 #include <string.h>
@@ -21,6 +23,13 @@
 #include "shmem_api.h"
 #include "shmemi_host_common.h"
 
+// AscendC::GetSystemCycle counts at 50 MHz, whatever the AI core clock
+constexpr double CYCLES_PER_US = 50.0;
+// blocks of the multi-core bandwidth launch, and the result slots its kernel keeps behind the data
+constexpr uint32_t MULTI_CORE_BLOCK_DIM = 8;
+constexpr uint32_t MULTI_CORE_SLOTS = 64;
+constexpr uint32_t MULTI_CORE_RESULT_OFFSET = 64;
+
 int g_npus = 8;
 const char *ipport;
 int f_rank = 0;
@@ -30,7 +39,14 @@ const char *test_type;
 extern void rdma_highlevel_put_pingpong_latency_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length);
 extern void rdma_postsend_cost_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length);
 extern void rdma_highlevel_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length);
+extern void rdma_multi_core_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length);
+extern void rdma_allreduce_one_block_do(void* stream, uint64_t fftsConfig, uint8_t* dest, uint8_t* source, uint64_t nelems);
+extern void rdma_put_signal_pingpong_latency_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length);
 extern void rdma_mte_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length, int64_t iter);
+extern void rdma_barrier_latency_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, shmem_team_t team);
+extern void rdma_p_rate_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int32_t rounds);
+extern void rdma_p_rate_cached_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int32_t rounds);
+extern void rdma_wait_vector_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int32_t nflags, int32_t mode);
 
 int test_shmem_rdma_highlevel_put_pingpong_latency(int rank_id, int n_ranks, uint64_t local_mem_size, int message_length)
 {
@@ -66,7 +82,7 @@ int test_shmem_rdma_highlevel_put_pingpong_latency(int rank_id, int n_ranks, uin
     aclrtSynchronizeStream(stream);
     if (rank_id == 0) {
         aclrtMemcpy(xHost, sizeof(int64_t), gva + message_length * n_ranks, sizeof(int64_t), ACL_MEMCPY_DEVICE_TO_HOST);
-        std::cout << "RDMA highlevel put pingpong latency test. Message length = " << message_length << " Byte; latency = " << xHost[0] / 50.0 << " us." << std::endl;
+        std::cout << "RDMA highlevel put pingpong latency test. Message length = " << message_length << " Byte; latency = " << xHost[0] / CYCLES_PER_US << " us." << std::endl;
     }
 
     aclrtFreeHost(xHost);
@@ -109,8 +125,9 @@ int test_shmem_rdma_postsend_cost(int rank_id, int n_ranks, uint64_t local_mem_s
     }
     aclrtSynchronizeStream(stream);
     if (rank_id == 0) {
-        aclrtMemcpy(xHost, sizeof(int64_t), gva + message_length * n_ranks, sizeof(int64_t), ACL_MEMCPY_DEVICE_TO_HOST);
-        std::cout << "RDMA postsend cost test. Message length = " << message_length << " Byte; postsend cost = " << xHost[0] / (50.0 * 500) << " us." << std::endl;
+        aclrtMemcpy(xHost, sizeof(int64_t) * 2, gva + message_length * n_ranks, sizeof(int64_t) * 2, ACL_MEMCPY_DEVICE_TO_HOST);
+        std::cout << "RDMA postsend cost test. Message length = " << message_length << " Byte; postsend cost = " << xHost[0] / (CYCLES_PER_US * 500) << " us." << std::endl;
+        std::cout << "RDMA postsend list cost test. Message length = " << message_length << " Byte; postsend cost = " << xHost[1] / (CYCLES_PER_US * 500) << " us." << std::endl;
     }
 
     aclrtFreeHost(xHost);
@@ -151,7 +168,7 @@ int test_shmem_rdma_highlevel_put_bw(int rank_id, int n_ranks, uint64_t local_me
     aclrtSynchronizeStream(stream);
     if (rank_id == 0) {
         aclrtMemcpy(xHost, sizeof(int64_t), gva + message_length * n_ranks, sizeof(int64_t), ACL_MEMCPY_DEVICE_TO_HOST);
-        std::cout << "RDMA high level put bandwidth test. Message length = " << message_length << " Byte; time = " << xHost[0] / (50.0) << " us." << std::endl;
+        std::cout << "RDMA high level put bandwidth test. Message length = " << message_length << " Byte; time = " << xHost[0] / CYCLES_PER_US << " us." << std::endl;
     }
 
     aclrtFreeHost(xHost);
@@ -162,6 +179,125 @@ int test_shmem_rdma_highlevel_put_bw(int rank_id, int n_ranks, uint64_t local_me
     return 0;
 }
 
+int test_shmem_rdma_put_signal_pingpong_latency(int rank_id, int n_ranks, uint64_t local_mem_size, int message_length)
+{
+    const int rounds = 100;
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+
+    uint64_t fftsConfig = shmemx_get_ffts_config();
+    uint8_t* gva = (uint8_t*)shmem_malloc(1024 * 1024 * 6);
+
+    int64_t *xHost;
+    size_t totalSize = message_length * n_ranks;
+
+    aclrtMallocHost((void **)(&xHost), totalSize);
+    for (uint32_t i = 0; i < message_length / sizeof(int64_t); i++) {
+        xHost[i] = rank_id + 10;
+    }
+    aclrtMemcpy(gva + rank_id * message_length, message_length, xHost, message_length, ACL_MEMCPY_HOST_TO_DEVICE);
+    aclrtMemset(gva + n_ranks * message_length, 256, 0, 256);
+    shmemi_control_barrier_all();
+
+    rdma_put_signal_pingpong_latency_do(1, stream, fftsConfig, gva, message_length);
+    aclrtSynchronizeStream(stream);
+    if (rank_id == 0) {
+        aclrtMemcpy(xHost, sizeof(int64_t) * 2, gva + message_length * n_ranks, sizeof(int64_t) * 2, ACL_MEMCPY_DEVICE_TO_HOST);
+        std::cout << "RDMA put signal pingpong latency test. Message length = " << message_length << " Byte; fused latency = " << xHost[0] / (CYCLES_PER_US * rounds * 2) << " us." << std::endl;
+        std::cout << "RDMA put signal pingpong latency test. Message length = " << message_length << " Byte; put + quiet + flag latency = " << xHost[1] / (CYCLES_PER_US * rounds * 2) << " us." << std::endl;
+    }
+
+    aclrtFreeHost(xHost);
+    shmem_finalize();
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    return 0;
+}
+
+int test_shmem_rdma_multi_qp_bw(int rank_id, int n_ranks, uint64_t local_mem_size, int message_length)
+{
+    const uint32_t qp_nums[] = {1, 2, 4, 8};
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    int64_t *xHost;
+    size_t totalSize = message_length * n_ranks;
+    aclrtMallocHost((void **)(&xHost), totalSize);
+
+    for (uint32_t qp_num : qp_nums) {
+        shmem_init_attr_t *attributes;
+        status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+        status = shmem_set_roce_qp_num(attributes, qp_num);
+        status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+
+        uint64_t fftsConfig = shmemx_get_ffts_config();
+        uint8_t* gva = (uint8_t*)shmem_malloc(1024 * 1024 * 6);
+        for (uint32_t i = 0; i < message_length / sizeof(int64_t); i++) {
+            xHost[i] = rank_id + 10;
+        }
+        aclrtMemcpy(gva + rank_id * message_length, message_length, xHost, message_length, ACL_MEMCPY_HOST_TO_DEVICE);
+
+        rdma_highlevel_put_bw_do(1, stream, fftsConfig, gva, message_length);
+        aclrtSynchronizeStream(stream);
+        if (rank_id == 0) {
+            // time at offset 0, number of QPs the kernel striped over at offset 24
+            aclrtMemcpy(xHost, sizeof(int64_t) * 4, gva + message_length * n_ranks, sizeof(int64_t) * 4,
+                        ACL_MEMCPY_DEVICE_TO_HOST);
+            double time_us = xHost[0] / CYCLES_PER_US;
+            std::cout << "RDMA multi QP put bandwidth test. QP number = " << qp_num << "; single core, striped QPs = "
+                      << xHost[3] << "; Message length = " << message_length << " Byte; time = " << time_us
+                      << " us; bandwidth = " << 10000.0 * message_length / (time_us * 1000.0) << " GB/s." << std::endl;
+        }
+
+        // the same message split over the cores of a multi-core launch, the slowest core gives the time
+        uint8_t *result = gva + message_length * n_ranks + MULTI_CORE_RESULT_OFFSET;
+        std::vector<int64_t> slots(1 + 5 * MULTI_CORE_SLOTS);
+        aclrtMemset(result, slots.size() * sizeof(int64_t), 0, slots.size() * sizeof(int64_t));
+        shmemi_control_barrier_all();
+        rdma_multi_core_put_bw_do(MULTI_CORE_BLOCK_DIM, stream, fftsConfig, gva, message_length);
+        aclrtSynchronizeStream(stream);
+        if (rank_id == 0) {
+            aclrtMemcpy(slots.data(), slots.size() * sizeof(int64_t), result, slots.size() * sizeof(int64_t),
+                        ACL_MEMCPY_DEVICE_TO_HOST);
+            int64_t cores = std::min<int64_t>(slots[0], MULTI_CORE_SLOTS);
+            int64_t cycles = 0;
+            int64_t max_qps = 0;
+            for (int64_t c = 0; c < cores; c++) {
+                cycles = std::max(cycles, slots[1 + 3 * MULTI_CORE_SLOTS + c]);
+                max_qps = std::max(max_qps, slots[1 + 4 * MULTI_CORE_SLOTS + c]);
+            }
+            double time_us = cycles / CYCLES_PER_US;
+            std::cout << "RDMA multi QP put bandwidth test. QP number = " << qp_num << "; " << cores
+                      << " cores, QPs in use = " << std::min<int64_t>(qp_num, cores) << ", striped QPs per core = "
+                      << max_qps << "; Message length = " << message_length << " Byte; time = " << time_us
+                      << " us; bandwidth = " << 10000.0 * message_length / (time_us * 1000.0) << " GB/s." << std::endl;
+        }
+        shmem_free(gva);
+        shmem_finalize();
+    }
+
+    aclrtFreeHost(xHost);
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    return 0;
+}
+
 int test_shmem_rdma_mte_put_bw(int rank_id, int n_ranks, uint64_t local_mem_size, int message_length)
 {
     int32_t device_id = rank_id % g_npus + f_npu;
@@ -201,8 +337,8 @@ int test_shmem_rdma_mte_put_bw(int rank_id, int n_ranks, uint64_t local_mem_size
         aclrtSynchronizeStream(stream);
         if (rank_id == 0 && iter >= 10) {
             aclrtMemcpy(outHost, 64, gva + message_length * n_ranks * 2, 64, ACL_MEMCPY_DEVICE_TO_HOST);
-            rdmaTotalTime += outHost[0] / 50.0;
-            mteTotalTime += outHost[6] / 50.0;
+            rdmaTotalTime += outHost[0] / CYCLES_PER_US;
+            mteTotalTime += outHost[6] / CYCLES_PER_US;
         }
     }
     if (rank_id == 0) {
@@ -219,6 +355,245 @@ int test_shmem_rdma_mte_put_bw(int rank_id, int n_ranks, uint64_t local_mem_size
     return 0;
 }
 
+int test_shmem_barrier_latency(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    const int rounds = 100;
+    const int min_team_size = 8;
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+
+    uint64_t fftsConfig = shmemx_get_ffts_config();
+    uint8_t* gva = (uint8_t*)shmem_malloc(1024);
+    int64_t cost = 0;
+
+    const char *algo_names[SHMEMX_BARRIER_ALGO_NUM] = {"auto", "dissem", "group_dissem", "central", "hier"};
+
+    // Team sizes double from 8 ranks up to the world size. Every algorithm able to span the team is measured,
+    // which gives the crossover table behind the automatic selection.
+    for (int team_size = std::min(min_team_size, n_ranks); ; team_size = std::min(team_size * 2, n_ranks)) {
+        shmem_team_t team = SHMEM_TEAM_WORLD;
+        if (team_size < n_ranks) {
+            status = shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, team_size, &team);
+        }
+        int auto_algo = SHMEMX_BARRIER_AUTO;
+        shmemx_team_get_barrier_algo(team, &auto_algo);
+        for (int algo = SHMEMX_BARRIER_DISSEM; algo < SHMEMX_BARRIER_ALGO_NUM; algo++) {
+            bool supported = rank_id < team_size && shmemx_team_set_barrier_algo(team, algo) == 0;
+            if (supported) {
+                rdma_barrier_latency_do(8, stream, fftsConfig, gva, team);
+                aclrtSynchronizeStream(stream);
+            }
+            if (rank_id == 0 && supported) {
+                aclrtMemcpy(&cost, sizeof(int64_t), gva, sizeof(int64_t), ACL_MEMCPY_DEVICE_TO_HOST);
+                std::cout << "Barrier latency test. Team size = " << team_size << "; algo = " << algo_names[algo]
+                          << (algo == auto_algo ? " (auto)" : "") << "; latency = " << cost / (CYCLES_PER_US * rounds)
+                          << " us." << std::endl;
+            }
+            shmemi_control_barrier_all();
+        }
+        if (team != SHMEM_TEAM_WORLD) {
+            shmem_team_destroy(team);
+        } else {
+            shmemx_team_set_barrier_algo(team, SHMEMX_BARRIER_AUTO);
+        }
+        if (team_size == n_ranks) {
+            break;
+        }
+    }
+
+    shmem_free(gva);
+    shmem_finalize();
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    return 0;
+}
+
+int test_shmem_allreduce_bw(int rank_id, int n_ranks, uint64_t local_mem_size, int message_length)
+{
+    const uint32_t qp_nums[] = {1, 2, 4, 8};
+    const int algos[] = {SHMEMX_COLL_TWO_SHOT, SHMEMX_COLL_RING, SHMEMX_COLL_PIPE_RING};
+    const char *algo_names[] = {"two_shot", "ring", "pipe_ring"};
+    const int rounds = 20;
+    const size_t min_length = 1024 * 1024;
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+    size_t max_length = std::max((size_t)message_length, min_length);
+
+    for (uint32_t qp_num : qp_nums) {
+        shmem_init_attr_t *attributes;
+        status = shmem_set_attr(rank_id, n_ranks, local_mem_size + 2 * max_length, ipport, &attributes);
+        status = shmem_set_roce_qp_num(attributes, qp_num);
+        status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+        float *source = (float *)shmem_malloc(max_length);
+        float *dest = (float *)shmem_malloc(max_length);
+        aclrtMemset(source, max_length, 0, max_length);
+
+        // Message sizes double from 1MB per rank up to msg_len. Bus bandwidth counts the 2 * (n - 1) / n of the
+        // message every rank sends and receives, to be compared with the NIC line rate.
+        for (size_t length = min_length; length <= max_length; length *= 2) {
+            size_t nelems = length / sizeof(float);
+            for (size_t a = 0; a < sizeof(algos) / sizeof(algos[0]); a++) {
+                shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, algos[a]);
+                shmem_float_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dest, source, nelems, stream);
+                aclrtSynchronizeStream(stream);
+                shmemi_control_barrier_all();
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < rounds; i++) {
+                    shmem_float_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dest, source, nelems, stream);
+                }
+                aclrtSynchronizeStream(stream);
+                double time_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+                                     .count() / rounds;
+                MPI_Allreduce(MPI_IN_PLACE, &time_us, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+                if (rank_id == 0) {
+                    std::cout << "Allreduce bandwidth test. QP number = " << qp_num << "; algo = " << algo_names[a]
+                              << "; Message length = " << length << " Byte; time = " << time_us
+                              << " us; bus bandwidth = " << 2.0 * (n_ranks - 1) / n_ranks * length / (time_us * 1000.0)
+                              << " GB/s." << std::endl;
+                }
+            }
+
+            // pipe_ring launched on one block, the only launch where a core rotates its units over several QPs
+            shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, SHMEMX_COLL_PIPE_RING);
+            uint64_t fftsConfig = shmemx_get_ffts_config();
+            rdma_allreduce_one_block_do(stream, fftsConfig, (uint8_t *)dest, (uint8_t *)source, nelems);
+            aclrtSynchronizeStream(stream);
+            shmemi_control_barrier_all();
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < rounds; i++) {
+                rdma_allreduce_one_block_do(stream, fftsConfig, (uint8_t *)dest, (uint8_t *)source, nelems);
+            }
+            aclrtSynchronizeStream(stream);
+            double time_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+                                 .count() / rounds;
+            MPI_Allreduce(MPI_IN_PLACE, &time_us, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            if (rank_id == 0) {
+                std::cout << "Allreduce bandwidth test. QP number = " << qp_num << "; algo = pipe_ring (1 block)"
+                          << "; Message length = " << length << " Byte; time = " << time_us
+                          << " us; bus bandwidth = " << 2.0 * (n_ranks - 1) / n_ranks * length / (time_us * 1000.0)
+                          << " GB/s." << std::endl;
+            }
+        }
+        shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, SHMEMX_COLL_AUTO);
+        shmem_free(dest);
+        shmem_free(source);
+        shmem_finalize();
+    }
+
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    return 0;
+}
+
+int test_shmem_p_rate(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    const int rounds = 10000;
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+
+    uint64_t fftsConfig = shmemx_get_ffts_config();
+    uint8_t* gva = (uint8_t*)shmem_malloc(1024);
+    int64_t cost[2] = {0, 0};
+
+    // Same shmem_int32_p loop, reading the device state from GM, then from the per-core snapshot
+    rdma_p_rate_do(1, stream, fftsConfig, gva, rounds);
+    aclrtSynchronizeStream(stream);
+    rdma_p_rate_cached_do(1, stream, fftsConfig, gva, rounds);
+    aclrtSynchronizeStream(stream);
+    shmemi_control_barrier_all();
+
+    if (rank_id == 0) {
+        aclrtMemcpy(cost, sizeof(cost), gva, sizeof(cost), ACL_MEMCPY_DEVICE_TO_HOST);
+        std::cout << "shmem_int32_p issue rate test. GM state: " << cost[0] / (CYCLES_PER_US * rounds)
+                  << " us per put, " << CYCLES_PER_US * rounds / cost[0] << " Mops." << std::endl;
+        std::cout << "shmem_int32_p issue rate test. Cached state: " << cost[1] / (CYCLES_PER_US * rounds)
+                  << " us per put, " << CYCLES_PER_US * rounds / cost[1] << " Mops." << std::endl;
+    }
+
+    shmem_free(gva);
+    shmem_finalize();
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    return 0;
+}
+
+int test_shmem_wait_vector(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    const int rounds = 100;
+    const int max_flags = 64;
+    const int mode_num = 4;
+    const size_t result_offset = max_flags * sizeof(int32_t) + 64;
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+
+    uint64_t fftsConfig = shmemx_get_ffts_config();
+    uint8_t* gva = (uint8_t*)shmem_malloc(1024);
+    int64_t cost = 0;
+
+    const char *mode_names[mode_num] = {"one by one", "wait_until_all", "wait_until_all + backoff", "wait_until_some"};
+
+    // Each round rank 1 raises every flag and rank 0 consumes them, the round trip is the wait latency and
+    // nflags / latency the rate at which signals are consumed.
+    for (int nflags = 8; nflags <= max_flags; nflags *= 2) {
+        for (int mode = 0; mode < mode_num; mode++) {
+            aclrtMemset(gva, 1024, 0, 1024);
+            shmemi_control_barrier_all();
+            rdma_wait_vector_do(8, stream, fftsConfig, gva, nflags, mode);
+            aclrtSynchronizeStream(stream);
+            if (rank_id == 0) {
+                aclrtMemcpy(&cost, sizeof(int64_t), gva + result_offset, sizeof(int64_t), ACL_MEMCPY_DEVICE_TO_HOST);
+                double latency = cost / (CYCLES_PER_US * rounds);
+                std::cout << "Vector wait test. Flags = " << nflags << "; mode = " << mode_names[mode]
+                          << "; latency = " << latency << " us; throughput = " << nflags / latency << " Msignals/s."
+                          << std::endl;
+            }
+            shmemi_control_barrier_all();
+        }
+    }
+
+    shmem_free(gva);
+    shmem_finalize();
+    aclrtDestroyStream(stream);
+    aclrtResetDevice(device_id);
+    aclFinalize();
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     if (argc != 7) {
@@ -233,19 +608,20 @@ int main(int argc, char *argv[])
     MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
     int rank_id;
     MPI_Comm_rank(MPI_COMM_WORLD, &rank_id);
-    if (n_ranks != 2) {
+    ipport = argv[1];
+    g_npus = atoi(argv[2]);
+    f_rank = atoi(argv[3]);
+    f_npu = atoi(argv[4]);
+    test_type = argv[5];
+    bool any_ranks = std::string(test_type) == "barrier_latency" || std::string(test_type) == "allreduce_bw";
+    if (n_ranks != 2 && !any_ranks) {
         std::cout << "[ERROR] Error number of ranks! Only support 2 ranks!" << std::endl;
         return -1;
     }
-    if (rank_id >= 2) {
+    if (rank_id >= 2 && !any_ranks) {
         std::cout << "[ERROR] Error rank ID! Only support 2 ranks!" << std::endl;
         return -1;
     }
-    ipport = argv[1];
-    g_npus = atoi(argv[2]);
-    f_rank = atoi(argv[3]);
-    f_npu = atoi(argv[4]);
-    test_type = argv[5];
     int msg_len = atoi(argv[6]);
     uint64_t local_mem_size = 1024UL * 1024UL * 64;
     if (std::string(test_type) == "highlevel_put_pingpong_latency") {
@@ -254,8 +630,20 @@ int main(int argc, char *argv[])
         test_shmem_rdma_postsend_cost(rank_id, n_ranks, local_mem_size, msg_len);
     } else if (std::string(test_type) == "highlevel_put_bw") {
         test_shmem_rdma_highlevel_put_bw(rank_id, n_ranks, local_mem_size, msg_len);
+    } else if (std::string(test_type) == "put_signal_latency") {
+        test_shmem_rdma_put_signal_pingpong_latency(rank_id, n_ranks, local_mem_size, msg_len);
+    } else if (std::string(test_type) == "multi_qp_bw") {
+        test_shmem_rdma_multi_qp_bw(rank_id, n_ranks, local_mem_size, msg_len);
     } else if (std::string(test_type) == "rdma_mte_bw") {
         test_shmem_rdma_mte_put_bw(rank_id, n_ranks, local_mem_size, msg_len);
+    } else if (std::string(test_type) == "barrier_latency") {
+        test_shmem_barrier_latency(rank_id, n_ranks, local_mem_size);
+    } else if (std::string(test_type) == "allreduce_bw") {
+        test_shmem_allreduce_bw(rank_id, n_ranks, local_mem_size, msg_len);
+    } else if (std::string(test_type) == "p_rate") {
+        test_shmem_p_rate(rank_id, n_ranks, local_mem_size);
+    } else if (std::string(test_type) == "wait_vector") {
+        test_shmem_wait_vector(rank_id, n_ranks, local_mem_size);
     }
 
     std::cout << "[SUCCESS] demo run success in rank " << rank_id << std::endl;
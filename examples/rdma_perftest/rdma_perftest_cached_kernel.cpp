@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+// RMA in this translation unit reads the per-core state snapshot taken by shmemx_state_cache_init
+#define SHMEM_DEVICE_STATE_CACHE
+#include "kernel_operator.h"
+#include "acl/acl.h"
+#include "shmem_api.h"
+
+extern "C" __global__ __aicore__ void rdma_p_rate_cached(uint64_t fftsConfig, GM_ADDR gva, int32_t rounds) {
+    shmemx_set_ffts_config(fftsConfig);
+    shmemx_state_cache_init();
+    if (AscendC::GetSubBlockIdx() != 0) {
+        return;
+    }
+    // rank 0 puts into rank 1 only, the two ranks never write the same target
+    if (shmem_my_pe() != 0) {
+        return;
+    }
+    __gm__ int32_t* dst = (__gm__ int32_t*)(gva + 64);
+
+    int64_t start = AscendC::GetSystemCycle();
+    for (int32_t i = 0; i < rounds; i++) {
+        shmem_int32_p(dst, i, 1);
+    }
+    int64_t cost = AscendC::GetSystemCycle() - start;
+
+    *(__gm__ int64_t*)(gva + sizeof(int64_t)) = cost;
+    dcci_cachelines(gva + sizeof(int64_t), sizeof(int64_t));
+}
+
+void rdma_p_rate_cached_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int32_t rounds) {
+    rdma_p_rate_cached<<<1, nullptr, stream>>>(fftsConfig, gva, rounds);
+}
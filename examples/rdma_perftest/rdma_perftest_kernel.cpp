@@ -13,6 +13,9 @@
 
 constexpr uint32_t MAGIC_VAL = 10;
 constexpr uint32_t WARMUP_MESSAGE_LENGTH = 32;
+constexpr uint32_t POSTSEND_COUNT = 500;
+constexpr int32_t SIGNAL_ROUNDS = 100;
+constexpr int32_t BARRIER_ROUNDS = 100;
 
 extern "C" __global__ __aicore__ void rdma_highlevel_put_pingpong_latency(uint64_t fftsConfig, GM_ADDR gva, int message_length) {
     shmemx_set_ffts_config(fftsConfig);
@@ -98,12 +101,22 @@ extern "C" __global__ __aicore__ void rdma_postsend_cost(uint64_t fftsConfig, GM
         peer = 1;
         GM_ADDR dest_addr = (GM_ADDR)(shmem_roce_ptr(src_addr, peer));
         int64_t start = AscendC::GetSystemCycle();
-        for (uint32_t i = 0; i < 500; i++) {
+        for (uint32_t i = 0; i < POSTSEND_COUNT; i++) {
             shmemi_roce_write(dest_addr, src_addr, peer, 0, message_length, ubLocal64, ubLocal32);
         }
         AscendC::PipeBarrier<PIPE_ALL>();
         int64_t end = AscendC::GetSystemCycle();
         *(__gm__ int64_t*)(gva + message_length * 2) = end - start;
+        shmemi_roce_quiet_core(peer, ubLocal64, ubLocal32);
+
+        // Same WQEs posted as lists, one doorbell every SHMEM_ROCE_MAX_POST_LIST WQEs
+        start = AscendC::GetSystemCycle();
+        shmemi_rdma_post_send_list(dest_addr, src_addr, peer, 0, SHMEMAIVOPCODE::OP_RDMA_WRITE,
+                                   (uint64_t)message_length * POSTSEND_COUNT, message_length, 0, ubLocal64, ubLocal32);
+        AscendC::PipeBarrier<PIPE_ALL>();
+        end = AscendC::GetSystemCycle();
+        *(__gm__ int64_t*)(gva + message_length * 2 + sizeof(int64_t)) = end - start;
+        shmemi_roce_quiet_core(peer, ubLocal64, ubLocal32);
     }
 }
 
@@ -134,7 +147,8 @@ extern "C" __global__ __aicore__ void rdma_highlevel_put_bw(uint64_t fftsConfig,
         for (int i = 0; i < 10000; i++) {
             shmem_put_uint8_mem_nbi(src_addr, src_addr, message_length, peer);
         }
-        shmemi_roce_quiet(peer, 0, ubLocal64, ubLocal32);
+        // large puts are striped over every QP, so all of them must drain before the flag is sent
+        shmemi_roce_quiet_core(peer, ubLocal64, ubLocal32);
         shmem_put_uint8_mem_nbi(gva + rank_size * message_length + 8, src_addr, sizeof(uint32_t), peer);
         while (*(__gm__ uint32_t*)(gva + message_length * rank_size + 16) != peer + MAGIC_VAL) {
             dcci_cachelines(gva + message_length * rank_size + 16, 8);
@@ -143,6 +157,10 @@ extern "C" __global__ __aicore__ void rdma_highlevel_put_bw(uint64_t fftsConfig,
         AscendC::PipeBarrier<PIPE_ALL>();
         int64_t end = AscendC::GetSystemCycle();
         *(__gm__ int64_t*)(gva + message_length * rank_size) = end - start;
+        // number of QPs the puts were actually striped over, less than qpNum when cores share QPs
+        uint32_t firstQp;
+        uint32_t qpStep;
+        *(__gm__ int64_t*)(gva + message_length * rank_size + 24) = shmemi_roce_core_qps(firstQp, qpStep);
     } else {
         peer = 0;
         while (*(__gm__ uint32_t*)(gva + rank_size * message_length + 8) != peer + MAGIC_VAL) {
@@ -158,6 +176,83 @@ void rdma_highlevel_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsCon
     rdma_highlevel_put_bw<<<1, nullptr, stream>>>(fftsConfig, gva, message_length);
 }
 
+// results of rdma_multi_core_put_bw behind the data, in int64 slots: core count, then per core ready flag, ack
+// flag, flag source, cycles and number of QPs the core striped over
+constexpr uint32_t MULTI_CORE_SLOTS = 64;
+constexpr uint32_t MULTI_CORE_RESULT_OFFSET = 64;
+
+// every AIV core of the launch puts its slice of the message, so that with qpNum no larger than the core count
+// each QP is driven by a core of its own instead of one core striping over all of them
+extern "C" __global__ __aicore__ void rdma_multi_core_put_bw(uint64_t fftsConfig, GM_ADDR gva, int message_length) {
+    shmemx_set_ffts_config(fftsConfig);
+    AscendC::TPipe pipe;
+    AscendC::TBuf<AscendC::TPosition::VECOUT> buf;
+    pipe.InitBuffer(buf, UB_ALIGN_SIZE * 2);
+    AscendC::LocalTensor<uint32_t> ubLocal32 = buf.GetWithOffset<uint32_t>(UB_ALIGN_SIZE / sizeof(uint32_t), 0);
+    AscendC::LocalTensor<uint64_t> ubLocal64 = buf.GetWithOffset<uint64_t>(UB_ALIGN_SIZE / sizeof(uint64_t), UB_ALIGN_SIZE);
+
+    int64_t rank = shmem_my_pe();
+    int64_t rank_size = shmem_n_pes();
+    uint32_t core_num = AscendC::GetBlockNum() * AscendC::GetTaskRation();
+    uint32_t core = AscendC::GetBlockIdx();
+    if (core >= MULTI_CORE_SLOTS) {
+        return;
+    }
+    __gm__ int64_t* result = (__gm__ int64_t*)(gva + message_length * rank_size + MULTI_CORE_RESULT_OFFSET);
+    __gm__ int64_t* ready = result + 1 + core;
+    __gm__ int64_t* ack = ready + MULTI_CORE_SLOTS;
+    __gm__ int64_t* flag_src = ack + MULTI_CORE_SLOTS;
+    __gm__ int64_t* cycles = flag_src + MULTI_CORE_SLOTS;
+    __gm__ int64_t* qps = cycles + MULTI_CORE_SLOTS;
+
+    uint64_t slice = ALIGH_TO((message_length + core_num - 1) / core_num, SHMEM_ROCE_STRIPE_ALIGN);
+    uint64_t offset = slice * core;
+    uint64_t len = offset < (uint64_t)message_length ? (message_length - offset < slice ? message_length - offset : slice) : 0;
+    GM_ADDR src_addr = gva + rank * message_length + offset;
+    *flag_src = 1;
+    dcci_cachelines((__gm__ uint8_t*)flag_src, sizeof(int64_t));
+
+    if (rank == 0) {
+        uint32_t peer = 1;
+        int64_t start = AscendC::GetSystemCycle();
+        for (int i = 0; i < 10000 && len > 0; i++) {
+            shmem_put_uint8_mem_nbi(src_addr, src_addr, len, peer);
+        }
+        shmemi_roce_quiet_core(peer, ubLocal64, ubLocal32);
+        shmem_put_int64_mem_nbi(ready, flag_src, 1, peer);
+        shmem_signal_wait_until((__gm__ int32_t*)ack, SHMEM_CMP_EQ, 1);
+        int64_t end = AscendC::GetSystemCycle();
+        uint32_t firstQp;
+        uint32_t qpStep;
+        *cycles = end - start;
+        *qps = shmemi_roce_core_qps(firstQp, qpStep);
+        dcci_cachelines((__gm__ uint8_t*)cycles, sizeof(int64_t));
+        dcci_cachelines((__gm__ uint8_t*)qps, sizeof(int64_t));
+        if (core == 0) {
+            *result = core_num;
+            dcci_cachelines((__gm__ uint8_t*)result, sizeof(int64_t));
+        }
+    } else {
+        uint32_t peer = 0;
+        shmem_signal_wait_until((__gm__ int32_t*)ready, SHMEM_CMP_EQ, 1);
+        shmem_put_int64_mem_nbi(ack, flag_src, 1, peer);
+    }
+}
+
+void rdma_multi_core_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length) {
+    rdma_multi_core_put_bw<<<block_dim, nullptr, stream>>>(fftsConfig, gva, message_length);
+}
+
+// float sum allreduce over SHMEM_TEAM_WORLD from a single block, whose cores own several QPs each
+extern "C" __global__ __aicore__ void rdma_allreduce_one_block(uint64_t fftsConfig, GM_ADDR dest, GM_ADDR source, uint64_t nelems) {
+    shmemx_set_ffts_config(fftsConfig);
+    shmem_float_sum_allreduce(SHMEM_TEAM_WORLD, (__gm__ float*)dest, (__gm__ float*)source, nelems);
+}
+
+void rdma_allreduce_one_block_do(void* stream, uint64_t fftsConfig, uint8_t* dest, uint8_t* source, uint64_t nelems) {
+    rdma_allreduce_one_block<<<1, nullptr, stream>>>(fftsConfig, dest, source, nelems);
+}
+
 extern "C" __global__ __aicore__ void rdma_mte_put_bw(uint64_t fftsConfig, GM_ADDR gva, int message_length, int64_t iter) {
     shmemx_set_ffts_config(fftsConfig);
     AscendC::LocalTensor<uint32_t> ubLocal32;
@@ -182,7 +277,7 @@ extern "C" __global__ __aicore__ void rdma_mte_put_bw(uint64_t fftsConfig, GM_AD
             for (int i = 0; i < 10000; i++) {
                 shmemi_roce_write((GM_ADDR)shmem_roce_ptr(src_addr, peer), src_addr, peer, 0, message_length, ubLocal64, ubLocal32);
             }
-            shmemi_roce_quiet(peer, 0, ubLocal64, ubLocal32);
+            shmemi_roce_quiet_core(peer, ubLocal64, ubLocal32);
             shmemi_roce_write((GM_ADDR)shmem_roce_ptr(gva + rank_size * message_length * 2 + 8, peer), src_addr, peer, 0, sizeof(int64_t), ubLocal64, ubLocal32);
             while (*(__gm__ int64_t*)(gva + message_length * rank_size * 2 + 16) != peer + MAGIC_VAL + iter) {
                 dcci_cachelines(gva + message_length * rank_size * 2 + 16, 8);
@@ -236,4 +331,187 @@ extern "C" __global__ __aicore__ void rdma_mte_put_bw(uint64_t fftsConfig, GM_AD
 
 void rdma_mte_put_bw_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length, int64_t iter) {
     rdma_mte_put_bw<<<2, nullptr, stream>>>(fftsConfig, gva, message_length, iter);
-}
\ No newline at end of file
+}
+extern "C" __global__ __aicore__ void rdma_put_signal_pingpong_latency(uint64_t fftsConfig, GM_ADDR gva, int message_length) {
+    shmemx_set_ffts_config(fftsConfig);
+    if (AscendC::GetSubBlockIdx() != 0) {
+        return;
+    }
+    AscendC::TPipe pipe;
+    AscendC::TBuf<AscendC::TPosition::VECOUT> buf;
+    pipe.InitBuffer(buf, UB_ALIGN_SIZE * 2);
+    AscendC::LocalTensor<uint32_t> ubLocal32 = buf.GetWithOffset<uint32_t>(UB_ALIGN_SIZE / sizeof(uint32_t), 0);
+    AscendC::LocalTensor<uint64_t> ubLocal64 = buf.GetWithOffset<uint64_t>(UB_ALIGN_SIZE / sizeof(uint64_t), UB_ALIGN_SIZE);
+
+    int64_t rank = shmem_my_pe();
+    int64_t rank_size = shmem_n_pes();
+    uint32_t peer = (rank == 0) ? 1 : 0;
+    GM_ADDR data_addr = gva + rank * message_length;
+    GM_ADDR result_addr = gva + rank_size * message_length;
+    __gm__ int32_t* sig_addr = (__gm__ int32_t*)(result_addr + 64);
+    __gm__ int32_t* flag_addr = (__gm__ int32_t*)(result_addr + 128);
+    __gm__ int32_t* flag_src = (__gm__ int32_t*)(result_addr + 192);
+
+    // Payload and signal posted as one WQE chain
+    int64_t start = AscendC::GetSystemCycle();
+    for (int32_t i = 1; i <= SIGNAL_ROUNDS; i++) {
+        if (rank == 0) {
+            shmem_putmem_signal_nbi(data_addr, data_addr, message_length, sig_addr, i, SHMEM_SIGNAL_SET, peer);
+            shmem_signal_wait_until(sig_addr, SHMEM_CMP_EQ, i);
+        } else {
+            shmem_signal_wait_until(sig_addr, SHMEM_CMP_EQ, i);
+            shmem_putmem_signal_nbi(data_addr, data_addr, message_length, sig_addr, i, SHMEM_SIGNAL_SET, peer);
+        }
+    }
+    int64_t fused = AscendC::GetSystemCycle() - start;
+
+    // Payload, quiet, then a separate flag write
+    start = AscendC::GetSystemCycle();
+    for (int32_t i = 1; i <= SIGNAL_ROUNDS; i++) {
+        if (rank != 0) {
+            shmem_signal_wait_until(flag_addr, SHMEM_CMP_EQ, i);
+        }
+        shmem_put_uint8_mem_nbi(data_addr, data_addr, message_length, peer);
+        shmemi_roce_quiet_core(peer, ubLocal64, ubLocal32);
+        *flag_src = i;
+        dcci_cachelines((__gm__ uint8_t*)flag_src, sizeof(int32_t));
+        shmem_put_int32_mem_nbi(flag_addr, flag_src, 1, peer);
+        if (rank == 0) {
+            shmem_signal_wait_until(flag_addr, SHMEM_CMP_EQ, i);
+        }
+    }
+    int64_t separate = AscendC::GetSystemCycle() - start;
+
+    if (rank == 0) {
+        *(__gm__ int64_t*)(result_addr) = fused;
+        *(__gm__ int64_t*)(result_addr + 8) = separate;
+        dcci_cachelines(result_addr, sizeof(int64_t) * 2);
+    }
+}
+
+void rdma_put_signal_pingpong_latency_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int message_length) {
+    rdma_put_signal_pingpong_latency<<<1, nullptr, stream>>>(fftsConfig, gva, message_length);
+}
+
+extern "C" __global__ __aicore__ void rdma_barrier_latency(uint64_t fftsConfig, GM_ADDR gva, shmem_team_t team) {
+    shmemx_set_ffts_config(fftsConfig);
+
+#ifdef __DAV_C220_VEC__
+    // warm up
+    shmemx_barrier_vec(team);
+
+    int64_t start = AscendC::GetSystemCycle();
+    for (int32_t i = 0; i < BARRIER_ROUNDS; i++) {
+        shmemx_barrier_vec(team);
+    }
+    int64_t cost = AscendC::GetSystemCycle() - start;
+
+    if (AscendC::GetBlockIdx() == 0) {
+        *(__gm__ int64_t*)(gva) = cost;
+        dcci_cachelines(gva, sizeof(int64_t));
+    }
+#endif
+}
+
+void rdma_barrier_latency_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, shmem_team_t team) {
+    rdma_barrier_latency<<<block_dim, nullptr, stream>>>(fftsConfig, gva, team);
+}
+
+extern "C" __global__ __aicore__ void rdma_p_rate(uint64_t fftsConfig, GM_ADDR gva, int32_t rounds) {
+    shmemx_set_ffts_config(fftsConfig);
+    if (AscendC::GetSubBlockIdx() != 0) {
+        return;
+    }
+    // rank 0 puts into rank 1 only, the two ranks never write the same target
+    if (shmem_my_pe() != 0) {
+        return;
+    }
+    __gm__ int32_t* dst = (__gm__ int32_t*)(gva + 64);
+
+    // Every shmem_int32_p loads the heap bases and the MTE config from the device state in GM
+    int64_t start = AscendC::GetSystemCycle();
+    for (int32_t i = 0; i < rounds; i++) {
+        shmem_int32_p(dst, i, 1);
+    }
+    int64_t cost = AscendC::GetSystemCycle() - start;
+
+    *(__gm__ int64_t*)(gva) = cost;
+    dcci_cachelines(gva, sizeof(int64_t));
+}
+
+void rdma_p_rate_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int32_t rounds) {
+    rdma_p_rate<<<1, nullptr, stream>>>(fftsConfig, gva, rounds);
+}
+
+constexpr int32_t WAIT_ROUNDS = 100;
+constexpr int32_t WAIT_MAX_FLAGS = 64;
+constexpr int32_t WAIT_FLAGS_PER_LINE = SCALAR_DATA_CACHELINE_SIZE / sizeof(int32_t);
+constexpr uint32_t WAIT_BACKOFF_MAX = 1024;
+
+// Rank 1 cores produce nflags packed flags for rank 0, one writer per cache line. Rank 0 waits for every round with
+// the wait mode, then releases the next round through an ack flag on rank 1.
+// mode 0: one flag at a time, 1: wait_until_all, 2: wait_until_all with backoff, 3: wait_until_some
+extern "C" __global__ __aicore__ void rdma_wait_vector(uint64_t fftsConfig, GM_ADDR gva, int32_t nflags, int32_t mode) {
+    shmemx_set_ffts_config(fftsConfig);
+    if (AscendC::GetSubBlockIdx() != 0) {
+        return;
+    }
+    int64_t rank = shmem_my_pe();
+    int32_t core = AscendC::GetBlockIdx();
+    int32_t core_num = AscendC::GetBlockNum();
+    __gm__ int32_t* flags = (__gm__ int32_t*)gva;
+    __gm__ int32_t* ack = (__gm__ int32_t*)(gva + WAIT_MAX_FLAGS * sizeof(int32_t));
+    GM_ADDR result_addr = gva + WAIT_MAX_FLAGS * sizeof(int32_t) + SCALAR_DATA_CACHELINE_SIZE;
+    int32_t lines = (nflags + WAIT_FLAGS_PER_LINE - 1) / WAIT_FLAGS_PER_LINE;
+
+    if (rank == 1) {
+        for (int32_t r = 1; r <= WAIT_ROUNDS; r++) {
+            shmemi_signal_wait_until_ge(ack, r - 1);
+            for (int32_t l = core; l < lines; l += core_num) {
+                for (int32_t f = l * WAIT_FLAGS_PER_LINE; f < nflags && f < (l + 1) * WAIT_FLAGS_PER_LINE; f++) {
+                    shmem_int32_p(flags + f, r, 0);
+                }
+            }
+        }
+        return;
+    }
+    if (core != 0) {
+        return;
+    }
+
+    int status[WAIT_MAX_FLAGS];
+    size_t indices[WAIT_MAX_FLAGS];
+    int64_t start = AscendC::GetSystemCycle();
+    for (int32_t r = 1; r <= WAIT_ROUNDS; r++) {
+        if (mode == 0) {
+            for (int32_t f = 0; f < nflags; f++) {
+                shmemi_wait_until(flags + f, SHMEM_CMP_EQ, r);
+            }
+        } else if (mode == 1) {
+            shmemi_wait_until_all(flags, nflags, nullptr, SHMEM_CMP_EQ, r, 1);
+        } else if (mode == 2) {
+            shmemi_wait_until_all(flags, nflags, nullptr, SHMEM_CMP_EQ, r, 1, WAIT_BACKOFF_MAX);
+        } else {
+            for (int32_t f = 0; f < nflags; f++) {
+                status[f] = 0;
+            }
+            int32_t consumed = 0;
+            while (consumed < nflags) {
+                size_t num = shmemi_wait_until_some(flags, nflags, indices, status, SHMEM_CMP_EQ, r);
+                for (size_t i = 0; i < num; i++) {
+                    status[indices[i]] = 1;
+                }
+                consumed += num;
+            }
+        }
+        shmem_int32_p(ack, r, 1);
+    }
+    int64_t cost = AscendC::GetSystemCycle() - start;
+
+    *(__gm__ int64_t*)(result_addr) = cost;
+    dcci_cachelines(result_addr, sizeof(int64_t));
+}
+
+void rdma_wait_vector_do(uint32_t block_dim, void* stream, uint64_t fftsConfig, uint8_t* gva, int32_t nflags, int32_t mode) {
+    rdma_wait_vector<<<block_dim, nullptr, stream>>>(fftsConfig, gva, nflags, mode);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+#include <mpi.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+
+int g_npus = 8;
+const char *ipport = "tcp://127.0.0.1:8998";
+int f_rank = 0;
+int f_npu = 0;
+uint32_t queue_block_dim = 4;
+
+constexpr int PERF_TIMES = 50;
+constexpr int CASE_NUM = 12;
+
+extern void work_submit_put_demo(void *stream, uint8_t *dest, uint8_t *source, uint64_t nbytes, int iters);
+
+// average time of one operation in us, the PEs start together and run PERF_TIMES operations back to back
+static double time_ops(const std::function<void()> &begin, const std::function<void()> &op,
+                       const std::function<void()> &end)
+{
+    begin();
+    op();
+    end();
+    shmem_barrier_all();
+    auto start = std::chrono::steady_clock::now();
+    begin();
+    for (int i = 0; i < PERF_TIMES; i++) {
+        op();
+    }
+    end();
+    auto stop = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(stop - start).count() / PERF_TIMES;
+    MPI_Allreduce(MPI_IN_PLACE, &us, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return us;
+}
+
+static double time_launches(aclrtStream stream, const std::function<void()> &launch)
+{
+    return time_ops([]() {}, launch, [&]() { aclrtSynchronizeStream(stream); });
+}
+
+// submits desc PERF_TIMES times from the host and waits for the last one
+static double time_queue(const shmemx_work_desc_t &desc)
+{
+    uint64_t ticket = 0;
+    return time_ops([]() {}, [&]() { shmemx_work_submit(&desc, &ticket); }, [&]() { shmemx_work_wait(ticket); });
+}
+
+int test_work_queue_perf(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % g_npus + f_npu;
+    int status = 0;
+    aclrtStream stream = nullptr;
+
+    status = aclInit(nullptr);
+    status = aclrtSetDevice(device_id);
+    status = aclrtCreateStream(&stream);
+
+    shmem_init_attr_t *attributes;
+    status = shmem_set_attr(rank_id, n_ranks, local_mem_size, ipport, &attributes);
+    status = shmem_init_attr(SHMEMX_INIT_WITH_MPI, attributes);
+
+    size_t max_bytes = 32UL << (CASE_NUM - 1);
+    int *source = (int *)shmem_malloc(max_bytes);
+    int *dest = (int *)shmem_malloc(max_bytes);
+    aclrtMemset(source, max_bytes, 0, max_bytes);
+    int peer = (rank_id + 1) % n_ranks;
+
+    // one kernel per operation, done before the queue starts as collectives must not run aside from it
+    std::vector<double> launch_put(CASE_NUM);
+    std::vector<double> launch_ar(CASE_NUM);
+    for (int i = 0; i < CASE_NUM; i++) {
+        size_t bytes = 32UL << i;
+        launch_put[i] = time_launches(stream, [&]() { shmem_putmem(dest, source, bytes, peer); });
+        launch_ar[i] = time_launches(stream, [&]() {
+            shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dest, source, bytes / sizeof(int), stream);
+        });
+    }
+
+    // host producer
+    std::vector<double> queue_put(CASE_NUM);
+    std::vector<double> queue_ar(CASE_NUM);
+    status = shmemx_work_queue_start(0, queue_block_dim, 0);
+    for (int i = 0; i < CASE_NUM; i++) {
+        shmemx_work_desc_t desc = {};
+        desc.op = SHMEMX_WORK_PUT;
+        desc.pe = peer;
+        desc.dest = (uint64_t)dest;
+        desc.source = (uint64_t)source;
+        desc.size = 32UL << i;
+        queue_put[i] = time_queue(desc);
+
+        desc.op = SHMEMX_WORK_ALLREDUCE;
+        desc.team = SHMEM_TEAM_WORLD;
+        desc.dtype = SHMEMX_WORK_INT32;
+        desc.reduce_op = SHMEMI_REDUCE_SUM;
+        desc.size = (32UL << i) / sizeof(int);
+        queue_ar[i] = time_queue(desc);
+    }
+    status = shmemx_work_queue_stop();
+
+    // device producer, one kernel submitting PERF_TIMES puts
+    std::vector<double> device_put(CASE_NUM);
+    status = shmemx_work_queue_start(0, queue_block_dim, SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS);
+    for (int i = 0; i < CASE_NUM; i++) {
+        size_t bytes = 32UL << i;
+        double us = time_launches(stream, [&]() {
+            work_submit_put_demo(stream, (uint8_t *)dest, (uint8_t *)source, bytes, PERF_TIMES);
+        });
+        device_put[i] = us / PERF_TIMES;
+    }
+    status = shmemx_work_queue_stop();
+
+    if (rank_id == 0) {
+        std::cout << std::setw(12) << "bytes" << std::setw(16) << "launch_put(us)" << std::setw(16)
+                  << "queue_put(us)" << std::setw(16) << "device_put(us)" << std::setw(16) << "launch_ar(us)"
+                  << std::setw(16) << "queue_ar(us)" << std::endl;
+        for (int i = 0; i < CASE_NUM; i++) {
+            std::cout << std::setw(12) << (32UL << i) << std::fixed << std::setprecision(2) << std::setw(16)
+                      << launch_put[i] << std::setw(16) << queue_put[i] << std::setw(16) << device_put[i]
+                      << std::setw(16) << launch_ar[i] << std::setw(16) << queue_ar[i] << std::endl;
+        }
+    }
+
+    shmem_free(dest);
+    shmem_free(source);
+    status = shmem_finalize();
+    status = aclrtDestroyStream(stream);
+    status = aclrtResetDevice(device_id);
+    status = aclFinalize();
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    int status = 0;
+    MPI_Init(&argc, &argv);
+    int rank_id, n_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_id);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
+    if (argc > 4) {
+        ipport = argv[1];
+        g_npus = atoi(argv[2]);
+        f_rank = atoi(argv[3]);
+        f_npu = atoi(argv[4]);
+    }
+    if (argc > 5) {
+        queue_block_dim = (uint32_t)atoi(argv[5]);
+    }
+
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    status = test_work_queue_perf(rank_id, n_ranks, local_mem_size);
+    if (status) {
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::cout << "[SUCCESS] demo run success in rank " << rank_id << std::endl;
+
+    MPI_Finalize();
+    return 0;
+}
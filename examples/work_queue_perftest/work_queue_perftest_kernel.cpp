@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+#include "shmem_api.h"
+
+// submits iters puts of nbytes to the right neighbour from one core, each waited for before the next is submitted
+extern "C" SHMEM_GLOBAL void work_submit_put(GM_ADDR dest, GM_ADDR source, uint64_t nbytes, int iters)
+{
+    if (AscendC::GetBlockIdx() != 0) {
+        return;
+    }
+    shmemx_work_desc_t desc = {};
+    desc.op = SHMEMX_WORK_PUT;
+    desc.pe = (shmem_my_pe() + 1) % shmem_n_pes();
+    desc.dest = (uint64_t)dest;
+    desc.source = (uint64_t)source;
+    desc.size = nbytes;
+    for (int i = 0; i < iters; i++) {
+        shmemx_work_wait(shmemx_work_submit(desc));
+    }
+}
+
+void work_submit_put_demo(void *stream, uint8_t *dest, uint8_t *source, uint64_t nbytes, int iters)
+{
+    work_submit_put<<<1, nullptr, stream>>>(dest, source, nbytes, iters);
+}
@@ -28,7 +28,7 @@ constexpr uint32_t UB_ALIGN_SIZE = 32;
 SHMEM_DEVICE __gm__ void *shmem_ptr(__gm__ void *ptr, int pe)
 {
     // Get Global State
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
 
     // Back to root address
     uint64_t offset = reinterpret_cast<uint64_t>(ptr) - reinterpret_cast<uint64_t>(device_state->heap_base);
@@ -203,7 +203,7 @@ SHMEM_DEVICE void shmemi_copy_gm2ub(const AscendC::LocalTensor<T> &dstUb,
 SHMEM_DEVICE __gm__ void *shmem_roce_ptr(__gm__ void *ptr, int pe)
 {
     // Get Global State
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
 
     // Back to root address
     uint64_t offset = reinterpret_cast<uint64_t>(ptr) - reinterpret_cast<uint64_t>(device_state->heap_base);
@@ -278,7 +278,7 @@ SHMEM_DEVICE void shmem_roce_get_mem_nbi(__gm__ T* dst, __gm__ T* src, __ubuf__
     ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(buf) + UB_ALIGN_SIZE;
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_read((__gm__ uint8_t*)dst, (__gm__ uint8_t*)ptr, pe, 0, elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
+    shmemi_roce_read_striped((__gm__ uint8_t*)dst, (__gm__ uint8_t*)ptr, pe, elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
 }
 
 
@@ -392,7 +392,7 @@ SHMEM_DEVICE void shmem_roce_get_mem_nbi(AscendC::GlobalTensor<T> dst, AscendC::
     ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(buf.GetPhyAddr()) + UB_ALIGN_SIZE;
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_read((__gm__ uint8_t*)dst.GetPhyAddr(), (__gm__ uint8_t*)ptr, pe, 0, elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
+    shmemi_roce_read_striped((__gm__ uint8_t*)dst.GetPhyAddr(), (__gm__ uint8_t*)ptr, pe, elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
 }
 
 /**
@@ -496,7 +496,7 @@ SHMEM_DEVICE void shmem_roce_put_mem_nbi(__gm__ T* dst, __gm__ T* src, __ubuf__
     ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(buf) + UB_ALIGN_SIZE;
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_write((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)src, pe, 0, elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
+    shmemi_roce_write_striped((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)src, pe, elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
 }
 
 /**
@@ -609,7 +609,7 @@ SHMEM_DEVICE void shmem_roce_put_mem_nbi(AscendC::GlobalTensor<T> dst, AscendC::
     ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
     ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(buf.GetPhyAddr()) + UB_ALIGN_SIZE;
     ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
-    shmemi_roce_write((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)(src.GetPhyAddr()), pe, 0, elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
+    shmemi_roce_write_striped((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)(src.GetPhyAddr()), pe, elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
 }
 
 /**
@@ -900,4 +900,4 @@ SHMEM_DEVICE void shmem_mte_put_mem_nbi(AscendC::GlobalTensor<T> dst, AscendC::L
     shmemi_copy_ub2gm(remote_buff, src, data_copy_params_ub2gm);
 }
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
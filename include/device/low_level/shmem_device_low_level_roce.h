@@ -14,6 +14,12 @@
 #include "internal/device/shmemi_device_common.h"
 
 constexpr uint32_t SHMEM_NUM_CQE_PER_POLL_CQ = 100;
+constexpr uint32_t SHMEM_NUM_WQE_RESERVED = 10;                  // SQ slots always kept free
+constexpr uint32_t SHMEM_ROCE_MAX_POST_LIST = 32;                // max WQEs posted with one doorbell
+constexpr uint64_t SHMEM_ROCE_SEGMENT_SIZE = 1024UL * 1024UL;    // transfers larger than this are split
+constexpr uint64_t SHMEM_ROCE_STRIPE_MIN_SIZE = 64UL * 1024UL;   // smaller transfers stay on one QP
+constexpr uint64_t SHMEM_ROCE_STRIPE_ALIGN = 4096;               // stripe boundary across QPs
+constexpr uint32_t SHMEM_ROCE_WQE_STRONG_ORDER = 1 << 10;        // WQE byte4 [10] SO, wait for preceding WQEs
 
 enum class SHMEMAIVOPCODE : uint32_t {
     OP_SEND = 0,
@@ -21,7 +27,9 @@ enum class SHMEMAIVOPCODE : uint32_t {
     OP_SEND_WITH_IMM,
     OP_RDMA_WRITE,
     OP_RDMA_WRITE_WITH_IMM,
-    OP_RDMA_READ
+    OP_RDMA_READ,
+    OP_ATOMIC_CMP_AND_SWAP,
+    OP_ATOMIC_FETCH_AND_ADD
 };
 
 struct SHMEMAIVRDMAInfo {
@@ -81,6 +89,11 @@ struct SHMEMsegCtx {
     uint64_t addr;
 };
 
+struct SHMEMatomicCtx {
+    uint64_t swapAddData; // swap value for CAS, addend for FAA
+    uint64_t cmpData; // compare value for CAS, unused for FAA
+};
+
 struct SHMEMcqeCtx {
     uint32_t byte4;
     uint32_t immtdata;
@@ -193,48 +206,64 @@ SHMEM_DEVICE uint32_t shmemi_roce_poll_cq(uint32_t remoteRankId, uint32_t qpIdx,
 }
 
 /**
- * @brief AIV direct RDMA helper function for post send, prepare WQE and ring doorbell.
+ * @brief Reserve WQE slots on the send queue, polling CQ first if the queue is about to be full.
  *
- * @param remoteAddr             [in] address in remote HBM
- * @param localAddr              [in] address in lcoal HBM
  * @param destRankId             [in] destination rank ID
  * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
- * @param opcode                 [in] rdma opcode in SHMEMAIVOPCODE enum class
- * @param messageLen             [in] message length in Bytes
  * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
  * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @param count                  [in] number of consecutive WQEs to reserve, no more than SHMEM_ROCE_MAX_POST_LIST
+ * @return Current SQ head (Producer Index), i.e. index of the first reserved WQE.
  */
 
-SHMEM_DEVICE void shmemi_rdma_post_send(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
-                                                    uint32_t destRankId, uint32_t qpIdx,
-                                                    SHMEMAIVOPCODE opcode, uint64_t messageLen,
-                                                    AscendC::LocalTensor<uint64_t> ubLocal64,
-                                                    AscendC::LocalTensor<uint32_t> ubLocal32)
+SHMEM_DEVICE uint32_t shmemi_rdma_sq_reserve(uint32_t destRankId, uint32_t qpIdx,
+                                             AscendC::LocalTensor<uint64_t> ubLocal64,
+                                             AscendC::LocalTensor<uint32_t> ubLocal32, uint32_t count = 1)
 {
     __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
     __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(device_state->qp_info);
     uint32_t qpNum = RDMAInfo->qpNum;
     __gm__ SHMEMWQCtx* qpCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr + (destRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
-    auto SHMEMmemInfoTable = RDMAInfo->memPtr;
-    auto sqBaseAddr = qpCtxEntry->bufAddr;
-    auto wqeSize = qpCtxEntry->wqeSize;
     auto curHardwareHeadAddr = qpCtxEntry->headAddr;
     dcci_cachelines((__gm__ uint8_t*)curHardwareHeadAddr, 8);
     uint32_t curHead = *(__gm__ uint32_t*)(curHardwareHeadAddr);
     auto curHardwareTailAddr = qpCtxEntry->tailAddr;
     auto depth = qpCtxEntry->depth;
-    auto shift = 13;
     AscendC::PipeBarrier<PIPE_ALL>();
 
-    // Poll CQ if send queue is full
+    // Poll CQ if send queue can not hold count more WQEs, head and tail are free running counters
     dcci_cachelines((__gm__ uint8_t*)curHardwareTailAddr, 8);
-    if ((curHead + 10) % depth == (*(__gm__ uint32_t*)(curHardwareTailAddr)) % depth) {
-        shmemi_roce_poll_cq(destRankId, qpIdx, *(__gm__ uint32_t*)(curHardwareTailAddr) +
-            SHMEM_NUM_CQE_PER_POLL_CQ, ubLocal64, ubLocal32);
+    uint32_t curTail = *(__gm__ uint32_t*)(curHardwareTailAddr);
+    uint32_t used = curHead - curTail;
+    if (used + count + SHMEM_NUM_WQE_RESERVED > depth) {
+        uint32_t advance = used + count + SHMEM_NUM_WQE_RESERVED - depth;
+        advance = advance > SHMEM_NUM_CQE_PER_POLL_CQ ? advance : SHMEM_NUM_CQE_PER_POLL_CQ;
+        advance = advance > used ? used : advance;
+        shmemi_roce_poll_cq(destRankId, qpIdx, curTail + advance, ubLocal64, ubLocal32);
     }
+    return curHead;
+}
 
-    // Write WQE to HBM
-    __gm__ uint8_t* wqeAddr = (__gm__ uint8_t*)(sqBaseAddr + wqeSize * (curHead % depth));
+/**
+ * @brief Fill the control segment of the WQE at index curHead, return the WQE address.
+ *
+ * @param qpCtxEntry             [in] send queue context
+ * @param curHead                [in] index of the WQE to fill
+ * @param remoteAddr             [in] address in remote HBM
+ * @param destRankId             [in] destination rank ID
+ * @param opcode                 [in] rdma opcode in SHMEMAIVOPCODE enum class
+ * @param messageLen             [in] message length in Bytes
+ */
+
+SHMEM_DEVICE __gm__ uint8_t* shmemi_rdma_fill_wqe(__gm__ SHMEMWQCtx* qpCtxEntry, uint32_t curHead,
+                                                  __gm__ uint8_t* remoteAddr, uint32_t destRankId,
+                                                  SHMEMAIVOPCODE opcode, uint64_t messageLen)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(device_state->qp_info);
+    auto SHMEMmemInfoTable = RDMAInfo->memPtr;
+    auto shift = 13;
+    __gm__ uint8_t* wqeAddr = (__gm__ uint8_t*)(qpCtxEntry->bufAddr + qpCtxEntry->wqeSize * (curHead % qpCtxEntry->depth));
     uint64_t ownBit = (curHead >> shift) & 0x1;
     uint32_t byte4 = (uint32_t)opcode & 0x1F;       // [0:4] opcode
     byte4 |= ((~ownBit) << 7) & (1 << 7); // [7] owner_bit
@@ -247,19 +276,41 @@ SHMEM_DEVICE void shmemi_rdma_post_send(__gm__ uint8_t* remoteAddr, __gm__ uint8
     __gm__ SHMEMmemInfo* remoteMemInfo = (__gm__ SHMEMmemInfo*)(SHMEMmemInfoTable + sizeof(SHMEMmemInfo) * destRankId);
     *(__gm__ uint32_t*)(wqeAddr + 20) = remoteMemInfo->rkey; // rkey
     *(__gm__ uint64_t*)(wqeAddr + 24) = (uint64_t)remoteAddr; // remote VA
+    return wqeAddr;
+}
 
-    // Write SGE to HBM
-    __gm__ uint8_t* sgeAddr = wqeAddr + sizeof(SHMEMwqeCtx);
+/**
+ * @brief Fill the SGE following the WQE control segment.
+ *
+ * @param sgeAddr                [in] address of the SGE in HBM
+ * @param localAddr              [in] address in lcoal HBM
+ * @param messageLen             [in] message length in Bytes
+ */
+
+SHMEM_DEVICE void shmemi_rdma_fill_sge(__gm__ uint8_t* sgeAddr, __gm__ uint8_t* localAddr, uint64_t messageLen)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(device_state->qp_info);
+    auto SHMEMmemInfoTable = RDMAInfo->memPtr;
     *(__gm__ uint32_t*)(sgeAddr) = messageLen; // message size in bytes
     __gm__ SHMEMmemInfo* localMemInfo = (__gm__ SHMEMmemInfo*)(SHMEMmemInfoTable + sizeof(SHMEMmemInfo) * shmemi_get_my_pe());
     *(__gm__ uint32_t*)(sgeAddr + 4) = localMemInfo->lkey; // lkey
     *(__gm__ uint64_t*)(sgeAddr + 8) = (uint64_t)localAddr; // local VA
+}
 
-    // WQE & SGE cache flush
-    dcci_cachelines(wqeAddr, sizeof(SHMEMwqeCtx) + sizeof(SHMEMsegCtx));
-    AscendC::PipeBarrier<PIPE_ALL>();
-    curHead++;
+/**
+ * @brief Ring the SQ doorbell with the new Producer Index and publish it to the head address.
+ *
+ * @param qpCtxEntry             [in] send queue context
+ * @param curHead                [in] new SQ head (Producer Index) after posting
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
 
+SHMEM_DEVICE void shmemi_rdma_ring_sq_doorbell(__gm__ SHMEMWQCtx* qpCtxEntry, uint32_t curHead,
+                                               AscendC::LocalTensor<uint64_t> ubLocal64,
+                                               AscendC::LocalTensor<uint32_t> ubLocal32)
+{
     uint64_t doorBellInfo = 0;
     doorBellInfo |= qpCtxEntry->wqn; // [0:23] DB_TAG = qp_num
     doorBellInfo |= 0 << 24; // [24:27] DB_CMD = HNS_ROCE_V2_SQ_DB(0)
@@ -279,7 +330,7 @@ SHMEM_DEVICE void shmemi_rdma_post_send(__gm__ uint8_t* remoteAddr, __gm__ uint8
 
     ubLocal32.SetValue(0, (uint32_t)curHead);
     AscendC::GlobalTensor<uint32_t> HeadGlobalTensor;
-    HeadGlobalTensor.SetGlobalBuffer((__gm__ uint32_t*)curHardwareHeadAddr);
+    HeadGlobalTensor.SetGlobalBuffer((__gm__ uint32_t*)qpCtxEntry->headAddr);
     AscendC::DataCopyExtParams copyParamsHead{1, 1 * sizeof(uint32_t), 0, 0, 0};
     AscendC::PipeBarrier<PIPE_ALL>();
     AscendC::DataCopyPad(HeadGlobalTensor, ubLocal32, copyParamsHead);
@@ -287,7 +338,208 @@ SHMEM_DEVICE void shmemi_rdma_post_send(__gm__ uint8_t* remoteAddr, __gm__ uint8
 }
 
 /**
- * @brief Asynchronous RDMA Write function.
+ * @brief AIV direct RDMA helper function for post send, prepare WQE and ring doorbell.
+ *
+ * @param remoteAddr             [in] address in remote HBM
+ * @param localAddr              [in] address in lcoal HBM
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param opcode                 [in] rdma opcode in SHMEMAIVOPCODE enum class
+ * @param messageLen             [in] message length in Bytes
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+
+SHMEM_DEVICE void shmemi_rdma_post_send(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
+                                                    uint32_t destRankId, uint32_t qpIdx,
+                                                    SHMEMAIVOPCODE opcode, uint64_t messageLen,
+                                                    AscendC::LocalTensor<uint64_t> ubLocal64,
+                                                    AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(device_state->qp_info);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    __gm__ SHMEMWQCtx* qpCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr + (destRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
+    uint32_t curHead = shmemi_rdma_sq_reserve(destRankId, qpIdx, ubLocal64, ubLocal32);
+
+    // Write WQE & SGE to HBM
+    __gm__ uint8_t* wqeAddr = shmemi_rdma_fill_wqe(qpCtxEntry, curHead, remoteAddr, destRankId, opcode, messageLen);
+    shmemi_rdma_fill_sge(wqeAddr + sizeof(SHMEMwqeCtx), localAddr, messageLen);
+
+    // WQE & SGE cache flush
+    dcci_cachelines(wqeAddr, sizeof(SHMEMwqeCtx) + sizeof(SHMEMsegCtx));
+    AscendC::PipeBarrier<PIPE_ALL>();
+    curHead++;
+
+    shmemi_rdma_ring_sq_doorbell(qpCtxEntry, curHead, ubLocal64, ubLocal32);
+}
+
+/**
+ * @brief AIV direct RDMA helper function for post list. Split a message into segments and post them as
+ *        consecutive WQEs, with one cache flush and one doorbell per SHMEM_ROCE_MAX_POST_LIST WQEs.
+ *
+ * @param remoteAddr             [in] address in remote HBM
+ * @param localAddr              [in] address in lcoal HBM
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param opcode                 [in] rdma opcode in SHMEMAIVOPCODE enum class
+ * @param messageLen             [in] total message length in Bytes
+ * @param segmentLen             [in] message length of each WQE in Bytes, the last one takes the remainder
+ * @param addrStride             [in] address advance between consecutive WQEs, segmentLen for a split transfer
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+
+SHMEM_DEVICE void shmemi_rdma_post_send_list(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
+                                             uint32_t destRankId, uint32_t qpIdx, SHMEMAIVOPCODE opcode,
+                                             uint64_t messageLen, uint64_t segmentLen, uint64_t addrStride,
+                                             AscendC::LocalTensor<uint64_t> ubLocal64,
+                                             AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(device_state->qp_info);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    __gm__ SHMEMWQCtx* qpCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr + (destRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
+    uint32_t depth = qpCtxEntry->depth;
+    uint32_t wqeSize = qpCtxEntry->wqeSize;
+
+    uint64_t offset = 0;
+    uint64_t addrOffset = 0;
+    while (offset < messageLen) {
+        uint64_t remainSegments = (messageLen - offset + segmentLen - 1) / segmentLen;
+        uint32_t count = remainSegments > SHMEM_ROCE_MAX_POST_LIST ? SHMEM_ROCE_MAX_POST_LIST : remainSegments;
+        uint32_t curHead = shmemi_rdma_sq_reserve(destRankId, qpIdx, ubLocal64, ubLocal32, count);
+        uint32_t firstIdx = curHead % depth;
+
+        // Write all WQEs & SGEs of the batch to HBM
+        for (uint32_t i = 0; i < count; i++) {
+            uint64_t len = (messageLen - offset) > segmentLen ? segmentLen : (messageLen - offset);
+            __gm__ uint8_t* wqeAddr = shmemi_rdma_fill_wqe(qpCtxEntry, curHead, remoteAddr + addrOffset,
+                                                           destRankId, opcode, len);
+            shmemi_rdma_fill_sge(wqeAddr + sizeof(SHMEMwqeCtx), localAddr + addrOffset, len);
+            offset += len;
+            addrOffset += addrStride;
+            curHead++;
+        }
+
+        // One cache flush over the batch, two if it wraps around the ring
+        __gm__ uint8_t* sqBase = (__gm__ uint8_t*)(qpCtxEntry->bufAddr);
+        uint32_t firstPart = (firstIdx + count > depth) ? depth - firstIdx : count;
+        dcci_cachelines(sqBase + (uint64_t)wqeSize * firstIdx, (uint64_t)wqeSize * firstPart);
+        if (firstPart < count) {
+            dcci_cachelines(sqBase, (uint64_t)wqeSize * (count - firstPart));
+        }
+        AscendC::PipeBarrier<PIPE_ALL>();
+
+        shmemi_rdma_ring_sq_doorbell(qpCtxEntry, curHead, ubLocal64, ubLocal32);
+    }
+}
+
+/**
+ * @brief AIV direct RDMA helper function for put with signal. The payload WRITE and the signal WRITE are
+ *        chained on the same QP under one doorbell, and the signal WQE is strongly ordered after the payload,
+ *        so the signal never lands before the data. Payloads larger than SHMEM_ROCE_SEGMENT_SIZE are posted
+ *        as a WQE list first, and the signal then rings its own doorbell.
+ *
+ * @param remoteAddr             [in] payload address in remote HBM
+ * @param localAddr              [in] payload address in local HBM
+ * @param messageLen             [in] payload length in Bytes, may be 0
+ * @param sigRemoteAddr          [in] signal address in remote HBM
+ * @param sigLocalAddr           [in] address in registered local HBM holding the signal value
+ * @param sigLen                 [in] signal length in Bytes
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ * @return SQ index of the signal WQE, the signal source may be reused once it completes.
+ */
+
+SHMEM_DEVICE uint32_t shmemi_rdma_post_write_signal(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
+                                                    uint64_t messageLen, __gm__ uint8_t* sigRemoteAddr,
+                                                    __gm__ uint8_t* sigLocalAddr, uint32_t sigLen,
+                                                    uint32_t destRankId, uint32_t qpIdx,
+                                                    AscendC::LocalTensor<uint64_t> ubLocal64,
+                                                    AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(device_state->qp_info);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    __gm__ SHMEMWQCtx* qpCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr + (destRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
+
+    bool chained = messageLen > 0 && messageLen <= SHMEM_ROCE_SEGMENT_SIZE;
+    if (messageLen > SHMEM_ROCE_SEGMENT_SIZE) {
+        shmemi_rdma_post_send_list(remoteAddr, localAddr, destRankId, qpIdx, SHMEMAIVOPCODE::OP_RDMA_WRITE,
+                                   messageLen, SHMEM_ROCE_SEGMENT_SIZE, SHMEM_ROCE_SEGMENT_SIZE, ubLocal64, ubLocal32);
+    }
+    uint32_t curHead = shmemi_rdma_sq_reserve(destRankId, qpIdx, ubLocal64, ubLocal32, chained ? 2 : 1);
+
+    // Write payload WQE (if chained) and signal WQE to HBM
+    if (chained) {
+        __gm__ uint8_t* wqeAddr = shmemi_rdma_fill_wqe(qpCtxEntry, curHead, remoteAddr, destRankId,
+                                                       SHMEMAIVOPCODE::OP_RDMA_WRITE, messageLen);
+        shmemi_rdma_fill_sge(wqeAddr + sizeof(SHMEMwqeCtx), localAddr, messageLen);
+        dcci_cachelines(wqeAddr, sizeof(SHMEMwqeCtx) + sizeof(SHMEMsegCtx));
+        curHead++;
+    }
+    uint32_t sigHead = curHead;
+    __gm__ uint8_t* sigWqeAddr = shmemi_rdma_fill_wqe(qpCtxEntry, curHead, sigRemoteAddr, destRankId,
+                                                      SHMEMAIVOPCODE::OP_RDMA_WRITE, sigLen);
+    *(__gm__ uint32_t*)(sigWqeAddr) |= SHMEM_ROCE_WQE_STRONG_ORDER;
+    shmemi_rdma_fill_sge(sigWqeAddr + sizeof(SHMEMwqeCtx), sigLocalAddr, sigLen);
+    dcci_cachelines(sigWqeAddr, sizeof(SHMEMwqeCtx) + sizeof(SHMEMsegCtx));
+    AscendC::PipeBarrier<PIPE_ALL>();
+    curHead++;
+
+    shmemi_rdma_ring_sq_doorbell(qpCtxEntry, curHead, ubLocal64, ubLocal32);
+    return sigHead;
+}
+
+/**
+ * @brief AIV direct RDMA helper function for 64-bit atomics. The original value at remoteAddr is
+ *        written to localAddr once the WQE completes.
+ *
+ * @param remoteAddr             [in] 8 Bytes aligned address in remote HBM
+ * @param localAddr              [in] 8 Bytes aligned address in registered local HBM to receive the fetched value
+ * @param destRankId             [in] destination rank ID
+ * @param qpIdx                  [in] QP index in multi-QP scenario (default 0 for single QP)
+ * @param opcode                 [in] OP_ATOMIC_CMP_AND_SWAP or OP_ATOMIC_FETCH_AND_ADD
+ * @param swapAdd                [in] swap value for CAS, addend for FAA
+ * @param compare                [in] compare value for CAS, ignored for FAA
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+
+SHMEM_DEVICE void shmemi_rdma_post_atomic(__gm__ uint8_t* remoteAddr, __gm__ uint8_t* localAddr,
+                                          uint32_t destRankId, uint32_t qpIdx, SHMEMAIVOPCODE opcode,
+                                          uint64_t swapAdd, uint64_t compare,
+                                          AscendC::LocalTensor<uint64_t> ubLocal64,
+                                          AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(device_state->qp_info);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    __gm__ SHMEMWQCtx* qpCtxEntry = (__gm__ SHMEMWQCtx*)(RDMAInfo->sqPtr + (destRankId * qpNum + qpIdx) * sizeof(SHMEMWQCtx));
+    uint32_t curHead = shmemi_rdma_sq_reserve(destRankId, qpIdx, ubLocal64, ubLocal32);
+
+    // Write WQE, SGE and atomic segment to HBM
+    __gm__ uint8_t* wqeAddr = shmemi_rdma_fill_wqe(qpCtxEntry, curHead, remoteAddr, destRankId, opcode,
+                                                   sizeof(uint64_t));
+    shmemi_rdma_fill_sge(wqeAddr + sizeof(SHMEMwqeCtx), localAddr, sizeof(uint64_t));
+    __gm__ SHMEMatomicCtx* atomicSeg = (__gm__ SHMEMatomicCtx*)(wqeAddr + sizeof(SHMEMwqeCtx) + sizeof(SHMEMsegCtx));
+    atomicSeg->swapAddData = swapAdd;
+    atomicSeg->cmpData = (opcode == SHMEMAIVOPCODE::OP_ATOMIC_CMP_AND_SWAP) ? compare : 0;
+
+    // WQE, SGE & atomic segment cache flush
+    dcci_cachelines(wqeAddr, sizeof(SHMEMwqeCtx) + sizeof(SHMEMsegCtx) + sizeof(SHMEMatomicCtx));
+    AscendC::PipeBarrier<PIPE_ALL>();
+    curHead++;
+
+    shmemi_rdma_ring_sq_doorbell(qpCtxEntry, curHead, ubLocal64, ubLocal32);
+}
+
+/**
+ * @brief Asynchronous RDMA Write function. Messages larger than SHMEM_ROCE_SEGMENT_SIZE are split and
+ *        posted as a WQE list.
  *
  * @param destDmaAddr            [in] destination address in remote HBM
  * @param srcDmaAddr             [in] source address in local HBM
@@ -304,12 +556,19 @@ SHMEM_DEVICE void shmemi_roce_write(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr,
                                                 AscendC::LocalTensor<uint64_t> ubLocal64,
                                                 AscendC::LocalTensor<uint32_t> ubLocal32)
 {
+    if (messageLen > SHMEM_ROCE_SEGMENT_SIZE) {
+        shmemi_rdma_post_send_list((__gm__ uint8_t*)destDmaAddr, (__gm__ uint8_t*)srcDmaAddr, destRankId, qpIdx,
+                                   SHMEMAIVOPCODE::OP_RDMA_WRITE, messageLen, SHMEM_ROCE_SEGMENT_SIZE,
+                                   SHMEM_ROCE_SEGMENT_SIZE, ubLocal64, ubLocal32);
+        return;
+    }
     shmemi_rdma_post_send(destDmaAddr, srcDmaAddr, destRankId, qpIdx, SHMEMAIVOPCODE::OP_RDMA_WRITE,
                             messageLen, ubLocal64, ubLocal32);
 }
 
 /**
- * @brief Asynchronous RDMA READ function.
+ * @brief Asynchronous RDMA READ function. Messages larger than SHMEM_ROCE_SEGMENT_SIZE are split and
+ *        posted as a WQE list.
  *
  * @param destDmaAddr            [in] destination address in local HBM
  * @param srcDmaAddr             [in] source address in remote HBM
@@ -326,10 +585,111 @@ SHMEM_DEVICE void shmemi_roce_read(__gm__ T* destDmaAddr, __gm__ T* srcDmaAddr,
                                                 AscendC::LocalTensor<uint64_t> ubLocal64,
                                                 AscendC::LocalTensor<uint32_t> ubLocal32)
 {
+    if (messageLen > SHMEM_ROCE_SEGMENT_SIZE) {
+        shmemi_rdma_post_send_list((__gm__ uint8_t*)srcDmaAddr, (__gm__ uint8_t*)destDmaAddr, srcRankId, qpIdx,
+                                   SHMEMAIVOPCODE::OP_RDMA_READ, messageLen, SHMEM_ROCE_SEGMENT_SIZE,
+                                   SHMEM_ROCE_SEGMENT_SIZE, ubLocal64, ubLocal32);
+        return;
+    }
     shmemi_rdma_post_send(srcDmaAddr, destDmaAddr, srcRankId, qpIdx, SHMEMAIVOPCODE::OP_RDMA_READ,
                             messageLen, ubLocal64, ubLocal32);
 }
 
+/**
+ * @brief Get the QPs owned by the calling core. With N AIV cores, core i owns QPs i, i + N, i + 2N ...,
+ *        so cores never share a producer index as long as qpNum is no less than N. Otherwise cores
+ *        share QP (i % qpNum). A core thus stripes over several QPs only when qpNum exceeds the AIV
+ *        cores of the launch; a launch using every core gets one QP per core, and the transfers of
+ *        the cores, not the stripes of one core, drive the QPs in parallel.
+ *
+ * @param firstQp                [out] first QP index owned by the core
+ * @param qpStep                 [out] distance between two QP indexes owned by the core
+ * @return Number of QPs owned by the core, at least 1.
+ */
+
+SHMEM_DEVICE uint32_t shmemi_roce_core_qps(uint32_t &firstQp, uint32_t &qpStep)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    __gm__ SHMEMAIVRDMAInfo* RDMAInfo = (__gm__ SHMEMAIVRDMAInfo*)(device_state->qp_info);
+    uint32_t qpNum = RDMAInfo->qpNum;
+    uint32_t coreNum = AscendC::GetBlockNum() * AscendC::GetTaskRation();
+    uint32_t coreIdx = AscendC::GetBlockIdx();
+    if (qpNum <= coreNum) {
+        firstQp = coreIdx % qpNum;
+        qpStep = qpNum;
+        return 1;
+    }
+    firstQp = coreIdx;
+    qpStep = coreNum;
+    return (qpNum - coreIdx + coreNum - 1) / coreNum;
+}
+
+/**
+ * @brief Asynchronous RDMA Write function, striped by chunk across the QPs owned by the calling core.
+ *
+ * @param destDmaAddr            [in] destination address in remote HBM
+ * @param srcDmaAddr             [in] source address in local HBM
+ * @param destRankId             [in] destination rank ID
+ * @param messageLen             [in] message length in Bytes
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+
+SHMEM_DEVICE void shmemi_roce_write_striped(__gm__ uint8_t* destDmaAddr, __gm__ uint8_t* srcDmaAddr,
+                                            uint32_t destRankId, uint64_t messageLen,
+                                            AscendC::LocalTensor<uint64_t> ubLocal64,
+                                            AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    uint32_t firstQp;
+    uint32_t qpStep;
+    uint32_t qpCount = shmemi_roce_core_qps(firstQp, qpStep);
+    if (qpCount == 1 || messageLen < SHMEM_ROCE_STRIPE_MIN_SIZE) {
+        shmemi_roce_write(destDmaAddr, srcDmaAddr, destRankId, firstQp, messageLen, ubLocal64, ubLocal32);
+        return;
+    }
+    uint64_t stripeLen = ALIGH_TO((messageLen + qpCount - 1) / qpCount, SHMEM_ROCE_STRIPE_ALIGN);
+    uint64_t offset = 0;
+    for (uint32_t i = 0; offset < messageLen; i++) {
+        uint64_t len = (messageLen - offset) > stripeLen ? stripeLen : (messageLen - offset);
+        shmemi_roce_write(destDmaAddr + offset, srcDmaAddr + offset, destRankId, firstQp + i * qpStep, len,
+                          ubLocal64, ubLocal32);
+        offset += len;
+    }
+}
+
+/**
+ * @brief Asynchronous RDMA READ function, striped by chunk across the QPs owned by the calling core.
+ *
+ * @param destDmaAddr            [in] destination address in local HBM
+ * @param srcDmaAddr             [in] source address in remote HBM
+ * @param srcRankId              [in] destination rank ID
+ * @param messageLen             [in] message length in Bytes
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+
+SHMEM_DEVICE void shmemi_roce_read_striped(__gm__ uint8_t* destDmaAddr, __gm__ uint8_t* srcDmaAddr,
+                                           uint32_t srcRankId, uint64_t messageLen,
+                                           AscendC::LocalTensor<uint64_t> ubLocal64,
+                                           AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    uint32_t firstQp;
+    uint32_t qpStep;
+    uint32_t qpCount = shmemi_roce_core_qps(firstQp, qpStep);
+    if (qpCount == 1 || messageLen < SHMEM_ROCE_STRIPE_MIN_SIZE) {
+        shmemi_roce_read(destDmaAddr, srcDmaAddr, srcRankId, firstQp, messageLen, ubLocal64, ubLocal32);
+        return;
+    }
+    uint64_t stripeLen = ALIGH_TO((messageLen + qpCount - 1) / qpCount, SHMEM_ROCE_STRIPE_ALIGN);
+    uint64_t offset = 0;
+    for (uint32_t i = 0; offset < messageLen; i++) {
+        uint64_t len = (messageLen - offset) > stripeLen ? stripeLen : (messageLen - offset);
+        shmemi_roce_read(destDmaAddr + offset, srcDmaAddr + offset, srcRankId, firstQp + i * qpStep, len,
+                         ubLocal64, ubLocal32);
+        offset += len;
+    }
+}
+
 /**
  * @brief RDMA Quiet function. This synchronous function ensures all previous RDMA WQEs are completed (data has arrived at the destination NIC).
  *
@@ -353,6 +713,25 @@ SHMEM_DEVICE void shmemi_roce_quiet(uint32_t remoteRankId, uint32_t qpIdx,
     shmemi_roce_poll_cq(remoteRankId, qpIdx, curHead, ubLocal64, ubLocal32);
 }
 
+/**
+ * @brief RDMA Quiet function over all QPs owned by the calling core, see shmemi_roce_core_qps.
+ *
+ * @param remoteRankId           [in] destination rank ID
+ * @param ubLocal64              [in] temporary UB local tensor of uint64_t used as workspace
+ * @param ubLocal32              [in] temporary UB local tensor of uint32_t used as workspace
+ */
+
+SHMEM_DEVICE void shmemi_roce_quiet_core(uint32_t remoteRankId, AscendC::LocalTensor<uint64_t> ubLocal64,
+                                         AscendC::LocalTensor<uint32_t> ubLocal32)
+{
+    uint32_t firstQp;
+    uint32_t qpStep;
+    uint32_t qpCount = shmemi_roce_core_qps(firstQp, qpStep);
+    for (uint32_t i = 0; i < qpCount; i++) {
+        shmemi_roce_quiet(remoteRankId, firstQp + i * qpStep, ubLocal64, ubLocal32);
+    }
+}
+
 SHMEM_DEVICE void shmemi_roce_qpinfo_test(__gm__ uint8_t* gva, uint32_t destRankId, uint32_t qpIdx)
 {
     __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
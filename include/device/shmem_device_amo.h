@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_DEVICE_AMO_H
+#define SHMEM_DEVICE_AMO_H
+
+#include "kernel_operator.h"
+#include "host/shmem_host_def.h"
+#include "internal/device/shmemi_device_amo.h"
+
+/**
+ * @brief Standard AMO Types and Names
+ *
+ * |NAME       | TYPE      |
+ * |-----------|-----------|
+ * |int32      | int32     |
+ * |int64      | int64     |
+ * |uint32     | uint32    |
+ * |uint64     | uint64    |
+ *
+ * Atomicity is only guaranteed among AMOs of the same type on the same address.
+ */
+
+#define SHMEM_TYPENAME_ATOMIC_FETCH_AICORE(NAME, TYPE)                                         \
+    /**                                                                                        \
+     * @brief Atomically fetch the value of a remote symmetric data object.                    \
+     *                                                                                         \
+     * @param src               [in] Symmetric address of the source data object.              \
+     * @param pe                [in] The number of the remote PE.                              \
+     * @return The value of src on the specified PE.                                           \
+     */                                                                                        \
+    SHMEM_DEVICE TYPE shmem_##NAME##_atomic_fetch(__gm__ TYPE *src, int pe)                    \
+    {                                                                                          \
+        return shmemi_atomic<TYPE>(src, 0, 0, SHMEMI_AMO_FETCH, pe);                           \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_FETCH_AICORE);
+
+#define SHMEM_TYPENAME_ATOMIC_SET_AICORE(NAME, TYPE)                                           \
+    /**                                                                                        \
+     * @brief Atomically set the value of a remote symmetric data object.                      \
+     *                                                                                         \
+     * @param dst               [in] Symmetric address of the destination data object.         \
+     * @param value             [in] The value to be set.                                      \
+     * @param pe                [in] The number of the remote PE.                              \
+     */                                                                                        \
+    SHMEM_DEVICE void shmem_##NAME##_atomic_set(__gm__ TYPE *dst, TYPE value, int pe)          \
+    {                                                                                          \
+        shmemi_atomic<TYPE>(dst, value, 0, SHMEMI_AMO_SET, pe);                                \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_SET_AICORE);
+
+#define SHMEM_TYPENAME_ATOMIC_SWAP_AICORE(NAME, TYPE)                                          \
+    /**                                                                                        \
+     * @brief Atomically swap the value of a remote symmetric data object.                     \
+     *                                                                                         \
+     * @param dst               [in] Symmetric address of the destination data object.         \
+     * @param value             [in] The value to be written.                                  \
+     * @param pe                [in] The number of the remote PE.                              \
+     * @return The value of dst on the specified PE before the swap.                           \
+     */                                                                                        \
+    SHMEM_DEVICE TYPE shmem_##NAME##_atomic_swap(__gm__ TYPE *dst, TYPE value, int pe)         \
+    {                                                                                          \
+        return shmemi_atomic<TYPE>(dst, value, 0, SHMEMI_AMO_SWAP, pe);                        \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_SWAP_AICORE);
+
+#define SHMEM_TYPENAME_ATOMIC_COMPARE_SWAP_AICORE(NAME, TYPE)                                            \
+    /**                                                                                                  \
+     * @brief Atomically write value to a remote symmetric data object if it equals cond.                \
+     *                                                                                                   \
+     * @param dst               [in] Symmetric address of the destination data object.                   \
+     * @param cond              [in] The value compared with dst.                                        \
+     * @param value             [in] The value to be written when dst equals cond.                       \
+     * @param pe                [in] The number of the remote PE.                                        \
+     * @return The value of dst on the specified PE before the operation.                                \
+     */                                                                                                  \
+    SHMEM_DEVICE TYPE shmem_##NAME##_atomic_compare_swap(__gm__ TYPE *dst, TYPE cond, TYPE value, int pe) \
+    {                                                                                                    \
+        return shmemi_atomic<TYPE>(dst, value, cond, SHMEMI_AMO_COMPARE_SWAP, pe);                       \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_COMPARE_SWAP_AICORE);
+
+#define SHMEM_TYPENAME_ATOMIC_OP_AICORE(NAME, TYPE, OP_FUNC, FETCH_OP_FUNC, OP)                       \
+    /**                                                                                              \
+     * @brief Atomically apply the operation with value to a remote symmetric data object.           \
+     *                                                                                               \
+     * @param dst               [in] Symmetric address of the destination data object.               \
+     * @param value             [in] The operand.                                                    \
+     * @param pe                [in] The number of the remote PE.                                    \
+     */                                                                                              \
+    SHMEM_DEVICE void shmem_##NAME##_##OP_FUNC(__gm__ TYPE *dst, TYPE value, int pe)                 \
+    {                                                                                                \
+        shmemi_atomic<TYPE>(dst, value, 0, SHMEMI_AMO_##OP, pe);                                     \
+    }                                                                                                \
+                                                                                                     \
+    /**                                                                                              \
+     * @brief Atomically apply the operation with value to a remote symmetric data object, and fetch \
+     *        the value before the operation.                                                        \
+     *                                                                                               \
+     * @param dst               [in] Symmetric address of the destination data object.               \
+     * @param value             [in] The operand.                                                    \
+     * @param pe                [in] The number of the remote PE.                                    \
+     * @return The value of dst on the specified PE before the operation.                            \
+     */                                                                                              \
+    SHMEM_DEVICE TYPE shmem_##NAME##_##FETCH_OP_FUNC(__gm__ TYPE *dst, TYPE value, int pe)           \
+    {                                                                                                \
+        return shmemi_atomic<TYPE>(dst, value, 0, SHMEMI_AMO_FETCH_##OP, pe);                        \
+    }
+
+// 'and', 'or' and 'xor' are alternative tokens in C++, so the full function suffixes are passed instead.
+#define SHMEM_TYPENAME_ATOMIC_ADD_AICORE(NAME, TYPE) \
+    SHMEM_TYPENAME_ATOMIC_OP_AICORE(NAME, TYPE, atomic_add, atomic_fetch_add, ADD)
+#define SHMEM_TYPENAME_ATOMIC_AND_AICORE(NAME, TYPE) \
+    SHMEM_TYPENAME_ATOMIC_OP_AICORE(NAME, TYPE, atomic_and, atomic_fetch_and, AND)
+#define SHMEM_TYPENAME_ATOMIC_OR_AICORE(NAME, TYPE) \
+    SHMEM_TYPENAME_ATOMIC_OP_AICORE(NAME, TYPE, atomic_or, atomic_fetch_or, OR)
+#define SHMEM_TYPENAME_ATOMIC_XOR_AICORE(NAME, TYPE) \
+    SHMEM_TYPENAME_ATOMIC_OP_AICORE(NAME, TYPE, atomic_xor, atomic_fetch_xor, XOR)
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_ADD_AICORE);
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_AND_AICORE);
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_OR_AICORE);
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_XOR_AICORE);
+
+#endif
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_DEVICE_COLL_H
+#define SHMEM_DEVICE_COLL_H
+
+#include "kernel_operator.h"
+#include "host/shmem_host_def.h"
+#include "device/shmem_device_rma.h"
+#include "internal/device/shmemi_device_coll.h"
+#include "internal/device/shmemi_device_quant.h"
+
+/*
+    Collective routines over a team.
+
+    1. Every vector core of every PE in the team must call the routine with the same arguments, the elements are
+       split among the vector cores. Cube cores may call it but take no part.
+
+    2. source and dest are symmetric and must not overlap, except for allreduce where dest may equal source.
+       Both can be reused once the routine returns on the calling PE.
+
+    3. Reductions use the UB area [SHMEM_COLL_UB_OFFSET, SHMEM_COLL_UB_OFFSET + SHMEM_COLL_UB_SIZE), and
+       half and bfloat16 are accumulated in float.
+
+    4. The routines return SHMEM_INVALID_PARAM without synchronizing if the calling PE is not a member of the team.
+*/
+
+/**
+ * @brief Standard Reduction Types and Names
+ *
+ * |NAME       | TYPE      |
+ * |-----------|-----------|
+ * |half       | half      |
+ * |bfloat16   | bfloat16  |
+ * |float      | float     |
+ * |int16      | int16     |
+ * |int32      | int32     |
+ */
+#define SHMEM_REDUCE_TYPE_FUNC(FUNC) \
+    FUNC(half, half);                \
+    FUNC(bfloat16, bfloat16_t);      \
+    FUNC(float, float);              \
+    FUNC(int16, int16_t);            \
+    FUNC(int32, int32_t)
+
+#define SHMEM_TYPENAME_ALLGATHER_AICORE(NAME, TYPE)                                                                    \
+    /**                                                                                                                \
+     * @brief Concatenate the source of every PE in the team, in team order, into dest on every PE.                    \
+     *                                                                                                                 \
+     * @param team              [in] The team over which to gather.                                                    \
+     * @param dest              [in] Symmetric destination, team size * nelems elements.                               \
+     * @param source            [in] Symmetric source, nelems elements.                                                \
+     * @param nelems            [in] Number of elements contributed by each PE.                                        \
+     * @return SHMEM_SUCCESS, or SHMEM_INVALID_PARAM if the calling PE is not a member of the team.                    \
+     */                                                                                                                \
+    SHMEM_DEVICE int shmem_##NAME##_allgather(shmem_team_t team, __gm__ TYPE *dest, __gm__ TYPE *source,               \
+                                              size_t nelems)                                                           \
+    {                                                                                                                  \
+        return shmemi_allgather<TYPE>(team, dest, source, nelems);                                                     \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLGATHER_AICORE);
+
+#define SHMEM_TYPENAME_BROADCAST_AICORE(NAME, TYPE)                                                                    \
+    /**                                                                                                                \
+     * @brief Copy the source of the root PE to dest on every PE in the team, the root included.                       \
+     *                                                                                                                 \
+     * @param team              [in] The team over which to broadcast.                                                 \
+     * @param dest              [in] Symmetric destination, nelems elements.                                           \
+     * @param source            [in] Symmetric source, nelems elements, only read on the root.                         \
+     * @param nelems            [in] Number of elements to broadcast.                                                  \
+     * @param pe_root           [in] The root, a PE number in the team.                                                \
+     * @return SHMEM_SUCCESS, or SHMEM_INVALID_PARAM if the calling PE is not a member or pe_root is out of the team.  \
+     */                                                                                                                \
+    SHMEM_DEVICE int shmem_##NAME##_broadcast(shmem_team_t team, __gm__ TYPE *dest, __gm__ TYPE *source,               \
+                                              size_t nelems, int pe_root)                                              \
+    {                                                                                                                  \
+        return shmemi_broadcast<TYPE>(team, dest, source, nelems, pe_root);                                            \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_BROADCAST_AICORE);
+
+#define SHMEM_TYPENAME_ALLTOALL_AICORE(NAME, TYPE)                                                                     \
+    /**                                                                                                                \
+     * @brief Exchange blocks of nelems elements between all PEs in the team, block j of the source of PE i lands      \
+     *        in block i of dest on PE j.                                                                              \
+     *                                                                                                                 \
+     * @param team              [in] The team over which to exchange.                                                  \
+     * @param dest              [in] Symmetric destination, team size * nelems elements.                               \
+     * @param source            [in] Symmetric source, team size * nelems elements.                                    \
+     * @param nelems            [in] Number of elements per block.                                                     \
+     * @return SHMEM_SUCCESS, or SHMEM_INVALID_PARAM if the calling PE is not a member of the team.                    \
+     */                                                                                                                \
+    SHMEM_DEVICE int shmem_##NAME##_alltoall(shmem_team_t team, __gm__ TYPE *dest, __gm__ TYPE *source,                \
+                                             size_t nelems)                                                            \
+    {                                                                                                                  \
+        return shmemi_alltoall<TYPE>(team, dest, source, nelems);                                                      \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLTOALL_AICORE);
+
+#define SHMEM_TYPENAME_ALLTOALLV_AICORE(NAME, TYPE)                                                                    \
+    /**                                                                                                                \
+     * @brief Exchange blocks of variable size between all PEs in the team, send_counts[j] elements of the source     \
+     *        of PE i land in dest on PE j, behind the blocks of the PEs before i, or at i * dest_stride if set.       \
+     *        Counts are exchanged by the call itself, receivers learn theirs from recv_counts.                        \
+     *                                                                                                                 \
+     * @param team              [in] The team over which to exchange.                                                  \
+     * @param dest              [in] Symmetric destination, large enough for every block received.                     \
+     * @param dest_stride       [in] Elements between the blocks in dest, 0 to pack them in team order. Blocks         \
+     *                               larger than the stride are cut to it.                                             \
+     * @param source            [in] Symmetric source.                                                                 \
+     * @param send_counts       [in] Local, team size elements sent to each PE.                                        \
+     * @param send_offsets      [in] Local, team size first elements in source of the block of each PE, nullptr if     \
+     *                               the blocks are packed in team order.                                              \
+     * @param recv_counts       [out] Local, team size elements received from each PE, after the cut, or nullptr.      \
+     * @param recv_offsets      [out] Local, team size first elements in dest of the block of each PE, or nullptr.     \
+     * @return SHMEM_SUCCESS, SHMEM_INVALID_PARAM if the calling PE is not a member of the team, or                   \
+     *         SHMEM_INVALID_VALUE once done if a block received by the calling PE was cut to dest_stride.             \
+     */                                                                                                                \
+    SHMEM_DEVICE int shmemx_##NAME##_alltoallv(shmem_team_t team, __gm__ TYPE *dest, size_t dest_stride,               \
+                                               __gm__ TYPE *source, __gm__ uint32_t *send_counts,                      \
+                                               __gm__ uint32_t *send_offsets, __gm__ uint32_t *recv_counts,            \
+                                               __gm__ uint64_t *recv_offsets)                                          \
+    {                                                                                                                  \
+        return shmemi_alltoallv<TYPE>(team, dest, dest_stride, source, send_counts, send_offsets, recv_counts,         \
+                                      recv_offsets);                                                                   \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLTOALLV_AICORE);
+
+#define SHMEM_TYPENAME_OP_ALLREDUCE_AICORE(NAME, TYPE, OP, REDUCE_OP)                                                  \
+    /**                                                                                                                \
+     * @brief Reduce the source of every PE in the team element-wise with the operation, and store the result in       \
+     *        dest on every PE.                                                                                        \
+     *                                                                                                                 \
+     * @param team              [in] The team over which to reduce.                                                    \
+     * @param dest              [in] Symmetric destination, nelems elements, may equal source.                         \
+     * @param source            [in] Symmetric source, nelems elements.                                                \
+     * @param nelems            [in] Number of elements to reduce.                                                     \
+     * @return SHMEM_SUCCESS, or SHMEM_INVALID_PARAM if the calling PE is not a member of the team.                    \
+     */                                                                                                                \
+    SHMEM_DEVICE int shmem_##NAME##_##OP##_allreduce(shmem_team_t team, __gm__ TYPE *dest, __gm__ TYPE *source,        \
+                                                     size_t nelems)                                                    \
+    {                                                                                                                  \
+        return shmemi_allreduce<TYPE, SHMEMI_REDUCE_##REDUCE_OP>(team, dest, source, nelems);                          \
+    }
+
+#define SHMEM_TYPENAME_ALLREDUCE_AICORE(NAME, TYPE)        \
+    SHMEM_TYPENAME_OP_ALLREDUCE_AICORE(NAME, TYPE, sum, SUM) \
+    SHMEM_TYPENAME_OP_ALLREDUCE_AICORE(NAME, TYPE, max, MAX) \
+    SHMEM_TYPENAME_OP_ALLREDUCE_AICORE(NAME, TYPE, min, MIN)
+
+SHMEM_REDUCE_TYPE_FUNC(SHMEM_TYPENAME_ALLREDUCE_AICORE);
+
+#define SHMEM_TYPENAME_OP_REDUCE_SCATTER_AICORE(NAME, TYPE, OP, REDUCE_OP)                                             \
+    /**                                                                                                                \
+     * @brief Reduce the source of every PE in the team element-wise with the operation, and scatter the result,       \
+     *        PE i of the team receives block i of nelems elements in dest.                                            \
+     *                                                                                                                 \
+     * @param team              [in] The team over which to reduce.                                                    \
+     * @param dest              [in] Symmetric destination, nelems elements.                                           \
+     * @param source            [in] Symmetric source, team size * nelems elements.                                    \
+     * @param nelems            [in] Number of elements per block.                                                     \
+     * @return SHMEM_SUCCESS, or SHMEM_INVALID_PARAM if the calling PE is not a member of the team.                    \
+     */                                                                                                                \
+    SHMEM_DEVICE int shmem_##NAME##_##OP##_reduce_scatter(shmem_team_t team, __gm__ TYPE *dest, __gm__ TYPE *source,   \
+                                                          size_t nelems)                                               \
+    {                                                                                                                  \
+        return shmemi_reduce_scatter<TYPE, SHMEMI_REDUCE_##REDUCE_OP>(team, dest, source, nelems);                     \
+    }
+
+#define SHMEM_TYPENAME_REDUCE_SCATTER_AICORE(NAME, TYPE)        \
+    SHMEM_TYPENAME_OP_REDUCE_SCATTER_AICORE(NAME, TYPE, sum, SUM) \
+    SHMEM_TYPENAME_OP_REDUCE_SCATTER_AICORE(NAME, TYPE, max, MAX) \
+    SHMEM_TYPENAME_OP_REDUCE_SCATTER_AICORE(NAME, TYPE, min, MIN)
+
+SHMEM_REDUCE_TYPE_FUNC(SHMEM_TYPENAME_REDUCE_SCATTER_AICORE);
+
+#define SHMEMX_TYPENAME_OP_REDUCE_LOCAL_AICORE(NAME, TYPE, OP, REDUCE_OP)                                              \
+    /**                                                                                                                \
+     * @brief Reduce num blocks of the calling PE element-wise with the operation on the vector unit,                  \
+     *        dest[j] = op over blocks i of source[i * stride + j], for collective implementations combining blocks    \
+     *        of peers they gathered. Every vector core calling it takes a share of the elements, the UB area of the   \
+     *        reductions is used, and half and bfloat16 are accumulated in float.                                      \
+     *                                                                                                                 \
+     * @param dest              [in] Destination in GM, nelems elements, may equal source.                             \
+     * @param source            [in] Blocks in GM, the first one at source.                                            \
+     * @param num               [in] Number of blocks, nothing is done below 1.                                        \
+     * @param stride            [in] Distance between blocks in elements.                                              \
+     * @param nelems            [in] Number of elements per block.                                                     \
+     */                                                                                                                \
+    SHMEM_DEVICE void shmemx_##NAME##_##OP##_reduce_local(__gm__ TYPE *dest, __gm__ TYPE *source, int num,             \
+                                                          size_t stride, size_t nelems)                                \
+    {                                                                                                                  \
+        shmemi_coll_reduce_local<TYPE, SHMEMI_REDUCE_##REDUCE_OP>(dest, source, num, stride, nelems);                  \
+    }
+
+#define SHMEMX_TYPENAME_REDUCE_LOCAL_AICORE(NAME, TYPE)           \
+    SHMEMX_TYPENAME_OP_REDUCE_LOCAL_AICORE(NAME, TYPE, sum, SUM)   \
+    SHMEMX_TYPENAME_OP_REDUCE_LOCAL_AICORE(NAME, TYPE, max, MAX)   \
+    SHMEMX_TYPENAME_OP_REDUCE_LOCAL_AICORE(NAME, TYPE, min, MIN)   \
+    SHMEMX_TYPENAME_OP_REDUCE_LOCAL_AICORE(NAME, TYPE, prod, PROD)
+
+SHMEM_REDUCE_TYPE_FUNC(SHMEMX_TYPENAME_REDUCE_LOCAL_AICORE);
+
+/**
+ * @brief Gather the float source of every PE in the team into dest on every PE, moved in the wire format of config.
+ *        dest receives the dequantized sources, the calling PE included.
+ *
+ * @param team              [in] The team over which to gather.
+ * @param dest              [in] Symmetric destination, team size * nelems elements.
+ * @param source            [in] Local source, nelems elements.
+ * @param nelems            [in] Number of elements per PE.
+ * @param config            [in] Wire format, block size, symmetric work buffer or 0 for the scratch of the team
+ *                               and optional error feedback, the same on every PE but for the error buffer. With 0
+ *                               the payload overwrites the scratch, see shmemx_team_get_scratch.
+ * @return SHMEM_SUCCESS, or SHMEM_INVALID_PARAM if the calling PE is not a member of the team or config is invalid.
+ */
+SHMEM_DEVICE int shmemx_float_allgather_quant(shmem_team_t team, __gm__ float *dest, __gm__ float *source,
+                                              size_t nelems, const shmemx_quant_config_t &config)
+{
+    return shmemi_allgather_quant(team, dest, source, nelems, config);
+}
+
+/**
+ * @brief Sum the float source of every PE in the team into dest on every PE, moved in the wire format of config.
+ *        Partial sums are accumulated in float, every PE ends with the same dest.
+ *
+ * @param team              [in] The team over which to reduce.
+ * @param dest              [in] Symmetric destination, nelems elements, may equal source.
+ * @param source            [in] Local source, nelems elements.
+ * @param nelems            [in] Number of elements to reduce.
+ * @param config            [in] Wire format, block size, symmetric work buffer or 0 for the scratch of the team
+ *                               and optional error feedback, the same on every PE but for the error buffer. With 0
+ *                               the payload overwrites the scratch, see shmemx_team_get_scratch.
+ * @return SHMEM_SUCCESS, or SHMEM_INVALID_PARAM if the calling PE is not a member of the team or config is invalid.
+ */
+SHMEM_DEVICE int shmemx_float_sum_allreduce_quant(shmem_team_t team, __gm__ float *dest, __gm__ float *source,
+                                                  size_t nelems, const shmemx_quant_config_t &config)
+{
+    return shmemi_allreduce_quant(team, dest, source, nelems, config);
+}
+
+#endif
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_DEVICE_CTX_H
+#define SHMEM_DEVICE_CTX_H
+
+#include "kernel_operator.h"
+#include "host/shmem_host_def.h"
+#include "internal/device/shmemi_device_common.h"
+#include "internal/device/shmemi_device_team.h"
+#include "low_level/shmem_device_low_level_rma.h"
+#include "low_level/shmem_device_low_level_roce.h"
+
+/*
+    Communication contexts.
+
+    A context is an ordering domain created on host (shmem_ctx_create / shmem_team_create_ctx). Each context
+    owns its UB staging area, MTE event ID and RoCE QP, and tracks per core which GM range and which RoCE
+    peers it touched since its last quiet. The QP is taken among those owned by the issuing core, see
+    shmemi_roce_core_qps, so contexts on different cores never post to the same SQ. shmem_ctx_quiet therefore
+        - waits only on the context's MTE3 event instead of PIPE_ALL,
+        - polls only the context's QP of the peers it posted to,
+        - flushes only the touched cachelines, falling back to the entire cache above SHMEM_CTX_DCCI_MAX_SIZE.
+    MTE requests of all contexts on one core still share the same in-order MTE queues, so a context quiet may
+    also observe completion of earlier requests issued by other contexts.
+
+    PE numbers passed to context operations are relative to the team the context was created on.
+*/
+
+SHMEM_DEVICE __gm__ shmemi_ctx_t *shmemi_ctx_get(shmem_ctx_t ctx)
+{
+    return &(shmemi_get_state()->ctx_pools[ctx]);
+}
+
+SHMEM_DEVICE __gm__ shmemi_ctx_track_t *shmemi_ctx_track(shmem_ctx_t ctx)
+{
+    uint64_t core = AscendC::GetBlockIdx() % SHMEM_MAX_AIV_PER_NPU;
+    return reinterpret_cast<__gm__ shmemi_ctx_track_t *>(shmemi_get_state()->ctx_track_pool +
+        (ctx * SHMEM_MAX_AIV_PER_NPU + core) * SHMEM_CTX_TRACK_SIZE);
+}
+
+SHMEM_DEVICE int shmemi_ctx_global_pe(__gm__ shmemi_ctx_t *ctx_ptr, int pe)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[ctx_ptr->team_idx];
+    return shmemi_team_global_pe(team, pe);
+}
+
+// QP of the ctx among those owned by the calling core, so that cores issuing on one ctx never share an SQ
+SHMEM_DEVICE uint32_t shmemi_ctx_qp_idx(__gm__ shmemi_ctx_t *ctx_ptr)
+{
+    uint32_t first_qp;
+    uint32_t qp_step;
+    uint32_t count = shmemi_roce_core_qps(first_qp, qp_step);
+    return first_qp + (ctx_ptr->qp_idx % count) * qp_step;
+}
+
+SHMEM_DEVICE void shmemi_ctx_track_range(__gm__ shmemi_ctx_track_t *track, __gm__ void *addr, uint64_t bytes)
+{
+    uint64_t lo = reinterpret_cast<uint64_t>(addr);
+    uint64_t hi = lo + bytes;
+    if (track->dirty_lo >= track->dirty_hi) {
+        track->dirty_lo = lo;
+        track->dirty_hi = hi;
+        return;
+    }
+    track->dirty_lo = lo < track->dirty_lo ? lo : track->dirty_lo;
+    track->dirty_hi = hi > track->dirty_hi ? hi : track->dirty_hi;
+}
+
+SHMEM_DEVICE void shmemi_ctx_track_roce(__gm__ shmemi_ctx_track_t *track, int pe)
+{
+    if (track->roce_pe_lo >= track->roce_pe_hi) {
+        track->roce_pe_lo = pe;
+        track->roce_pe_hi = pe + 1;
+        return;
+    }
+    track->roce_pe_lo = pe < track->roce_pe_lo ? pe : track->roce_pe_lo;
+    track->roce_pe_hi = pe + 1 > track->roce_pe_hi ? pe + 1 : track->roce_pe_hi;
+}
+
+SHMEM_DEVICE void shmemi_ctx_track_reset(__gm__ shmemi_ctx_track_t *track)
+{
+    track->dirty_lo = 0;
+    track->dirty_hi = 0;
+    track->roce_pe_lo = 0;
+    track->roce_pe_hi = 0;
+}
+
+SHMEM_DEVICE void shmemi_ctx_roce_ub(AscendC::LocalTensor<uint64_t> &ub_tensor_64,
+                                     AscendC::LocalTensor<uint32_t> &ub_tensor_32)
+{
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+}
+
+/**
+ * @brief Wait for the staging UB of the ctx to be drained by previous MTE3 requests before reusing it.
+ */
+SHMEM_DEVICE void shmemi_ctx_ub_acquire(__gm__ shmemi_ctx_t *ctx_ptr)
+{
+    AscendC::TEventID event_id = (AscendC::TEventID)ctx_ptr->mte_config.event_id;
+    AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+    AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_ctx_put_mem_nbi(shmem_ctx_t ctx, __gm__ T *dst, __gm__ T *src, uint32_t elem_size, int pe)
+{
+    auto device_state = shmemi_get_hot_state();
+    __gm__ shmemi_ctx_t *ctx_ptr = shmemi_ctx_get(ctx);
+    __gm__ shmemi_ctx_track_t *track = shmemi_ctx_track(ctx);
+    int global_pe = shmemi_ctx_global_pe(ctx_ptr, pe);
+
+    if (device_state->topo_list[global_pe] & SHMEM_TRANSPORT_MTE) {
+        shmemi_ctx_ub_acquire(ctx_ptr);
+        shmem_mte_put_mem_nbi(dst, src, reinterpret_cast<__ubuf__ T *>(ctx_ptr->mte_config.shmem_ub),
+                              ctx_ptr->mte_config.ub_size, elem_size, global_pe,
+                              (AscendC::TEventID)ctx_ptr->mte_config.event_id);
+        shmemi_ctx_track_range(track, shmem_ptr(dst, global_pe), elem_size * sizeof(T));
+    } else if (device_state->topo_list[global_pe] & SHMEM_TRANSPORT_ROCE) {
+        auto ptr = shmem_roce_ptr(dst, global_pe);
+        if (ptr == nullptr) return;
+        AscendC::LocalTensor<uint32_t> ub_tensor_32;
+        AscendC::LocalTensor<uint64_t> ub_tensor_64;
+        shmemi_ctx_roce_ub(ub_tensor_64, ub_tensor_32);
+        shmemi_roce_write((__gm__ uint8_t *)ptr, (__gm__ uint8_t *)src, global_pe, shmemi_ctx_qp_idx(ctx_ptr),
+                          elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
+        shmemi_ctx_track_roce(track, global_pe);
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_ctx_get_mem_nbi(shmem_ctx_t ctx, __gm__ T *dst, __gm__ T *src, uint32_t elem_size, int pe)
+{
+    auto device_state = shmemi_get_hot_state();
+    __gm__ shmemi_ctx_t *ctx_ptr = shmemi_ctx_get(ctx);
+    __gm__ shmemi_ctx_track_t *track = shmemi_ctx_track(ctx);
+    int global_pe = shmemi_ctx_global_pe(ctx_ptr, pe);
+
+    if (device_state->topo_list[global_pe] & SHMEM_TRANSPORT_MTE) {
+        shmemi_ctx_ub_acquire(ctx_ptr);
+        shmem_mte_get_mem_nbi(dst, src, reinterpret_cast<__ubuf__ T *>(ctx_ptr->mte_config.shmem_ub),
+                              ctx_ptr->mte_config.ub_size, elem_size, global_pe,
+                              (AscendC::TEventID)ctx_ptr->mte_config.event_id);
+        shmemi_ctx_track_range(track, dst, elem_size * sizeof(T));
+    } else if (device_state->topo_list[global_pe] & SHMEM_TRANSPORT_ROCE) {
+        auto ptr = shmem_roce_ptr(src, global_pe);
+        if (ptr == nullptr) return;
+        AscendC::LocalTensor<uint32_t> ub_tensor_32;
+        AscendC::LocalTensor<uint64_t> ub_tensor_64;
+        shmemi_ctx_roce_ub(ub_tensor_64, ub_tensor_32);
+        shmemi_roce_read((__gm__ uint8_t *)dst, (__gm__ uint8_t *)ptr, global_pe, shmemi_ctx_qp_idx(ctx_ptr),
+                         elem_size * sizeof(T), ub_tensor_64, ub_tensor_32);
+        shmemi_ctx_track_roce(track, global_pe);
+        shmemi_ctx_track_range(track, dst, elem_size * sizeof(T));
+    }
+}
+
+/**
+ * @brief Ensure ordering of put, AMO and memory store operations issued on the context, without waiting
+ *        for their remote completion.
+ *
+ * @param ctx               [in] The context on which to perform the operation.
+ */
+SHMEM_DEVICE void shmem_ctx_fence(shmem_ctx_t ctx)
+{
+    // RoCE WQEs on one QP are delivered in order, only MTE requests need to be drained.
+    AscendC::TEventID event_id = (AscendC::TEventID)shmemi_ctx_get(ctx)->mte_config.event_id;
+    AscendC::SetFlag<AscendC::HardEvent::MTE3_S>(event_id);
+    AscendC::WaitFlag<AscendC::HardEvent::MTE3_S>(event_id);
+}
+
+/**
+ * @brief Ensure completion of all operations issued on the context by the calling core.
+ *
+ * @param ctx               [in] The context on which to perform the operation.
+ */
+SHMEM_DEVICE void shmem_ctx_quiet(shmem_ctx_t ctx)
+{
+    auto device_state = shmemi_get_hot_state();
+    __gm__ shmemi_ctx_t *ctx_ptr = shmemi_ctx_get(ctx);
+    __gm__ shmemi_ctx_track_t *track = shmemi_ctx_track(ctx);
+
+    shmem_ctx_fence(ctx);
+
+    if (track->roce_pe_lo < track->roce_pe_hi) {
+        AscendC::LocalTensor<uint32_t> ub_tensor_32;
+        AscendC::LocalTensor<uint64_t> ub_tensor_64;
+        shmemi_ctx_roce_ub(ub_tensor_64, ub_tensor_32);
+        uint32_t qp_idx = shmemi_ctx_qp_idx(ctx_ptr);
+        for (int pe = track->roce_pe_lo; pe < track->roce_pe_hi; pe++) {
+            if (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE) {
+                shmemi_roce_quiet(pe, qp_idx, ub_tensor_64, ub_tensor_32);
+            }
+        }
+    }
+
+    if (track->dirty_lo < track->dirty_hi) {
+        uint64_t dirty_size = track->dirty_hi - track->dirty_lo;
+        if (dirty_size <= SHMEM_CTX_DCCI_MAX_SIZE) {
+            dcci_cachelines(reinterpret_cast<__gm__ uint8_t *>(track->dirty_lo), dirty_size);
+        } else {
+            dcci_entire_cache();
+        }
+    }
+    shmemi_ctx_track_reset(track);
+}
+
+/**
+ * @brief Asynchronous interface. Copy contiguous data on local PE to symmetric address on the specified PE,
+ *        through the given context.
+ *
+ * @param ctx               [in] The context on which to perform the operation.
+ * @param dst               [in] Pointer on Symmetric memory of the destination data.
+ * @param src               [in] Pointer on local device of the source data.
+ * @param elem_size         [in] Number of bytes to copy.
+ * @param pe                [in] PE number of the remote PE, relative to the team of ctx.
+ */
+SHMEM_DEVICE void shmem_ctx_putmem_nbi(shmem_ctx_t ctx, __gm__ void *dst, __gm__ void *src, uint32_t elem_size,
+                                       int32_t pe)
+{
+    shmemi_ctx_put_mem_nbi(ctx, reinterpret_cast<__gm__ char *>(dst), reinterpret_cast<__gm__ char *>(src),
+                           elem_size, pe);
+}
+
+/**
+ * @brief Synchronous interface. Copy contiguous data on local PE to symmetric address on the specified PE,
+ *        through the given context.
+ *
+ * @param ctx               [in] The context on which to perform the operation.
+ * @param dst               [in] Pointer on Symmetric memory of the destination data.
+ * @param src               [in] Pointer on local device of the source data.
+ * @param elem_size         [in] Number of bytes to copy.
+ * @param pe                [in] PE number of the remote PE, relative to the team of ctx.
+ */
+SHMEM_DEVICE void shmem_ctx_putmem(shmem_ctx_t ctx, __gm__ void *dst, __gm__ void *src, uint32_t elem_size,
+                                   int32_t pe)
+{
+    shmem_ctx_putmem_nbi(ctx, dst, src, elem_size, pe);
+    shmem_ctx_quiet(ctx);
+}
+
+/**
+ * @brief Asynchronous interface. Copy contiguous data on symmetric memory from the specified PE to address on
+ *        the local PE, through the given context.
+ *
+ * @param ctx               [in] The context on which to perform the operation.
+ * @param dst               [in] Pointer on local device of the destination data.
+ * @param src               [in] Pointer on Symmetric memory of the source data.
+ * @param elem_size         [in] Number of bytes to copy.
+ * @param pe                [in] PE number of the remote PE, relative to the team of ctx.
+ */
+SHMEM_DEVICE void shmem_ctx_getmem_nbi(shmem_ctx_t ctx, __gm__ void *dst, __gm__ void *src, uint32_t elem_size,
+                                       int32_t pe)
+{
+    shmemi_ctx_get_mem_nbi(ctx, reinterpret_cast<__gm__ char *>(dst), reinterpret_cast<__gm__ char *>(src),
+                           elem_size, pe);
+}
+
+/**
+ * @brief Synchronous interface. Copy contiguous data on symmetric memory from the specified PE to address on
+ *        the local PE, through the given context.
+ *
+ * @param ctx               [in] The context on which to perform the operation.
+ * @param dst               [in] Pointer on local device of the destination data.
+ * @param src               [in] Pointer on Symmetric memory of the source data.
+ * @param elem_size         [in] Number of bytes to copy.
+ * @param pe                [in] PE number of the remote PE, relative to the team of ctx.
+ */
+SHMEM_DEVICE void shmem_ctx_getmem(shmem_ctx_t ctx, __gm__ void *dst, __gm__ void *src, uint32_t elem_size,
+                                   int32_t pe)
+{
+    shmem_ctx_getmem_nbi(ctx, dst, src, elem_size, pe);
+    shmem_ctx_quiet(ctx);
+}
+
+#define SHMEM_CTX_TYPENAME_MEM(NAME, TYPE)                                                                     \
+    /**                                                                                                        \
+     * @brief Asynchronous interface. Copy contiguous data on local PE to symmetric address on the specified   \
+     *        PE, through the given context.                                                                   \
+     *                                                                                                         \
+     * @param ctx               [in] The context on which to perform the operation.                            \
+     * @param dst               [in] Pointer on Symmetric memory of the destination data.                      \
+     * @param src               [in] Pointer on local device of the source data.                               \
+     * @param elem_size         [in] Number of elements in the dest and source arrays.                         \
+     * @param pe                [in] PE number of the remote PE, relative to the team of ctx.                  \
+     */                                                                                                        \
+    SHMEM_DEVICE void shmem_ctx_put_##NAME##_mem_nbi(shmem_ctx_t ctx, __gm__ TYPE *dst, __gm__ TYPE *src,      \
+                                                     uint32_t elem_size, int32_t pe)                           \
+    {                                                                                                          \
+        shmemi_ctx_put_mem_nbi(ctx, dst, src, elem_size, pe);                                                  \
+    }                                                                                                          \
+                                                                                                               \
+    /**                                                                                                        \
+     * @brief Synchronous interface. Copy contiguous data on local PE to symmetric address on the specified    \
+     *        PE, through the given context.                                                                   \
+     *                                                                                                         \
+     * @param ctx               [in] The context on which to perform the operation.                            \
+     * @param dst               [in] Pointer on Symmetric memory of the destination data.                      \
+     * @param src               [in] Pointer on local device of the source data.                               \
+     * @param elem_size         [in] Number of elements in the dest and source arrays.                         \
+     * @param pe                [in] PE number of the remote PE, relative to the team of ctx.                  \
+     */                                                                                                        \
+    SHMEM_DEVICE void shmem_ctx_put_##NAME##_mem(shmem_ctx_t ctx, __gm__ TYPE *dst, __gm__ TYPE *src,          \
+                                                 uint32_t elem_size, int32_t pe)                               \
+    {                                                                                                          \
+        shmemi_ctx_put_mem_nbi(ctx, dst, src, elem_size, pe);                                                  \
+        shmem_ctx_quiet(ctx);                                                                                  \
+    }                                                                                                          \
+                                                                                                               \
+    /**                                                                                                        \
+     * @brief Asynchronous interface. Copy contiguous data on symmetric memory from the specified PE to        \
+     *        address on the local PE, through the given context.                                             \
+     *                                                                                                         \
+     * @param ctx               [in] The context on which to perform the operation.                            \
+     * @param dst               [in] Pointer on local device of the destination data.                          \
+     * @param src               [in] Pointer on Symmetric memory of the source data.                           \
+     * @param elem_size         [in] Number of elements in the dest and source arrays.                         \
+     * @param pe                [in] PE number of the remote PE, relative to the team of ctx.                  \
+     */                                                                                                        \
+    SHMEM_DEVICE void shmem_ctx_get_##NAME##_mem_nbi(shmem_ctx_t ctx, __gm__ TYPE *dst, __gm__ TYPE *src,      \
+                                                     uint32_t elem_size, int32_t pe)                           \
+    {                                                                                                          \
+        shmemi_ctx_get_mem_nbi(ctx, dst, src, elem_size, pe);                                                  \
+    }                                                                                                          \
+                                                                                                               \
+    /**                                                                                                        \
+     * @brief Synchronous interface. Copy contiguous data on symmetric memory from the specified PE to         \
+     *        address on the local PE, through the given context.                                             \
+     *                                                                                                         \
+     * @param ctx               [in] The context on which to perform the operation.                            \
+     * @param dst               [in] Pointer on local device of the destination data.                          \
+     * @param src               [in] Pointer on Symmetric memory of the source data.                           \
+     * @param elem_size         [in] Number of elements in the dest and source arrays.                         \
+     * @param pe                [in] PE number of the remote PE, relative to the team of ctx.                  \
+     */                                                                                                        \
+    SHMEM_DEVICE void shmem_ctx_get_##NAME##_mem(shmem_ctx_t ctx, __gm__ TYPE *dst, __gm__ TYPE *src,          \
+                                                 uint32_t elem_size, int32_t pe)                               \
+    {                                                                                                          \
+        shmemi_ctx_get_mem_nbi(ctx, dst, src, elem_size, pe);                                                  \
+        shmem_ctx_quiet(ctx);                                                                                  \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_CTX_TYPENAME_MEM);
+
+#endif
@@ -16,6 +16,7 @@
 #include "low_level/shmem_device_low_level_roce.h"
 #include "shmem_device_team.h"
 #include "internal/device/sync/shmemi_device_p2p.h"
+#include "internal/device/shmemi_device_amo.h"
 #include "shmem_device_sync.h"
 #include "host/shmem_host_def.h"
 
@@ -118,7 +119,7 @@ SHMEM_DEVICE void shmem_getmem(__gm__ void *dst, __gm__ void *src, uint32_t elem
     /* RDMA */
     /* MTE  */
     /* Global State Get */
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -144,7 +145,7 @@ SHMEM_DEVICE void shmem_getmem(__gm__ void *dst, __gm__ void *src, uint32_t elem
         /* RDMA */                                                                                               \
         /* MTE  */                                                                                               \
         /* Global State Get */                                                                                   \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                    \
+        auto device_state = shmemi_get_hot_state();                                                              \
         /* CopyUB Config Set */                                                                                  \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                    \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                \
@@ -170,7 +171,7 @@ SHMEM_DEVICE void shmem_putmem(__gm__ void *dst, __gm__ void *src, uint32_t elem
     /* RDMA */
     /* MTE  */
     /* Global State Get */
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -195,7 +196,7 @@ SHMEM_DEVICE void shmem_putmem(__gm__ void *dst, __gm__ void *src, uint32_t elem
         /* RDMA */                                                                                                \
         /* MTE  */                                                                                                \
         /* Global State Get */                                                                                    \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                     \
+        auto device_state = shmemi_get_hot_state();                                                               \
         /* CopyUB Config Set */                                                                                   \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                     \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                 \
@@ -222,7 +223,7 @@ SHMEM_DEVICE void shmem_getmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t
     /* RDMA */
     /* MTE  */
     /* Global State Get */
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -244,7 +245,7 @@ SHMEM_DEVICE void shmem_getmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t
     SHMEM_DEVICE void shmem_get_##NAME##_mem_nbi(__gm__ TYPE *dst, __gm__ TYPE *src, uint32_t elem_size, int32_t pe) \
     {                                                                                                                \
         /* Global State Get */                                                                                       \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                        \
+        auto device_state = shmemi_get_hot_state();                                                                  \
         if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {                                                     \
             /* MTE  */                                                                                               \
             /* CopyUB Config Set */                                                                                  \
@@ -267,7 +268,7 @@ SHMEM_DEVICE void shmem_getmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t
             ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR           \
                                                                              + UB_ALIGN_SIZE);                       \
             ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;                                                           \
-            shmemi_roce_read((__gm__ uint8_t*)dst, (__gm__ uint8_t*)ptr, pe, 0, elem_size * sizeof(TYPE),            \
+            shmemi_roce_read_striped((__gm__ uint8_t*)dst, (__gm__ uint8_t*)ptr, pe, elem_size * sizeof(TYPE),            \
                                 ub_tensor_64, ub_tensor_32);                                                         \
         }                                                                                                            \
     }
@@ -291,7 +292,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_NBI);
         /* RDMA */                                                                                                 \
         /* MTE  */                                                                                                 \
         /* Global State Get */                                                                                     \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
+        auto device_state = shmemi_get_hot_state();                                                                \
         /* CopyUB Config Set */                                                                                    \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                      \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                  \
@@ -316,7 +317,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_DETAILED_NBI);
                                                  uint32_t elem_size, int pe)                                       \
     {                                                                                                              \
         /* Global State Get */                                                                                     \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
+        auto device_state = shmemi_get_hot_state();                                                                \
         if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {                                                   \
             /* MTE  */                                                                                             \
             /* CopyUB Config Set */                                                                                \
@@ -342,7 +343,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_DETAILED_NBI);
             ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR         \
                                                                             + UB_ALIGN_SIZE);                      \
             ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;                                                         \
-            shmemi_roce_read((__gm__ uint8_t*)(dst.GetPhyAddr()), (__gm__ uint8_t*)ptr, pe, 0,                     \
+            shmemi_roce_read_striped((__gm__ uint8_t*)(dst.GetPhyAddr()), (__gm__ uint8_t*)ptr, pe,                     \
                                 elem_size * sizeof(TYPE), ub_tensor_64, ub_tensor_32);                             \
         }                                                                                                          \
     }
@@ -366,7 +367,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_TENSOR_NBI);
         /* RDMA */                                                                                                 \
         /* MTE  */                                                                                                 \
         /* Global State Get */                                                                                     \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
+        auto device_state = shmemi_get_hot_state();                                                                \
         /* CopyUB Config Set */                                                                                    \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                      \
         /* Create LocalTensor */                                                                                   \
@@ -392,7 +393,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_TENSOR_DETAILED_NBI);
     SHMEM_DEVICE void shmem_put_##NAME##_mem_nbi(__gm__ TYPE *dst, __gm__ TYPE *src, uint32_t elem_size, int32_t pe) \
     {                                                                                                                \
         /* Global State Get */                                                                                       \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                        \
+        auto device_state = shmemi_get_hot_state();                                                                  \
         if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {                                                     \
             /* MTE  */                                                                                               \
             /* CopyUB Config Set */                                                                                  \
@@ -415,7 +416,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_TENSOR_DETAILED_NBI);
             ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR           \
                                                                             + UB_ALIGN_SIZE);                        \
             ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;                                                           \
-            shmemi_roce_write((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)src, pe, 0, elem_size * sizeof(TYPE),           \
+            shmemi_roce_write_striped((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)src, pe, elem_size * sizeof(TYPE),           \
                                     ub_tensor_64, ub_tensor_32);                                                     \
         }                                                                                                            \
     }
@@ -439,7 +440,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_NBI);
         /* RDMA */                                                                                                 \
         /* MTE  */                                                                                                 \
         /* Global State Get */                                                                                     \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
+        auto device_state = shmemi_get_hot_state();                                                                \
         /* CopyUB Config Set */                                                                                    \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                      \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                  \
@@ -463,7 +464,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_DETAILED_NBI);
                                                  uint32_t elem_size, int pe)                                       \
     {                                                                                                              \
         /* Global State Get */                                                                                     \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
+        auto device_state = shmemi_get_hot_state();                                                                \
         if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {                                                   \
             /* MTE  */                                                                                             \
             /* CopyUB Config Set */                                                                                \
@@ -489,7 +490,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_DETAILED_NBI);
             ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR         \
                                                                             + UB_ALIGN_SIZE);                      \
             ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;                                                         \
-            shmemi_roce_write((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)(src.GetPhyAddr()), pe, 0,                    \
+            shmemi_roce_write_striped((__gm__ uint8_t*)ptr, (__gm__ uint8_t*)(src.GetPhyAddr()), pe,                    \
                                                     elem_size * sizeof(TYPE), ub_tensor_64, ub_tensor_32);         \
         }                                                                                                          \
     }
@@ -513,7 +514,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_TENSOR_NBI);
         /* RDMA */                                                                                                 \
         /* MTE  */                                                                                                 \
         /* Global State Get */                                                                                     \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
+        auto device_state = shmemi_get_hot_state();                                                                \
         /* CopyUB Config Set */                                                                                    \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                      \
         /* Create LocalTensor */                                                                                   \
@@ -541,7 +542,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_TENSOR_DETAILED_NBI);
     {                                                                                                              \
         /* MTE  */                                                                                                 \
         /* Global State Get */                                                                                     \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
+        auto device_state = shmemi_get_hot_state();                                                                \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                    \
         shmem_mte_get_mem_nbi(dst, src, elem_size, pe, copy_event_id);                                             \
     }
@@ -563,7 +564,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_UB_NBI);
     {                                                                                                             \
         /* MTE  */                                                                                                \
         /* Global State Get */                                                                                    \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                     \
+        auto device_state = shmemi_get_hot_state();                                                               \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                   \
         shmem_mte_get_mem_nbi(dst, src, elem_size, pe, copy_event_id);                                            \
     }
@@ -585,7 +586,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_UB_TENSOR_NBI);
     {                                                                                                      \
         /* MTE  */                                                                                         \
         /* Global State Get */                                                                             \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                              \
+        auto device_state = shmemi_get_hot_state();                                                        \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;            \
         shmem_mte_get_mem_nbi(dst, src, copy_params, pe, copy_event_id);                                   \
     }
@@ -607,7 +608,7 @@ SHMEM_TYPE_FUNC(SHMEM_GET_TYPENAME_MEM_UB_DETAILED_NBI);
     {                                                                                                             \
         /* MTE  */                                                                                                \
         /* Global State Get */                                                                                    \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                     \
+        auto device_state = shmemi_get_hot_state();                                                               \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                   \
         shmem_mte_get_mem_nbi(dst, src, copy_params, pe, copy_event_id);                                          \
     }
@@ -626,7 +627,7 @@ SHMEM_DEVICE void shmem_putmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t
 {
     /* MTE  */
     /* Global State Get */
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -648,7 +649,7 @@ SHMEM_DEVICE void shmem_putmem_nbi(__gm__ void *dst, __gm__ void *src, uint32_t
     {                                                                                                                  \
         /* MTE  */                                                                                                     \
         /* Global State Get */                                                                                         \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                          \
+        auto device_state = shmemi_get_hot_state();                                                                    \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                        \
         shmem_mte_put_mem_nbi(dst, src, elem_size, pe, copy_event_id);                                                 \
     }
@@ -669,7 +670,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_UB_NBI);
     {                                                                                                             \
         /* MTE  */                                                                                                \
         /* Global State Get */                                                                                    \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                     \
+        auto device_state = shmemi_get_hot_state();                                                               \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                   \
         shmem_mte_put_mem_nbi(dst, src, elem_size, pe, copy_event_id);                                            \
     }
@@ -691,7 +692,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_UB_TENSOR_NBI);
     {                                                                                                        \
         /* MTE  */                                                                                           \
         /* Global State Get */                                                                               \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                \
+        auto device_state = shmemi_get_hot_state();                                                          \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;              \
         shmem_mte_put_mem_nbi(dst, src, copy_params, pe, copy_event_id);                                     \
     }
@@ -713,7 +714,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_UB_DETAILED_NBI);
     {                                                                                                             \
         /* MTE  */                                                                                                \
         /* Global State Get */                                                                                    \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                     \
+        auto device_state = shmemi_get_hot_state();                                                               \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                   \
         shmem_mte_put_mem_nbi(dst, src, copy_params, pe, copy_event_id);                                          \
     }
@@ -722,7 +723,8 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_UB_TENSOR_DETAILED_NBI);
 
 /**
  * @brief Synchronous interface. Copy contiguous data on local PE to symmetric address on the specified PE
- *       then update sig_addr
+ *       then update sig_addr. Over RoCE the signal is posted in the same WQE chain as the data and is ordered
+ *       after it, the receiver only needs shmem_signal_wait_until.
  *
  * @param dst               [in] Pointer on local device of the destination data.
  * @param src               [in] Pointer on Symmetric memory of the source data.
@@ -740,7 +742,14 @@ SHMEM_DEVICE void shmem_putmem_signal(__gm__ void *dst, __gm__ void *src, size_t
     /* RDMA */
     /* MTE  */
     /* Global State Set */
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
+    if (!(device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) &&
+        (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE)) {
+        /* RoCE */
+        shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src,
+                               elem_size, sig_addr, signal, sig_op, pe, true);
+        return;
+    }
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -767,7 +776,14 @@ SHMEM_DEVICE void shmem_putmem_signal(__gm__ void *dst, __gm__ void *src, size_t
     SHMEM_DEVICE void shmem_put_##NAME##_mem_signal(__gm__ TYPE *dst, __gm__ TYPE *src, size_t elem_size,         \
                                                     __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe) \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                     \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                     \
+        auto device_state = shmemi_get_hot_state();                                                               \
+        if (!(device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) &&                                               \
+            (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE)) {                                               \
+            /* RoCE */                                                                                            \
+            shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src,                                  \
+                                   elem_size * sizeof(TYPE), sig_addr, signal, sig_op, pe, true);                 \
+            return;                                                                                               \
+        }                                                                                                         \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                   \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                     \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                 \
@@ -797,7 +813,14 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL);
                                                     size_t elem_size, __gm__ int32_t *sig_addr, int32_t signal,       \
                                                     int sig_op, int pe)                                               \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                         \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                         \
+        auto device_state = shmemi_get_hot_state();                                                                   \
+        if (!(device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) &&                                                   \
+            (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE)) {                                                   \
+            /* RoCE */                                                                                                \
+            shmemi_roce_put_signal((__gm__ uint8_t *)dst.GetPhyAddr(), (__gm__ uint8_t *)src.GetPhyAddr(),            \
+                                   elem_size * sizeof(TYPE), sig_addr, signal, sig_op, pe, true);                     \
+            return;                                                                                                   \
+        }                                                                                                             \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                       \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                         \
         AscendC::LocalTensor<TYPE> ub_tensor;                                                                         \
@@ -830,7 +853,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_TENSOR);
                                                     const non_contiguous_copy_param &copy_params,                  \
                                                     __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe)  \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                      \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                      \
+        auto device_state = shmemi_get_hot_state();                                                                \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                    \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                      \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                  \
@@ -861,7 +884,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_DETAILED);
                                                     const non_contiguous_copy_param &copy_params,                     \
                                                     __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe)     \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                         \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                         \
+        auto device_state = shmemi_get_hot_state();                                                                   \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                       \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                         \
         AscendC::LocalTensor<TYPE> ub_tensor;                                                                         \
@@ -878,7 +901,9 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_TENSOR_DETAILED);
 
 /**
  * @brief Asynchronous interface. Copy contiguous data on local PE to symmetric address on the specified PE then update
- * sig_addr
+ * sig_addr. Over RoCE a SHMEM_SIGNAL_SET signal is posted in the same WQE chain as the data and is ordered after it.
+ * SHMEM_SIGNAL_ADD has no such chain: RDMA atomics are 64-bit only, so the 32-bit add is a compare-swap loop on the
+ * enclosing word and this call blocks until the payload and the signal have completed.
  *
  * @param dst               [in] Pointer on local device of the destination data.
  * @param src               [in] Pointer on Symmetric memory of the source data.
@@ -896,7 +921,14 @@ SHMEM_DEVICE void shmem_putmem_signal_nbi(__gm__ void *dst, __gm__ void *src, si
     /* RDMA */
     /* MTE  */
     /* Global State Set */
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
+    if (!(device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) &&
+        (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE)) {
+        /* RoCE */
+        shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src,
+                               elem_size, sig_addr, signal, sig_op, pe, false);
+        return;
+    }
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -918,12 +950,20 @@ SHMEM_DEVICE void shmem_putmem_signal_nbi(__gm__ void *dst, __gm__ void *src, si
      * @param signal            [in] The value used to update sig_addr.                                               \
      * @param sig_op            [in] Operation used to update sig_addr with signal. Supported operations:             \
      *                               SHMEM_SIGNAL_SET/SHMEM_SIGNAL_ADD                                                \
+     *                               Over RoCE SHMEM_SIGNAL_ADD is a blocking AMO, see shmem_putmem_signal_nbi.       \
      * @param pe                [in] PE number of the remote PE.                                                      \
      */                                                                                                               \
     SHMEM_DEVICE void shmem_put_##NAME##_mem_signal_nbi(__gm__ TYPE *dst, __gm__ TYPE *src, size_t elem_size,         \
                                                         __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe) \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                         \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                         \
+        auto device_state = shmemi_get_hot_state();                                                                   \
+        if (!(device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) &&                                                   \
+            (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE)) {                                                   \
+            /* RoCE */                                                                                                \
+            shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src,                                      \
+                                   elem_size * sizeof(TYPE), sig_addr, signal, sig_op, pe, false);                    \
+            return;                                                                                                   \
+        }                                                                                                             \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                       \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                         \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                     \
@@ -947,13 +987,21 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_NBI);
      * @param signal            [in] The value used to update sig_addr.                                               \
      * @param sig_op            [in] Operation used to update sig_addr with signal. Supported operations:             \
      *                               SHMEM_SIGNAL_SET/SHMEM_SIGNAL_ADD                                                \
+     *                               Over RoCE SHMEM_SIGNAL_ADD is a blocking AMO, see shmem_putmem_signal_nbi.       \
      * @param pe                [in] PE number of the remote PE.                                                      \
      */                                                                                                               \
     SHMEM_DEVICE void shmem_put_##NAME##_mem_signal_nbi(AscendC::GlobalTensor<TYPE> dst,                              \
                                                         AscendC::GlobalTensor<TYPE> src, size_t elem_size,            \
                                                         __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe) \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                         \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                         \
+        auto device_state = shmemi_get_hot_state();                                                                   \
+        if (!(device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) &&                                                   \
+            (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE)) {                                                   \
+            /* RoCE */                                                                                                \
+            shmemi_roce_put_signal((__gm__ uint8_t *)dst.GetPhyAddr(), (__gm__ uint8_t *)src.GetPhyAddr(),            \
+                                   elem_size * sizeof(TYPE), sig_addr, signal, sig_op, pe, false);                    \
+            return;                                                                                                   \
+        }                                                                                                             \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                       \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                         \
         AscendC::LocalTensor<TYPE> ub_tensor;                                                                         \
@@ -986,7 +1034,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_TENSOR_NBI);
                                                         const non_contiguous_copy_param &copy_params,                 \
                                                         __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe) \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                         \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                         \
+        auto device_state = shmemi_get_hot_state();                                                                   \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                       \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                         \
         uint32_t copy_ub_size = device_state->mte_config.ub_size;                                                     \
@@ -1017,7 +1065,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_DETAILED_NBI);
         AscendC::GlobalTensor<TYPE> dst, AscendC::GlobalTensor<TYPE> src,                                           \
         const non_contiguous_copy_param &copy_params, __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe) \
     { /* ROCE */ /* RDMA */ /* MTE  */ /* Global State Set */                                                       \
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();                                       \
+        auto device_state = shmemi_get_hot_state();                                                                 \
         AscendC::TEventID copy_event_id = (AscendC::TEventID)device_state->mte_config.event_id;                     \
         uint64_t copy_ub = device_state->mte_config.shmem_ub;                                                       \
         AscendC::LocalTensor<TYPE> ub_tensor;                                                                       \
@@ -1048,4 +1096,144 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_TENSOR_DETAILED_NBI);
     }
 
 SHMEM_TEST_TYPE_FUNC(SHMEM_TEST);
+
+/*
+    Point-to-point waits over arrays of ivars, as in OpenSHMEM 1.5. Elements with a nonzero status entry are skipped,
+    status may be null. Flags packed in whole cache lines are polled one line at a time, see shmemi_device_p2p.h.
+*/
+
+// Upper bound, in system cycles, of the exponential backoff between empty polls of the wait APIs, 0 spins.
+#ifndef SHMEM_WAIT_BACKOFF_MAX
+#define SHMEM_WAIT_BACKOFF_MAX 0
+#endif
+
+#define SHMEM_WAIT_UNTIL(NAME, TYPE)                                                                                   \
+    /**                                                                                                                \
+     * @brief Wait until ivar satisfies the comparison with cmp_value.                                                 \
+     *                                                                                                                 \
+     * @param ivar               [in] Local address of the data object to be tested.                                   \
+     * @param cmp                [in] The comparison operator, SHMEM_CMP_EQ/NE/GT/GE/LT/LE.                            \
+     * @param cmp_value          [in] The value compared with the data objects.                                        \
+     */                                                                                                                \
+    SHMEM_DEVICE void shmem_##NAME##_wait_until(__gm__ TYPE *ivar, int cmp, TYPE cmp_value)                            \
+    {                                                                                                                  \
+        shmemi_wait_until(ivar, cmp, cmp_value);                                                                       \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEM_WAIT_UNTIL);
+
+#define SHMEM_WAIT_UNTIL_ALL(NAME, TYPE)                                                                               \
+    /**                                                                                                                \
+     * @brief Wait until all elements of ivars not excluded by status satisfy the comparison.                          \
+     *                                                                                                                 \
+     * @param ivars              [in] Local address of an array of nelems data objects.                                \
+     * @param nelems             [in] Number of elements in ivars.                                                     \
+     * @param status             [in] Local array of nelems, nonzero entries exclude elements. May be null.            \
+     * @param cmp                [in] The comparison operator, SHMEM_CMP_EQ/NE/GT/GE/LT/LE.                            \
+     * @param cmp_value          [in] The value compared with the data objects.                                        \
+     */                                                                                                                \
+    SHMEM_DEVICE void shmem_##NAME##_wait_until_all(                                                                   \
+        __gm__ TYPE *ivars, size_t nelems, const int *status, int cmp, TYPE cmp_value)                                 \
+    {                                                                                                                  \
+        shmemi_wait_until_all(ivars, nelems, status, cmp, cmp_value, 1, SHMEM_WAIT_BACKOFF_MAX);                       \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEM_WAIT_UNTIL_ALL);
+
+#define SHMEM_WAIT_UNTIL_ANY(NAME, TYPE)                                                                               \
+    /**                                                                                                                \
+     * @brief Wait until any element of ivars not excluded by status satisfies the comparison.                         \
+     *                                                                                                                 \
+     * @param ivars              [in] Local address of an array of nelems data objects.                                \
+     * @param nelems             [in] Number of elements in ivars.                                                     \
+     * @param status             [in] Local array of nelems, nonzero entries exclude elements. May be null.            \
+     * @param cmp                [in] The comparison operator, SHMEM_CMP_EQ/NE/GT/GE/LT/LE.                            \
+     * @param cmp_value          [in] The value compared with the data objects.                                        \
+     * @return Index of a satisfied element, SIZE_MAX if status excludes every element.                                \
+     */                                                                                                                \
+    SHMEM_DEVICE size_t shmem_##NAME##_wait_until_any(                                                                 \
+        __gm__ TYPE *ivars, size_t nelems, const int *status, int cmp, TYPE cmp_value)                                 \
+    {                                                                                                                  \
+        return shmemi_wait_until_any(ivars, nelems, status, cmp, cmp_value, 1, SHMEM_WAIT_BACKOFF_MAX);                \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEM_WAIT_UNTIL_ANY);
+
+#define SHMEM_WAIT_UNTIL_SOME(NAME, TYPE)                                                                              \
+    /**                                                                                                                \
+     * @brief Wait until some elements of ivars not excluded by status satisfy the comparison.                         \
+     *                                                                                                                 \
+     * @param ivars              [in] Local address of an array of nelems data objects.                                \
+     * @param nelems             [in] Number of elements in ivars.                                                     \
+     * @param indices            [out] Local array of nelems, receives indices of satisfied elements.                  \
+     * @param status             [in] Local array of nelems, nonzero entries exclude elements. May be null.            \
+     * @param cmp                [in] The comparison operator, SHMEM_CMP_EQ/NE/GT/GE/LT/LE.                            \
+     * @param cmp_value          [in] The value compared with the data objects.                                        \
+     * @return Number of indices written, 0 if status excludes every element.                                          \
+     */                                                                                                                \
+    SHMEM_DEVICE size_t shmem_##NAME##_wait_until_some(                                                                \
+        __gm__ TYPE *ivars, size_t nelems, size_t *indices, const int *status, int cmp, TYPE cmp_value)                \
+    {                                                                                                                  \
+        return shmemi_wait_until_some(ivars, nelems, indices, status, cmp, cmp_value, 1, SHMEM_WAIT_BACKOFF_MAX);      \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEM_WAIT_UNTIL_SOME);
+
+#define SHMEM_TEST_ALL(NAME, TYPE)                                                                                     \
+    /**                                                                                                                \
+     * @brief Test whether all elements of ivars not excluded by status satisfy the comparison.                        \
+     *                                                                                                                 \
+     * @param ivars              [in] Local address of an array of nelems data objects.                                \
+     * @param nelems             [in] Number of elements in ivars.                                                     \
+     * @param status             [in] Local array of nelems, nonzero entries exclude elements. May be null.            \
+     * @param cmp                [in] The comparison operator, SHMEM_CMP_EQ/NE/GT/GE/LT/LE.                            \
+     * @param cmp_value          [in] The value compared with the data objects.                                        \
+     * @return 1 if they all do, 0 otherwise.                                                                          \
+     */                                                                                                                \
+    SHMEM_DEVICE int shmem_##NAME##_test_all(                                                                          \
+        __gm__ TYPE *ivars, size_t nelems, const int *status, int cmp, TYPE cmp_value)                                 \
+    {                                                                                                                  \
+        return shmemi_test_all(ivars, nelems, status, cmp, cmp_value, 1);                                              \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEM_TEST_ALL);
+
+#define SHMEM_TEST_ANY(NAME, TYPE)                                                                                     \
+    /**                                                                                                                \
+     * @brief Test whether any element of ivars not excluded by status satisfies the comparison.                       \
+     *                                                                                                                 \
+     * @param ivars              [in] Local address of an array of nelems data objects.                                \
+     * @param nelems             [in] Number of elements in ivars.                                                     \
+     * @param status             [in] Local array of nelems, nonzero entries exclude elements. May be null.            \
+     * @param cmp                [in] The comparison operator, SHMEM_CMP_EQ/NE/GT/GE/LT/LE.                            \
+     * @param cmp_value          [in] The value compared with the data objects.                                        \
+     * @return Index of a satisfied element, SIZE_MAX if there is none.                                                \
+     */                                                                                                                \
+    SHMEM_DEVICE size_t shmem_##NAME##_test_any(                                                                       \
+        __gm__ TYPE *ivars, size_t nelems, const int *status, int cmp, TYPE cmp_value)                                 \
+    {                                                                                                                  \
+        return shmemi_test_any(ivars, nelems, status, cmp, cmp_value);                                                 \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEM_TEST_ANY);
+
+#define SHMEM_TEST_SOME(NAME, TYPE)                                                                                    \
+    /**                                                                                                                \
+     * @brief Find the elements of ivars not excluded by status that satisfy the comparison.                           \
+     *                                                                                                                 \
+     * @param ivars              [in] Local address of an array of nelems data objects.                                \
+     * @param nelems             [in] Number of elements in ivars.                                                     \
+     * @param indices            [out] Local array of nelems, receives indices of satisfied elements.                  \
+     * @param status             [in] Local array of nelems, nonzero entries exclude elements. May be null.            \
+     * @param cmp                [in] The comparison operator, SHMEM_CMP_EQ/NE/GT/GE/LT/LE.                            \
+     * @param cmp_value          [in] The value compared with the data objects.                                        \
+     * @return Number of indices written.                                                                              \
+     */                                                                                                                \
+    SHMEM_DEVICE size_t shmem_##NAME##_test_some(                                                                      \
+        __gm__ TYPE *ivars, size_t nelems, size_t *indices, const int *status, int cmp, TYPE cmp_value)                \
+    {                                                                                                                  \
+        return shmemi_test_some(ivars, nelems, indices, status, cmp, cmp_value);                                       \
+    }
+
+SHMEM_TEST_TYPE_FUNC(SHMEM_TEST_SOME);
 #endif
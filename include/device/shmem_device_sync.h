@@ -92,6 +92,42 @@ SHMEM_DEVICE void shmemx_barrier_all_vec()
     shmemx_barrier_vec(SHMEM_TEAM_WORLD);
 }
 
+/**
+ * @brief First half of a split-phase barrier over the vector cores of a team. Publishes the arrival of the calling PE
+ *        and returns without waiting for the other PEs, so that independent work can be done before completing the
+ *        barrier with shmemx_barrier_wait or shmemx_barrier_test. Must be called by all vector cores of the PE.
+ *
+ * @param tid              [in] team to do barrier
+ */
+SHMEM_DEVICE void shmemx_barrier_arrive(shmem_team_t tid)
+{
+    shmemi_barrier_arrive<true>(tid);
+}
+
+/**
+ * @brief Complete a split-phase barrier started by shmemx_barrier_arrive. Returns after all PEs in the team have
+ *        arrived, with the same guarantees as shmemx_barrier_vec. Must be called by all vector cores of the PE.
+ *
+ * @param tid              [in] team to do barrier
+ */
+SHMEM_DEVICE void shmemx_barrier_wait(shmem_team_t tid)
+{
+    shmemi_barrier_wait<true>(tid);
+}
+
+/**
+ * @brief Test a split-phase barrier started by shmemx_barrier_arrive without blocking. Vector core 0 makes progress
+ *        on the barrier, other cores report what it has observed, so core 0 must keep testing (or wait) until
+ *        completion. Once it returns 1 the barrier is complete and shmemx_barrier_wait is not needed.
+ *
+ * @param tid              [in] team to do barrier
+ * @return 1 if all PEs in the team have arrived, 0 otherwise.
+ */
+SHMEM_DEVICE int shmemx_barrier_test(shmem_team_t tid)
+{
+    return shmemi_barrier_test(tid);
+}
+
 /**
  * @brief The shmem_quiet routine ensures completion of all operations on symmetric data objects issued by the calling PE.
  *        On systems with only scale-up network (HCCS), updates are globally visible, whereas on systems with both scale-up network HCCS and scale-out network (RDMA), SHMEM only guarantees that updates to the memory of a given PE are visible to that PE.
@@ -12,6 +12,7 @@
 
 #include "host_device/shmem_types.h"
 #include "internal/host_device/shmemi_types.h"
+#include "internal/device/shmemi_device_team.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,7 +25,7 @@ extern "C" {
  */
 SHMEM_DEVICE int shmem_my_pe(void)
 {
-    return shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
+    return shmemi_get_my_pe();
 }
 
 /**
@@ -34,7 +35,33 @@ SHMEM_DEVICE int shmem_my_pe(void)
  */
 SHMEM_DEVICE int shmem_n_pes(void)
 {
-    return shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->size;
+    return shmemi_get_total_pe();
+}
+
+/**
+ * @brief Returns the version of the device state, bumped by the host whenever it publishes a change such as a team
+ *        creation or destruction. A kernel launched with the host value of shmemx_state_version can compare it to
+ *        detect a state that changed under it.
+ *
+ * @return Version of the device state.
+ */
+SHMEM_DEVICE uint64_t shmemx_state_version(void)
+{
+    __gm__ shmemi_device_host_state_t *state = shmemi_get_state();
+    // the host writes the state behind the scalar cache
+    dcci_cacheline((__gm__ uint8_t *)&state->state_version);
+    return state->state_version;
+}
+
+/**
+ * @brief Snapshots the read-mostly device state (PE, heap and MTE config, transport table addresses) into
+ *        block-local storage of the calling core. Only takes effect in translation units compiled with
+ *        SHMEM_DEVICE_STATE_CACHE defined before the SHMEM headers, where it must be called at kernel entry before
+ *        any RMA, since the block-local snapshot is not reset between kernels. A no-op otherwise.
+ */
+SHMEM_DEVICE void shmemx_state_cache_init(void)
+{
+    shmemi_state_cache_init();
 }
 
 /**
@@ -93,21 +120,67 @@ SHMEM_DEVICE int shmem_team_translate_pe(shmem_team_t src_team, int src_pe, shme
     shmemi_team_t *src_team_ptr = device_state->team_pools[src_team];
     shmemi_team_t *dest_team_ptr = device_state->team_pools[dest_team];
 
-    if (src_pe > src_team_ptr->size) {
+    if (src_pe < 0 || src_pe >= src_team_ptr->size) {
         return -1;
     }
 
-    int global_pe = src_team_ptr->start + src_pe * src_team_ptr->stride;
-    int pe_start = dest_team_ptr->start;
-    int pe_stride = dest_team_ptr->stride;
-    int pe_size = dest_team_ptr->size;
+    return shmemi_team_pe(dest_team_ptr, shmemi_team_global_pe(src_team_ptr, src_pe));
+}
 
-    int n = (global_pe - pe_start) / pe_stride;
-    if (global_pe < pe_start || (global_pe - pe_start) % pe_stride || n >= pe_size) {
-        return -1;
+/**
+ * @brief Returns the scratch of a team, zeroed symmetric memory the library holds for the team at the same offset
+ *        on every member. The host takes it on first use with shmemx_team_get_scratch. The scratch has a single
+ *        owner at a time, quantized collectives with a config work of 0 write their payload in it.
+ *
+ * @param team              [in] A team handle.
+ *
+ * @return Local address of the scratch, nullptr if the team holds none or the team handle is SHMEM_TEAM_INVALID.
+ */
+SHMEM_DEVICE __gm__ void *shmemx_team_scratch(shmem_team_t team)
+{
+    if (team == SHMEM_TEAM_INVALID) {
+        return nullptr;
     }
+    shmemi_team_t *team_ptr = shmemi_get_state()->team_pools[team];
+    return team_ptr != nullptr ? (__gm__ void *)team_ptr->scratch : nullptr;
+}
+
+/**
+ * @brief Returns the bytes of the scratch of a team.
+ *
+ * @param team              [in] A team handle.
+ *
+ * @return Size of the scratch, 0 if the team holds none or the team handle is SHMEM_TEAM_INVALID.
+ */
+SHMEM_DEVICE uint64_t shmemx_team_scratch_size(shmem_team_t team)
+{
+    if (team == SHMEM_TEAM_INVALID) {
+        return 0;
+    }
+    shmemi_team_t *team_ptr = shmemi_get_state()->team_pools[team];
+    return team_ptr != nullptr ? team_ptr->scratch_size : 0;
+}
 
-    return n;
+/**
+ * @brief Returns the next epoch of the calling vector core on a team, 1 on the first call after the team is
+ *        created. Every core taking one epoch per collective gets the same value as the cores of the other
+ *        members, so flags in the scratch tagged with it never match those left by an earlier collective.
+ *
+ * @param team              [in] A team handle.
+ *
+ * @return The epoch, or -1 if the team handle is SHMEM_TEAM_INVALID.
+ */
+SHMEM_DEVICE int32_t shmemx_team_epoch_next(shmem_team_t team)
+{
+    if (team == SHMEM_TEAM_INVALID) {
+        return -1;
+    }
+    auto epoch = shmemi_team_epoch(team);
+    int32_t next = shmemi_load(epoch) + 1;
+    shmemi_store(epoch, next);
+    // the host reads it behind the scalar cache in shmemx_team_scratch_stats
+    dcci_cacheline((__gm__ uint8_t *)epoch);
+    return next;
 }
 
 #ifdef __cplusplus
@@ -26,7 +26,7 @@
 SHMEM_DEVICE void shmemx_mte_get_mem_nbi(__gm__ int8_t* dst, __gm__ int8_t* src, uint32_t elem_size, int32_t pe, bool enable_L2)
 {
     /* Global State Get */
-    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto device_state = shmemi_get_hot_state();
     /* CopyUB Config Set */
     uint64_t copy_ub = device_state->mte_config.shmem_ub;
     uint32_t copy_ub_size = device_state->mte_config.ub_size;
@@ -46,7 +46,7 @@ SHMEM_DEVICE void shmemx_mte_get_mem_nbi(__gm__ int8_t* dst, __gm__ int8_t* src,
 SHMEM_DEVICE void shmemx_mte_put_mem_nbi(__gm__ int8_t* dst, __gm__ int8_t* src, uint32_t elem_size, int32_t pe, bool enable_L2)
 {
         /* Global State Get */
-        __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+        auto device_state = shmemi_get_hot_state();
         /* CopyUB Config Set */
         uint64_t copy_ub = device_state->mte_config.shmem_ub;
         uint32_t copy_ub_size = device_state->mte_config.ub_size;
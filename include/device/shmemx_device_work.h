@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMX_DEVICE_WORK_H
+#define SHMEMX_DEVICE_WORK_H
+
+#include "kernel_operator.h"
+#include "host/shmem_host_def.h"
+#include "internal/device/shmemi_device_work.h"
+
+/*
+    Submission from kernels to the persistent communication kernel of the calling PE, see shmemx_host_work.h. The
+    queue must have been started with SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS. A descriptor is submitted by one core,
+    the submitting kernel must not run on the cores reserved by the persistent kernel.
+*/
+
+/**
+ * @brief Submit an operation to the work queue of the calling PE, waiting for a free slot if the queue is full.
+ *
+ * @param desc              [in] Descriptor of the operation, copied into the queue.
+ * @return Ticket of the operation, ~0 if the queue is not running or does not take device producers.
+ */
+SHMEM_DEVICE uint64_t shmemx_work_submit(const shmemx_work_desc_t &desc)
+{
+    return shmemi_work_submit(desc);
+}
+
+/**
+ * @brief Wait until an operation of the work queue of the calling PE has completed, and so have all operations
+ *        submitted before it.
+ *
+ * @param ticket            [in] Ticket returned by shmemx_work_submit.
+ */
+SHMEM_DEVICE void shmemx_work_wait(uint64_t ticket)
+{
+    auto queue = (__gm__ shmemi_work_queue_t *)shmemi_get_state()->work_queue;
+    if (queue != nullptr && ticket != SHMEMI_WORK_INVALID_TICKET) {
+        shmemi_work_wait(queue, ticket);
+    }
+}
+
+#endif  // SHMEMX_DEVICE_WORK_H
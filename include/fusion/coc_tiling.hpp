@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_FUSION_COC_TILING_HPP
+#define SHMEM_FUSION_COC_TILING_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/*
+    Runtime tiling of the fused GEMM + communication (CoC) kernels, shared by the host, which fills it, and the
+    kernels, which take it by value. The kernels schedule GEMM tiles of m0 x n0 chosen at runtime, up to the L1 tile
+    their L1 buffers are compiled for, see CocTileShape. The K step k0 is that of the compiled tile, the host copies
+    it here so that both sides agree on it.
+
+    The AIC cores store pValue rounds of GEMM tiles, one tile per AIC core per round, into one of the two slots of
+    the symmetric workspace, then the AIV cores move that comm block while the AIC cores fill the other slot.
+    A comm block is cut into lenPerLoop-element sub-blocks spread over commNpuSplit x commDataSplit AIV cores, which
+    copy them ubMoveNum / 2 elements at a time through two ping-pong UB buffers.
+*/
+
+namespace Catlass::Fusion {
+
+// L1 tile the kernels are compiled for, fp32 takes half the tile of the 16-bit types
+struct CocTileShape {
+    uint32_t m;
+    uint32_t n;
+    uint32_t k;
+};
+constexpr CocTileShape COC_TILE_HALF = {128, 256, 256};
+constexpr CocTileShape COC_TILE_FLOAT = {128, 128, 128};
+
+// runtime m0 and n0 are multiples of the cube fractal
+constexpr uint32_t COC_TILE_ALIGN = 16;
+
+inline CocTileShape CocTileMax(size_t elemSize)
+{
+    return elemSize == sizeof(float) ? COC_TILE_FLOAT : COC_TILE_HALF;
+}
+
+struct CocTiling {
+    uint32_t m = 0;
+    uint32_t k = 0;
+    uint32_t n = 0;
+    uint32_t m0 = 128;                  // GEMM tile rows, capped by CocTilingSetTile
+    uint32_t k0 = 256;                  // K step of the compiled tile, set by CocTilingSetTile
+    uint32_t n0 = 256;                  // GEMM tile columns, capped by CocTilingSetTile
+    uint32_t swizzleDirect = 1;         // comm sub-block order, 0 Zn, 1 Nz
+    uint32_t swizzleOffset = 7;
+    uint32_t ubMoveNum = 16 * 1024;     // elements of both UB ping-pong buffers
+    uint32_t pValue = 3;                // GEMM rounds per comm block
+    uint32_t commNpuSplit = 2;          // AIV cores sharing the peers of a comm block
+    uint32_t commDataSplit = 1;         // AIV cores sharing the rows of a comm block
+    uint32_t lenPerLoop = 128 * 256 / 2;   // elements of a comm sub-block, a multiple of n0
+};
+
+// comm blocks are double buffered
+constexpr uint32_t COC_WORKSPACE_SLOTS = 2;
+
+// UB bytes a ping-pong buffer may take, the rest of the UB is left to the shmem internal buffers
+constexpr uint32_t COC_UB_BUFFER_MAX_BYTES = 64 * 1024;
+
+// bytes of the symmetric workspace of the kernels launched on blockNum AIC cores
+inline size_t CocWorkspaceBytes(const CocTiling &tiling, uint32_t blockNum, size_t elemSize)
+{
+    return static_cast<size_t>(tiling.m0) * tiling.n0 * blockNum * tiling.pValue * COC_WORKSPACE_SLOTS * elemSize;
+}
+
+// caps m0 x n0 at the compiled tile of elements of elemSize bytes, 0 takes the whole tile, and sets its K step
+inline void CocTilingSetTile(CocTiling &tiling, size_t elemSize)
+{
+    CocTileShape tile = CocTileMax(elemSize);
+    tiling.m0 = (tiling.m0 == 0 || tiling.m0 > tile.m) ? tile.m : tiling.m0;
+    tiling.n0 = (tiling.n0 == 0 || tiling.n0 > tile.n) ? tile.n : tiling.n0;
+    tiling.k0 = tile.k;
+}
+
+// whether the kernels can run the tiling on rankSize PEs, elemSize is the size of the output element
+inline bool CocTilingValid(const CocTiling &tiling, uint32_t rankSize, size_t elemSize)
+{
+    if (tiling.m == 0 || tiling.n == 0 || tiling.k == 0 || tiling.m0 == 0 || tiling.n0 == 0 || tiling.pValue == 0 ||
+        rankSize == 0) {
+        return false;
+    }
+    CocTileShape tile = CocTileMax(elemSize);
+    if (tiling.m0 > tile.m || tiling.n0 > tile.n || tiling.k0 != tile.k || tiling.m0 % COC_TILE_ALIGN != 0 ||
+        tiling.n0 % COC_TILE_ALIGN != 0) {
+        return false;
+    }
+    if (tiling.commNpuSplit == 0 || tiling.commDataSplit == 0 || rankSize % tiling.commNpuSplit != 0) {
+        return false;
+    }
+    if (tiling.lenPerLoop < tiling.n0 || tiling.lenPerLoop % tiling.n0 != 0) {
+        return false;
+    }
+    // a ping-pong buffer holds whole rows of a tile
+    return tiling.ubMoveNum / 2 >= tiling.n0 && tiling.ubMoveNum / 2 * elemSize <= COC_UB_BUFFER_MAX_BYTES;
+}
+
+// whether the rows split evenly over rankSize PEs in whole GEMM tiles, as GEMM-RS and AG-GEMM need
+inline bool CocRowSplitValid(const CocTiling &tiling, uint32_t rankSize)
+{
+    if (rankSize == 0 || tiling.m0 == 0 || tiling.m % rankSize != 0) {
+        return false;
+    }
+    return (tiling.m / rankSize) % tiling.m0 == 0;
+}
+
+}  // namespace Catlass::Fusion
+
+#endif  // SHMEM_FUSION_COC_TILING_HPP
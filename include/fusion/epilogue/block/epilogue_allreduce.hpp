@@ -7,8 +7,8 @@
  * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
  * See LICENSE in the root of the software repository for the full text of the License.
  */
-#ifndef _EPILOGUE_ALLREDUCE_HPP
-#define _EPILOGUE_ALLREDUCE_HPP
+#ifndef SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_ALLREDUCE_HPP
+#define SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_ALLREDUCE_HPP
 
 // from catlass
 #include "catlass/catlass.hpp"
@@ -18,40 +18,28 @@
 #include "catlass/matrix_coord.hpp"
 #include "catlass/layout/layout.hpp"
 
-// from kernel
-#include "epilogue/block/block_swizzle_dynamic.hpp"
+// from fusion
+#include "fusion/coc_tiling.hpp"
+#include "fusion/gemm/block/block_comm_swizzle.hpp"
+#include "fusion/epilogue/block/epilogue_comm.hpp"
 
 // from shmem-device
 #include "shmem_api.h"
 
-using namespace Catlass;
-
-CATLASS_DEVICE
-MatrixCoord GetActualShape(const MatrixCoord &blockCount, const MatrixCoord &blockCoord, const MatrixCoord &blockShape,
-                           const MatrixCoord &residue)
-{
-    MatrixCoord c = blockShape;
-
-    if ((residue.row() != 0) && (blockCoord.row() == blockCount.row() - 1)) {
-        c.row() = residue.row();
-    } else if (blockCoord.row() >= blockCount.row()) {
-        c.row() = 0;
-    }
-
-    if ((residue.column() != 0) && (blockCoord.column() == blockCount.column() - 1)) {
-        c.column() = residue.column();
-    } else if (blockCoord.column() >= blockCount.column()) {
-        c.column() = 0;
-    }
-    return c;
-}
-
 namespace Catlass::Epilogue::Block {
+
+/*
+    Allreduce of a comm block of GEMM tiles in the symmetric workspace. Reduce-scatter: every rank owns
+    1 / rankSize of the rows of the block and adds the same rows of every peer into its own workspace with MTE atomic
+    adds. Allgather: every rank copies the owned rows of every peer from their workspace to the destination, placing
+    each tile row back at its position in the output matrix. Ranks meet in a barrier before each phase and after
+    the last one, so the workspace slot is free again when the epilogue returns.
+*/
 template <class... Args>
 class EpilogueAllReduce {};
 
-template <class BlockScheduler_, class CommBlockSwizzle_>
-class EpilogueAllReduce<BlockScheduler_, CommBlockSwizzle_> {
+template <class ElementC_, class BlockScheduler_, class CommBlockSwizzle_>
+class EpilogueAllReduce<ElementC_, BlockScheduler_, CommBlockSwizzle_> {
 public:
     using BlockScheduler = BlockScheduler_;
     using CommBlockSwizzle = CommBlockSwizzle_;
@@ -59,16 +47,11 @@ public:
     // Type aliases
     using ArchTag = Arch::AtlasA2;
 
-    using ElementC = half;
-    using ElementAttachedSource = half;
-    using ElementAttachedOutput = half;
+    using ElementC = ElementC_;
+    using ElementDestination = ElementC;
 
     using LayoutStore = layout::RowMajor;
-
     using LayoutWorkspace = LayoutStore;
-
-    using ElementDestination = ElementAttachedOutput;
-
     using LayoutDestination = LayoutStore;
 
     using ScheduleTypeOp1 = typename Gemm::Block::ReduceScatterSchedule;
@@ -79,7 +62,7 @@ public:
         AscendC::GlobalTensor<ElementDestination> destination;
         LayoutDestination layoutDestination;
         int64_t strideDestination;
-        __gm__ ElementAttachedSource *symmetricPtr;
+        __gm__ ElementC *symmetricPtr;
         BlockScheduler gemmSwizzle;
         CommBlockSwizzle commSwizzle;
         MatrixCoord blockShape;
@@ -90,16 +73,16 @@ public:
 
         CATLASS_DEVICE
         Params(AscendC::GlobalTensor<ElementDestination> destination, const LayoutDestination &layoutDestination,
-               int64_t strideDestination, __gm__ ElementAttachedSource *symmetricPtr, MatrixCoord blockShape,
+               int64_t strideDestination, __gm__ ElementC *symmetricPtr, MatrixCoord blockShape,
                MatrixCoord processShape, BlockScheduler gemmSwizzle, CommBlockSwizzle commSwizzle)
             : destination(destination),
               layoutDestination(layoutDestination),
               strideDestination(strideDestination),
               symmetricPtr(symmetricPtr),
-              blockShape(blockShape),
-              processShape(processShape),
               gemmSwizzle(gemmSwizzle),
-              commSwizzle(commSwizzle)
+              commSwizzle(commSwizzle),
+              blockShape(blockShape),
+              processShape(processShape)
         {
         }
     };
@@ -125,11 +108,11 @@ public:
         int32_t aivIndex = AscendC::GetSubBlockIdx();
         auto loopNumPerComm = aicoreNum * pValue;
 
-        auto layoutPeerMemStore =
-            layout::RowMajor(blockShape.row() * loopNumPerComm * BufferNum, blockShape.column(), blockShape.column());
+        auto layoutPeerMemStore = layout::RowMajor(blockShape.row() * loopNumPerComm * Fusion::COC_WORKSPACE_SLOTS,
+                                                   blockShape.column(), blockShape.column());
 
         // re-sliced Block by comm cores
-        uint32_t flagIdx = calIdx % BufferNum;
+        uint32_t flagIdx = calIdx % Fusion::COC_WORKSPACE_SLOTS;
         MatrixCoord actualCommBlockShape = blockShape * actualCommBlockCount;
         MatrixCoord outputBlockOffset = blockShape * MatrixCoord{calIdx * loopNumPerComm, 0};
 
@@ -142,6 +125,7 @@ public:
 
         AscendC::GlobalTensor<ElementC> peerMem;
         peerMem.SetGlobalBuffer(params.symmetricPtr);
+        CommPingPongCopy<ArchTag, ElementC> copy(resource, params.processShape.row() * params.processShape.column());
 
         // Local matmul is completed, waiting until tasks on all devices are complete.
         shmemx_barrier_all_vec();
@@ -161,60 +145,24 @@ public:
                     continue;
                 }
 
-                auto offsetIn = blockOffset + rankBlockOffset;
-                auto offsetOut = blockOffset + rankBlockOffset;
-
+                auto offset = blockOffset + rankBlockOffset + subBlockOffset;
                 auto residueProcessShape = actualCommSubBlockShape % params.processShape;
                 MatrixCoord processCount = CeilDiv(actualCommSubBlockShape, params.processShape);
                 uint32_t processLoop = processCount.row() * processCount.column();
 
-                // [ReduceScatter] 1. Alloc TmpUB
-                int tmpBufferSize = 32 * 1024 / sizeof(ElementC);  // 32 KB
-                AscendC::LocalTensor<half> tmpBuffer1 = resource.ubBuf.template GetBufferByByte<ElementC>(0);
-                tmpBuffer1.SetSize(tmpBufferSize);
-                int tmpBufferOffset = 96 * 1024;  // half of UB
-                AscendC::LocalTensor<half> tmpBuffer2 =
-                    resource.ubBuf.template GetBufferByByte<ElementC>(tmpBufferOffset);
-                tmpBuffer2.SetSize(tmpBufferSize);
-
-                // [ReduceScatter] 2. Pre Interface Sync
-                AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
-                AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID1);
-                int pingpongId = 0;
-
+                // [ReduceScatter] the owned rows of the peer are added into the same rows of the local workspace
+                copy.Begin();
                 for (uint32_t processIndex = 0; processIndex < processLoop; ++processIndex) {
-                    AscendC::TEventID EVENT_ID = pingpongId == 0 ? EVENT_ID0 : EVENT_ID1;
-                    AscendC::LocalTensor<ElementC> buf = pingpongId == 0 ? tmpBuffer1 : tmpBuffer2;
-
                     MatrixCoord processCoord{processIndex / processCount.column(),
                                              processIndex % processCount.column()};
                     auto actualProcessShape =
                         GetActualShape(processCount, processCoord, params.processShape, residueProcessShape);
-
-                    auto processOffset = processCoord * params.processShape;
-
-                    auto inputOffset = offsetIn + subBlockOffset + processOffset;
-                    auto outputOffset = offsetOut + subBlockOffset + processOffset;
-
+                    int64_t elemOffset = layoutPeerMemStore.GetOffset(offset + processCoord * params.processShape);
                     uint32_t copySize = actualProcessShape.row() * actualProcessShape.column();
-
-                    int64_t inputElemOffset = layoutPeerMemStore.GetOffset(inputOffset);
-                    int64_t outputElemOffset = layoutPeerMemStore.GetOffset(outputOffset);
-
-                    // [ReduceScatter] 2. Pre Interface Sync
-                    AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID);
-
-                    // [ReduceScatter] 3. Start shmem_mte_get_mem_nbi
-                    shmem_mte_get_mem_nbi(peerMem[outputElemOffset], peerMem[inputElemOffset], buf, copySize,
-                                          mRankIdx % rankSize, EVENT_ID);
-
-                    // [ReduceScatter] 4. Post Interface Sync
-                    AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID);
-                    pingpongId = (pingpongId + 1) % BufferNum;
+                    copy(peerMem[elemOffset], peerMem[elemOffset], 1, copySize, copySize, copySize,
+                         mRankIdx % rankSize);
                 }
-                // [ReduceScatter] 4. Post Interface Sync
-                AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
-                AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID1);
+                copy.End();
             }
         }
 
@@ -244,20 +192,8 @@ public:
 
                 uint32_t processLoop = processCount.row() * processCount.column();
 
-                // [AllGather] 1. Alloc TmpUB
-                int tmpBufferSize = 32 * 1024 / sizeof(ElementC);  // 32 KB
-                AscendC::LocalTensor<half> tmpBuffer1 = resource.ubBuf.template GetBufferByByte<ElementC>(0);
-                tmpBuffer1.SetSize(tmpBufferSize);
-                int tmpBufferOffset = 96 * 1024;  // half of UB
-                AscendC::LocalTensor<half> tmpBuffer2 =
-                    resource.ubBuf.template GetBufferByByte<ElementC>(tmpBufferOffset);
-                tmpBuffer2.SetSize(tmpBufferSize);
-
-                // [AllGather] 2. Pre Interface Sync
-                AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
-                AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID1);
-                int pingpongId = 0;
-
+                // [AllGather] the reduced rows of the peer go back to their tiles in the destination
+                copy.Begin();
                 for (uint32_t processIndex = 0; processIndex < processLoop; ++processIndex) {
                     MatrixCoord processCoord{processIndex / processCount.column(),
                                              processIndex % processCount.column()};
@@ -268,6 +204,7 @@ public:
 
                     uint32_t residueM = actualProcessShape.row();
 
+                    // the rows of the sub-block may span several GEMM tiles, which are apart in the destination
                     while (residueM > 0) {
                         MatrixCoord outputLoopOffset = (offsetOut + processOffset + subBlockOffset) / gemmBlockShape;
                         MatrixCoord residueOutputOffset = (offsetOut + processOffset + subBlockOffset) % gemmBlockShape;
@@ -291,35 +228,15 @@ public:
                             int64_t inputElemOffset = layoutInput.GetOffset(inputOffset);
                             int64_t outputElemOffset = layoutOutput.GetOffset(outputOffset);
 
-                            uint32_t copySize = actualMoveShape.row() * actualMoveShape.column();
-
-                            AscendC::TEventID EVENT_ID = pingpongId == 0 ? EVENT_ID0 : EVENT_ID1;
-                            AscendC::LocalTensor<ElementC> buf = pingpongId == 0 ? tmpBuffer1 : tmpBuffer2;
-
-                            // [AllGather] 2. Pre Interface Sync
-                            AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID);
-
-                            non_contiguous_copy_param copyParams;
-                            copyParams.repeat = actualMoveShape.row();
-                            copyParams.length = actualMoveShape.column();
-                            copyParams.src_ld = layoutInput.stride(0);
-                            copyParams.dst_ld = layoutOutput.stride(0);
-
-                            // [AllGather] 3. Start shmem_mte_get_mem_nbi non-contiguous version
-                            shmem_mte_get_mem_nbi(params.destination[outputElemOffset], peerMem[inputElemOffset], buf,
-                                                  copyParams, mRankIdx % rankSize, EVENT_ID);
-
-                            // [AllGather] 4. Post Interface Sync
-                            AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID);
-                            pingpongId = (pingpongId + 1) % BufferNum;
+                            copy(params.destination[outputElemOffset], peerMem[inputElemOffset],
+                                 actualMoveShape.row(), actualMoveShape.column(), layoutInput.stride(0),
+                                 layoutOutput.stride(0), mRankIdx % rankSize);
                         }
                         residueM -= actualMoveM;
                         processOffset += MatrixCoord{actualMoveM, 0};
                     }
                 }
-                // [AllGather] 4. Post Interface Sync
-                AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
-                AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID1);
+                copy.End();
             }
         }
 
@@ -328,13 +245,11 @@ public:
     }
 
 private:
-    const static uint32_t BufferNum = 2;
-
-    MatrixCoord gemmBlockShape;
     Arch::Resource<ArchTag> &resource;
     Params params;
+    MatrixCoord gemmBlockShape;
 };
 
 }  // namespace Catlass::Epilogue::Block
 
-#endif  // _EPILOGUE_ALLREDUCE_HPP
\ No newline at end of file
+#endif  // SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_ALLREDUCE_HPP
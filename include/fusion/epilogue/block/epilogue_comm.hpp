@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_COMM_HPP
+#define SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_COMM_HPP
+
+// from catlass
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/matrix_coord.hpp"
+
+// from shmem-device
+#include "shmem_api.h"
+
+namespace Catlass::Epilogue::Block {
+
+// shape of block blockCoord of a grid of blockCount blocks of blockShape, the last row and column take the residue
+CATLASS_DEVICE
+MatrixCoord GetActualShape(const MatrixCoord &blockCount, const MatrixCoord &blockCoord, const MatrixCoord &blockShape,
+                           const MatrixCoord &residue)
+{
+    MatrixCoord c = blockShape;
+
+    if ((residue.row() != 0) && (blockCoord.row() == blockCount.row() - 1)) {
+        c.row() = residue.row();
+    } else if (blockCoord.row() >= blockCount.row()) {
+        c.row() = 0;
+    }
+
+    if ((residue.column() != 0) && (blockCoord.column() == blockCount.column() - 1)) {
+        c.column() = residue.column();
+    } else if (blockCoord.column() >= blockCount.column()) {
+        c.column() = 0;
+    }
+    return c;
+}
+
+/*
+    Copies tiles of a peer into local GM over MTE through two UB buffers of bufferElems elements at the start of the
+    UB, so that the MTE2 read of a tile overlaps the MTE3 write of the previous one. Copies are issued between Begin
+    and End, each of at most bufferElems elements.
+*/
+template <class ArchTag, class Element>
+class CommPingPongCopy {
+public:
+    CATLASS_DEVICE
+    CommPingPongCopy(Arch::Resource<ArchTag> &resource, uint32_t bufferElems)
+    {
+        for (uint32_t i = 0; i < BUFFER_NUM; ++i) {
+            buf[i] = resource.ubBuf.template GetBufferByByte<Element>(i * bufferElems * sizeof(Element));
+            buf[i].SetSize(bufferElems);
+        }
+    }
+
+    CATLASS_DEVICE
+    void Begin()
+    {
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID1);
+        pingpongId = 0;
+    }
+
+    CATLASS_DEVICE
+    void End()
+    {
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID1);
+    }
+
+    // rows x cols elements of the symmetric src on pe to the local dst, rows stride srcLd and dstLd elements apart
+    CATLASS_DEVICE
+    void operator()(AscendC::GlobalTensor<Element> const &dst, AscendC::GlobalTensor<Element> const &src,
+                    uint32_t rows, uint32_t cols, uint32_t srcLd, uint32_t dstLd, int pe)
+    {
+        AscendC::TEventID eventId = pingpongId == 0 ? EVENT_ID0 : EVENT_ID1;
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(eventId);
+        if (srcLd == cols && dstLd == cols) {
+            shmem_mte_get_mem_nbi(dst, src, buf[pingpongId], rows * cols, pe, eventId);
+        } else {
+            non_contiguous_copy_param copyParams;
+            copyParams.repeat = rows;
+            copyParams.length = cols;
+            copyParams.src_ld = srcLd;
+            copyParams.dst_ld = dstLd;
+            shmem_mte_get_mem_nbi(dst, src, buf[pingpongId], copyParams, pe, eventId);
+        }
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(eventId);
+        pingpongId = (pingpongId + 1) % BUFFER_NUM;
+    }
+
+private:
+    static constexpr uint32_t BUFFER_NUM = 2;
+
+    AscendC::LocalTensor<Element> buf[BUFFER_NUM];
+    uint32_t pingpongId = 0;
+};
+
+}  // namespace Catlass::Epilogue::Block
+
+#endif  // SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_COMM_HPP
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_REDUCE_SCATTER_HPP
+#define SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_REDUCE_SCATTER_HPP
+
+// from catlass
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/matrix_coord.hpp"
+#include "catlass/layout/layout.hpp"
+
+// from fusion
+#include "fusion/coc_tiling.hpp"
+#include "fusion/epilogue/block/epilogue_comm.hpp"
+
+// from shmem-device
+#include "shmem_api.h"
+
+namespace Catlass::Epilogue::Block {
+
+/*
+    Reduce-scatter of a comm block of GEMM tiles in the symmetric workspace, rank r ends with rows
+    [r * mPerRank, (r + 1) * mPerRank) of the sum of the GEMM outputs of all ranks. mPerRank is a multiple of the
+    tile height, so every tile has one owner, and the AIV cores of the owner pull the tile from every rank into the
+    destination: the local tile is copied, the tiles of the peers are added with MTE atomic adds. Ranks meet in a
+    barrier before and after, so the workspace slot is free again when the epilogue returns.
+*/
+template <class... Args>
+class EpilogueReduceScatter {};
+
+template <class ElementC_, class BlockScheduler_>
+class EpilogueReduceScatter<ElementC_, BlockScheduler_> {
+public:
+    using BlockScheduler = BlockScheduler_;
+
+    using ArchTag = Arch::AtlasA2;
+
+    using ElementC = ElementC_;
+    using ElementDestination = ElementC;
+
+    using LayoutWorkspace = layout::RowMajor;
+    using LayoutDestination = layout::RowMajor;
+
+    struct Params {
+        AscendC::GlobalTensor<ElementDestination> destination;
+        LayoutDestination layoutDestination;    // mPerRank x n
+        __gm__ ElementC *symmetricPtr;
+        BlockScheduler gemmSwizzle;
+        MatrixCoord processShape;
+        uint32_t mPerRank;
+
+        CATLASS_DEVICE
+        Params() = default;
+
+        CATLASS_DEVICE
+        Params(AscendC::GlobalTensor<ElementDestination> destination, const LayoutDestination &layoutDestination,
+               __gm__ ElementC *symmetricPtr, BlockScheduler gemmSwizzle, MatrixCoord processShape,
+               uint32_t mPerRank)
+            : destination(destination),
+              layoutDestination(layoutDestination),
+              symmetricPtr(symmetricPtr),
+              gemmSwizzle(gemmSwizzle),
+              processShape(processShape),
+              mPerRank(mPerRank)
+        {
+        }
+    };
+
+    CATLASS_DEVICE
+    EpilogueReduceScatter(Arch::Resource<ArchTag> &resource, Params const &params, const GemmCoord &blockGemmShape)
+        : resource(resource), params(params), gemmBlockShape(blockGemmShape.m(), blockGemmShape.n())
+    {
+    }
+
+    CATLASS_DEVICE
+    void operator()(MatrixCoord const &blockShape, MatrixCoord const &commBlockCount,
+                    MatrixCoord const &actualCommBlockCount, uint32_t calIdx, uint32_t rankIdx, uint32_t rankSize,
+                    uint32_t pValue)
+    {
+        uint32_t aivIndex = AscendC::GetBlockIdx();
+        uint32_t aivNum = AscendC::GetBlockNum() * AscendC::GetSubBlockNum();
+        uint32_t loopNumPerComm = AscendC::GetBlockNum() * pValue;
+        uint32_t slotIdx = calIdx % Fusion::COC_WORKSPACE_SLOTS;
+
+        auto layoutWorkspace = layout::RowMajor(gemmBlockShape.row() * loopNumPerComm * Fusion::COC_WORKSPACE_SLOTS,
+                                                gemmBlockShape.column(), gemmBlockShape.column());
+        AscendC::GlobalTensor<ElementC> peerMem;
+        peerMem.SetGlobalBuffer(params.symmetricPtr);
+        CommPingPongCopy<ArchTag, ElementC> copy(resource, params.processShape.row() * params.processShape.column());
+
+        // Local matmul is completed, waiting until tasks on all devices are complete.
+        shmemx_barrier_all_vec();
+
+        for (uint32_t tileIdx = aivIndex; tileIdx < actualCommBlockCount.row(); tileIdx += aivNum) {
+            uint32_t loopIdx = calIdx * loopNumPerComm + tileIdx;
+            GemmCoord tileCoord = params.gemmSwizzle.GetBlockCoord(loopIdx);
+            GemmCoord tileShape = params.gemmSwizzle.GetActualBlockShape(tileCoord);
+            uint32_t rowStart = tileCoord.m() * gemmBlockShape.row();
+            if (rowStart / params.mPerRank != rankIdx) {
+                continue;
+            }
+
+            MatrixCoord workspaceOffset{(slotIdx * loopNumPerComm + tileIdx) * gemmBlockShape.row(), 0};
+            MatrixCoord outputOffset{rowStart - rankIdx * params.mPerRank, tileCoord.n() * gemmBlockShape.column()};
+            uint32_t rowsPerCopy = params.processShape.row();
+
+            for (uint32_t step = 0; step < rankSize; ++step) {
+                if (step == 1) {
+                    // the local tile is in place, the peers add onto it
+                    AscendC::SetFlag<AscendC::HardEvent::MTE3_S>(EVENT_ID0);
+                    AscendC::WaitFlag<AscendC::HardEvent::MTE3_S>(EVENT_ID0);
+                    AscendC::SetAtomicAdd<ElementC>();
+                    AscendC::PipeBarrier<PIPE_ALL>();
+                }
+                copy.Begin();
+                for (uint32_t row = 0; row < tileShape.m(); row += rowsPerCopy) {
+                    uint32_t rows = min(rowsPerCopy, tileShape.m() - row);
+                    int64_t inputElemOffset = layoutWorkspace.GetOffset(workspaceOffset + MatrixCoord{row, 0});
+                    int64_t outputElemOffset = params.layoutDestination.GetOffset(outputOffset + MatrixCoord{row, 0});
+                    copy(params.destination[outputElemOffset], peerMem[inputElemOffset], rows, tileShape.n(),
+                         layoutWorkspace.stride(0), params.layoutDestination.stride(0), (rankIdx + step) % rankSize);
+                }
+                copy.End();
+            }
+            AscendC::SetFlag<AscendC::HardEvent::MTE3_S>(EVENT_ID0);
+            AscendC::WaitFlag<AscendC::HardEvent::MTE3_S>(EVENT_ID0);
+            AscendC::SetAtomicNone();
+            AscendC::PipeBarrier<PIPE_ALL>();
+        }
+
+        // Peers are done with the local workspace slot.
+        shmemx_barrier_all_vec();
+    }
+
+private:
+    Arch::Resource<ArchTag> &resource;
+    Params params;
+    MatrixCoord gemmBlockShape;
+};
+
+}  // namespace Catlass::Epilogue::Block
+
+#endif  // SHMEM_FUSION_EPILOGUE_BLOCK_EPILOGUE_REDUCE_SCATTER_HPP
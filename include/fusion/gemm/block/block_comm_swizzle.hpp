@@ -7,7 +7,9 @@
  * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
  * See LICENSE in the root of the software repository for the full text of the License.
  */
-#pragma once
+#ifndef SHMEM_FUSION_GEMM_BLOCK_COMM_SWIZZLE_HPP
+#define SHMEM_FUSION_GEMM_BLOCK_COMM_SWIZZLE_HPP
+
 #include "catlass/catlass.hpp"
 #include "catlass/detail/alignment.hpp"
 #include "catlass/gemm_coord.hpp"
@@ -19,6 +21,13 @@ struct ReduceScatterSchedule {};
 struct AllGatherSchedule {};
 struct AllReduceSchedule {};
 
+/*
+    Order in which the AIV cores walk the sub-blocks of a comm block. The comm block is cut into mLoops rows of
+    sub-blocks by rankSize ranks, each rank owning problemSize / rankSize rows for the reduce-scatter phase, and the
+    sub-block (mIdx, nIdx) pairs row mIdx with peer nIdx. Zn walks swizzleOffset rows for every peer before moving on,
+    Nz walks swizzleOffset peers for every row, and both rotate the peer by the row so that the AIV cores do not all
+    read the same peer at once.
+*/
 struct CommBlockSwizzleDynamic {
 
     ///
@@ -43,8 +52,8 @@ struct CommBlockSwizzleDynamic {
     CommBlockSwizzleDynamic() {}
 
     CATLASS_DEVICE
-    CommBlockSwizzleDynamic(MatrixCoord blockShape_, uint32_t rankIdx_, uint32_t rankSize_, uint32_t swizzleDirection_ = 0,
-        uint32_t commDataSplit_ = 1, uint32_t commNpuSplit_ = 1)
+    CommBlockSwizzleDynamic(MatrixCoord blockShape_, uint32_t rankIdx_, uint32_t rankSize_,
+        uint32_t swizzleDirection_ = 0, uint32_t commDataSplit_ = 1, uint32_t commNpuSplit_ = 1)
         : blockShape(blockShape_), rankIdx(rankIdx_), rankSize(rankSize_), swizzleDirection(swizzleDirection_),
           commDataSplit(commDataSplit_), commNpuSplit(commNpuSplit_)
     {
@@ -166,4 +175,4 @@ struct CommBlockSwizzleDynamic {
 
 }  // namespace Catlass::Gemm::Block
 
-   
\ No newline at end of file
+#endif  // SHMEM_FUSION_GEMM_BLOCK_COMM_SWIZZLE_HPP
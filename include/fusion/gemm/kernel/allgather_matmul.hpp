@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_FUSION_GEMM_KERNEL_ALLGATHER_MATMUL_HPP
+#define SHMEM_FUSION_GEMM_KERNEL_ALLGATHER_MATMUL_HPP
+
+// from catlass
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/arch/cross_core_sync.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/matrix_coord.hpp"
+#include "catlass/layout/layout.hpp"
+
+// from fusion
+#include "fusion/coc_tiling.hpp"
+#include "fusion/epilogue/block/epilogue_comm.hpp"
+
+// from shmem-device
+#include "shmem_api.h"
+
+namespace Catlass::Gemm::Kernel {
+
+/*
+    C = allgather(A) x B, every rank holds an mPerRank x k slab of A in symmetric memory and gets the full m x n C.
+    Slabs are consumed in ring order starting with the local one: while the AIC cores multiply slab s, the AIV cores
+    pull slab s + 1 from its owner into gatheredA, which ends up holding the gathered A. Gathered slabs are announced
+    to the AIC cores through two cross-core flags used alternately, the AIC cores hand them back so that neither runs
+    more than two slabs ahead of the other.
+*/
+template <
+    class BlockMmad_,
+    class BlockScheduler_
+>
+class AllGatherMatmul {
+public:
+    using BlockMmad = BlockMmad_;
+    using ArchTag = typename BlockMmad::ArchTag;
+    using L1TileShape = typename BlockMmad::L1TileShape;
+    using ElementA = typename BlockMmad::ElementA;
+    using LayoutA = typename BlockMmad::LayoutA;
+    using ElementB = typename BlockMmad::ElementB;
+    using LayoutB = typename BlockMmad::LayoutB;
+    using ElementC = typename BlockMmad::ElementC;
+    using LayoutC = typename BlockMmad::LayoutC;
+
+    using BlockScheduler = BlockScheduler_;
+
+    /// Parameters structure
+    struct Params {
+        // Data members
+        GemmCoord problemShape;     // mPerRank x n x k
+        GemmCoord blockShape;       // GEMM tile, no larger than the L1 tile of BlockMmad
+        uint32_t rankIdx;
+        uint32_t rankSize;
+        uint32_t copyElems;         // elements of a UB ping-pong buffer
+
+        GM_ADDR ptrA;               // symmetric, mPerRank x k
+        LayoutA layoutA;
+        GM_ADDR ptrB;
+        LayoutB layoutB;
+        GM_ADDR ptrGatheredA;       // rankSize * mPerRank x k
+        GM_ADDR ptrC;               // rankSize * mPerRank x n
+        LayoutC layoutC;
+
+        // Methods
+        CATLASS_DEVICE
+        Params() {}
+
+        CATLASS_DEVICE
+        Params(
+            GemmCoord const &problemShape_, GemmCoord const &blockShape_,
+            uint32_t rank_, uint32_t rankSize_, uint32_t copyElems_,
+            GM_ADDR ptrA_, LayoutA const &layoutA_,
+            GM_ADDR ptrB_, LayoutB const &layoutB_,
+            GM_ADDR ptrGatheredA_,
+            GM_ADDR ptrC_, LayoutC const &layoutC_
+        ) : problemShape(problemShape_), blockShape(blockShape_),
+            rankIdx(rank_), rankSize(rankSize_), copyElems(copyElems_),
+            ptrA(ptrA_), layoutA(layoutA_),
+            ptrB(ptrB_), layoutB(layoutB_),
+            ptrGatheredA(ptrGatheredA_),
+            ptrC(ptrC_), layoutC(layoutC_) {}
+    };
+
+    // Methods
+    CATLASS_DEVICE
+    AllGatherMatmul()
+    {
+        for (uint32_t i = 0; i < Fusion::COC_WORKSPACE_SLOTS; ++i) {
+            flagAivGathered[i] = Arch::CrossCoreFlag(i);
+            flagAicConsumed[i] = Arch::CrossCoreFlag(i);
+        }
+    }
+
+    template <int32_t CORE_TYPE = g_coreType>
+    CATLASS_DEVICE
+    void operator()(Params &params);
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIC>(Params &params)
+    {
+        BlockScheduler matmulBlockScheduler(params.problemShape,
+                                            MakeCoord(params.blockShape.m(), params.blockShape.n()));
+        uint32_t coreLoops = matmulBlockScheduler.GetCoreLoops();
+
+        BlockMmad blockMmad(resource);
+
+        uint32_t aicoreIndex = AscendC::GetBlockIdx();
+        uint32_t aicoreNum = AscendC::GetBlockNum();
+        uint32_t mPerRank = params.problemShape.m();
+        uint32_t k = params.problemShape.k();
+
+        AscendC::GlobalTensor<ElementA> gmLocalA;
+        gmLocalA.SetGlobalBuffer((__gm__ ElementA *)params.ptrA);
+        AscendC::GlobalTensor<ElementA> gmGatheredA;
+        gmGatheredA.SetGlobalBuffer((__gm__ ElementA *)params.ptrGatheredA);
+        AscendC::GlobalTensor<ElementB> gmB;
+        gmB.SetGlobalBuffer((__gm__ ElementB *)params.ptrB);
+        AscendC::GlobalTensor<ElementC> gmC;
+        gmC.SetGlobalBuffer((__gm__ ElementC *)params.ptrC);
+
+        for (uint32_t slabIdx = 0; slabIdx < params.rankSize; ++slabIdx) {
+            uint32_t peer = (params.rankIdx + slabIdx) % params.rankSize;
+            uint32_t flagIdx = slabIdx % Fusion::COC_WORKSPACE_SLOTS;
+            // the local slab is read in place, the others once the AIV cores have gathered them
+            AscendC::GlobalTensor<ElementA> gmA = gmLocalA;
+            if (slabIdx > 0) {
+                Arch::CrossCoreWaitFlag(flagAivGathered[flagIdx]);
+                gmA = gmGatheredA[static_cast<int64_t>(peer) * mPerRank * k];
+            }
+
+            for (uint32_t loopIdx = aicoreIndex; loopIdx < coreLoops; loopIdx += aicoreNum) {
+                // Compute block location
+                GemmCoord blockCoord = matmulBlockScheduler.GetBlockCoord(loopIdx);
+                GemmCoord actualBlockShape = matmulBlockScheduler.GetActualBlockShape(blockCoord);
+
+                // Compute initial location in logical coordinates
+                MatrixCoord offsetA{blockCoord.m() * params.blockShape.m(), blockCoord.k() * L1TileShape::K};
+                MatrixCoord offsetB{blockCoord.k() * L1TileShape::K, blockCoord.n() * params.blockShape.n()};
+                MatrixCoord offsetC{peer * mPerRank + blockCoord.m() * params.blockShape.m(),
+                                    blockCoord.n() * params.blockShape.n()};
+                int64_t gmOffsetA = params.layoutA.GetOffset(offsetA);
+                int64_t gmOffsetB = params.layoutB.GetOffset(offsetB);
+                int64_t gmOffsetC = params.layoutC.GetOffset(offsetC);
+
+                // Compute block-scoped matrix multiply-add
+                blockMmad(
+                    gmA[gmOffsetA], params.layoutA,
+                    gmB[gmOffsetB], params.layoutB,
+                    gmC[gmOffsetC], params.layoutC,
+                    actualBlockShape);
+            }
+
+            // the AIV cores wait for it before announcing slab slabIdx + 2
+            if (slabIdx >= 1 && slabIdx + Fusion::COC_WORKSPACE_SLOTS < params.rankSize) {
+                Arch::CrossCoreSetFlag<0x2, PIPE_FIX>(flagAicConsumed[flagIdx]);
+            }
+        }
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIV>(Params &params)
+    {
+        uint32_t aivIndex = AscendC::GetBlockIdx();
+        uint32_t aivNum = AscendC::GetBlockNum() * AscendC::GetSubBlockNum();
+        uint64_t slabElems = static_cast<uint64_t>(params.problemShape.m()) * params.problemShape.k();
+
+        // split a slab over the AIV cores in 32-byte aligned pieces
+        constexpr uint32_t alignElems = 32 / sizeof(ElementA);
+        uint64_t pieceElems = (slabElems + aivNum - 1) / aivNum;
+        pieceElems = (pieceElems + alignElems - 1) / alignElems * alignElems;
+        uint64_t pieceStart = pieceElems * aivIndex;
+        uint64_t pieceLen = pieceStart < slabElems ? min(pieceElems, slabElems - pieceStart) : 0;
+
+        AscendC::GlobalTensor<ElementA> gmA;
+        gmA.SetGlobalBuffer((__gm__ ElementA *)params.ptrA);
+        AscendC::GlobalTensor<ElementA> gmGatheredA;
+        gmGatheredA.SetGlobalBuffer((__gm__ ElementA *)params.ptrGatheredA);
+        Epilogue::Block::CommPingPongCopy<ArchTag, ElementA> copy(resource, params.copyElems);
+
+        // A of all ranks is ready
+        shmemx_barrier_all_vec();
+
+        for (uint32_t slabIdx = 0; slabIdx < params.rankSize; ++slabIdx) {
+            uint32_t peer = (params.rankIdx + slabIdx) % params.rankSize;
+            uint32_t flagIdx = slabIdx % Fusion::COC_WORKSPACE_SLOTS;
+
+            if (pieceLen > 0) {
+                int64_t dstOffset = static_cast<int64_t>(peer * slabElems + pieceStart);
+                copy.Begin();
+                uint32_t len = static_cast<uint32_t>(pieceLen);
+                copy(gmGatheredA[dstOffset], gmA[pieceStart], 1, len, len, len, peer);
+                copy.End();
+            }
+            if (slabIdx == 0) {
+                // the AIC cores read the local slab in place
+                continue;
+            }
+
+            // the slab is complete once every AIV core of the device has copied its piece
+            AscendC::PipeBarrier<PIPE_ALL>();
+            shmemi_barrier_core<true>();
+            if (slabIdx > Fusion::COC_WORKSPACE_SLOTS) {
+                Arch::CrossCoreWaitFlag(flagAicConsumed[flagIdx]);
+            }
+            Arch::CrossCoreSetFlag<0x2, PIPE_MTE3>(flagAivGathered[flagIdx]);
+        }
+
+        // Peers are done reading the local A.
+        shmemx_barrier_all_vec();
+    }
+
+private:
+    // ID used for inter-core synchronization
+    Arch::CrossCoreFlag flagAivGathered[Fusion::COC_WORKSPACE_SLOTS];
+    Arch::CrossCoreFlag flagAicConsumed[Fusion::COC_WORKSPACE_SLOTS];
+    Arch::Resource<ArchTag> resource;
+};
+
+} // namespace Catlass::Gemm::Kernel
+
+#endif // SHMEM_FUSION_GEMM_KERNEL_ALLGATHER_MATMUL_HPP
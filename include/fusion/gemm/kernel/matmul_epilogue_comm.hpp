@@ -7,8 +7,8 @@
  * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
  * See LICENSE in the root of the software repository for the full text of the License.
  */
-#ifndef CATLASS_GEMM_KERNEL_MATMUL_EPILOGUE_COMM_HPP
-#define CATLASS_GEMM_KERNEL_MATMUL_EPILOGUE_COMM_HPP
+#ifndef SHMEM_FUSION_GEMM_KERNEL_MATMUL_EPILOGUE_COMM_HPP
+#define SHMEM_FUSION_GEMM_KERNEL_MATMUL_EPILOGUE_COMM_HPP
 
 // from catlass
 #include "catlass/catlass.hpp"
@@ -17,11 +17,17 @@
 #include "catlass/gemm_coord.hpp"
 #include "catlass/matrix_coord.hpp"
 
-// from kernel
-#include "epilogue/block/epilogue_allreduce.hpp"
-#include "epilogue/block/block_swizzle_dynamic.hpp"
+// from fusion
+#include "fusion/coc_tiling.hpp"
+#include "fusion/epilogue/block/epilogue_comm.hpp"
 
 namespace Catlass::Gemm::Kernel {
+
+/*
+    AIC cores run the GEMM tile by tile into the symmetric workspace, pValue rounds per comm block, AIV cores run
+    BlockEpilogue on each comm block as soon as it is stored. The workspace holds COC_WORKSPACE_SLOTS comm blocks, so
+    the GEMM of the next block overlaps the communication of the current one.
+*/
 template <
     class BlockMmad_,
     class BlockEpilogue_,
@@ -85,7 +91,7 @@ public:
     CATLASS_DEVICE
     MatmulEpilogueComm()
     {
-        for (uint32_t i = 0; i < BufferNum; ++i) {
+        for (uint32_t i = 0; i < Fusion::COC_WORKSPACE_SLOTS; ++i) {
             flagAicFinishStore[i] = Arch::CrossCoreFlag(i);
             flagAivFinishCompute[i] = Arch::CrossCoreFlag(i);
         }
@@ -99,7 +105,9 @@ public:
     CATLASS_DEVICE
     void operator()<AscendC::AIC>(Params &params)
     {
-        BlockScheduler matmulBlockScheduler(params.problemShape, MakeCoord(L1TileShape::M, L1TileShape::N));
+        // tiles of blockShape, no larger than the L1 tile of BlockMmad
+        BlockScheduler matmulBlockScheduler(params.problemShape,
+                                            MakeCoord(params.blockShape.m(), params.blockShape.n()));
         uint32_t coreLoops = matmulBlockScheduler.GetCoreLoops();
 
         BlockMmad blockMmad(resource);
@@ -121,7 +129,7 @@ public:
         uint32_t commCoreLoops = CeilDiv(coreLoops, blockPerComm) * blockPerComm;
 
         auto layoutC = layout::RowMajor{
-            params.blockShape.m() * blockPerComm * BufferNum,
+            params.blockShape.m() * blockPerComm * Fusion::COC_WORKSPACE_SLOTS,
             params.blockShape.n(),
             params.blockShape.n()
         };
@@ -129,10 +137,10 @@ public:
         for (uint32_t loopIdx = aicoreIndex; loopIdx < commCoreLoops; loopIdx += AscendC::GetBlockNum()) {
             uint32_t commIdx = loopIdx / blockPerComm;
             uint32_t blockLoopIdx = loopIdx / aicoreNum;
-            uint32_t bufferIdx = commIdx % BufferNum;
+            uint32_t bufferIdx = commIdx % Fusion::COC_WORKSPACE_SLOTS;
             uint32_t pIdx = blockLoopIdx % params.pValue;
 
-            if (pIdx == 0 && commIdx >= BufferNum) {
+            if (pIdx == 0 && commIdx >= Fusion::COC_WORKSPACE_SLOTS) {
                 Arch::CrossCoreWaitFlag(flagAivFinishCompute[bufferIdx]);
             }
 
@@ -142,9 +150,9 @@ public:
                 GemmCoord actualBlockShape = matmulBlockScheduler.GetActualBlockShape(blockCoord);
 
                 // Compute initial location in logical coordinates
-                MatrixCoord offsetA{blockCoord.m() * L1TileShape::M, blockCoord.k() * L1TileShape::K};
-                MatrixCoord offsetB{blockCoord.k() * L1TileShape::K, blockCoord.n() * L1TileShape::N};
-                MatrixCoord offsetC{loopIdx % (blockPerComm * BufferNum) * L1TileShape::M, 0};
+                MatrixCoord offsetA{blockCoord.m() * params.blockShape.m(), blockCoord.k() * L1TileShape::K};
+                MatrixCoord offsetB{blockCoord.k() * L1TileShape::K, blockCoord.n() * params.blockShape.n()};
+                MatrixCoord offsetC{loopIdx % (blockPerComm * Fusion::COC_WORKSPACE_SLOTS) * params.blockShape.m(), 0};
                 int64_t gmOffsetA = params.layoutA.GetOffset(offsetA);
                 int64_t gmOffsetB = params.layoutB.GetOffset(offsetB);
                 int64_t gmOffsetC = layoutC.GetOffset(offsetC);
@@ -167,7 +175,7 @@ public:
     CATLASS_DEVICE
     void operator()<AscendC::AIV>(Params &params)
     {
-        BlockEpilogue blockAllReduceEpilogue(resource, params.epilogueParams, params.blockShape);
+        BlockEpilogue blockEpilogue(resource, params.epilogueParams, params.blockShape);
 
         uint32_t aicoreNum = AscendC::GetBlockNum();
         auto loopNumPerComm = aicoreNum * params.pValue;
@@ -180,9 +188,9 @@ public:
         MatrixCoord blockShape{params.blockShape.m(), params.blockShape.n()};
 
         for (uint32_t calIdx = 0; calIdx < commLoops.row() * commLoops.column(); ++calIdx) {
-            uint32_t flagIdx = calIdx % BufferNum;
+            uint32_t flagIdx = calIdx % Fusion::COC_WORKSPACE_SLOTS;
             MatrixCoord commLoopsCoord{calIdx, 0};
-            MatrixCoord actualCommBlockCount = GetActualShape(
+            MatrixCoord actualCommBlockCount = Epilogue::Block::GetActualShape(
                 commLoops,
                 commLoopsCoord,
                 commBlockCount,
@@ -192,7 +200,8 @@ public:
             // wait aic
             Arch::CrossCoreWaitFlag(flagAicFinishStore[flagIdx]);
 
-            blockAllReduceEpilogue(blockShape, commBlockCount, actualCommBlockCount, calIdx, params.rankIdx, params.rankSize, params.pValue);
+            blockEpilogue(blockShape, commBlockCount, actualCommBlockCount, calIdx, params.rankIdx, params.rankSize,
+                params.pValue);
 
             // set aic
             Arch::CrossCoreSetFlag<0x2, PIPE_MTE3>(flagAivFinishCompute[flagIdx]);
@@ -201,14 +210,12 @@ public:
     }
 
 private:
-    const static uint32_t BufferNum = 2;
-
     // ID used for inter-core synchronization
-    Arch::CrossCoreFlag flagAicFinishStore[BufferNum];
-    Arch::CrossCoreFlag flagAivFinishCompute[BufferNum];
+    Arch::CrossCoreFlag flagAicFinishStore[Fusion::COC_WORKSPACE_SLOTS];
+    Arch::CrossCoreFlag flagAivFinishCompute[Fusion::COC_WORKSPACE_SLOTS];
     Arch::Resource<ArchTag> resource;
 };
 
 } // namespace Catlass::Gemm::Kernel
 
-#endif // CATLASS_GEMM_KERNEL_MATMUL_EPILOGUE_COMM_HPP
+#endif // SHMEM_FUSION_GEMM_KERNEL_MATMUL_EPILOGUE_COMM_HPP
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_FUSION_HPP
+#define SHMEM_FUSION_HPP
+
+/*
+    Fused GEMM + communication (CoC) kernels of row-major matrices on the PEs of SHMEM_TEAM_WORLD, built on catlass.
+    The device functions below are called from a mix (AIC + AIV) kernel after shmemx_set_ffts_config, launched on all
+    AIC cores; symmetricPtr is a shmem_malloc'ed workspace of CocWorkspaceBytes bytes, AllGatherMatmul needs none as
+    its A is symmetric. Data moves between PEs of a host over MTE.
+
+    MatmulAllReduce:        C = sum over ranks of A x B, A m x k, B k x n, C m x n on every rank.
+    MatmulReduceScatter:    rank r gets rows [r * m / rankSize, (r + 1) * m / rankSize) of the sum of A x B.
+    AllGatherMatmul:        C = allgather(A) x B, A m / rankSize x k in symmetric memory, C m x n on every rank.
+
+    Element is half, bfloat16_t or float; CocTileConfig sizes the L1 and L0 buffers per element type, the GEMM tiles
+    are tiling.m0 x tiling.n0 up to that size, see CocTilingSetTile. GEMM-RS and AG-GEMM split the rows in whole
+    tiles, see CocRowSplitValid.
+*/
+
+// from catlass
+#include "catlass/catlass.hpp"
+#include "catlass/arch/arch.hpp"
+#include "catlass/gemm/block/block_mmad.hpp"
+#include "catlass/gemm/block/block_swizzle.hpp"
+#include "catlass/gemm/dispatch_policy.hpp"
+#include "catlass/gemm/gemm_type.hpp"
+#include "catlass/layout/layout.hpp"
+
+// from fusion
+#include "fusion/coc_tiling.hpp"
+#include "fusion/gemm/block/block_comm_swizzle.hpp"
+#include "fusion/epilogue/block/epilogue_allreduce.hpp"
+#include "fusion/epilogue/block/epilogue_reduce_scatter.hpp"
+#include "fusion/gemm/kernel/matmul_epilogue_comm.hpp"
+#include "fusion/gemm/kernel/allgather_matmul.hpp"
+
+// from shmem-device
+#include "shmem_api.h"
+
+namespace Catlass::Fusion {
+
+// L1 / L0 tiles filling the L1 and L0 buffers with double buffering, the largest tiles of CocTiling
+template <class Element>
+struct CocTileConfig {
+    using L1TileShape = GemmShape<COC_TILE_HALF.m, COC_TILE_HALF.n, COC_TILE_HALF.k>;
+    using L0TileShape = GemmShape<COC_TILE_HALF.m, COC_TILE_HALF.n, COC_TILE_HALF.k / 4>;
+};
+
+template <>
+struct CocTileConfig<float> {
+    using L1TileShape = GemmShape<COC_TILE_FLOAT.m, COC_TILE_FLOAT.n, COC_TILE_FLOAT.k>;
+    using L0TileShape = GemmShape<COC_TILE_FLOAT.m, COC_TILE_FLOAT.n, COC_TILE_FLOAT.k / 4>;
+};
+
+template <class Element>
+struct CocGemmTypes {
+    using TileConfig = CocTileConfig<Element>;
+    using AType = Gemm::GemmType<Element, layout::RowMajor>;
+    using BType = Gemm::GemmType<Element, layout::RowMajor>;
+    using CType = Gemm::GemmType<Element, layout::RowMajor>;
+    using BlockMmad = Gemm::Block::BlockMmad<Gemm::MmadAtlasA2Pingpong<true>, typename TileConfig::L1TileShape,
+                                             typename TileConfig::L0TileShape, AType, BType, CType>;
+    using BlockScheduler = typename Gemm::Block::GemmIdentityBlockSwizzle<7, 1>;
+    using CommBlockSwizzle = Gemm::Block::CommBlockSwizzleDynamic;
+};
+
+template <class Element>
+CATLASS_DEVICE void MatmulAllReduce(GM_ADDR a, GM_ADDR b, GM_ADDR c, GM_ADDR symmetricPtr, CocTiling tiling)
+{
+    using Types = CocGemmTypes<Element>;
+    using BlockScheduler = typename Types::BlockScheduler;
+    using CommBlockSwizzle = typename Types::CommBlockSwizzle;
+    using BlockEpilogue = Epilogue::Block::EpilogueAllReduce<Element, BlockScheduler, CommBlockSwizzle>;
+    using Kernel = Gemm::Kernel::MatmulEpilogueComm<typename Types::BlockMmad, BlockEpilogue, BlockScheduler>;
+
+    uint32_t rank = shmem_my_pe();
+    uint32_t rankSize = shmem_n_pes();
+    GemmCoord problemShape{tiling.m, tiling.n, tiling.k};
+    GemmCoord blockShape{tiling.m0, tiling.n0, tiling.k0};
+
+    BlockScheduler matmulBlockScheduler(problemShape, MakeCoord(tiling.m0, tiling.n0));
+    MatrixCoord commBlockShape{tiling.lenPerLoop / tiling.n0, tiling.n0};
+    MatrixCoord commProcessShape{tiling.ubMoveNum / 2 / tiling.n0, tiling.n0};
+    CommBlockSwizzle commSwizzle{commBlockShape, rank, rankSize, tiling.swizzleDirect, tiling.commDataSplit,
+                                 tiling.commNpuSplit};
+
+    AscendC::GlobalTensor<Element> gmC;
+    gmC.SetGlobalBuffer((__gm__ Element *)c);
+    typename BlockEpilogue::Params epilogueParams{gmC, layout::RowMajor(tiling.m, tiling.n, tiling.n), 0,
+                                                  (__gm__ Element *)symmetricPtr, commBlockShape, commProcessShape,
+                                                  matmulBlockScheduler, commSwizzle};
+    typename Kernel::Params params{problemShape, blockShape, tiling.pValue, rank, rankSize,
+                                   a, layout::RowMajor(tiling.m, tiling.k, tiling.k),
+                                   b, layout::RowMajor(tiling.k, tiling.n, tiling.n),
+                                   symmetricPtr, epilogueParams};
+    Kernel kernel;
+    kernel(params);
+}
+
+template <class Element>
+CATLASS_DEVICE void MatmulReduceScatter(GM_ADDR a, GM_ADDR b, GM_ADDR c, GM_ADDR symmetricPtr, CocTiling tiling)
+{
+    using Types = CocGemmTypes<Element>;
+    using BlockScheduler = typename Types::BlockScheduler;
+    using BlockEpilogue = Epilogue::Block::EpilogueReduceScatter<Element, BlockScheduler>;
+    using Kernel = Gemm::Kernel::MatmulEpilogueComm<typename Types::BlockMmad, BlockEpilogue, BlockScheduler>;
+
+    uint32_t rank = shmem_my_pe();
+    uint32_t rankSize = shmem_n_pes();
+    uint32_t mPerRank = tiling.m / rankSize;
+    GemmCoord problemShape{tiling.m, tiling.n, tiling.k};
+    GemmCoord blockShape{tiling.m0, tiling.n0, tiling.k0};
+
+    BlockScheduler matmulBlockScheduler(problemShape, MakeCoord(tiling.m0, tiling.n0));
+    MatrixCoord commProcessShape{tiling.ubMoveNum / 2 / tiling.n0, tiling.n0};
+
+    AscendC::GlobalTensor<Element> gmC;
+    gmC.SetGlobalBuffer((__gm__ Element *)c);
+    typename BlockEpilogue::Params epilogueParams{gmC, layout::RowMajor(mPerRank, tiling.n, tiling.n),
+                                                  (__gm__ Element *)symmetricPtr, matmulBlockScheduler,
+                                                  commProcessShape, mPerRank};
+    typename Kernel::Params params{problemShape, blockShape, tiling.pValue, rank, rankSize,
+                                   a, layout::RowMajor(tiling.m, tiling.k, tiling.k),
+                                   b, layout::RowMajor(tiling.k, tiling.n, tiling.n),
+                                   symmetricPtr, epilogueParams};
+    Kernel kernel;
+    kernel(params);
+}
+
+// gatheredA is local GM of m x k elements, it holds the gathered A on return
+template <class Element>
+CATLASS_DEVICE void AllGatherMatmul(GM_ADDR a, GM_ADDR b, GM_ADDR gatheredA, GM_ADDR c, CocTiling tiling)
+{
+    using Types = CocGemmTypes<Element>;
+    using Kernel = Gemm::Kernel::AllGatherMatmul<typename Types::BlockMmad, typename Types::BlockScheduler>;
+
+    uint32_t rank = shmem_my_pe();
+    uint32_t rankSize = shmem_n_pes();
+    uint32_t mPerRank = tiling.m / rankSize;
+    GemmCoord problemShape{mPerRank, tiling.n, tiling.k};
+    GemmCoord blockShape{tiling.m0, tiling.n0, tiling.k0};
+
+    typename Kernel::Params params{problemShape, blockShape, rank, rankSize, tiling.ubMoveNum / 2,
+                                   a, layout::RowMajor(mPerRank, tiling.k, tiling.k),
+                                   b, layout::RowMajor(tiling.k, tiling.n, tiling.n),
+                                   gatheredA,
+                                   c, layout::RowMajor(tiling.m, tiling.n, tiling.n)};
+    Kernel kernel;
+    kernel(params);
+}
+
+}  // namespace Catlass::Fusion
+
+#endif  // SHMEM_FUSION_HPP
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_HOST_AMO_H
+#define SHMEM_HOST_AMO_H
+
+#include "acl/acl.h"
+#include "shmem_host_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Host AMOs are posted as single-core kernels on the default stream. Fetching variants wait for the kernel
+    to finish and return the fetched value, non-fetching variants return once the kernel is launched.
+    The shmemx_*_on_stream variants post on the stream of the caller instead and never wait, fetched values
+    land in device memory once the stream reaches the kernel.
+*/
+
+#define SHMEM_TYPENAME_ATOMIC_FETCH(NAME, TYPE)                                                  \
+    /**                                                                                          \
+    * @brief Atomically fetch the value of a remote symmetric data object.                       \
+    *                                                                                            \
+    * @param src               [in] Symmetric address of the source data object.                 \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @return The value of src on the specified PE.                                              \
+    */                                                                                           \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_fetch(TYPE *src, int pe);
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_FETCH)
+#undef SHMEM_TYPENAME_ATOMIC_FETCH
+
+#define SHMEM_TYPENAME_ATOMIC_SET(NAME, TYPE)                                                    \
+    /**                                                                                          \
+    * @brief Atomically set the value of a remote symmetric data object.                         \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param value             [in] The value to be set.                                         \
+    * @param pe                [in] The number of the remote PE.                                 \
+    */                                                                                           \
+    SHMEM_HOST_API void shmem_##NAME##_atomic_set(TYPE *dst, TYPE value, int pe);
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_SET)
+#undef SHMEM_TYPENAME_ATOMIC_SET
+
+#define SHMEM_TYPENAME_ATOMIC_SWAP(NAME, TYPE)                                                   \
+    /**                                                                                          \
+    * @brief Atomically swap the value of a remote symmetric data object.                        \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param value             [in] The value to be written.                                     \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @return The value of dst on the specified PE before the swap.                              \
+    */                                                                                           \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_swap(TYPE *dst, TYPE value, int pe);
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_SWAP)
+#undef SHMEM_TYPENAME_ATOMIC_SWAP
+
+#define SHMEM_TYPENAME_ATOMIC_COMPARE_SWAP(NAME, TYPE)                                           \
+    /**                                                                                          \
+    * @brief Atomically write value to a remote symmetric data object if it equals cond.         \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param cond              [in] The value compared with dst.                                 \
+    * @param value             [in] The value to be written when dst equals cond.                \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @return The value of dst on the specified PE before the operation.                         \
+    */                                                                                           \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_compare_swap(TYPE *dst, TYPE cond, TYPE value, int pe);
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_COMPARE_SWAP)
+#undef SHMEM_TYPENAME_ATOMIC_COMPARE_SWAP
+
+#define SHMEM_TYPENAME_ATOMIC_ON_STREAM(NAME, TYPE)                                              \
+    /**                                                                                          \
+    * @brief Enqueue an atomic fetch of a remote symmetric data object on the stream.            \
+    *                                                                                            \
+    * @param src               [in] Symmetric address of the source data object.                 \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @param fetched           [out] Device memory receiving the value of src, or nullptr.       \
+    * @param stream            [in] Stream to enqueue on.                                        \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid PE or address.      \
+    */                                                                                           \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_fetch_on_stream(TYPE *src, int pe, TYPE *fetched,  \
+                                                              aclrtStream stream);               \
+                                                                                                 \
+    /**                                                                                          \
+    * @brief Enqueue an atomic set of a remote symmetric data object on the stream.              \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param value             [in] The value to be set.                                         \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @param stream            [in] Stream to enqueue on.                                        \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid PE or address.      \
+    */                                                                                           \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_set_on_stream(TYPE *dst, TYPE value, int pe,       \
+                                                            aclrtStream stream);                 \
+                                                                                                 \
+    /**                                                                                          \
+    * @brief Enqueue an atomic swap of a remote symmetric data object on the stream.             \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param value             [in] The value to be written.                                     \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @param fetched           [out] Device memory receiving the value before the swap, or       \
+    *                                nullptr.                                                    \
+    * @param stream            [in] Stream to enqueue on.                                        \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid PE or address.      \
+    */                                                                                           \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_swap_on_stream(TYPE *dst, TYPE value, int pe,      \
+                                                             TYPE *fetched, aclrtStream stream); \
+                                                                                                 \
+    /**                                                                                          \
+    * @brief Enqueue an atomic compare and swap of a remote symmetric data object on the stream. \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param cond              [in] The value compared with dst.                                 \
+    * @param value             [in] The value to be written when dst equals cond.                \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @param fetched           [out] Device memory receiving the value before the operation, or  \
+    *                                nullptr.                                                    \
+    * @param stream            [in] Stream to enqueue on.                                        \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid PE or address.      \
+    */                                                                                           \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_compare_swap_on_stream(TYPE *dst, TYPE cond,       \
+                                                                     TYPE value, int pe,         \
+                                                                     TYPE *fetched,              \
+                                                                     aclrtStream stream);
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_ON_STREAM)
+#undef SHMEM_TYPENAME_ATOMIC_ON_STREAM
+
+#define SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, OP_FUNC, FETCH_OP_FUNC)                             \
+    /**                                                                                          \
+    * @brief Atomically apply the operation with value to a remote symmetric data object.        \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param value             [in] The operand.                                                 \
+    * @param pe                [in] The number of the remote PE.                                 \
+    */                                                                                           \
+    SHMEM_HOST_API void shmem_##NAME##_##OP_FUNC(TYPE *dst, TYPE value, int pe);                 \
+                                                                                                 \
+    /**                                                                                          \
+    * @brief Atomically apply the operation with value to a remote symmetric data object, and    \
+    *        fetch the value before the operation.                                               \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param value             [in] The operand.                                                 \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @return The value of dst on the specified PE before the operation.                         \
+    */                                                                                           \
+    SHMEM_HOST_API TYPE shmem_##NAME##_##FETCH_OP_FUNC(TYPE *dst, TYPE value, int pe);           \
+                                                                                                 \
+    /**                                                                                          \
+    * @brief Enqueue the operation with value on a remote symmetric data object on the stream.   \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param value             [in] The operand.                                                 \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @param stream            [in] Stream to enqueue on.                                        \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid PE or address.      \
+    */                                                                                           \
+    SHMEM_HOST_API int shmemx_##NAME##_##OP_FUNC##_on_stream(TYPE *dst, TYPE value, int pe,      \
+                                                             aclrtStream stream);                \
+                                                                                                 \
+    /**                                                                                          \
+    * @brief Enqueue the operation with value on a remote symmetric data object on the stream,   \
+    *        fetching the value before the operation.                                            \
+    *                                                                                            \
+    * @param dst               [in] Symmetric address of the destination data object.            \
+    * @param value             [in] The operand.                                                 \
+    * @param pe                [in] The number of the remote PE.                                 \
+    * @param fetched           [out] Device memory receiving the value before the operation, or  \
+    *                                nullptr.                                                    \
+    * @param stream            [in] Stream to enqueue on.                                        \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid PE or address.      \
+    */                                                                                           \
+    SHMEM_HOST_API int shmemx_##NAME##_##FETCH_OP_FUNC##_on_stream(TYPE *dst, TYPE value,        \
+                                                                    int pe, TYPE *fetched,       \
+                                                                    aclrtStream stream);
+
+#define SHMEM_TYPENAME_ATOMIC_ADD(NAME, TYPE) SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, atomic_add, atomic_fetch_add)
+#define SHMEM_TYPENAME_ATOMIC_AND(NAME, TYPE) SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, atomic_and, atomic_fetch_and)
+#define SHMEM_TYPENAME_ATOMIC_OR(NAME, TYPE) SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, atomic_or, atomic_fetch_or)
+#define SHMEM_TYPENAME_ATOMIC_XOR(NAME, TYPE) SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, atomic_xor, atomic_fetch_xor)
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_ADD)
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_AND)
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_OR)
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_XOR)
+#undef SHMEM_TYPENAME_ATOMIC_ADD
+#undef SHMEM_TYPENAME_ATOMIC_AND
+#undef SHMEM_TYPENAME_ATOMIC_OR
+#undef SHMEM_TYPENAME_ATOMIC_XOR
+#undef SHMEM_TYPENAME_ATOMIC_OP
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
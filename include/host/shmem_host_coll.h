@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEM_HOST_COLL_H
+#define SHMEM_HOST_COLL_H
+
+#include "acl/acl.h"
+#include "shmem_host_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Host collectives are enqueued as a kernel on the stream and return without waiting for it, nullptr stands for
+    the default stream. Every PE in the team must enqueue the same collective, with the same arguments, in the same
+    order. Refer to shmem_device_coll.h for the semantics and the restrictions on the buffers.
+*/
+
+/**
+* @brief Standard Reduction Types and Names valid on Host
+*
+* |NAME       | TYPE              |
+* |-----------|-------------------|
+* |half       | shmem_half_t      |
+* |bfloat16   | shmem_bfloat16_t  |
+* |float      | float             |
+* |int16      | int16             |
+* |int32      | int32             |
+*/
+#define SHMEM_HOST_REDUCE_TYPE_FUNC(FUNC)   \
+    FUNC(half, shmem_half_t);               \
+    FUNC(bfloat16, shmem_bfloat16_t);       \
+    FUNC(float, float);                     \
+    FUNC(int16, int16_t);                   \
+    FUNC(int32, int32_t)
+
+#define SHMEM_TYPENAME_ALLGATHER_ON_STREAM(NAME, TYPE)                                                                 \
+    /**                                                                                                                \
+    * @brief Enqueue an allgather over the team, source of member i lands in block i of dest on every member.          \
+    *                                                                                                                  \
+    * @param team              [in] The team over which to gather.                                                     \
+    * @param dest              [in] Symmetric destination, team size * nelems elements.                                \
+    * @param source            [in] Symmetric source, nelems elements.                                                 \
+    * @param nelems            [in] Number of elements contributed by each PE.                                         \
+    * @param stream            [in] Stream to enqueue on.                                                              \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid team or address.                          \
+    */                                                                                                                 \
+    SHMEM_HOST_API int shmem_##NAME##_allgather_on_stream(shmem_team_t team, TYPE *dest, TYPE *source, size_t nelems,  \
+                                                         aclrtStream stream);
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLGATHER_ON_STREAM)
+#undef SHMEM_TYPENAME_ALLGATHER_ON_STREAM
+
+#define SHMEM_TYPENAME_BROADCAST_ON_STREAM(NAME, TYPE)                                                                 \
+    /**                                                                                                                \
+    * @brief Enqueue a broadcast of the source of the root to dest on every member of the team.                        \
+    *                                                                                                                  \
+    * @param team              [in] The team over which to broadcast.                                                  \
+    * @param dest              [in] Symmetric destination, nelems elements.                                            \
+    * @param source            [in] Symmetric source, nelems elements, only read on the root.                          \
+    * @param nelems            [in] Number of elements to broadcast.                                                   \
+    * @param pe_root           [in] The root, a PE number in the team.                                                 \
+    * @param stream            [in] Stream to enqueue on.                                                              \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid team or address.                          \
+    */                                                                                                                 \
+    SHMEM_HOST_API int shmem_##NAME##_broadcast_on_stream(shmem_team_t team, TYPE *dest, TYPE *source, size_t nelems,  \
+                                                         int pe_root, aclrtStream stream);
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_BROADCAST_ON_STREAM)
+#undef SHMEM_TYPENAME_BROADCAST_ON_STREAM
+
+#define SHMEM_TYPENAME_ALLTOALL_ON_STREAM(NAME, TYPE)                                                                  \
+    /**                                                                                                                \
+    * @brief Enqueue an alltoall over the team, block j of the source of member i lands in block i of dest on          \
+    *        member j.                                                                                                 \
+    *                                                                                                                  \
+    * @param team              [in] The team over which to exchange.                                                   \
+    * @param dest              [in] Symmetric destination, team size * nelems elements.                                \
+    * @param source            [in] Symmetric source, team size * nelems elements.                                     \
+    * @param nelems            [in] Number of elements per block.                                                      \
+    * @param stream            [in] Stream to enqueue on.                                                              \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid team or address.                          \
+    */                                                                                                                 \
+    SHMEM_HOST_API int shmem_##NAME##_alltoall_on_stream(shmem_team_t team, TYPE *dest, TYPE *source, size_t nelems,   \
+                                                        aclrtStream stream);
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLTOALL_ON_STREAM)
+#undef SHMEM_TYPENAME_ALLTOALL_ON_STREAM
+
+#define SHMEM_TYPENAME_ALLTOALLV_ON_STREAM(NAME, TYPE)                                                                 \
+    /**                                                                                                                \
+    * @brief Enqueue an alltoallv over the team, send_counts[j] elements of the source of member i land in dest on     \
+    *        member j, behind the blocks of the members before i, or at i * dest_stride if set.                        \
+    *                                                                                                                  \
+    * @param team              [in] The team over which to exchange.                                                   \
+    * @param dest              [in] Symmetric destination, large enough for every block received.                      \
+    * @param dest_stride       [in] Elements between the blocks in dest, 0 to pack them in team order. Blocks          \
+    *                               larger than the stride are cut to it.                                              \
+    * @param source            [in] Symmetric source.                                                                  \
+    * @param send_counts       [in] Device memory, team size elements sent to each member.                             \
+    * @param send_offsets      [in] Device memory, team size first elements in source of the block of each member,     \
+    *                               nullptr if the blocks are packed in team order.                                    \
+    * @param recv_counts       [out] Device memory, team size elements received from each member, after the cut,      \
+    *                                or nullptr.                                                                       \
+    * @param recv_offsets      [out] Device memory, team size first elements in dest of the block of each member,      \
+    *                                or nullptr.                                                                       \
+    * @param truncated         [out] Device memory, number of blocks received cut to dest_stride, or nullptr.          \
+    * @param stream            [in] Stream to enqueue on.                                                              \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid team or address.                          \
+    */                                                                                                                 \
+    SHMEM_HOST_API int shmemx_##NAME##_alltoallv_on_stream(shmem_team_t team, TYPE *dest, size_t dest_stride,          \
+                                                           TYPE *source, uint32_t *send_counts,                        \
+                                                           uint32_t *send_offsets, uint32_t *recv_counts,              \
+                                                           uint64_t *recv_offsets, uint32_t *truncated,                \
+                                                           aclrtStream stream);
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLTOALLV_ON_STREAM)
+#undef SHMEM_TYPENAME_ALLTOALLV_ON_STREAM
+
+#define SHMEM_TYPENAME_OP_REDUCE_ON_STREAM(NAME, TYPE, OP)                                                             \
+    /**                                                                                                                \
+    * @brief Enqueue an allreduce over the team, dest on every member receives the element-wise reduction of           \
+    *        the sources of all members.                                                                               \
+    *                                                                                                                  \
+    * @param team              [in] The team over which to reduce.                                                     \
+    * @param dest              [in] Symmetric destination, nelems elements, may equal source.                          \
+    * @param source            [in] Symmetric source, nelems elements.                                                 \
+    * @param nelems            [in] Number of elements to reduce.                                                      \
+    * @param stream            [in] Stream to enqueue on.                                                              \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid team or address.                          \
+    */                                                                                                                 \
+    SHMEM_HOST_API int shmem_##NAME##_##OP##_allreduce_on_stream(shmem_team_t team, TYPE *dest, TYPE *source,          \
+                                                                 size_t nelems, aclrtStream stream);                   \
+                                                                                                                       \
+    /**                                                                                                                \
+    * @brief Enqueue a reduce-scatter over the team, member i receives in dest the element-wise reduction of           \
+    *        block i of the sources of all members.                                                                    \
+    *                                                                                                                  \
+    * @param team              [in] The team over which to reduce.                                                     \
+    * @param dest              [in] Symmetric destination, nelems elements.                                            \
+    * @param source            [in] Symmetric source, team size * nelems elements.                                     \
+    * @param nelems            [in] Number of elements per block.                                                      \
+    * @param stream            [in] Stream to enqueue on.                                                              \
+    * @return SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid team or address.                          \
+    */                                                                                                                 \
+    SHMEM_HOST_API int shmem_##NAME##_##OP##_reduce_scatter_on_stream(shmem_team_t team, TYPE *dest, TYPE *source,     \
+                                                                      size_t nelems, aclrtStream stream);
+
+#define SHMEM_TYPENAME_REDUCE_ON_STREAM(NAME, TYPE)    \
+    SHMEM_TYPENAME_OP_REDUCE_ON_STREAM(NAME, TYPE, sum) \
+    SHMEM_TYPENAME_OP_REDUCE_ON_STREAM(NAME, TYPE, max) \
+    SHMEM_TYPENAME_OP_REDUCE_ON_STREAM(NAME, TYPE, min)
+
+SHMEM_HOST_REDUCE_TYPE_FUNC(SHMEM_TYPENAME_REDUCE_ON_STREAM)
+#undef SHMEM_TYPENAME_REDUCE_ON_STREAM
+#undef SHMEM_TYPENAME_OP_REDUCE_ON_STREAM
+
+/**
+ * @brief Force the algorithm of a collective on a team for every message size. Teams are created with the
+ *        algorithms of the tuning table, see shmemx_coll_tune_set. All PEs of the team must pass the same
+ *        arguments, while no kernel is using the team.
+ *
+ * @param team [IN] team handle
+ * @param op [IN] one of shmemx_coll_op_t
+ * @param algo [IN] one of shmemx_coll_algo_t, SHMEMX_COLL_AUTO restores the tuning table
+ * @return Returns 0 on success, SHMEM_INVALID_PARAM if the team is invalid or the algorithm can not run op on it
+ */
+SHMEM_HOST_API int shmemx_team_set_coll_algo(shmem_team_t team, int op, int algo);
+
+/**
+ * @brief Get the algorithm a collective uses on a team for a message size, never SHMEMX_COLL_AUTO.
+ *
+ * @param team [IN] team handle
+ * @param op [IN] one of shmemx_coll_op_t
+ * @param nbytes [IN] bytes contributed by each PE
+ * @param algo [OUT] one of shmemx_coll_algo_t
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmemx_team_get_coll_algo(shmem_team_t team, int op, size_t nbytes, int *algo);
+
+/**
+ * @brief Set the algorithm of a collective up to max_bytes per PE in the tuning table, for teams of the size and
+ *        the transport mix (one host or several) of team, and apply the table to team. Teams created afterwards
+ *        pick the row up, existing teams other than team keep their algorithms. The table starts from built-in
+ *        defaults and the file named by SHMEM_COLL_TUNE_FILE.
+ *
+ * @param team [IN] team handle
+ * @param op [IN] one of shmemx_coll_op_t
+ * @param max_bytes [IN] largest message per PE the algorithm applies to, SIZE_MAX for no bound
+ * @param algo [IN] one of shmemx_coll_algo_t except SHMEMX_COLL_AUTO
+ * @return Returns 0 on success, SHMEM_INVALID_PARAM if the team is invalid or the algorithm can not run op on it
+ */
+SHMEM_HOST_API int shmemx_coll_tune_set(shmem_team_t team, int op, size_t max_bytes, int algo);
+
+/**
+ * @brief Write the tuning table to a file which SHMEM_COLL_TUNE_FILE can load, one row
+ *        "op max_pes transport max_bytes algo" per line.
+ *
+ * @param path [IN] path of the file
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmemx_coll_tune_save(const char *path);
+
+/**
+ * @brief Get the bytes of the symmetric work buffer of the quantized collectives for nelems elements per PE.
+ *
+ * @param nelems [IN] elements contributed by each PE
+ * @param config [IN] wire format and block size, work and error are ignored
+ * @return Returns the size in bytes, 0 if config is invalid
+ */
+SHMEM_HOST_API size_t shmemx_quant_work_size(size_t nelems, const shmemx_quant_config_t *config);
+
+/**
+ * @brief Enqueue an allgather of float elements moved in the wire format of config, see shmemx_quant_format_t.
+ *        dest on every member receives the dequantized sources of all members, its own included.
+ *
+ * @param team [IN] team handle
+ * @param dest [IN] symmetric destination, team size * nelems elements
+ * @param source [IN] local source, nelems elements
+ * @param nelems [IN] elements contributed by each PE
+ * @param config [IN] wire format, block size, symmetric work buffer or 0 for the scratch of the team, taken on
+ *                    first use, and optional error feedback
+ * @param stream [IN] stream to enqueue on
+ * @return Returns SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid team, address or config
+ */
+SHMEM_HOST_API int shmemx_float_allgather_quant_on_stream(shmem_team_t team, float *dest, float *source,
+                                                          size_t nelems, const shmemx_quant_config_t *config,
+                                                          aclrtStream stream);
+
+/**
+ * @brief Enqueue a sum allreduce of float elements moved in the wire format of config, see shmemx_quant_format_t.
+ *        Sums are accumulated in float, dest is the same on every member and may equal source.
+ *
+ * @param team [IN] team handle
+ * @param dest [IN] symmetric destination, nelems elements
+ * @param source [IN] local source, nelems elements
+ * @param nelems [IN] elements to reduce
+ * @param config [IN] wire format, block size, symmetric work buffer or 0 for the scratch of the team, taken on
+ *                    first use, and optional error feedback
+ * @param stream [IN] stream to enqueue on
+ * @return Returns SHMEM_SUCCESS once enqueued, SHMEM_INVALID_PARAM on an invalid team, address or config
+ */
+SHMEM_HOST_API int shmemx_float_sum_allreduce_quant_on_stream(shmem_team_t team, float *dest, float *source,
+                                                              size_t nelems, const shmemx_quant_config_t *config,
+                                                              aclrtStream stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
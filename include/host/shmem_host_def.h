@@ -17,37 +17,62 @@
 extern "C" {
 #endif
 
+/**
+ * @brief 16-bit floating point types on Host. The host has no arithmetic on them, they only carry the bit pattern
+ *        of the device half and bfloat16_t.
+ */
+typedef uint16_t shmem_half_t;
+typedef uint16_t shmem_bfloat16_t;
+
 /**
 * @brief Standard RMA Types and Names valid on Host
 *
+* |NAME       | TYPE              |
+* |-----------|-------------------|
+* |float      | float             |
+* |double     | double            |
+* |int8       | int8              |
+* |int16      | int16             |
+* |int32      | int32             |
+* |int64      | int64             |
+* |uint8      | uint8             |
+* |uint16     | uint16            |
+* |uint32     | uint32            |
+* |uint64     | uint64            |
+* |char       | char              |
+* |half       | shmem_half_t      |
+* |bfloat16   | shmem_bfloat16_t  |
+*/
+#define SHMEM_TYPE_FUNC(FUNC)           \
+    FUNC(float, float);                 \
+    FUNC(double, double);               \
+    FUNC(int8, int8_t);                 \
+    FUNC(int16, int16_t);               \
+    FUNC(int32, int32_t);               \
+    FUNC(int64, int64_t);               \
+    FUNC(uint8, uint8_t);               \
+    FUNC(uint16, uint16_t);             \
+    FUNC(uint32, uint32_t);             \
+    FUNC(uint64, uint64_t);             \
+    FUNC(char, char);                   \
+    FUNC(half, shmem_half_t);           \
+    FUNC(bfloat16, shmem_bfloat16_t)
+
+/**
+* @brief Standard AMO Types and Names, valid on both Host and Device
+*
 * |NAME       | TYPE      |
 * |-----------|-----------|
-* |float      | float     |
-* |double     | double    |
-* |int8       | int8      |
-* |int16      | int16     |
 * |int32      | int32     |
 * |int64      | int64     |
-* |uint8      | uint8     |
-* |uint16     | uint16    |
 * |uint32     | uint32    |
 * |uint64     | uint64    |
-* |char       | char      |
 */
-#define SHMEM_TYPE_FUNC(FUNC) \
-    FUNC(float, float);       \
-    FUNC(double, double);     \
-    FUNC(int8, int8_t);       \
-    FUNC(int16, int16_t);     \
-    FUNC(int32, int32_t);     \
-    FUNC(int64, int64_t);     \
-    FUNC(uint8, uint8_t);     \
-    FUNC(uint16, uint16_t);   \
-    FUNC(uint32, uint32_t);   \
-    FUNC(uint64, uint64_t);   \
-    FUNC(char, char)
-// FUNC(half, half);
-// FUNC(bfloat16, bfloat16_t);
+#define SHMEM_AMO_TYPE_FUNC(FUNC) \
+    FUNC(int32, int32_t);         \
+    FUNC(int64, int64_t);         \
+    FUNC(uint32, uint32_t);       \
+    FUNC(uint64, uint64_t)
 
 /**
  * @defgroup group_macros Macros
@@ -126,6 +151,7 @@ enum shmem_transport_t : uint8_t {
  * - uint32_t shm_init_timeout: shm_init_timeout
  * - uint32_t shm_create_timeout: shm_create_timeout
  * - uint32_t control_operation_timeout: control_operation_timeout
+ * - uint32_t roce_qp_num: number of RoCE QPs created per peer, 0 is treated as 1
 */
 typedef struct {
     int version;
@@ -133,6 +159,7 @@ typedef struct {
     uint32_t shm_init_timeout;
     uint32_t shm_create_timeout;
     uint32_t control_operation_timeout;
+    uint32_t roce_qp_num;
 } shmem_init_optional_attr_t;
 
 /**
@@ -59,6 +59,18 @@ SHMEM_HOST_API int shmem_set_data_op_engine_type(shmem_init_attr_t *attributes,
  */
 SHMEM_HOST_API int shmem_set_timeout(shmem_init_attr_t *attributes, uint32_t value);
 
+/**
+ * @brief Modify the number of RoCE QPs created per peer in the attributes that will be used for initialization.
+ *        Large RoCE transfers are striped across QPs, and different vector cores post on different QPs.
+ *        If this method is not used, the default value is 1
+ *        if method <b>shmem_set_attr()</b> is used after this method, the roce_qp_num param will be overwritten by the default value.
+ *
+ * @param attributes        [in/out] Pointer to the attributes to modify the RoCE QP number
+ * @param value             [in] Number of RoCE QPs per peer, in [1, SHMEM_MAX_ROCE_QP_NUM]
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmem_set_roce_qp_num(shmem_init_attr_t *attributes, uint32_t value);
+
 /**
  * @brief Initialize the resources required for SHMEM task based on attributes.
  *        Attributes can be created by users or obtained by calling <b>shmem_set_attr()</b>.
@@ -94,6 +106,14 @@ SHMEM_HOST_API void shmem_info_get_version(int *major, int *minor);
  */
 SHMEM_HOST_API void shmem_info_get_name(char *name);
 
+/**
+ * @brief Returns the version of the device state. It grows whenever the host publishes a change of the state, such as
+ *        a team creation or destruction, and can be passed to a kernel that compares it with its device counterpart.
+ *
+ * @return Version of the device state last published by the host.
+ */
+SHMEM_HOST_API uint64_t shmemx_state_version();
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,6 +13,9 @@
     
     Our barrier implementation ensures that:
         On systems with only HCCS: All operations of all ranks of a team ON EXECUTING/INTERNAL STREAMs before the barrier are visiable to all ranks of the team after the barrier.
+
+    Host barriers on a stream are only enqueued, completion is ordered on the stream. The blocking host shmem_barrier
+    drains the default stream, and synchronizes SHMEM_TEAM_WORLD through the bootstrap without launching a kernel.
         
     Refer to shmem_device_sync.h for using restrictions.
 */
@@ -36,6 +39,55 @@ extern "C" {
  */
 SHMEM_HOST_API uint64_t shmemx_get_ffts_config();
 
+/**
+ * @brief Enqueue a barrier over the team on the stream. The calling thread is not blocked, kernels enqueued on the
+ *        stream afterwards start once all PEs in the team have reached the barrier on their streams.
+ *
+ * @param tid              [in] team to do barrier
+ * @param stream           [in] stream to enqueue on, nullptr for the default stream
+ */
+SHMEM_HOST_API void shmem_barrier_on_stream(shmem_team_t tid, aclrtStream stream);
+
+/**
+ * @brief shmem_barrier_on_stream of all PEs.
+ *
+ * @param stream           [in] stream to enqueue on, nullptr for the default stream
+ */
+SHMEM_HOST_API void shmem_barrier_all_on_stream(aclrtStream stream);
+
+/**
+ * @brief Enqueue a barrier over the team on the stream and record event right behind it, so that completion can be
+ *        observed with aclrtQueryEventStatus / aclrtSynchronizeEvent or waited on by other streams.
+ *
+ * @param tid              [in] team to do barrier
+ * @param stream           [in] stream to enqueue on, nullptr for the default stream
+ * @param event            [in] event created by the caller, not recorded if nullptr
+ * @return 0 on success, SHMEM_INVALID_PARAM if the team is invalid
+ */
+SHMEM_HOST_API int shmemx_barrier_on_stream_event(shmem_team_t tid, aclrtStream stream, aclrtEvent event);
+
+/**
+ * @brief Enqueue the first half of a split-phase barrier over the team on the stream. The calling thread and the
+ *        stream are not synchronized, kernels enqueued on the stream afterwards run while other PEs are arriving.
+ *        Must be followed by shmemx_barrier_wait_on_stream before the next barrier on the team.
+ *
+ * @param tid              [in] team to do barrier
+ * @param stream           [in] stream to enqueue on, nullptr for the default stream
+ * @return 0 on success, SHMEM_INVALID_PARAM if the team is invalid
+ */
+SHMEM_HOST_API int shmemx_barrier_arrive_on_stream(shmem_team_t tid, aclrtStream stream);
+
+/**
+ * @brief Enqueue the completion of a split-phase barrier started by shmemx_barrier_arrive_on_stream. Kernels
+ *        enqueued on the stream afterwards start once all PEs in the team have arrived. The calling thread is not
+ *        blocked.
+ *
+ * @param tid              [in] team to do barrier
+ * @param stream           [in] stream to enqueue on, nullptr for the default stream
+ * @return 0 on success, SHMEM_INVALID_PARAM if the team is invalid
+ */
+SHMEM_HOST_API int shmemx_barrier_wait_on_stream(shmem_team_t tid, aclrtStream stream);
+
 #ifdef __cplusplus
 }
 #endif
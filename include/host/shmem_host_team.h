@@ -43,6 +43,20 @@ SHMEM_HOST_API int shmem_team_split_strided(shmem_team_t parent_team, int pe_sta
 SHMEM_HOST_API int shmem_team_split_2d(shmem_team_t parent_team, int x_range, shmem_team_t *x_team,
                                        shmem_team_t *y_team);
 
+/**
+ * @brief Collective Interface. Split a parent team into disjoint teams of arbitrary members, one per color. Members
+ *        of a new team are ordered by key, ties are broken by their PE number in the parent team. All PEs of the
+ *        parent team must call it, and enqueued work on the default stream completes first.
+ *
+ * @param parent_team       [in] A team handle.
+ * @param color             [in] PEs passing the same color join the same team, a negative color joins no team.
+ * @param key               [in] Orders the PEs inside the new team.
+ * @param new_team          [out] A team handle, SHMEM_TEAM_INVALID if color is negative.
+ *
+ * @return 0 on successful creation of new_team; otherwise nonzero.
+ */
+SHMEM_HOST_API int shmemx_team_split(shmem_team_t parent_team, int color, int key, shmem_team_t *new_team);
+
 /**
  * @brief Translate a given PE number in one team into the corresponding PE number in another team.
  * 
@@ -100,10 +114,121 @@ SHMEM_HOST_API int shmem_team_n_pes(shmem_team_t team);
  * @brief return team config which pass in as team created
  *
  * @param team [IN] team handle
- * @param config [OUT] the config associated with team, reserved for future use
+ * @param config [OUT] the config associated with team, num_contexts is the number of live contexts on the team
  */
 SHMEM_HOST_API int shmem_team_get_config(shmem_team_t team, shmem_team_config_t *config);
 
+/**
+ * @brief Override the barrier algorithm of a team. The team is created with SHMEM_BARRIER_ALGO from the environment
+ *        (auto, dissem, group_dissem, central or hier), automatic selection by default. All PEs of the team must
+ *        pass the same algo, while no kernel is using the team.
+ *
+ * @param team [IN] team handle
+ * @param algo [IN] one of shmemx_barrier_algo_t, SHMEMX_BARRIER_AUTO restores automatic selection
+ * @return Returns 0 on success, SHMEM_INVALID_PARAM if the team is invalid or the algorithm can not span it
+ */
+SHMEM_HOST_API int shmemx_team_set_barrier_algo(shmem_team_t team, int algo);
+
+/**
+ * @brief Get the barrier algorithm used by a team, never SHMEMX_BARRIER_AUTO.
+ *
+ * @param team [IN] team handle
+ * @param algo [OUT] one of shmemx_barrier_algo_t
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmemx_team_get_barrier_algo(shmem_team_t team, int *algo);
+
+/**
+ * @brief Set the size of the scratch of a team, symmetric memory the library holds for the collectives of the
+ *        team. Teams start with SHMEM_TEAM_SCRATCH_SIZE bytes, 4MB by default. A scratch of another size already
+ *        held is released and taken again on next use. Collective over the team, while no kernel is using it: the
+ *        members exchange their sizes and fail together unless all passed the same one.
+ *
+ * @param team [IN] team handle
+ * @param size [IN] bytes, rounded up to 64KB, 0 restores SHMEM_TEAM_SCRATCH_SIZE
+ * @return Returns 0 on success, SHMEM_INVALID_PARAM if the team is invalid, the members passed different sizes or
+ *         size exceeds the scratch arena
+ */
+SHMEM_HOST_API int shmemx_team_set_scratch_size(shmem_team_t team, size_t size);
+
+/**
+ * @brief Get the scratch of a team, zeroed symmetric memory at the same offset on every member, which kernels
+ *        reach with shmemx_team_scratch and tag with shmemx_team_epoch_next instead of caller workspaces and
+ *        magic numbers. Collective over the team on first use, where it is taken from the arena of
+ *        SHMEM_SCRATCH_ARENA_SIZE bytes (64MB by default), with the size set for the team or size if larger. Local
+ *        afterwards. The arena comes out of the symmetric heap with the first scratch request of any team, which
+ *        has to be made on a team of all PEs, SHMEM_TEAM_WORLD for instance. It stays with the team until it is resized or the team is destroyed.
+ *        The scratch has a single owner at a time, the library does not partition it: the quantized collectives
+ *        called with a config work of 0 leave their payload in it, which kernels polling epoch-tagged flags in the
+ *        scratch could take for a flag. Applications using the scratch pass a work buffer to those collectives.
+ *
+ * @param team [IN] team handle
+ * @param size [IN] bytes needed
+ * @param scratch [OUT] local address of the scratch, nullptr on failure
+ * @return Returns 0 on success, SHMEM_INVALID_PARAM if the team is invalid, its scratch is smaller than size or
+ *         the arena is not taken yet and the team lacks some PEs, SHMEM_INNER_ERROR if the arena does not fit in
+ *         the symmetric heap or the scratch does not fit in the arena of every member
+ */
+SHMEM_HOST_API int shmemx_team_get_scratch(shmem_team_t team, size_t size, void **scratch);
+
+/**
+ * @brief Get the usage of the scratch of a team and of the arena on the calling PE.
+ *
+ * @param team [IN] team handle
+ * @param stats [OUT] usage, see shmemx_team_scratch_stats_t
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmemx_team_scratch_stats(shmem_team_t team, shmemx_team_scratch_stats_t *stats);
+
+/**
+ * @brief Create a communication context on the team. Operations issued on a context are ordered and
+ *        completed (shmem_ctx_fence / shmem_ctx_quiet on device) independently from other contexts.
+ *
+ * @param team [IN] team handle, PE numbers passed to operations on the context are relative to it
+ * @param options [IN] bitwise OR of SHMEM_CTX_SERIALIZED, SHMEM_CTX_PRIVATE and SHMEM_CTX_NOSTORE, or 0
+ * @param ctx [OUT] the created context, SHMEM_CTX_INVALID on failure
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmem_team_create_ctx(shmem_team_t team, long options, shmem_ctx_t *ctx);
+
+/**
+ * @brief Create a communication context on SHMEM_TEAM_WORLD.
+ *
+ * @param options [IN] bitwise OR of SHMEM_CTX_SERIALIZED, SHMEM_CTX_PRIVATE and SHMEM_CTX_NOSTORE, or 0
+ * @param ctx [OUT] the created context, SHMEM_CTX_INVALID on failure
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmem_ctx_create(long options, shmem_ctx_t *ctx);
+
+/**
+ * @brief Destroy a communication context. Operations on it must have been quieted beforehand.
+ *        SHMEM_CTX_DEFAULT can not be destroyed.
+ *
+ * @param ctx [IN] context handle
+ */
+SHMEM_HOST_API void shmem_ctx_destroy(shmem_ctx_t ctx);
+
+/**
+ * @brief Get the team a communication context was created on.
+ *
+ * @param ctx [IN] context handle
+ * @param team [OUT] the team of ctx, SHMEM_TEAM_INVALID if ctx is invalid
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmem_ctx_get_team(shmem_ctx_t ctx, shmem_team_t *team);
+
+/**
+ * @brief Relocate the UB staging buffer and event ID used by MTE operations on a communication context.
+ *        Contexts used concurrently on one core must not overlap in UB nor share event IDs.
+ *
+ * @param ctx [IN] context handle
+ * @param offset [IN] UB start address of the staging buffer
+ * @param ub_size [IN] size of the staging buffer in bytes
+ * @param event_id [IN] TEventID used to synchronize the staging buffer
+ * @return Returns 0 on success or an error code on failure
+ */
+SHMEM_HOST_API int shmemx_ctx_set_ub_params(shmem_ctx_t ctx, uint64_t offset, uint32_t ub_size, uint32_t event_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMX_HOST_WORK_H
+#define SHMEMX_HOST_WORK_H
+
+#include "acl/acl.h"
+#include "shmem_host_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Persistent communication kernel.
+
+    shmemx_work_queue_start launches a kernel that stays resident on block_dim cores and runs the operations
+    submitted to a symmetric ring of descriptors, shmemx_work_desc_t, in submission order, so that small RMA and
+    collectives cost a descriptor write instead of a kernel launch. The host submits with shmemx_work_submit, kernels
+    with the device shmemx_work_submit when the queue takes device producers. Completion is seen through the ticket
+    of the operation, through the optional done_flag of the descriptor, or through the signal of PUT_SIGNAL.
+
+    1. Start and stop are collective over all PEs. Every PE must submit the same barriers and collectives of a team,
+       in the same order, as the members run them in the order of their own queues.
+
+    2. The cores reserved by the persistent kernel are unavailable to other kernels until it stops. Collectives and
+       barriers of the teams used through the queue must not be launched aside from it in the meantime.
+
+    3. Operations are checked by the host on submission, descriptors submitted by kernels are trusted.
+*/
+
+/**
+ * @brief Allocate the work queue and launch the persistent communication kernel on a stream of its own.
+ *
+ * @param depth             [in] Slots of the ring, a power of two up to 4096, 0 for the default of 256.
+ * @param block_dim         [in] Cores reserved by the kernel, the operations are split among them.
+ * @param flags             [in] SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS or 0.
+ * @return SHMEM_SUCCESS on success, SHMEM_INVALID_PARAM on invalid arguments or if the kernel already runs,
+ *         SHMEM_INNER_ERROR if the queue could not be allocated or the kernel not launched.
+ */
+SHMEM_HOST_API int shmemx_work_queue_start(uint32_t depth, uint32_t block_dim, int flags);
+
+/**
+ * @brief Stop the persistent communication kernel once the operations submitted so far have completed, and free
+ *        the work queue.
+ *
+ * @return SHMEM_SUCCESS on success, SHMEM_INVALID_PARAM if the kernel is not running.
+ */
+SHMEM_HOST_API int shmemx_work_queue_stop(void);
+
+/**
+ * @brief Submit an operation to the work queue of the calling PE, waiting for a free slot if the queue is full.
+ *
+ * @param desc              [in] Descriptor of the operation, copied into the queue.
+ * @param ticket            [out] Ticket of the operation, may be nullptr.
+ * @return SHMEM_SUCCESS once submitted, SHMEM_INVALID_PARAM on an invalid descriptor or if the kernel is not running.
+ */
+SHMEM_HOST_API int shmemx_work_submit(const shmemx_work_desc_t *desc, uint64_t *ticket);
+
+/**
+ * @brief Check whether an operation of the work queue has completed, and so have all operations submitted before it.
+ *
+ * @param ticket            [in] Ticket returned by shmemx_work_submit.
+ * @param done              [out] 1 if the operation has completed, 0 otherwise.
+ * @return SHMEM_SUCCESS on success, SHMEM_INVALID_PARAM if the kernel is not running.
+ */
+SHMEM_HOST_API int shmemx_work_test(uint64_t ticket, int *done);
+
+/**
+ * @brief Wait until an operation of the work queue has completed, and so have all operations submitted before it.
+ *
+ * @param ticket            [in] Ticket returned by shmemx_work_submit.
+ * @return SHMEM_SUCCESS on success, SHMEM_INVALID_PARAM if the kernel is not running.
+ */
+SHMEM_HOST_API int shmemx_work_wait(uint64_t ticket);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SHMEMX_HOST_WORK_H
@@ -37,11 +37,39 @@ enum shmemi_op_t{
     SHMEMI_OP_GET,
     SHMEMI_OP_G,
     // SHMEMI_OP_FENCE,
-    // SHMEMI_OP_AMO,
+    SHMEMI_OP_AMO,
     // SHMEMI_OP_QUIET,
     // SHMEMI_OP_SENTINEL = INT_MAX,
 };
 
+/**
+ * @brief Atomic memory operation type, used when posting AMOs from host.
+ */
+enum shmemi_amo_op_t {
+    SHMEMI_AMO_FETCH = 0,
+    SHMEMI_AMO_SET,
+    SHMEMI_AMO_ADD,
+    SHMEMI_AMO_FETCH_ADD,
+    SHMEMI_AMO_SWAP,
+    SHMEMI_AMO_COMPARE_SWAP,
+    SHMEMI_AMO_AND,
+    SHMEMI_AMO_FETCH_AND,
+    SHMEMI_AMO_OR,
+    SHMEMI_AMO_FETCH_OR,
+    SHMEMI_AMO_XOR,
+    SHMEMI_AMO_FETCH_XOR,
+};
+
+/**
+ * @brief Reduction operation of collectives.
+ */
+enum shmemi_reduce_op_t {
+    SHMEMI_REDUCE_SUM = 0,
+    SHMEMI_REDUCE_MAX,
+    SHMEMI_REDUCE_MIN,
+    SHMEMI_REDUCE_PROD,     ///< Only by the local reductions shmemx_*_prod_reduce_local on device.
+};
+
 /**
  * @brief Team's index.
 */
@@ -50,6 +78,24 @@ enum shmem_team_index_t{
     SHMEM_TEAM_WORLD = 0
 };
 
+/**
+ * @brief Communication context's index.
+*/
+enum shmem_ctx_index_t {
+    SHMEM_CTX_INVALID = -1,
+    SHMEM_CTX_DEFAULT = 0
+};
+
+/**
+ * @brief Options of communication context creation. Accepted for compatibility, contexts are always private
+ *        to the core issuing operations on them.
+ */
+enum {
+    SHMEM_CTX_SERIALIZED = 1 << 0,
+    SHMEM_CTX_PRIVATE = 1 << 1,
+    SHMEM_CTX_NOSTORE = 1 << 2
+};
+
 /**
  * @brief Data op engine type.
 */
@@ -80,12 +126,153 @@ enum {
 };
 
 /**
- * @brief Reserved for future use.
+ * @brief Barrier algorithms of a team, see shmemi_device_barrier.h for details.
+ */
+enum shmemx_barrier_algo_t {
+    SHMEMX_BARRIER_AUTO = 0,        ///< Chosen at team creation from team size, vector core count and transports.
+    SHMEMX_BARRIER_DISSEM,          ///< Dissemination, log2(N) rounds on one vector core. Spans hosts over RoCE.
+    SHMEMX_BARRIER_GROUP_DISSEM,    ///< Group dissemination, log_k(N) rounds on k vector cores. Single host only.
+    SHMEMX_BARRIER_CENTRAL,         ///< Centralized pull, N/k remote loads on k vector cores. Single host only.
+    SHMEMX_BARRIER_HIER,            ///< Hierarchical, MTE within hosts and dissemination among host leaders.
+    SHMEMX_BARRIER_ALGO_NUM
+};
+
+/**
+ * @brief Collectives whose algorithm is chosen per team and message size.
+ */
+enum shmemx_coll_op_t {
+    SHMEMX_COLL_ALLGATHER = 0,
+    SHMEMX_COLL_BROADCAST,
+    SHMEMX_COLL_ALLTOALL,
+    SHMEMX_COLL_REDUCE_SCATTER,
+    SHMEMX_COLL_ALLREDUCE,
+    SHMEMX_COLL_OP_NUM
+};
+
+/**
+ * @brief Collective algorithms, see shmemi_device_coll.h for details.
+ */
+enum shmemx_coll_algo_t {
+    SHMEMX_COLL_AUTO = 0,           ///< Chosen per message size from the tuning table.
+    SHMEMX_COLL_ONE_SHOT,           ///< Every member reads all peers at once. All collectives.
+    SHMEMX_COLL_TWO_SHOT,           ///< Reduce-scatter, then allgather of the reduced slices. Allreduce only.
+    SHMEMX_COLL_RING,               ///< size - 1 steps reading the left neighbour. Allgather and allreduce.
+    SHMEMX_COLL_RECURSIVE_DOUBLING, ///< log2(size) steps reading member mype ^ 2^k. Allgather and allreduce on
+                                    ///< power-of-two teams, broadcast as a binomial tree.
+    SHMEMX_COLL_HIER,               ///< MTE within hosts, host leaders across. Allgather and broadcast on teams
+                                    ///< spanning hosts.
+    SHMEMX_COLL_LL_ONE_SHOT,        ///< Every member stores its source into all peers, flags instead of barriers.
+                                    ///< Allreduce on teams within one host, small messages.
+    SHMEMX_COLL_LL_TWO_SHOT,        ///< Member i gets slice i stored by all peers and stores the reduced slice back,
+                                    ///< flags instead of barriers. Allreduce on teams within one host.
+    SHMEMX_COLL_PIPE_RING,          ///< Ring whose chunks are pushed to the right neighbour with a signal, the
+                                    ///< reduction of a chunk overlaps the transfer of the next. Allreduce. Chunks
+                                    ///< of a core rotate over its own QPs, several only with fewer cores than QPs.
+    SHMEMX_COLL_ALGO_NUM
+};
+
+/**
+ * @brief Wire formats of the quantized collectives, see shmemi_device_quant.h for details.
+ */
+enum shmemx_quant_format_t {
+    SHMEMX_QUANT_BF16 = 0,          ///< float cast to bfloat16 with round to nearest even, no scales.
+    SHMEMX_QUANT_INT8,              ///< Symmetric int8, one float scale per block_size elements, absmax / 127.
+    SHMEMX_QUANT_FORMAT_NUM
+};
+
+/**
+ * @brief Configuration of the quantized collectives. Addresses are device addresses.
+ */
+typedef struct {
+    int32_t format;         ///< shmemx_quant_format_t.
+    uint32_t block_size;    ///< Elements per scale, a power of two in [32, 2048]. Slices are cut at block
+                            ///< boundaries for every format.
+    uint64_t work;          ///< 'void *' symmetric, shmemx_quant_work_size bytes, holds the quantized elements.
+                            ///< 0 for the scratch of the team, see shmemx_team_get_scratch, which the call
+                            ///< then owns: kernels keeping flags in that scratch must not share it.
+    uint64_t error;         ///< 'float *' local error feedback of the source elements, 0 to disable. Added to the
+                            ///< source before quantizing, then replaced by what the quantization lost.
+} shmemx_quant_config_t;
+
+/**
+ * @brief Operations of a work queue descriptor, see shmemx_host_work.h for details.
+ */
+enum shmemx_work_op_t {
+    SHMEMX_WORK_NOP = 0,            ///< Completes without moving data.
+    SHMEMX_WORK_PUT,                ///< size bytes from local source to symmetric dest on pe.
+    SHMEMX_WORK_GET,                ///< size bytes from symmetric source on pe to local dest.
+    SHMEMX_WORK_PUT_SIGNAL,         ///< PUT, then sig_op of signal on sig_addr of pe once the data has landed.
+    SHMEMX_WORK_SIGNAL,             ///< sig_op of signal on sig_addr of pe.
+    SHMEMX_WORK_BARRIER,            ///< Barrier of the team.
+    SHMEMX_WORK_ALLGATHER,          ///< size bytes per member of the team.
+    SHMEMX_WORK_BROADCAST,          ///< size bytes from member pe of the team.
+    SHMEMX_WORK_ALLTOALL,           ///< size bytes per pair of members of the team.
+    SHMEMX_WORK_REDUCE_SCATTER,     ///< size elements of dtype per member of the team, reduced with reduce_op.
+    SHMEMX_WORK_ALLREDUCE,          ///< size elements of dtype, reduced with reduce_op.
+    SHMEMX_WORK_OP_NUM
+};
+
+/**
+ * @brief Element types of the reductions of a work queue descriptor, see SHMEM_HOST_REDUCE_TYPE_FUNC.
+ */
+enum shmemx_work_dtype_t {
+    SHMEMX_WORK_HALF = 0,
+    SHMEMX_WORK_BFLOAT16,
+    SHMEMX_WORK_FLOAT,
+    SHMEMX_WORK_INT16,
+    SHMEMX_WORK_INT32,
+    SHMEMX_WORK_DTYPE_NUM
+};
+
+/**
+ * @brief Flags of shmemx_work_queue_start.
+ */
+enum {
+    SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS = 0x1,  ///< Kernels submit too, every producer takes tickets atomically.
+};
+
+/**
+ * @brief Descriptor of an operation run by the persistent communication kernel. Addresses are device addresses,
+ *        fields an operation does not use are ignored.
+ */
+typedef struct {
+    int32_t op;             ///< shmemx_work_op_t.
+    int32_t team;           ///< Team of barriers and collectives.
+    int32_t pe;             ///< Target PE of RMA and signals, root of broadcasts in team view.
+    int32_t dtype;          ///< shmemx_work_dtype_t of reductions.
+    int32_t reduce_op;      ///< shmemi_reduce_op_t of reductions.
+    int32_t sig_op;         ///< SHMEM_SIGNAL_SET or SHMEM_SIGNAL_ADD.
+    int32_t signal;         ///< Operand of sig_op.
+    int32_t done_value;     ///< Stored to done_flag once the operation has completed on the calling PE.
+    uint64_t dest;
+    uint64_t source;
+    uint64_t size;          ///< Bytes moved by RMA and data collectives, elements of reductions.
+    uint64_t sig_addr;      ///< 'int32_t *' symmetric signal of PUT_SIGNAL and SIGNAL.
+    uint64_t done_flag;     ///< 'int32_t *' local completion flag, 0 for none.
+} shmemx_work_desc_t;
+
+/**
+ * @brief Team configuration.
  */
 typedef struct {
-    int num_contexts;
+    int num_contexts;   ///< Number of communication contexts created on the team.
 } shmem_team_config_t;
 
+/**
+ * @brief Usage of the scratch of a team seen from the calling PE, see shmemx_team_scratch_stats.
+ */
+typedef struct {
+    uint64_t size;          ///< Bytes of the scratch held by the team, 0 before its first use.
+    uint64_t target_size;   ///< Bytes the scratch gets when it is allocated, see shmemx_team_set_scratch_size.
+    uint64_t peak_request;  ///< Largest request, in bytes.
+    uint64_t requests;      ///< Requests served.
+    uint64_t failures;      ///< Requests refused, larger than the scratch held or not fitting in the arena.
+    uint64_t allocations;   ///< Times the scratch was taken from the arena.
+    uint64_t epoch;         ///< Epochs taken by vector core 0 on the team, see shmemx_team_epoch_next.
+    uint64_t arena_used;    ///< Bytes of the arena held by the teams of the calling PE.
+    uint64_t arena_size;    ///< Bytes of the arena, SHMEM_SCRATCH_ARENA_SIZE.
+} shmemx_team_scratch_stats_t;
+
 /**@} */ // end of group_enums
 
 /**
@@ -98,6 +285,11 @@ typedef struct {
 */
 typedef int shmem_team_t;
 
+/**
+ * @brief A typedef of int, index of a communication context
+*/
+typedef int shmem_ctx_t;
+
 /**@} */ // end of group_typedef
 
 #ifdef __cplusplus
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_AMO_H
+#define SHMEMI_DEVICE_AMO_H
+
+#include "kernel_operator.h"
+#include "internal/device/shmemi_device_common.h"
+#include "device/low_level/shmem_device_low_level_rma.h"
+#include "device/low_level/shmem_device_low_level_roce.h"
+#include "host/shmem_host_def.h"
+
+/*
+    Atomic memory operations (AMO).
+
+    MTE peers share the same HBM address space, so AMOs are issued directly from the scalar unit:
+        - non-fetching 32-bit add goes through the atomic store path (set_st_atomic_cfg + st_atomic),
+          which is the cheapest and also backs SHMEM_SIGNAL_ADD;
+        - fetch-add / swap / compare-swap use the GM scalar atomics;
+        - and / or / xor have no hardware counterpart and are built as compare-swap loops.
+
+    RoCE peers use RDMA atomics posted from AIV, which operate on naturally aligned 64-bit words only:
+        - 64-bit fetch-add and compare-swap map to OP_ATOMIC_FETCH_AND_ADD / OP_ATOMIC_CMP_AND_SWAP;
+        - everything else, including all 32-bit operations, is a compare-swap loop on the enclosing 64-bit word.
+    The NIC writes the original value into a per-core slot of the symmetric amo_fetch_pool, which is read back
+    after the WQE completes. RoCE AMOs are therefore always blocking.
+
+    The same slot stages the value of RoCE put-with-signal. SHMEM_SIGNAL_SET is an RDMA WRITE chained after the
+    payload on the same QP, SHMEM_SIGNAL_ADD is a RoCE AMO issued after the payload on the same QP. Either way the
+    signal lands after the data and the receiver only needs shmem_signal_wait_until. SHMEM_SIGNAL_ADD is not chained
+    as a 64-bit fetch-add: a carry out of the 32-bit signal would corrupt the other half of the word. It is therefore
+    blocking, also from the _nbi entry points.
+*/
+
+struct shmemi_amo_slot_t {
+    uint64_t fetch;             // written by the NIC for RDMA atomics
+    int32_t signal;             // source of the RDMA WRITE delivering a signal
+    uint32_t signal_pending;    // a signal WQE still reads from signal
+    uint32_t signal_pe;
+    uint32_t signal_qp;
+    uint32_t signal_wqe;        // SQ index of the pending signal WQE
+};
+
+SHMEM_DEVICE __gm__ shmemi_amo_slot_t *shmemi_amo_slot()
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    return reinterpret_cast<__gm__ shmemi_amo_slot_t *>(device_state->amo_fetch_pool +
+        (AscendC::GetBlockIdx() % SHMEM_MAX_AIV_PER_NPU) * SHMEM_AMO_FETCH_SLOT_SIZE);
+}
+
+template<typename T>
+SHMEM_DEVICE T shmemi_amo_apply(int op, T old, T value)
+{
+    switch (op) {
+        case SHMEMI_AMO_ADD:
+        case SHMEMI_AMO_FETCH_ADD:
+            return old + value;
+        case SHMEMI_AMO_SET:
+        case SHMEMI_AMO_SWAP:
+        case SHMEMI_AMO_COMPARE_SWAP:
+            return value;
+        case SHMEMI_AMO_AND:
+        case SHMEMI_AMO_FETCH_AND:
+            return old & value;
+        case SHMEMI_AMO_OR:
+        case SHMEMI_AMO_FETCH_OR:
+            return old | value;
+        case SHMEMI_AMO_XOR:
+        case SHMEMI_AMO_FETCH_XOR:
+            return old ^ value;
+        default:
+            return old;
+    }
+}
+
+template<typename T>
+SHMEM_DEVICE T shmemi_mte_atomic(__gm__ T *addr, T value, T cond, int op, int pe)
+{
+    __gm__ T *ptr = shmemi_ptr(addr, pe);
+    T old = 0;
+
+    // ensure previous atomic operations end
+    dcci_atomic();
+    dsb_all();
+
+    switch (op) {
+        case SHMEMI_AMO_ADD:
+            if constexpr (sizeof(T) == sizeof(int32_t)) {
+                set_st_atomic_cfg(ATOMIC_S32, ATOMIC_SUM);
+                st_atomic<int32_t>(static_cast<int32_t>(value), reinterpret_cast<__gm__ int32_t *>(ptr));
+            } else {
+                old = AscendC::AtomicAdd(ptr, value);
+            }
+            break;
+        case SHMEMI_AMO_FETCH_ADD:
+            old = AscendC::AtomicAdd(ptr, value);
+            break;
+        case SHMEMI_AMO_FETCH:
+            old = AscendC::AtomicAdd(ptr, static_cast<T>(0));
+            break;
+        case SHMEMI_AMO_SET:
+        case SHMEMI_AMO_SWAP:
+            old = AscendC::AtomicExch(ptr, value);
+            break;
+        case SHMEMI_AMO_COMPARE_SWAP:
+            old = AscendC::AtomicCas(ptr, cond, value);
+            break;
+        default: {
+            old = AscendC::AtomicAdd(ptr, static_cast<T>(0));
+            T prev;
+            while ((prev = AscendC::AtomicCas(ptr, old, shmemi_amo_apply(op, old, value))) != old) {
+                old = prev;
+            }
+            break;
+        }
+    }
+    dcci_atomic();
+    return old;
+}
+
+SHMEM_DEVICE uint64_t shmemi_roce_atomic64(__gm__ uint8_t *remote, __gm__ uint8_t *slot, int pe,
+                                           SHMEMAIVOPCODE opcode, uint64_t swap_add, uint64_t compare,
+                                           AscendC::LocalTensor<uint64_t> ub_tensor_64,
+                                           AscendC::LocalTensor<uint32_t> ub_tensor_32)
+{
+    uint32_t qp_idx;
+    uint32_t qp_step;
+    shmemi_roce_core_qps(qp_idx, qp_step);
+    shmemi_rdma_post_atomic(remote, slot, pe, qp_idx, opcode, swap_add, compare, ub_tensor_64, ub_tensor_32);
+    shmemi_roce_quiet(pe, qp_idx, ub_tensor_64, ub_tensor_32);
+    dcci_cachelines(slot, sizeof(uint64_t));
+    return *(__gm__ uint64_t *)slot;
+}
+
+template<typename T>
+SHMEM_DEVICE T shmemi_roce_atomic(__gm__ T *addr, T value, T cond, int op, int pe)
+{
+    __gm__ shmemi_device_host_state_t *device_state = shmemi_get_state();
+    auto ptr = shmem_roce_ptr(addr, pe);
+    if (ptr == nullptr) return 0;
+
+    /* Create LocalTensor */
+    AscendC::LocalTensor<uint32_t> ub_tensor_32;
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    AscendC::LocalTensor<uint64_t> ub_tensor_64;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+
+    // Per-core landing slot for the value returned by the NIC
+    __gm__ uint8_t *slot = reinterpret_cast<__gm__ uint8_t *>(&shmemi_amo_slot()->fetch);
+
+    // RDMA atomics work on aligned 64-bit words, 32-bit types live in the low or high half of one
+    uint64_t remote = reinterpret_cast<uint64_t>(ptr);
+    __gm__ uint8_t *word_addr = reinterpret_cast<__gm__ uint8_t *>(remote & ~(sizeof(uint64_t) - 1));
+    uint32_t shift = (remote & (sizeof(uint64_t) - 1)) * 8;
+    uint64_t mask = (sizeof(T) == sizeof(uint64_t)) ? ~0ULL : ((1ULL << (sizeof(T) * 8)) - 1);
+
+    if constexpr (sizeof(T) == sizeof(uint64_t)) {
+        switch (op) {
+            case SHMEMI_AMO_ADD:
+            case SHMEMI_AMO_FETCH_ADD:
+                return static_cast<T>(shmemi_roce_atomic64(word_addr, slot, pe, SHMEMAIVOPCODE::OP_ATOMIC_FETCH_AND_ADD,
+                    static_cast<uint64_t>(value), 0, ub_tensor_64, ub_tensor_32));
+            case SHMEMI_AMO_COMPARE_SWAP:
+                return static_cast<T>(shmemi_roce_atomic64(word_addr, slot, pe, SHMEMAIVOPCODE::OP_ATOMIC_CMP_AND_SWAP,
+                    static_cast<uint64_t>(value), static_cast<uint64_t>(cond), ub_tensor_64, ub_tensor_32));
+            default:
+                break;
+        }
+    }
+
+    // Fetch current word with a zero fetch-add, then retry compare-swap until no one races with us
+    uint64_t word = shmemi_roce_atomic64(word_addr, slot, pe, SHMEMAIVOPCODE::OP_ATOMIC_FETCH_AND_ADD, 0, 0,
+        ub_tensor_64, ub_tensor_32);
+    while (true) {
+        T old = static_cast<T>((word >> shift) & mask);
+        if (op == SHMEMI_AMO_FETCH || (op == SHMEMI_AMO_COMPARE_SWAP && old != cond)) {
+            return old;
+        }
+        T new_val = shmemi_amo_apply(op, old, value);
+        uint64_t new_word = (word & ~(mask << shift)) | ((static_cast<uint64_t>(new_val) & mask) << shift);
+        uint64_t prev = shmemi_roce_atomic64(word_addr, slot, pe, SHMEMAIVOPCODE::OP_ATOMIC_CMP_AND_SWAP, new_word,
+            word, ub_tensor_64, ub_tensor_32);
+        if (prev == word) {
+            return old;
+        }
+        word = prev;
+    }
+}
+
+SHMEM_DEVICE void shmemi_roce_signal_slot_acquire(__gm__ shmemi_amo_slot_t *slot,
+                                                  AscendC::LocalTensor<uint64_t> ub_tensor_64,
+                                                  AscendC::LocalTensor<uint32_t> ub_tensor_32)
+{
+    if (!slot->signal_pending) {
+        return;
+    }
+    // The previous signal WQE is done once the SQ consumer index moves past it
+    __gm__ SHMEMAIVRDMAInfo *rdma_info = (__gm__ SHMEMAIVRDMAInfo *)(shmemi_get_state()->qp_info);
+    __gm__ SHMEMWQCtx *wq_ctx = (__gm__ SHMEMWQCtx *)(rdma_info->sqPtr +
+        (slot->signal_pe * rdma_info->qpNum + slot->signal_qp) * sizeof(SHMEMWQCtx));
+    dcci_cachelines((__gm__ uint8_t *)wq_ctx->tailAddr, sizeof(uint32_t));
+    uint32_t tail = *(__gm__ uint32_t *)(wq_ctx->tailAddr);
+    if (static_cast<int32_t>(tail - slot->signal_wqe) <= 0) {
+        shmemi_roce_poll_cq(slot->signal_pe, slot->signal_qp, slot->signal_wqe + 1, ub_tensor_64, ub_tensor_32);
+    }
+    slot->signal_pending = 0;
+}
+
+/**
+ * @brief Put contiguous data to the specified PE over RoCE, then update sig_addr on that PE. Payload and signal
+ *        are posted on the first QP of the calling core so that the signal is ordered after the payload.
+ *
+ * @param dst               [in] Symmetric address of the destination data.
+ * @param src               [in] Local address of the source data.
+ * @param bytes             [in] Payload size in bytes.
+ * @param sig_addr          [in] Symmetric address of the signal word to be updated.
+ * @param signal            [in] The value used to update sig_addr.
+ * @param sig_op            [in] SHMEM_SIGNAL_SET or SHMEM_SIGNAL_ADD.
+ * @param pe                [in] The number of the remote PE.
+ * @param blocking          [in] Wait for the payload and the signal to complete before returning.
+ */
+SHMEM_DEVICE void shmemi_roce_put_signal(__gm__ uint8_t *dst, __gm__ uint8_t *src, uint64_t bytes,
+                                         __gm__ int32_t *sig_addr, int32_t signal, int sig_op, int pe, bool blocking)
+{
+    auto dst_ptr = shmem_roce_ptr(dst, pe);
+    auto sig_ptr = shmem_roce_ptr(sig_addr, pe);
+    if (dst_ptr == nullptr || sig_ptr == nullptr) return;
+
+    /* Create LocalTensor */
+    AscendC::LocalTensor<uint32_t> ub_tensor_32;
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    AscendC::LocalTensor<uint64_t> ub_tensor_64;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+
+    uint32_t qp_idx;
+    uint32_t qp_step;
+    shmemi_roce_core_qps(qp_idx, qp_step);
+
+    if (sig_op == SHMEM_SIGNAL_ADD) {
+        // RDMA atomics are 64-bit only, the 32-bit add is a blocking AMO ordered behind the payload on the same QP,
+        // even when the caller asked for _nbi
+        if (bytes > 0) {
+            shmemi_roce_write((__gm__ uint8_t *)dst_ptr, src, pe, qp_idx, bytes, ub_tensor_64, ub_tensor_32);
+        }
+        shmemi_roce_atomic<int32_t>(sig_addr, signal, 0, SHMEMI_AMO_ADD, pe);
+        return;
+    }
+
+    __gm__ shmemi_amo_slot_t *slot = shmemi_amo_slot();
+    shmemi_roce_signal_slot_acquire(slot, ub_tensor_64, ub_tensor_32);
+    slot->signal = signal;
+    dcci_cachelines(reinterpret_cast<__gm__ uint8_t *>(&slot->signal), sizeof(int32_t));
+
+    uint32_t sig_wqe = shmemi_rdma_post_write_signal((__gm__ uint8_t *)dst_ptr, src, bytes,
+        (__gm__ uint8_t *)sig_ptr, reinterpret_cast<__gm__ uint8_t *>(&slot->signal), sizeof(int32_t), pe, qp_idx,
+        ub_tensor_64, ub_tensor_32);
+    if (blocking) {
+        shmemi_roce_quiet(pe, qp_idx, ub_tensor_64, ub_tensor_32);
+        return;
+    }
+    slot->signal_pe = pe;
+    slot->signal_qp = qp_idx;
+    slot->signal_wqe = sig_wqe;
+    slot->signal_pending = 1;
+    dcci_cachelines(reinterpret_cast<__gm__ uint8_t *>(slot), sizeof(shmemi_amo_slot_t));
+}
+
+/**
+ * @brief Perform an atomic memory operation on the symmetric address on the specified PE.
+ *
+ * @param addr              [in] Symmetric address of the target on local PE.
+ * @param value             [in] Operand of the operation.
+ * @param cond              [in] Compared value, only used by SHMEMI_AMO_COMPARE_SWAP.
+ * @param op                [in] Operation in shmemi_amo_op_t.
+ * @param pe                [in] The number of the remote PE.
+ * @return Value of the target before the operation. Meaningless for SHMEMI_AMO_ADD over MTE.
+ */
+template<typename T>
+SHMEM_DEVICE T shmemi_atomic(__gm__ T *addr, T value, T cond, int op, int pe)
+{
+    auto device_state = shmemi_get_hot_state();
+    if (device_state->topo_list[pe] & SHMEM_TRANSPORT_MTE) {
+        return shmemi_mte_atomic(addr, value, cond, op, pe);
+    } else if (device_state->topo_list[pe] & SHMEM_TRANSPORT_ROCE) {
+        return shmemi_roce_atomic(addr, value, cond, op, pe);
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,1510 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_COLL_H
+#define SHMEMI_DEVICE_COLL_H
+
+#include "kernel_operator.h"
+#include "host/shmem_host_def.h"
+#include "internal/device/shmemi_device_common.h"
+#include "internal/device/shmemi_device_team.h"
+#include "internal/device/sync/shmemi_device_quiet.h"
+#include "internal/device/sync/shmemi_device_barrier.h"
+#include "device/low_level/shmem_device_low_level_rma.h"
+#include "device/low_level/shmem_device_low_level_roce.h"
+
+/*
+    Collectives over a team.
+
+    All vector cores of every member PE call the collective with the same arguments. The members first agree that
+    the sources are ready with a team barrier, then every vector core pulls its share of the elements from the peers
+    into the local destination, and a closing team barrier keeps sources and destinations in place until every peer
+    is done with them. Peers reachable over MTE are read directly, the others with RoCE reads.
+
+    The algorithm is looked up in the team descriptor by collective and bytes per PE, see shmemi_coll_algo. Steps of
+    multi-step algorithms are separated by team barriers, each step reading what the peers wrote in the previous one.
+
+        - one-shot:             every member reads all peers at once, peers are visited starting from the next
+                                member so that members do not all read the same PE at once.
+                                allreduce with dest aliasing source falls back to two-shot.
+        - two-shot:             allreduce, member i reduces slice i of the elements into its dest, then the slices
+                                are gathered from the dest of their owners.
+        - ring:                 allgather, step s reads block mype - s from the dest of the left neighbour.
+                                allreduce, a ring reduce-scatter of size slices, the left partial of a slice is
+                                reduced with the local source, then a ring allgather of the reduced slices.
+        - recursive doubling:   allgather, step k reads the 2^k blocks gathered by member mype ^ 2^k.
+                                allreduce, recursive halving of the slices down to slice mype, then recursive
+                                doubling of the reduced slices. Both need a power-of-two team and use ring otherwise.
+                                broadcast, a binomial tree, members [2^k, 2^(k+1)) from the root read from member
+                                rel - 2^k at step k.
+        - hierarchical:         allgather, members gather their host over MTE, host leaders read the blocks of the
+                                other hosts from their leaders, the other members copy them from their leader.
+                                broadcast, the root host and the host leaders read the root, the other members
+                                read their leader.
+        - low-latency:          allreduce within a host, members store into the peers instead of reading them,
+                                and flags set along the data replace the team barriers, see the section below.
+        - pipelined ring:       allreduce, the steps of ring pushed to the right neighbour in chunks written with a
+                                signal, no barrier between the steps, see the section below.
+
+    Semantics:
+        - allgather:        dest[i * nelems, (i + 1) * nelems) = source of member i
+        - broadcast:        dest = source of the root
+        - alltoall:         dest[i * nelems, (i + 1) * nelems) = source[mype * nelems, (mype + 1) * nelems) of member i
+        - alltoallv:        the block of send_counts[mype] elements of member i lands in dest after the blocks of the
+                            members before i, or at i * dest_stride, see the alltoallv section.
+        - reduce_scatter:   dest = op over members i of source[mype * nelems, (mype + 1) * nelems) of member i
+        - allreduce:        dest = op over members of source, dest may alias source.
+
+    Reductions run on the vector unit in chunks of SHMEMI_COLL_UB_CHUNK bytes of the accumulator in the UB area
+    [SHMEM_COLL_UB_OFFSET, SHMEM_COLL_UB_OFFSET + SHMEM_COLL_UB_SIZE), which kernels calling reductions must leave
+    alone. half and bfloat16 are accumulated in float and rounded once at the end, the vector unit has no bfloat16
+    arithmetic and half loses precision summed over many members. A chunk of a peer without MTE access is first read
+    into the destination of the chunk, which is overwritten by the result anyway.
+*/
+
+#define SHMEMI_COLL_UB_CHUNK (SHMEM_COLL_UB_SIZE / 3)
+#define SHMEMI_COLL_UB_ACC 0                                // accumulator
+#define SHMEMI_COLL_UB_IN SHMEMI_COLL_UB_CHUNK              // chunk of a peer
+#define SHMEMI_COLL_UB_IN_ACC (2 * SHMEMI_COLL_UB_CHUNK)    // chunk of a peer converted to the accumulator type
+
+template <typename T>
+struct shmemi_coll_acc {
+    using type = T;
+    static constexpr bool cast = false;
+};
+
+template <>
+struct shmemi_coll_acc<half> {
+    using type = float;
+    static constexpr bool cast = true;
+};
+
+template <>
+struct shmemi_coll_acc<bfloat16_t> {
+    using type = float;
+    static constexpr bool cast = true;
+};
+
+template <typename T>
+SHMEM_DEVICE __ubuf__ T *shmemi_coll_ub_ptr(uint32_t offset)
+{
+    return reinterpret_cast<__ubuf__ T *>(SHMEM_COLL_UB_OFFSET + offset);
+}
+
+template <typename T>
+SHMEM_DEVICE AscendC::LocalTensor<T> shmemi_coll_ub_tensor(uint32_t offset)
+{
+    AscendC::LocalTensor<T> tensor;
+    tensor.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECCALC);
+    tensor.address_.bufferAddr = reinterpret_cast<uint64_t>(shmemi_coll_ub_ptr<T>(offset));
+    tensor.address_.dataLen = SHMEMI_COLL_UB_CHUNK;
+    return tensor;
+}
+
+template <AscendC::HardEvent EVENT>
+SHMEM_DEVICE void shmemi_coll_pipe_sync()
+{
+    AscendC::SetFlag<EVENT>(EVENT_ID0);
+    AscendC::WaitFlag<EVENT>(EVENT_ID0);
+}
+
+// elements [offset, offset + count) of nelems handled by the calling vector core, split in blocks of 32 bytes
+template <typename T>
+SHMEM_DEVICE void shmemi_coll_core_range(size_t nelems, size_t &offset, size_t &count)
+{
+    size_t align = UB_ALIGN_SIZE / sizeof(T);
+    size_t core_num = AscendC::GetBlockNum() * AscendC::GetTaskRation();
+    size_t per_core = (nelems + core_num - 1) / core_num;
+    per_core = (per_core + align - 1) / align * align;
+    offset = per_core * AscendC::GetBlockIdx();
+    if (offset > nelems) {
+        offset = nelems;
+    }
+    count = (nelems - offset) < per_core ? (nelems - offset) : per_core;
+}
+
+// descriptor of the team, nullptr if the team is invalid or the calling PE is not a member
+SHMEM_DEVICE shmemi_team_t *shmemi_coll_team(shmem_team_t tid)
+{
+    if (tid < 0 || tid >= SHMEM_MAX_TEAMS) {
+        return nullptr;
+    }
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+    return shmemi_team_is_member(team) ? team : nullptr;
+}
+
+SHMEM_DEVICE bool shmemi_coll_is_mte(int pe)
+{
+    return (shmemi_get_hot_state()->topo_list[pe] & SHMEM_TRANSPORT_MTE) != 0;
+}
+
+SHMEM_DEVICE void shmemi_coll_roce_quiet(int pe)
+{
+    AscendC::LocalTensor<uint32_t> ub_tensor_32;
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    AscendC::LocalTensor<uint64_t> ub_tensor_64;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+    shmemi_roce_quiet_core(pe, ub_tensor_64, ub_tensor_32);
+}
+
+// completes the reads of the calling core from pe
+SHMEM_DEVICE void shmemi_coll_quiet_pe(int pe)
+{
+    if (!shmemi_coll_is_mte(pe)) {
+        shmemi_coll_roce_quiet(pe);
+    }
+    shmemi_quiet();
+}
+
+// completes the reads of the calling core from the members of the team
+SHMEM_DEVICE void shmemi_coll_quiet(shmemi_team_t *team)
+{
+    for (int i = 0; i < team->size; i++) {
+        int pe = shmemi_team_global_pe(team, i);
+        if (!shmemi_coll_is_mte(pe)) {
+            shmemi_coll_roce_quiet(pe);
+        }
+    }
+    shmemi_quiet();
+}
+
+// completes the reads of the calling core from the members on its host
+SHMEM_DEVICE void shmemi_coll_quiet_local(shmemi_team_t *team)
+{
+    for (int i = 0; i < team->local_size; i++) {
+        if (!shmemi_coll_is_mte(team->local_pes[i])) {
+            shmemi_coll_roce_quiet(team->local_pes[i]);
+        }
+    }
+    shmemi_quiet();
+}
+
+// completes the reads of the calling core from the leaders of the other hosts
+SHMEM_DEVICE void shmemi_coll_quiet_leaders(shmemi_team_t *team)
+{
+    for (int i = 0; i < team->host_num; i++) {
+        if (i != team->host_rank && !shmemi_coll_is_mte(team->leader_pes[i])) {
+            shmemi_coll_roce_quiet(team->leader_pes[i]);
+        }
+    }
+    shmemi_quiet();
+}
+
+SHMEM_DEVICE bool shmemi_coll_is_pow2(int n)
+{
+    return (n & (n - 1)) == 0;
+}
+
+// algorithm of the collective op for nbytes per PE, falls back to one that can span the team
+SHMEM_DEVICE int shmemi_coll_algo(shmemi_team_t *team, int op, size_t nbytes)
+{
+    if (team->size == 1) {
+        return SHMEMX_COLL_ONE_SHOT;
+    }
+    shmemi_coll_tune_t *tune = &team->coll_tune[op];
+    if (tune->range_num <= 0) {
+        return op == SHMEMX_COLL_ALLREDUCE ? SHMEMX_COLL_TWO_SHOT : SHMEMX_COLL_ONE_SHOT;
+    }
+    int i = 0;
+    while (i + 1 < tune->range_num && nbytes > tune->max_bytes[i]) {
+        i++;
+    }
+    int algo = tune->algo[i];
+    if (algo == SHMEMX_COLL_RECURSIVE_DOUBLING && op != SHMEMX_COLL_BROADCAST && !shmemi_coll_is_pow2(team->size)) {
+        return SHMEMX_COLL_RING;
+    }
+    if (algo == SHMEMX_COLL_HIER && team->host_num <= 1) {
+        return SHMEMX_COLL_ONE_SHOT;
+    }
+    return algo;
+}
+
+// first element of slice idx when nelems are cut in parts slices of 32-byte multiples, nelems for idx == parts
+template <typename T>
+SHMEM_DEVICE size_t shmemi_coll_slice_offset(size_t nelems, int parts, int idx)
+{
+    size_t align = UB_ALIGN_SIZE / sizeof(T);
+    size_t slice = (nelems + parts - 1) / parts;
+    slice = (slice + align - 1) / align * align;
+    return slice * idx < nelems ? slice * idx : nelems;
+}
+
+// copies nelems elements of the symmetric src on pe to the local dst
+template <typename T>
+SHMEM_DEVICE void shmemi_coll_get(__gm__ T *dst, __gm__ T *src, size_t nelems, int pe)
+{
+    if (nelems == 0) {
+        return;
+    }
+    auto device_state = shmemi_get_hot_state();
+    if (shmemi_coll_is_mte(pe)) {
+        AscendC::TEventID event_id = (AscendC::TEventID)device_state->mte_config.event_id;
+        shmem_mte_get_mem_nbi(dst, src, reinterpret_cast<__ubuf__ T *>(device_state->mte_config.shmem_ub),
+                              device_state->mte_config.ub_size, (uint32_t)nelems, pe, event_id);
+        // the staging buffer is reused by the next copy
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+    } else {
+        shmem_roce_get_mem_nbi(dst, src, reinterpret_cast<__ubuf__ T *>(SHMEM_INTERNAL_UB_BUF_START_ADDR),
+                               (uint32_t)nelems, pe);
+    }
+}
+
+// copies nelems elements of the local src to the symmetric dst on pe, src must be in the symmetric heap for RoCE
+template <typename T>
+SHMEM_DEVICE void shmemi_coll_put(__gm__ T *dst, __gm__ T *src, size_t nelems, int pe)
+{
+    if (nelems == 0) {
+        return;
+    }
+    auto device_state = shmemi_get_hot_state();
+    if (shmemi_coll_is_mte(pe)) {
+        AscendC::TEventID event_id = (AscendC::TEventID)device_state->mte_config.event_id;
+        shmem_mte_put_mem_nbi(dst, src, reinterpret_cast<__ubuf__ T *>(device_state->mte_config.shmem_ub),
+                              device_state->mte_config.ub_size, (uint32_t)nelems, pe, event_id);
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+    } else {
+        shmem_roce_put_mem_nbi(dst, src, reinterpret_cast<__ubuf__ T *>(SHMEM_INTERNAL_UB_BUF_START_ADDR),
+                               (uint32_t)nelems, pe);
+    }
+}
+
+// shmemi_coll_put, then sets sig_addr on pe to val once the elements have landed, the RoCE signal completes with
+// the next quiet of pe
+template <typename T>
+SHMEM_DEVICE void shmemi_coll_put_signal(__gm__ T *dst, __gm__ T *src, size_t nelems, __gm__ int32_t *sig_addr,
+                                         int32_t val, int pe)
+{
+    if (shmemi_coll_is_mte(pe)) {
+        shmemi_coll_put(dst, src, nelems, pe);
+        shmemi_quiet();
+        shmemi_signal_set(sig_addr, pe, val);
+    } else {
+        shmemi_roce_put_signal((__gm__ uint8_t *)dst, (__gm__ uint8_t *)src, nelems * sizeof(T), sig_addr, val,
+                               SHMEM_SIGNAL_SET, pe, false);
+    }
+}
+
+template <int OP, typename T>
+SHMEM_DEVICE void shmemi_coll_op(const AscendC::LocalTensor<T> &acc, const AscendC::LocalTensor<T> &in, uint32_t n)
+{
+    if constexpr (OP == SHMEMI_REDUCE_SUM) {
+        AscendC::Add(acc, acc, in, n);
+    } else if constexpr (OP == SHMEMI_REDUCE_MAX) {
+        AscendC::Max(acc, acc, in, n);
+    } else if constexpr (OP == SHMEMI_REDUCE_MIN) {
+        AscendC::Min(acc, acc, in, n);
+    } else {
+        AscendC::Mul(acc, acc, in, n);
+    }
+}
+
+// shmemi_coll_get of the share of the calling core
+template <typename T>
+SHMEM_DEVICE void shmemi_coll_get_split(__gm__ T *dst, __gm__ T *src, size_t nelems, int pe)
+{
+    size_t offset;
+    size_t count;
+    shmemi_coll_core_range<T>(nelems, offset, count);
+    shmemi_coll_get(dst + offset, src + offset, count, pe);
+}
+
+/* Reduces n elements of local and of remote on num peers into the local dst, n fits in one UB chunk. The peers are
+   the members first, first + 1, ... in team view, wrapping around, and remote is a symmetric address. local may
+   alias dst. */
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_coll_reduce_chunk(shmemi_team_t *team, __gm__ T *dst, __gm__ T *local, __gm__ T *remote,
+                                           int first, int num, uint32_t n)
+{
+    using acc_t = typename shmemi_coll_acc<T>::type;
+    constexpr bool cast = shmemi_coll_acc<T>::cast;
+    auto acc = shmemi_coll_ub_tensor<acc_t>(SHMEMI_COLL_UB_ACC);
+    auto in = shmemi_coll_ub_tensor<T>(SHMEMI_COLL_UB_IN);
+    auto in_acc = shmemi_coll_ub_tensor<acc_t>(SHMEMI_COLL_UB_IN_ACC);
+
+    // the local input initializes the accumulator
+    if constexpr (cast) {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), local, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        AscendC::Cast(acc, in, AscendC::RoundMode::CAST_NONE, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE2>();
+    } else {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_ACC), local, n * sizeof(T));
+    }
+
+    for (int i = 0; i < num; i++) {
+        int pe = shmemi_team_global_pe(team, (first + i) % team->size);
+        __gm__ T *peer_src = dst;
+        if (shmemi_coll_is_mte(pe)) {
+            peer_src = reinterpret_cast<__gm__ T *>(shmem_ptr(remote, pe));
+        } else {
+            // local may alias dst, it must be in UB before the RoCE read lands
+            AscendC::PipeBarrier<PIPE_ALL>();
+            shmem_roce_get_mem_nbi(dst, remote, reinterpret_cast<__ubuf__ T *>(SHMEM_INTERNAL_UB_BUF_START_ADDR), n,
+                                   pe);
+            shmemi_coll_roce_quiet(pe);
+        }
+
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), peer_src, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        if constexpr (cast) {
+            AscendC::Cast(in_acc, in, AscendC::RoundMode::CAST_NONE, n);
+            AscendC::PipeBarrier<PIPE_V>();
+            shmemi_coll_op<OP>(acc, in_acc, n);
+        } else {
+            shmemi_coll_op<OP>(acc, in, n);
+        }
+        // the next peer is loaded into the buffer just consumed
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE2>();
+    }
+
+    if constexpr (cast) {
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Cast(in, acc, AscendC::RoundMode::CAST_RINT, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+        shmemi_copy_ub2gm(dst, shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), n * sizeof(T));
+    } else {
+        if (num == 0) {
+            shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_MTE3>();
+        } else {
+            shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+        }
+        shmemi_copy_ub2gm(dst, shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_ACC), n * sizeof(T));
+    }
+    // the next chunk is loaded into the buffer just stored
+    shmemi_coll_pipe_sync<AscendC::HardEvent::MTE3_MTE2>();
+}
+
+// shmemi_coll_reduce_chunk over the share of nelems of the calling core
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_coll_reduce_split(shmemi_team_t *team, __gm__ T *dst, __gm__ T *local, __gm__ T *remote,
+                                           int first, int num, size_t nelems)
+{
+    constexpr size_t chunk = SHMEMI_COLL_UB_CHUNK / sizeof(typename shmemi_coll_acc<T>::type);
+    size_t core_offset;
+    size_t count;
+    shmemi_coll_core_range<T>(nelems, core_offset, count);
+    for (size_t offset = core_offset; offset < core_offset + count; offset += chunk) {
+        size_t n = (core_offset + count - offset) < chunk ? (core_offset + count - offset) : chunk;
+        shmemi_coll_reduce_chunk<T, OP>(team, dst + offset, local + offset, remote + offset, first, num, (uint32_t)n);
+    }
+}
+
+// local reductions
+
+/* dst = op over blocks i in [0, num) of src + i * stride for n elements, n fits in one UB chunk, num is at least 1.
+   Buffers are in the GM of the calling PE, dst may alias the first block. */
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_coll_reduce_local_chunk(__gm__ T *dst, __gm__ T *src, int num, size_t stride, uint32_t n)
+{
+    using acc_t = typename shmemi_coll_acc<T>::type;
+    constexpr bool cast = shmemi_coll_acc<T>::cast;
+    auto acc = shmemi_coll_ub_tensor<acc_t>(SHMEMI_COLL_UB_ACC);
+    auto in = shmemi_coll_ub_tensor<T>(SHMEMI_COLL_UB_IN);
+    auto in_acc = shmemi_coll_ub_tensor<acc_t>(SHMEMI_COLL_UB_IN_ACC);
+
+    // the first block initializes the accumulator
+    if constexpr (cast) {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), src, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        AscendC::Cast(acc, in, AscendC::RoundMode::CAST_NONE, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE2>();
+    } else {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_ACC), src, n * sizeof(T));
+    }
+
+    for (int i = 1; i < num; i++) {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), src + i * stride, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        if constexpr (cast) {
+            AscendC::Cast(in_acc, in, AscendC::RoundMode::CAST_NONE, n);
+            AscendC::PipeBarrier<PIPE_V>();
+            shmemi_coll_op<OP>(acc, in_acc, n);
+        } else {
+            shmemi_coll_op<OP>(acc, in, n);
+        }
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE2>();
+    }
+
+    if constexpr (cast) {
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Cast(in, acc, AscendC::RoundMode::CAST_RINT, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+        shmemi_copy_ub2gm(dst, shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), n * sizeof(T));
+    } else {
+        if (num == 1) {
+            shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_MTE3>();
+        } else {
+            shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+        }
+        shmemi_copy_ub2gm(dst, shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_ACC), n * sizeof(T));
+    }
+    shmemi_coll_pipe_sync<AscendC::HardEvent::MTE3_MTE2>();
+}
+
+// shmemi_coll_reduce_local_chunk over the share of nelems of the calling core
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_coll_reduce_local(__gm__ T *dst, __gm__ T *src, int num, size_t stride, size_t nelems)
+{
+    constexpr size_t chunk = SHMEMI_COLL_UB_CHUNK / sizeof(typename shmemi_coll_acc<T>::type);
+    if (num < 1) {
+        return;
+    }
+    size_t core_offset;
+    size_t count;
+    shmemi_coll_core_range<T>(nelems, core_offset, count);
+    for (size_t offset = core_offset; offset < core_offset + count; offset += chunk) {
+        size_t n = (core_offset + count - offset) < chunk ? (core_offset + count - offset) : chunk;
+        shmemi_coll_reduce_local_chunk<T, OP>(dst + offset, src + offset, num, stride, (uint32_t)n);
+    }
+}
+
+// allgather
+
+template <typename T>
+SHMEM_DEVICE void shmemi_allgather_one_shot(shmemi_team_t *team, __gm__ T *dest, __gm__ T *source, size_t nelems)
+{
+    for (int i = 0; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        shmemi_coll_get_split(dest + peer * nelems, source, nelems, shmemi_team_global_pe(team, peer));
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_allgather_ring(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                        size_t nelems)
+{
+    int left_pe = shmemi_team_global_pe(team, (team->mype + team->size - 1) % team->size);
+    shmemi_coll_get_split(dest + team->mype * nelems, source, nelems, shmemi_team_global_pe(team, team->mype));
+    for (int s = 1; s < team->size; s++) {
+        shmemi_coll_quiet_pe(left_pe);
+        shmemi_barrier<true>(tid);
+        __gm__ T *block = dest + ((team->mype + team->size - s) % team->size) * nelems;
+        shmemi_coll_get_split(block, block, nelems, left_pe);
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_allgather_rd(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                      size_t nelems)
+{
+    int prev_pe = shmemi_team_global_pe(team, team->mype);
+    shmemi_coll_get_split(dest + team->mype * nelems, source, nelems, prev_pe);
+    for (int step = 1; step < team->size; step <<= 1) {
+        shmemi_coll_quiet_pe(prev_pe);
+        shmemi_barrier<true>(tid);
+        // the partner holds the step blocks of its aligned group
+        int partner = team->mype ^ step;
+        __gm__ T *blocks = dest + (partner & ~(step - 1)) * nelems;
+        prev_pe = shmemi_team_global_pe(team, partner);
+        shmemi_coll_get_split(blocks, blocks, step * nelems, prev_pe);
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_allgather_hier(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                        size_t nelems)
+{
+    for (int i = 0; i < team->local_size; i++) {
+        int pe = team->local_pes[(team->local_rank + i) % team->local_size];
+        shmemi_coll_get_split(dest + shmemi_team_pe(team, pe) * nelems, source, nelems, pe);
+    }
+    shmemi_coll_quiet_local(team);
+    shmemi_barrier<true>(tid);
+
+    if (team->local_rank == 0) {
+        for (int i = 0; i < team->size; i++) {
+            int host = shmemi_team_pe_host(team, i);
+            if (host != team->host_rank) {
+                shmemi_coll_get_split(dest + i * nelems, dest + i * nelems, nelems, team->leader_pes[host]);
+            }
+        }
+        shmemi_coll_quiet_leaders(team);
+    }
+    shmemi_barrier<true>(tid);
+
+    if (team->local_rank != 0) {
+        for (int i = 0; i < team->size; i++) {
+            if (shmemi_team_pe_host(team, i) != team->host_rank) {
+                shmemi_coll_get_split(dest + i * nelems, dest + i * nelems, nelems, team->local_pes[0]);
+            }
+        }
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE int shmemi_allgather(shmem_team_t tid, __gm__ T *dest, __gm__ T *source, size_t nelems)
+{
+    if ASCEND_IS_AIC {
+        return SHMEM_SUCCESS;
+    }
+    shmemi_team_t *team = shmemi_coll_team(tid);
+    if (team == nullptr) {
+        return SHMEM_INVALID_PARAM;
+    }
+
+    shmemi_barrier<true>(tid);
+    switch (shmemi_coll_algo(team, SHMEMX_COLL_ALLGATHER, nelems * sizeof(T))) {
+        case SHMEMX_COLL_RING:
+            shmemi_allgather_ring(tid, team, dest, source, nelems);
+            break;
+        case SHMEMX_COLL_RECURSIVE_DOUBLING:
+            shmemi_allgather_rd(tid, team, dest, source, nelems);
+            break;
+        case SHMEMX_COLL_HIER:
+            shmemi_allgather_hier(tid, team, dest, source, nelems);
+            break;
+        default:
+            shmemi_allgather_one_shot(team, dest, source, nelems);
+            break;
+    }
+    shmemi_coll_quiet(team);
+    shmemi_barrier<true>(tid);
+    return SHMEM_SUCCESS;
+}
+
+// broadcast
+
+template <typename T>
+SHMEM_DEVICE void shmemi_broadcast_binomial(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                            size_t nelems, int pe_root)
+{
+    int rel = (team->mype - pe_root + team->size) % team->size;
+    if (rel == 0) {
+        shmemi_coll_get_split(dest, source, nelems, shmemi_team_global_pe(team, team->mype));
+    }
+    for (int step = 1; step < team->size; step <<= 1) {
+        shmemi_quiet();
+        shmemi_barrier<true>(tid);
+        if (rel >= step && rel < 2 * step) {
+            int pe = shmemi_team_global_pe(team, (rel - step + pe_root) % team->size);
+            shmemi_coll_get_split(dest, dest, nelems, pe);
+            shmemi_coll_quiet_pe(pe);
+        }
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_broadcast_hier(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                        size_t nelems, int pe_root)
+{
+    int root = shmemi_team_global_pe(team, pe_root);
+    bool root_host = shmemi_team_pe_host(team, pe_root) == team->host_rank;
+    if (root_host || team->local_rank == 0) {
+        shmemi_coll_get_split(dest, source, nelems, root);
+        shmemi_coll_quiet_pe(root);
+    }
+    shmemi_barrier<true>(tid);
+    if (!root_host && team->local_rank != 0) {
+        shmemi_coll_get_split(dest, dest, nelems, team->local_pes[0]);
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE int shmemi_broadcast(shmem_team_t tid, __gm__ T *dest, __gm__ T *source, size_t nelems, int pe_root)
+{
+    if ASCEND_IS_AIC {
+        return SHMEM_SUCCESS;
+    }
+    shmemi_team_t *team = shmemi_coll_team(tid);
+    if (team == nullptr || pe_root < 0 || pe_root >= team->size) {
+        return SHMEM_INVALID_PARAM;
+    }
+
+    shmemi_barrier<true>(tid);
+    int root = shmemi_team_global_pe(team, pe_root);
+    switch (shmemi_coll_algo(team, SHMEMX_COLL_BROADCAST, nelems * sizeof(T))) {
+        case SHMEMX_COLL_RECURSIVE_DOUBLING:
+            shmemi_broadcast_binomial(tid, team, dest, source, nelems, pe_root);
+            break;
+        case SHMEMX_COLL_HIER:
+            shmemi_broadcast_hier(tid, team, dest, source, nelems, pe_root);
+            break;
+        default:
+            shmemi_coll_get_split(dest, source, nelems, root);
+            shmemi_coll_quiet_pe(root);
+            break;
+    }
+    shmemi_quiet();
+    shmemi_barrier<true>(tid);
+    return SHMEM_SUCCESS;
+}
+
+// alltoall, one-shot only
+
+template <typename T>
+SHMEM_DEVICE int shmemi_alltoall(shmem_team_t tid, __gm__ T *dest, __gm__ T *source, size_t nelems)
+{
+    if ASCEND_IS_AIC {
+        return SHMEM_SUCCESS;
+    }
+    shmemi_team_t *team = shmemi_coll_team(tid);
+    if (team == nullptr) {
+        return SHMEM_INVALID_PARAM;
+    }
+
+    shmemi_barrier<true>(tid);
+    for (int i = 0; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        shmemi_coll_get_split(dest + peer * nelems, source + team->mype * nelems, nelems,
+                              shmemi_team_global_pe(team, peer));
+    }
+    shmemi_coll_quiet(team);
+    shmemi_barrier<true>(tid);
+    return SHMEM_SUCCESS;
+}
+
+/* alltoallv, blocks of variable size, as exchanged by the token dispatch and combine of MoE layers.
+
+   The receivers do not know the sizes of their blocks, so core 0 of every member first stores its row of send
+   counts into the count pool of every member with a ready flag along, after which every member holds the count
+   matrix M, M[i][j] being the elements member i sends to member j. Each member derives from it where its blocks
+   land on the peers and what it receives without any further round: with a packed dest the block of member i lands
+   on member j behind those of the members before it, at the sum over k < i of M[k][j].
+
+   All vector cores then store their share of every block into the dest of its member, visiting the members from
+   the calling PE on, over MTE within the host and RoCE writes across. Once the stores of all cores have completed,
+   core 0 sets a done flag on every member, which replaces the closing team barrier: a member returns as soon as all
+   blocks addressed to it are in, whatever the peers still send to others.
+
+   The entry team barrier stays, the peers may still read their dest in the previous kernel, and it keeps the reset
+   of the flags at the end of a call before the puts of the next one, on the same team or on another, the pool is
+   shared by all teams and laid out for the world. */
+
+SHMEM_DEVICE __gm__ uint8_t *shmemi_coll_counts_pool()
+{
+    return (__gm__ uint8_t *)shmemi_get_state()->coll_counts_pool;
+}
+
+// flag of the local pool set by member writer, ready once its row of counts is written, done once its blocks are
+SHMEM_DEVICE __gm__ int32_t *shmemi_coll_counts_flag(bool done, int writer)
+{
+    uint64_t slot = (uint64_t)(done ? shmemi_get_state()->npes : 0) + writer;
+    return (__gm__ int32_t *)(shmemi_coll_counts_pool() + slot * SHMEMI_SYNCBIT_SIZE);
+}
+
+// send counts of member writer, row writer of the count matrix
+SHMEM_DEVICE __gm__ uint32_t *shmemi_coll_counts_row(int writer)
+{
+    int npes = shmemi_get_state()->npes;
+    return (__gm__ uint32_t *)(shmemi_coll_counts_pool() + SHMEM_COLL_COUNTS_ROW_OFFSET(npes) +
+                               writer * SHMEM_COLL_COUNTS_ROW_SIZE(npes));
+}
+
+// stores the send counts of the calling PE into its row of the count matrix of every member, core 0 only
+SHMEM_DEVICE void shmemi_alltoallv_counts_put(shmemi_team_t *team, __gm__ uint32_t *send_counts)
+{
+    __gm__ uint32_t *row = shmemi_coll_counts_row(team->mype);
+    dcci_cachelines((__gm__ uint8_t *)send_counts, team->size * sizeof(uint32_t));
+    for (int j = 0; j < team->size; j++) {
+        row[j] = send_counts[j];
+    }
+    dcci_cachelines((__gm__ uint8_t *)row, team->size * sizeof(uint32_t));
+    __gm__ int32_t *ready = shmemi_coll_counts_flag(false, team->mype);
+    shmemi_signal_set(ready, 1);
+    for (int i = 1; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        shmemi_coll_put_signal(row, row, team->size, ready, 1, shmemi_team_global_pe(team, peer));
+    }
+}
+
+// waits for the rows of all members, the count matrix can be read once it returns
+SHMEM_DEVICE void shmemi_alltoallv_counts_wait(shmemi_team_t *team)
+{
+    for (int i = 0; i < team->size; i++) {
+        shmemi_wait_until<int32_t>(shmemi_coll_counts_flag(false, i), SHMEM_CMP_EQ, 1);
+    }
+    dcci_cachelines((__gm__ uint8_t *)shmemi_coll_counts_row(0),
+                    team->size * SHMEM_COLL_COUNTS_ROW_SIZE(shmemi_get_state()->npes));
+}
+
+// elements of the block of member i stored into dest on member j, clamped to dest_stride if set
+SHMEM_DEVICE uint64_t shmemi_alltoallv_count(int i, int j, size_t dest_stride)
+{
+    uint64_t count = shmemi_coll_counts_row(i)[j];
+    return (dest_stride != 0 && count > dest_stride) ? dest_stride : count;
+}
+
+// first element of dest on member j receiving the block of member i
+SHMEM_DEVICE uint64_t shmemi_alltoallv_dest_offset(int i, int j, size_t dest_stride)
+{
+    if (dest_stride != 0) {
+        return (uint64_t)i * dest_stride;
+    }
+    uint64_t offset = 0;
+    for (int k = 0; k < i; k++) {
+        offset += shmemi_coll_counts_row(k)[j];
+    }
+    return offset;
+}
+
+// first element of the source of the calling PE sent to member j, packed in team order without send_offsets
+SHMEM_DEVICE uint64_t shmemi_alltoallv_source_offset(shmemi_team_t *team, int j, __gm__ uint32_t *send_offsets)
+{
+    if (send_offsets != nullptr) {
+        return send_offsets[j];
+    }
+    __gm__ uint32_t *row = shmemi_coll_counts_row(team->mype);
+    uint64_t offset = 0;
+    for (int k = 0; k < j; k++) {
+        offset += row[k];
+    }
+    return offset;
+}
+
+// blocks received by the calling PE that were cut to dest_stride, every core reads the same count matrix
+SHMEM_DEVICE uint32_t shmemi_alltoallv_cut_blocks(shmemi_team_t *team, size_t dest_stride)
+{
+    uint32_t cut = 0;
+    for (int i = 0; dest_stride != 0 && i < team->size; i++) {
+        cut += shmemi_coll_counts_row(i)[team->mype] > dest_stride ? 1 : 0;
+    }
+    return cut;
+}
+
+// counts of the calling PE as received, cut like the puts, and their offsets in dest, core 0 only
+SHMEM_DEVICE void shmemi_alltoallv_recv_info(shmemi_team_t *team, size_t dest_stride, __gm__ uint32_t *recv_counts,
+                                             __gm__ uint64_t *recv_offsets)
+{
+    uint64_t offset = 0;
+    for (int i = 0; i < team->size; i++) {
+        uint64_t count = shmemi_alltoallv_count(i, team->mype, dest_stride);
+        if (recv_counts != nullptr) {
+            recv_counts[i] = (uint32_t)count;
+        }
+        if (recv_offsets != nullptr) {
+            recv_offsets[i] = dest_stride != 0 ? (uint64_t)i * dest_stride : offset;
+        }
+        offset += count;
+    }
+    if (recv_counts != nullptr) {
+        dcci_cachelines((__gm__ uint8_t *)recv_counts, team->size * sizeof(uint32_t));
+    }
+    if (recv_offsets != nullptr) {
+        dcci_cachelines((__gm__ uint8_t *)recv_offsets, team->size * sizeof(uint64_t));
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE int shmemi_alltoallv(shmem_team_t tid, __gm__ T *dest, size_t dest_stride, __gm__ T *source,
+                                  __gm__ uint32_t *send_counts, __gm__ uint32_t *send_offsets,
+                                  __gm__ uint32_t *recv_counts, __gm__ uint64_t *recv_offsets,
+                                  __gm__ uint32_t *truncated = nullptr)
+{
+    if ASCEND_IS_AIC {
+        return SHMEM_SUCCESS;
+    }
+    shmemi_team_t *team = shmemi_coll_team(tid);
+    if (team == nullptr || send_counts == nullptr) {
+        return SHMEM_INVALID_PARAM;
+    }
+    bool leader_core = AscendC::GetBlockIdx() == 0;
+
+    shmemi_barrier<true>(tid);
+    if (leader_core) {
+        shmemi_alltoallv_counts_put(team, send_counts);
+    }
+    shmemi_alltoallv_counts_wait(team);
+    if (send_offsets != nullptr) {
+        dcci_cachelines((__gm__ uint8_t *)send_offsets, team->size * sizeof(uint32_t));
+    }
+
+    for (int i = 0; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        size_t offset;
+        size_t count;
+        shmemi_coll_core_range<T>(shmemi_alltoallv_count(team->mype, peer, dest_stride), offset, count);
+        shmemi_coll_put(dest + shmemi_alltoallv_dest_offset(team->mype, peer, dest_stride) + offset,
+                        source + shmemi_alltoallv_source_offset(team, peer, send_offsets) + offset, count,
+                        shmemi_team_global_pe(team, peer));
+    }
+    shmemi_coll_quiet(team);
+    shmemi_barrier_core<true>();
+
+    __gm__ int32_t *done = shmemi_coll_counts_flag(true, team->mype);
+    if (leader_core) {
+        for (int i = 0; i < team->size; i++) {
+            int peer = (team->mype + i) % team->size;
+            shmemi_barrier_signal_peer(done, shmemi_team_global_pe(team, peer), 1);
+        }
+        shmemi_alltoallv_recv_info(team, dest_stride, recv_counts, recv_offsets);
+    }
+    uint32_t cut = shmemi_alltoallv_cut_blocks(team, dest_stride);
+    if (leader_core && truncated != nullptr) {
+        *truncated = cut;
+        dcci_cachelines((__gm__ uint8_t *)truncated, sizeof(uint32_t));
+    }
+    for (int i = 0; i < team->size; i++) {
+        shmemi_wait_until<int32_t>(shmemi_coll_counts_flag(true, i), SHMEM_CMP_EQ, 1);
+    }
+
+    // every core is past its waits, the peers set the flags again only after the next entry barrier
+    shmemi_barrier_core<true>();
+    if (leader_core) {
+        for (int i = 0; i < team->size; i++) {
+            shmemi_signal_set(shmemi_coll_counts_flag(false, i), 0);
+            shmemi_signal_set(shmemi_coll_counts_flag(true, i), 0);
+        }
+    }
+    return cut != 0 ? SHMEM_INVALID_VALUE : SHMEM_SUCCESS;
+}
+
+// reduce_scatter, one-shot only, the partial sums of a ring would need a second buffer
+
+template <typename T, int OP>
+SHMEM_DEVICE int shmemi_reduce_scatter(shmem_team_t tid, __gm__ T *dest, __gm__ T *source, size_t nelems)
+{
+    if ASCEND_IS_AIC {
+        return SHMEM_SUCCESS;
+    }
+    shmemi_team_t *team = shmemi_coll_team(tid);
+    if (team == nullptr) {
+        return SHMEM_INVALID_PARAM;
+    }
+
+    shmemi_barrier<true>(tid);
+    __gm__ T *block = source + team->mype * nelems;
+    shmemi_coll_reduce_split<T, OP>(team, dest, block, block, team->mype + 1, team->size - 1, nelems);
+    shmemi_quiet();
+    shmemi_barrier<true>(tid);
+    return SHMEM_SUCCESS;
+}
+
+// allreduce
+
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_allreduce_two_shot(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                            size_t nelems)
+{
+    size_t lo = shmemi_coll_slice_offset<T>(nelems, team->size, team->mype);
+    size_t hi = shmemi_coll_slice_offset<T>(nelems, team->size, team->mype + 1);
+    shmemi_coll_reduce_split<T, OP>(team, dest + lo, source + lo, source + lo, team->mype + 1, team->size - 1, hi - lo);
+    shmemi_quiet();
+    shmemi_barrier<true>(tid);
+
+    for (int i = 1; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        lo = shmemi_coll_slice_offset<T>(nelems, team->size, peer);
+        hi = shmemi_coll_slice_offset<T>(nelems, team->size, peer + 1);
+        shmemi_coll_get_split(dest + lo, dest + lo, hi - lo, shmemi_team_global_pe(team, peer));
+    }
+}
+
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_allreduce_ring(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                        size_t nelems)
+{
+    int size = team->size;
+    int left = (team->mype + size - 1) % size;
+    int left_pe = shmemi_team_global_pe(team, left);
+
+    // step s reduces the partial of slice mype - 1 - s of the left neighbour, ending with slice mype + 1
+    for (int s = 0; s < size - 1; s++) {
+        if (s > 0) {
+            shmemi_coll_quiet_pe(left_pe);
+            shmemi_barrier<true>(tid);
+        }
+        int slice = (team->mype + 2 * size - 1 - s) % size;
+        size_t lo = shmemi_coll_slice_offset<T>(nelems, size, slice);
+        size_t hi = shmemi_coll_slice_offset<T>(nelems, size, slice + 1);
+        __gm__ T *remote = (s == 0 ? source : dest) + lo;
+        shmemi_coll_reduce_split<T, OP>(team, dest + lo, source + lo, remote, left, 1, hi - lo);
+    }
+
+    // step s copies slice mype - s, reduced by the left neighbour or forwarded by it
+    for (int s = 0; s < size - 1; s++) {
+        shmemi_coll_quiet_pe(left_pe);
+        shmemi_barrier<true>(tid);
+        int slice = (team->mype + size - s) % size;
+        size_t lo = shmemi_coll_slice_offset<T>(nelems, size, slice);
+        size_t hi = shmemi_coll_slice_offset<T>(nelems, size, slice + 1);
+        shmemi_coll_get_split(dest + lo, dest + lo, hi - lo, left_pe);
+    }
+}
+
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_allreduce_rd(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                      size_t nelems)
+{
+    int size = team->size;
+    int first = 0;
+    int num = size;
+    int partner_pe = -1;
+
+    // recursive halving, keep the half of the slices selected by the bit of mype, down to slice mype
+    for (int mask = size >> 1; mask > 0; mask >>= 1) {
+        if (partner_pe >= 0) {
+            shmemi_coll_quiet_pe(partner_pe);
+            shmemi_barrier<true>(tid);
+        }
+        num >>= 1;
+        if (team->mype & mask) {
+            first += num;
+        }
+        int partner = team->mype ^ mask;
+        size_t lo = shmemi_coll_slice_offset<T>(nelems, size, first);
+        size_t hi = shmemi_coll_slice_offset<T>(nelems, size, first + num);
+        __gm__ T *input = (partner_pe < 0 ? source : dest) + lo;
+        shmemi_coll_reduce_split<T, OP>(team, dest + lo, input, input, partner, 1, hi - lo);
+        partner_pe = shmemi_team_global_pe(team, partner);
+    }
+
+    // recursive doubling, the partner holds the reduced slices of its aligned group
+    for (int mask = 1; mask < size; mask <<= 1) {
+        shmemi_coll_quiet_pe(partner_pe);
+        shmemi_barrier<true>(tid);
+        int partner = team->mype ^ mask;
+        int base = partner & ~(mask - 1);
+        size_t lo = shmemi_coll_slice_offset<T>(nelems, size, base);
+        size_t hi = shmemi_coll_slice_offset<T>(nelems, size, base + mask);
+        partner_pe = shmemi_team_global_pe(team, partner);
+        shmemi_coll_get_split(dest + lo, dest + lo, hi - lo, partner_pe);
+    }
+}
+
+/* Pipelined ring allreduce, the slices and steps of ring, pushed to the right neighbour instead of read from the left
+   one, with no team barrier between the steps.
+
+   Step g handles slice mype - g: steps 1 to size - 1 receive the partial of the left neighbour into dest and reduce
+   it with the source in place, the last of them completing the slice, steps size to 2 * size - 2 receive reduced
+   slices, and every step but the last sends the slice on, the first one straight from the source. Every core cuts
+   its share of a slice into units of SHMEM_COLL_PIPE_CHUNK_SIZE bytes, handled in the same order at both ends of a
+   link, so the unit a core reduces overlaps the transfer of the next one it receives and of the last one it sent.
+
+   A unit is written together with a signal. Over RoCE the payload and the signal WQE are chained on one QP and
+   consecutive units of a core rotate over its QPs, the lanes; over MTE the copy is completed before the flag is set.
+   Lanes are the QPs the core owns, see shmemi_roce_core_qps, never shared with another core: a core has several
+   only when the launch has fewer AIV cores than qpNum, as a one-block device launch. A launch of every core, as the
+   stream wrappers use, has one lane per core, and the QPs carry units in parallel because the cores do.
+   The left neighbour sets the flag of a lane to the units sent on it in the call, unit k is there once the flag of
+   lane k % lanes reaches k / lanes + 1. Every unit lands in its own place of dest, so a sender running ahead never
+   overwrites data not consumed yet. The flags are reset by their owner before the opening team barrier, and a call
+   waits on every flag set for it, so no closing barrier is needed. dest aliasing source falls back to ring, the
+   partials of the left neighbour would overwrite the source. */
+
+// running unit counts and signals in flight of the calling core
+struct shmemi_coll_pipe_t {
+    int left_pe;
+    int right_pe;
+    uint32_t send_lanes;    // 1 over MTE, the QPs of the core over RoCE
+    uint32_t recv_lanes;
+    uint32_t first_qp;
+    uint32_t qp_step;
+    uint32_t sent;
+    uint32_t received;
+    uint32_t sig_wqe[SHMEM_COLL_PIPE_MAX_LANES][SHMEM_COLL_PIPE_SIG_DEPTH];   // SQ index of the signal of a word
+};
+
+SHMEM_DEVICE __gm__ uint8_t *shmemi_coll_pipe_pool()
+{
+    return (__gm__ uint8_t *)shmemi_get_state()->coll_pipe_pool;
+}
+
+// flag of a lane of the calling core, set by the same core of the left neighbour
+SHMEM_DEVICE __gm__ int32_t *shmemi_coll_pipe_flag(uint32_t lane)
+{
+    uint64_t slot = (uint64_t)AscendC::GetBlockIdx() * SHMEM_COLL_PIPE_MAX_LANES + lane;
+    return (__gm__ int32_t *)(shmemi_coll_pipe_pool() + slot * SHMEMI_SYNCBIT_SIZE);
+}
+
+// local word the NIC reads the value of signal round of a lane from, until the signal WQE completes
+SHMEM_DEVICE __gm__ int32_t *shmemi_coll_pipe_sig_word(uint32_t lane, uint32_t round)
+{
+    uint64_t slot = ((uint64_t)AscendC::GetBlockIdx() * SHMEM_COLL_PIPE_MAX_LANES + lane) * SHMEM_COLL_PIPE_SIG_DEPTH +
+                    round % SHMEM_COLL_PIPE_SIG_DEPTH;
+    return (__gm__ int32_t *)(shmemi_coll_pipe_pool() + SHMEM_COLL_PIPE_SIG_OFFSET + slot * SHMEMI_SYNCBIT_SIZE);
+}
+
+// QPs owned by the calling core towards pe, both ends of a link are launched alike and agree on it
+SHMEM_DEVICE uint32_t shmemi_coll_pipe_lanes(int pe)
+{
+    if (shmemi_coll_is_mte(pe)) {
+        return 1;
+    }
+    uint32_t first_qp;
+    uint32_t qp_step;
+    uint32_t count = shmemi_roce_core_qps(first_qp, qp_step);
+    return count < SHMEM_COLL_PIPE_MAX_LANES ? count : SHMEM_COLL_PIPE_MAX_LANES;
+}
+
+// resets the flags of the calling core, then agrees with the team that the sources are ready
+SHMEM_DEVICE void shmemi_coll_pipe_begin(shmem_team_t tid, shmemi_team_t *team, shmemi_coll_pipe_t *pipe)
+{
+    pipe->left_pe = shmemi_team_global_pe(team, (team->mype + team->size - 1) % team->size);
+    pipe->right_pe = shmemi_team_global_pe(team, (team->mype + 1) % team->size);
+    pipe->send_lanes = shmemi_coll_pipe_lanes(pipe->right_pe);
+    pipe->recv_lanes = shmemi_coll_pipe_lanes(pipe->left_pe);
+    shmemi_roce_core_qps(pipe->first_qp, pipe->qp_step);
+    pipe->sent = 0;
+    pipe->received = 0;
+    for (uint32_t lane = 0; lane < SHMEM_COLL_PIPE_MAX_LANES; lane++) {
+        *shmemi_coll_pipe_flag(lane) = 0;
+    }
+    dcci_cachelines((__gm__ uint8_t *)shmemi_coll_pipe_flag(0), SHMEM_COLL_PIPE_MAX_LANES * SHMEMI_SYNCBIT_SIZE);
+    shmemi_barrier<true>(tid);
+}
+
+// waits for the RoCE signal of round of a lane posted SHMEM_COLL_PIPE_SIG_DEPTH rounds ago, its word is reused
+SHMEM_DEVICE void shmemi_coll_pipe_sig_acquire(shmemi_coll_pipe_t *pipe, uint32_t lane, uint32_t round,
+                                               AscendC::LocalTensor<uint64_t> ub_tensor_64,
+                                               AscendC::LocalTensor<uint32_t> ub_tensor_32)
+{
+    if (round < SHMEM_COLL_PIPE_SIG_DEPTH) {
+        return;
+    }
+    uint32_t qp = pipe->first_qp + lane * pipe->qp_step;
+    uint32_t wqe = pipe->sig_wqe[lane][round % SHMEM_COLL_PIPE_SIG_DEPTH];
+    __gm__ SHMEMAIVRDMAInfo *rdma_info = (__gm__ SHMEMAIVRDMAInfo *)(shmemi_get_state()->qp_info);
+    __gm__ SHMEMWQCtx *wq_ctx = (__gm__ SHMEMWQCtx *)(rdma_info->sqPtr +
+        (pipe->right_pe * rdma_info->qpNum + qp) * sizeof(SHMEMWQCtx));
+    dcci_cachelines((__gm__ uint8_t *)wq_ctx->tailAddr, sizeof(uint32_t));
+    uint32_t tail = *(__gm__ uint32_t *)(wq_ctx->tailAddr);
+    if (static_cast<int32_t>(tail - wqe) <= 0) {
+        shmemi_roce_poll_cq(pipe->right_pe, qp, wqe + 1, ub_tensor_64, ub_tensor_32);
+    }
+}
+
+// sends n elements of the local src to dst on the right neighbour as the next unit of the calling core
+template <typename T>
+SHMEM_DEVICE void shmemi_coll_pipe_send(shmemi_coll_pipe_t *pipe, __gm__ T *dst, __gm__ T *src, size_t n)
+{
+    uint32_t lane = pipe->sent % pipe->send_lanes;
+    uint32_t round = pipe->sent / pipe->send_lanes;
+    pipe->sent++;
+    __gm__ int32_t *flag = shmemi_coll_pipe_flag(lane);
+    if (shmemi_coll_is_mte(pipe->right_pe)) {
+        shmemi_coll_put_signal(dst, src, n, flag, (int32_t)round + 1, pipe->right_pe);
+        return;
+    }
+
+    AscendC::LocalTensor<uint32_t> ub_tensor_32;
+    ub_tensor_32.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_32.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR);
+    ub_tensor_32.address_.dataLen = UB_ALIGN_SIZE;
+    AscendC::LocalTensor<uint64_t> ub_tensor_64;
+    ub_tensor_64.address_.logicPos = static_cast<uint8_t>(AscendC::TPosition::VECOUT);
+    ub_tensor_64.address_.bufferAddr = reinterpret_cast<uint64_t>(SHMEM_INTERNAL_UB_BUF_START_ADDR + UB_ALIGN_SIZE);
+    ub_tensor_64.address_.dataLen = UB_ALIGN_SIZE;
+    shmemi_coll_pipe_sig_acquire(pipe, lane, round, ub_tensor_64, ub_tensor_32);
+    __gm__ int32_t *word = shmemi_coll_pipe_sig_word(lane, round);
+    *word = (int32_t)round + 1;
+    dcci_cachelines((__gm__ uint8_t *)word, sizeof(int32_t));
+    pipe->sig_wqe[lane][round % SHMEM_COLL_PIPE_SIG_DEPTH] = shmemi_rdma_post_write_signal(
+        (__gm__ uint8_t *)shmem_roce_ptr(dst, pipe->right_pe), (__gm__ uint8_t *)src, n * sizeof(T),
+        (__gm__ uint8_t *)shmem_roce_ptr(flag, pipe->right_pe), (__gm__ uint8_t *)word, sizeof(int32_t),
+        pipe->right_pe, pipe->first_qp + lane * pipe->qp_step, ub_tensor_64, ub_tensor_32);
+}
+
+// waits for the next unit of the calling core from the left neighbour
+SHMEM_DEVICE void shmemi_coll_pipe_wait(shmemi_coll_pipe_t *pipe)
+{
+    uint32_t lane = pipe->received % pipe->recv_lanes;
+    int32_t val = (int32_t)(pipe->received / pipe->recv_lanes) + 1;
+    pipe->received++;
+    shmemi_wait_until<int32_t>(shmemi_coll_pipe_flag(lane), SHMEM_CMP_GE, val);
+}
+
+// dst = dst op src for n elements, n fits in one UB chunk
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_coll_combine_chunk(__gm__ T *dst, __gm__ T *src, uint32_t n)
+{
+    using acc_t = typename shmemi_coll_acc<T>::type;
+    auto acc = shmemi_coll_ub_tensor<acc_t>(SHMEMI_COLL_UB_ACC);
+    auto in = shmemi_coll_ub_tensor<T>(SHMEMI_COLL_UB_IN);
+    auto in_acc = shmemi_coll_ub_tensor<acc_t>(SHMEMI_COLL_UB_IN_ACC);
+
+    if constexpr (shmemi_coll_acc<T>::cast) {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), dst, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        AscendC::Cast(acc, in, AscendC::RoundMode::CAST_NONE, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE2>();
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), src, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        AscendC::Cast(in_acc, in, AscendC::RoundMode::CAST_NONE, n);
+        AscendC::PipeBarrier<PIPE_V>();
+        shmemi_coll_op<OP>(acc, in_acc, n);
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Cast(in, acc, AscendC::RoundMode::CAST_RINT, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+        shmemi_copy_ub2gm(dst, shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), n * sizeof(T));
+    } else {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_ACC), dst, n * sizeof(T));
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), src, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        shmemi_coll_op<OP>(acc, in, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+        shmemi_copy_ub2gm(dst, shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_ACC), n * sizeof(T));
+    }
+    // the next chunk is loaded into the buffers just stored, and the unit may be sent from dst
+    shmemi_coll_pipe_sync<AscendC::HardEvent::MTE3_MTE2>();
+}
+
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_allreduce_pipe_ring(shmem_team_t tid, shmemi_team_t *team, __gm__ T *dest, __gm__ T *source,
+                                             size_t nelems)
+{
+    constexpr size_t unit = SHMEM_COLL_PIPE_CHUNK_SIZE / sizeof(T);
+    constexpr size_t chunk = SHMEMI_COLL_UB_CHUNK / sizeof(typename shmemi_coll_acc<T>::type);
+    int size = team->size;
+    shmemi_coll_pipe_t pipe;
+    shmemi_coll_pipe_begin(tid, team, &pipe);
+
+    for (int g = 0; g < 2 * size - 1; g++) {
+        int slice = (team->mype + 2 * size - g) % size;
+        size_t lo = shmemi_coll_slice_offset<T>(nelems, size, slice);
+        size_t hi = shmemi_coll_slice_offset<T>(nelems, size, slice + 1);
+        size_t core_offset;
+        size_t count;
+        shmemi_coll_core_range<T>(hi - lo, core_offset, count);
+        size_t end = lo + core_offset + count;
+        for (size_t offset = lo + core_offset; offset < end; offset += unit) {
+            size_t n = (end - offset) < unit ? (end - offset) : unit;
+            if (g > 0) {
+                shmemi_coll_pipe_wait(&pipe);
+            }
+            if (g > 0 && g < size) {
+                for (size_t c = 0; c < n; c += chunk) {
+                    uint32_t len = (uint32_t)((n - c) < chunk ? (n - c) : chunk);
+                    shmemi_coll_combine_chunk<T, OP>(dest + offset + c, source + offset + c, len);
+                }
+            }
+            if (g < 2 * size - 2) {
+                shmemi_coll_pipe_send(&pipe, dest + offset, (g == 0 ? source : dest) + offset, n);
+            }
+        }
+    }
+    // the sources of the units sent must stay in place until the NIC has read them
+    if (!shmemi_coll_is_mte(pipe.right_pe)) {
+        shmemi_coll_roce_quiet(pipe.right_pe);
+    }
+    shmemi_quiet();
+}
+
+/* Low-latency allreduce of teams within one host, no team barrier.
+
+   Each PE owns the symmetric pool at coll_ll_pool. Writers are identified by their index among the PEs of their
+   host in SHMEM_TEAM_WORLD, so that a data slot and its flags only ever get written by one peer whatever the team.
+   Every pair of PEs counts the low-latency calls they took part in together, the sequence of the pair, which
+   selects one of two data slots and flag sets by its parity and is the value the flags are set to. The writer of
+   call s + 1 into a slot of parity (s + 1) & 1 has finished call s, so it has seen the data of call s of the reader,
+   sent once the reader was done with call s - 1, the last one that used the slot. Flags are never reset, the
+   sequence only grows.
+
+        - ll one-shot:  every core stores its share of the source into slot mype of every peer over MTE, sets its
+                        flag there, then waits for the flags of its share and reduces the local source and the
+                        slots in UB into dest.
+        - ll two-shot:  slice i of the source goes to slot mype of member i, the owner of a slice reduces it in UB
+                        and stores the result into dest of every member through shmem_ptr, then sets a second flag.
+
+   Flags are per core, the reader core waits for the writer core with the same index, so all members run the call
+   with the same block dim, as for every collective. Teams of more than SHMEM_COLL_LL_MAX_PES members or with a
+   member out of MTE reach, and messages beyond a data slot fall back to one-shot or two-shot. */
+
+// host-local writer index and pair sequence of every member of the team for the current call, in team view
+struct shmemi_coll_ll_t {
+    int idx[SHMEM_COLL_LL_MAX_PES];
+    int32_t seq[SHMEM_COLL_LL_MAX_PES];
+};
+
+SHMEM_DEVICE __gm__ uint8_t *shmemi_coll_ll_pool()
+{
+    return (__gm__ uint8_t *)shmemi_get_state()->coll_ll_pool;
+}
+
+// flag of the local pool set by writer for core, phase 0 once the data slot is written, 1 once dest is
+SHMEM_DEVICE __gm__ int32_t *shmemi_coll_ll_flag(int phase, int32_t seq, int writer, int core)
+{
+    uint64_t slot = ((uint64_t)((seq & 1) * 2 + phase) * SHMEM_COLL_LL_MAX_PES + writer) * SHMEM_MAX_AIV_PER_NPU + core;
+    return (__gm__ int32_t *)(shmemi_coll_ll_pool() + slot * SHMEMI_SYNCBIT_SIZE);
+}
+
+// data slot of the local pool written by writer
+template <typename T>
+SHMEM_DEVICE __gm__ T *shmemi_coll_ll_slot(int32_t seq, int writer)
+{
+    uint64_t slot = (uint64_t)(seq & 1) * SHMEM_COLL_LL_MAX_PES + writer;
+    return (__gm__ T *)(shmemi_coll_ll_pool() + SHMEM_COLL_LL_DATA_OFFSET + slot * SHMEM_COLL_LL_SLOT_SIZE);
+}
+
+// last pair sequence per host-local index, local, written by core 0 only
+SHMEM_DEVICE __gm__ int32_t *shmemi_coll_ll_seqs()
+{
+    return (__gm__ int32_t *)(shmemi_coll_ll_pool() + SHMEM_COLL_LL_SEQ_OFFSET);
+}
+
+// fills the writer indexes of the members, false if the team can not run the low-latency allreduce
+SHMEM_DEVICE bool shmemi_coll_ll_members(shmemi_team_t *team, shmemi_coll_ll_t *ll)
+{
+    if (shmemi_get_state()->coll_ll_pool == 0 || team->size > SHMEM_COLL_LL_MAX_PES) {
+        return false;
+    }
+    shmemi_team_t *world = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD];
+    int local_size = world->local_size < SHMEM_COLL_LL_MAX_PES ? world->local_size : SHMEM_COLL_LL_MAX_PES;
+    for (int i = 0; i < team->size; i++) {
+        int pe = shmemi_team_global_pe(team, i);
+        if (!shmemi_coll_is_mte(pe)) {
+            return false;
+        }
+        ll->idx[i] = -1;
+        for (int j = 0; j < local_size; j++) {
+            if (world->local_pes[j] == pe) {
+                ll->idx[i] = j;
+                break;
+            }
+        }
+        if (ll->idx[i] < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// sequences of the call, the cores must not read them while core 0 stores those of the previous call
+SHMEM_DEVICE void shmemi_coll_ll_begin(shmemi_team_t *team, shmemi_coll_ll_t *ll)
+{
+    shmemi_barrier_core<true>();
+    auto seqs = shmemi_coll_ll_seqs();
+    dcci_cacheline((__gm__ uint8_t *)seqs);
+    for (int i = 0; i < team->size; i++) {
+        ll->seq[i] = seqs[ll->idx[i]] + 1;
+    }
+}
+
+SHMEM_DEVICE void shmemi_coll_ll_end(shmemi_team_t *team, shmemi_coll_ll_t *ll)
+{
+    shmemi_barrier_core<true>();
+    if (AscendC::GetBlockIdx() != 0) {
+        return;
+    }
+    auto seqs = shmemi_coll_ll_seqs();
+    for (int i = 0; i < team->size; i++) {
+        if (i != team->mype) {
+            seqs[ll->idx[i]] = ll->seq[i];
+        }
+    }
+    dcci_cacheline((__gm__ uint8_t *)seqs);
+}
+
+// copies n elements of the local src into the data slot of the calling PE on member i
+template <typename T>
+SHMEM_DEVICE void shmemi_coll_ll_store(shmemi_team_t *team, shmemi_coll_ll_t *ll, int i, size_t offset,
+                                       __gm__ T *src, size_t n)
+{
+    if (n == 0) {
+        return;
+    }
+    auto device_state = shmemi_get_hot_state();
+    AscendC::TEventID event_id = (AscendC::TEventID)device_state->mte_config.event_id;
+    __gm__ T *slot = shmemi_coll_ll_slot<T>(ll->seq[i], ll->idx[team->mype]) + offset;
+    shmem_mte_put_mem_nbi(slot, src, reinterpret_cast<__ubuf__ T *>(device_state->mte_config.shmem_ub),
+                          device_state->mte_config.ub_size, (uint32_t)n, shmemi_team_global_pe(team, i), event_id);
+    // the staging buffer is reused by the next copy
+    AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+    AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(event_id);
+}
+
+// sets the flag of the calling core on every peer, once its stores have landed
+SHMEM_DEVICE void shmemi_coll_ll_signal(shmemi_team_t *team, shmemi_coll_ll_t *ll, int phase)
+{
+    shmemi_quiet();
+    int core = AscendC::GetBlockIdx();
+    for (int i = 1; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        shmemi_signal_set(shmemi_coll_ll_flag(phase, ll->seq[peer], ll->idx[team->mype], core),
+                          shmemi_team_global_pe(team, peer), ll->seq[peer]);
+    }
+}
+
+SHMEM_DEVICE void shmemi_coll_ll_wait(shmemi_team_t *team, shmemi_coll_ll_t *ll, int phase)
+{
+    int core = AscendC::GetBlockIdx();
+    for (int i = 1; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        shmemi_wait_until<int32_t>(shmemi_coll_ll_flag(phase, ll->seq[peer], ll->idx[peer], core), SHMEM_CMP_EQ,
+                                   ll->seq[peer]);
+    }
+}
+
+/* Reduces n elements of local and of the data slots of the peers at offset into dst, n fits in one UB chunk. With
+   all_pes the result is also stored into dst of every peer, dst being symmetric. local may alias dst. */
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_coll_ll_reduce_chunk(shmemi_team_t *team, shmemi_coll_ll_t *ll, __gm__ T *dst,
+                                              __gm__ T *local, size_t offset, uint32_t n, bool all_pes)
+{
+    using acc_t = typename shmemi_coll_acc<T>::type;
+    constexpr bool cast = shmemi_coll_acc<T>::cast;
+    auto acc = shmemi_coll_ub_tensor<acc_t>(SHMEMI_COLL_UB_ACC);
+    auto in = shmemi_coll_ub_tensor<T>(SHMEMI_COLL_UB_IN);
+    auto in_acc = shmemi_coll_ub_tensor<acc_t>(SHMEMI_COLL_UB_IN_ACC);
+
+    if constexpr (cast) {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), local, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        AscendC::Cast(acc, in, AscendC::RoundMode::CAST_NONE, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE2>();
+    } else {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_ACC), local, n * sizeof(T));
+    }
+
+    for (int i = 1; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        __gm__ T *slot = shmemi_coll_ll_slot<T>(ll->seq[peer], ll->idx[peer]) + offset;
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN), slot, n * sizeof(T));
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        if constexpr (cast) {
+            AscendC::Cast(in_acc, in, AscendC::RoundMode::CAST_NONE, n);
+            AscendC::PipeBarrier<PIPE_V>();
+            shmemi_coll_op<OP>(acc, in_acc, n);
+        } else {
+            shmemi_coll_op<OP>(acc, in, n);
+        }
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE2>();
+    }
+
+    __ubuf__ T *result = shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_ACC);
+    if constexpr (cast) {
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Cast(in, acc, AscendC::RoundMode::CAST_RINT, n);
+        result = shmemi_coll_ub_ptr<T>(SHMEMI_COLL_UB_IN);
+    }
+    shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+    shmemi_copy_ub2gm(dst, result, n * sizeof(T));
+    for (int i = 1; all_pes && i < team->size; i++) {
+        shmemi_copy_ub2gm(shmemi_ptr(dst, shmemi_team_global_pe(team, (team->mype + i) % team->size)), result,
+                          n * sizeof(T));
+    }
+    // the next chunk is loaded into the buffer just stored
+    shmemi_coll_pipe_sync<AscendC::HardEvent::MTE3_MTE2>();
+}
+
+// shmemi_coll_ll_reduce_chunk over elements [offset, offset + count) of the slots
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_coll_ll_reduce(shmemi_team_t *team, shmemi_coll_ll_t *ll, __gm__ T *dst, __gm__ T *local,
+                                        size_t offset, size_t count, bool all_pes)
+{
+    constexpr size_t chunk = SHMEMI_COLL_UB_CHUNK / sizeof(typename shmemi_coll_acc<T>::type);
+    for (size_t done = 0; done < count; done += chunk) {
+        size_t n = (count - done) < chunk ? (count - done) : chunk;
+        shmemi_coll_ll_reduce_chunk<T, OP>(team, ll, dst + done, local + done, offset + done, (uint32_t)n, all_pes);
+    }
+}
+
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_allreduce_ll_one_shot(shmemi_team_t *team, shmemi_coll_ll_t *ll, __gm__ T *dest,
+                                               __gm__ T *source, size_t nelems)
+{
+    size_t offset;
+    size_t count;
+    shmemi_coll_core_range<T>(nelems, offset, count);
+    for (int i = 1; i < team->size; i++) {
+        shmemi_coll_ll_store(team, ll, (team->mype + i) % team->size, offset, source + offset, count);
+    }
+    shmemi_coll_ll_signal(team, ll, 0);
+    shmemi_coll_ll_wait(team, ll, 0);
+    shmemi_coll_ll_reduce<T, OP>(team, ll, dest + offset, source + offset, offset, count, false);
+}
+
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_allreduce_ll_two_shot(shmemi_team_t *team, shmemi_coll_ll_t *ll, __gm__ T *dest,
+                                               __gm__ T *source, size_t nelems)
+{
+    size_t offset;
+    size_t count;
+    for (int i = 1; i < team->size; i++) {
+        int peer = (team->mype + i) % team->size;
+        size_t lo = shmemi_coll_slice_offset<T>(nelems, team->size, peer);
+        size_t hi = shmemi_coll_slice_offset<T>(nelems, team->size, peer + 1);
+        shmemi_coll_core_range<T>(hi - lo, offset, count);
+        shmemi_coll_ll_store(team, ll, peer, offset, source + lo + offset, count);
+    }
+    shmemi_coll_ll_signal(team, ll, 0);
+    shmemi_coll_ll_wait(team, ll, 0);
+
+    // the peers are past their stores of phase 0, dest aliasing source can be overwritten
+    size_t lo = shmemi_coll_slice_offset<T>(nelems, team->size, team->mype);
+    size_t hi = shmemi_coll_slice_offset<T>(nelems, team->size, team->mype + 1);
+    shmemi_coll_core_range<T>(hi - lo, offset, count);
+    shmemi_coll_ll_reduce<T, OP>(team, ll, dest + lo + offset, source + lo + offset, offset, count, true);
+    shmemi_coll_ll_signal(team, ll, 1);
+    shmemi_coll_ll_wait(team, ll, 1);
+}
+
+// true if the share of one PE of nelems elements fits a data slot
+template <typename T>
+SHMEM_DEVICE bool shmemi_coll_ll_fits(shmemi_team_t *team, int algo, size_t nelems)
+{
+    if (algo == SHMEMX_COLL_LL_TWO_SHOT) {
+        return shmemi_coll_slice_offset<T>(nelems, team->size, 1) * sizeof(T) <= SHMEM_COLL_LL_SLOT_SIZE;
+    }
+    return nelems * sizeof(T) <= SHMEM_COLL_LL_SLOT_SIZE;
+}
+
+template <typename T, int OP>
+SHMEM_DEVICE int shmemi_allreduce(shmem_team_t tid, __gm__ T *dest, __gm__ T *source, size_t nelems)
+{
+    if ASCEND_IS_AIC {
+        return SHMEM_SUCCESS;
+    }
+    shmemi_team_t *team = shmemi_coll_team(tid);
+    if (team == nullptr) {
+        return SHMEM_INVALID_PARAM;
+    }
+
+    int algo = shmemi_coll_algo(team, SHMEMX_COLL_ALLREDUCE, nelems * sizeof(T));
+    if (algo == SHMEMX_COLL_LL_ONE_SHOT || algo == SHMEMX_COLL_LL_TWO_SHOT) {
+        shmemi_coll_ll_t ll;
+        if (shmemi_coll_ll_fits<T>(team, algo, nelems) && shmemi_coll_ll_members(team, &ll)) {
+            shmemi_coll_ll_begin(team, &ll);
+            if (algo == SHMEMX_COLL_LL_ONE_SHOT) {
+                shmemi_allreduce_ll_one_shot<T, OP>(team, &ll, dest, source, nelems);
+            } else {
+                shmemi_allreduce_ll_two_shot<T, OP>(team, &ll, dest, source, nelems);
+            }
+            shmemi_coll_ll_end(team, &ll);
+            return SHMEM_SUCCESS;
+        }
+        algo = algo == SHMEMX_COLL_LL_ONE_SHOT ? SHMEMX_COLL_ONE_SHOT : SHMEMX_COLL_TWO_SHOT;
+    }
+    if (algo == SHMEMX_COLL_PIPE_RING) {
+        if (dest != source && shmemi_coll_pipe_pool() != nullptr) {
+            shmemi_allreduce_pipe_ring<T, OP>(tid, team, dest, source, nelems);
+            return SHMEM_SUCCESS;
+        }
+        algo = SHMEMX_COLL_RING;
+    }
+    if (algo == SHMEMX_COLL_ONE_SHOT && dest == source) {
+        // peers still read the source being overwritten
+        algo = SHMEMX_COLL_TWO_SHOT;
+    }
+    shmemi_barrier<true>(tid);
+    switch (algo) {
+        case SHMEMX_COLL_ONE_SHOT:
+            shmemi_coll_reduce_split<T, OP>(team, dest, source, source, team->mype + 1, team->size - 1, nelems);
+            break;
+        case SHMEMX_COLL_RING:
+            shmemi_allreduce_ring<T, OP>(tid, team, dest, source, nelems);
+            break;
+        case SHMEMX_COLL_RECURSIVE_DOUBLING:
+            shmemi_allreduce_rd<T, OP>(tid, team, dest, source, nelems);
+            break;
+        default:
+            shmemi_allreduce_two_shot<T, OP>(tid, team, dest, source, nelems);
+            break;
+    }
+    shmemi_coll_quiet(team);
+    shmemi_barrier<true>(tid);
+    return SHMEM_SUCCESS;
+}
+
+#endif
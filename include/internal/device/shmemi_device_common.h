@@ -40,16 +40,60 @@ SHMEM_DEVICE __gm__ shmemi_device_host_state_t *shmemi_get_state() {
 }
 #endif
 
+/*
+    Per-core snapshot of the read-mostly state. Kernels compiled with SHMEM_DEVICE_STATE_CACHE call
+    shmemx_state_cache_init() at entry, then hot RMA and signal paths read scalars held by the core instead of loading
+    GM fields on every call. The per-PE tables are too large to copy, the snapshot only keeps their addresses.
+*/
+typedef void *shmemi_addr_t;
+
+typedef struct {
+    int mype;
+    int npes;
+    void *heap_base;
+    size_t heap_size;
+    shmemi_mte_config_t mte_config;
+    __gm__ uint8_t *topo_list;
+    __gm__ shmemi_addr_t *p2p_heap_base;
+    __gm__ shmemi_addr_t *rdma_heap_base;
+} shmemi_state_cache_t;
+
+#ifdef SHMEM_DEVICE_STATE_CACHE
+__BLOCK_LOCAL__ __inline__ shmemi_state_cache_t g_shmemi_state_cache;
+
+SHMEM_DEVICE shmemi_state_cache_t *shmemi_get_hot_state() {
+    return &g_shmemi_state_cache;
+}
+#else
+SHMEM_DEVICE __gm__ shmemi_device_host_state_t *shmemi_get_hot_state() {
+    return shmemi_get_state();
+}
+#endif
+
+SHMEM_DEVICE void shmemi_state_cache_init() {
+#ifdef SHMEM_DEVICE_STATE_CACHE
+    __gm__ shmemi_device_host_state_t *state = shmemi_get_state();
+    g_shmemi_state_cache.mype = state->mype;
+    g_shmemi_state_cache.npes = state->npes;
+    g_shmemi_state_cache.heap_base = state->heap_base;
+    g_shmemi_state_cache.heap_size = state->heap_size;
+    g_shmemi_state_cache.mte_config = state->mte_config;
+    g_shmemi_state_cache.topo_list = state->topo_list;
+    g_shmemi_state_cache.p2p_heap_base = state->p2p_heap_base;
+    g_shmemi_state_cache.rdma_heap_base = state->rdma_heap_base;
+#endif
+}
+
 SHMEM_DEVICE int shmemi_get_my_pe() {
-    return shmemi_get_state()->mype;
+    return shmemi_get_hot_state()->mype;
 }
 
 SHMEM_DEVICE int shmemi_get_total_pe() {
-    return shmemi_get_state()->npes;
+    return shmemi_get_hot_state()->npes;
 }
 
 SHMEM_DEVICE uint64_t shmemi_get_heap_size() {
-    return shmemi_get_state()->heap_size;
+    return shmemi_get_hot_state()->heap_size;
 }
 
 template<typename T>
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_QUANT_H
+#define SHMEMI_DEVICE_QUANT_H
+
+#include "internal/device/shmemi_device_coll.h"
+
+/*
+    Quantized collectives over a team, float elements moved in a compressed wire format.
+
+    Every member first quantizes its source into its symmetric work buffer, the peers then read the compressed
+    elements instead of the floats, over MTE within the host and with RoCE reads across, and dequantize them in UB.
+    Reads of peers without MTE access land in the destination of the chunk, which is overwritten by the result.
+
+        - SHMEMX_QUANT_BF16:    float cast to bfloat16, half the bytes.
+        - SHMEMX_QUANT_INT8:    a quarter of the bytes plus a float scale per block, the scale of a block is its
+                                absolute maximum / 127, elements are divided by it and rounded to the nearest int8.
+
+    The work buffer, or the scratch of the team when the config has none, holds the quantized elements, then the
+    scales, see SHMEM_QUANT_DATA_SIZE. The scratch is not partitioned, the payload overwrites any flag kept there.
+    With error feedback the local error buffer is added to the source before quantizing, and is replaced by the
+    difference between that sum and its dequantized value, so that what one call loses is sent with the next one.
+
+        - allgather:    dest[i * nelems, (i + 1) * nelems) = dequantized source of member i, the calling PE
+                        included, so that all members hold the same values.
+        - allreduce:    sum, two-shot. Member i accumulates slice i of the dequantized sources of all members in
+                        float, quantizes the sum into slice i of its own work buffer, which no peer reads in that
+                        step, and every member dequantizes the reduced slices from their owners. Three team
+                        barriers, the sources are local and need none on entry.
+
+    Chunks of SHMEMI_QUANT_CHUNK elements go through the UB area of the reductions, a chunk holds whole blocks.
+*/
+
+#define SHMEMI_QUANT_CHUNK SHMEM_QUANT_MAX_BLOCK
+#define SHMEMI_QUANT_UB_ACC 0                                                   // float, accumulator or source
+#define SHMEMI_QUANT_UB_TMP (SHMEMI_QUANT_UB_ACC + SHMEMI_QUANT_CHUNK * 4)     // float, dequantized or scaled
+#define SHMEMI_QUANT_UB_HALF (SHMEMI_QUANT_UB_TMP + SHMEMI_QUANT_CHUNK * 4)    // half, int8 conversions
+#define SHMEMI_QUANT_UB_RAW (SHMEMI_QUANT_UB_HALF + SHMEMI_QUANT_CHUNK * 2)    // quantized elements
+#define SHMEMI_QUANT_UB_SCALE (SHMEMI_QUANT_UB_RAW + SHMEMI_QUANT_CHUNK * 2)   // float per block
+#define SHMEMI_QUANT_UB_MAX (SHMEMI_QUANT_UB_SCALE + SHMEMI_QUANT_CHUNK / SHMEM_QUANT_MIN_BLOCK * 4)
+#define SHMEMI_QUANT_MAX_STRIDE (UB_ALIGN_SIZE / sizeof(float))                 // floats per block maximum
+#define SHMEMI_QUANT_UB_WORK \
+    (SHMEMI_QUANT_UB_MAX + SHMEMI_QUANT_CHUNK / SHMEM_QUANT_MIN_BLOCK * UB_ALIGN_SIZE)  // of ReduceMax
+
+static_assert(SHMEMI_QUANT_UB_WORK + SHMEM_QUANT_MAX_BLOCK * 4 <= SHMEM_COLL_UB_SIZE,
+              "quantization buffers exceed the UB area of the reductions");
+
+struct shmemi_quant_t {
+    int format;
+    uint32_t block;
+    size_t nelems;
+    __gm__ uint8_t *work;   // local address of the symmetric work buffer
+    __gm__ float *error;    // nullptr without error feedback
+};
+
+// a config without work buffer uses the scratch of the team, which must hold the whole of it
+SHMEM_DEVICE bool shmemi_quant_make(shmemi_team_t *team, const shmemx_quant_config_t &config, size_t nelems,
+                                    shmemi_quant_t &q)
+{
+    uint32_t block = config.block_size;
+    if (config.format < 0 || config.format >= SHMEMX_QUANT_FORMAT_NUM ||
+        block < SHMEM_QUANT_MIN_BLOCK || block > SHMEM_QUANT_MAX_BLOCK || (block & (block - 1)) != 0) {
+        return false;
+    }
+    q.format = config.format;
+    q.block = block;
+    q.nelems = nelems;
+    q.work = (__gm__ uint8_t *)(config.work != 0 ? config.work : team->scratch);
+    q.error = (__gm__ float *)config.error;
+    if (config.work == 0) {
+        uint64_t work_size = config.format == SHMEMX_QUANT_BF16 ? SHMEM_QUANT_DATA_SIZE(nelems, sizeof(uint16_t)) :
+            SHMEM_QUANT_DATA_SIZE(nelems, sizeof(int8_t)) + SHMEM_QUANT_SCALE_SIZE(nelems, block);
+        return team->scratch != 0 && work_size <= team->scratch_size;
+    }
+    return true;
+}
+
+SHMEM_DEVICE uint32_t shmemi_quant_elem_size(const shmemi_quant_t &q)
+{
+    return q.format == SHMEMX_QUANT_BF16 ? sizeof(bfloat16_t) : sizeof(int8_t);
+}
+
+SHMEM_DEVICE size_t shmemi_quant_blocks(const shmemi_quant_t &q)
+{
+    return (q.nelems + q.block - 1) / q.block;
+}
+
+// quantized element offset of the work buffer, local
+SHMEM_DEVICE __gm__ uint8_t *shmemi_quant_data(const shmemi_quant_t &q, size_t offset)
+{
+    return q.work + offset * shmemi_quant_elem_size(q);
+}
+
+// scale of the block starting at element offset of the work buffer, local
+SHMEM_DEVICE __gm__ float *shmemi_quant_scales(const shmemi_quant_t &q, size_t offset)
+{
+    return (__gm__ float *)(q.work + SHMEM_QUANT_DATA_SIZE(q.nelems, shmemi_quant_elem_size(q))) + offset / q.block;
+}
+
+// blocks [first, first + count) of the calling core among the blocks [begin, end)
+SHMEM_DEVICE void shmemi_quant_core_blocks(size_t begin, size_t end, size_t &first, size_t &count)
+{
+    size_t core_num = AscendC::GetBlockNum() * AscendC::GetTaskRation();
+    size_t per_core = (end - begin + core_num - 1) / core_num;
+    first = begin + per_core * AscendC::GetBlockIdx();
+    if (first > end) {
+        first = end;
+    }
+    count = (end - first) < per_core ? (end - first) : per_core;
+}
+
+// blocks of the slice of member idx of a team of size members
+SHMEM_DEVICE void shmemi_quant_slice(const shmemi_quant_t &q, int size, int idx, size_t &begin, size_t &end)
+{
+    size_t blocks = shmemi_quant_blocks(q);
+    size_t per_slice = (blocks + size - 1) / size;
+    begin = per_slice * idx < blocks ? per_slice * idx : blocks;
+    end = begin + per_slice < blocks ? begin + per_slice : blocks;
+}
+
+// dequantizes n elements of the raw and scale buffers in UB into the float buffer at UB offset out, vector only
+SHMEM_DEVICE void shmemi_quant_dequant_ub(const shmemi_quant_t &q, uint32_t out, uint32_t n)
+{
+    auto dst = shmemi_coll_ub_tensor<float>(out);
+    if (q.format == SHMEMX_QUANT_BF16) {
+        AscendC::Cast(dst, shmemi_coll_ub_tensor<bfloat16_t>(SHMEMI_QUANT_UB_RAW), AscendC::RoundMode::CAST_NONE, n);
+        return;
+    }
+    auto halfs = shmemi_coll_ub_tensor<half>(SHMEMI_QUANT_UB_HALF);
+    AscendC::Cast(halfs, shmemi_coll_ub_tensor<int8_t>(SHMEMI_QUANT_UB_RAW), AscendC::RoundMode::CAST_NONE, n);
+    AscendC::PipeBarrier<PIPE_V>();
+    AscendC::Cast(dst, halfs, AscendC::RoundMode::CAST_NONE, n);
+    AscendC::PipeBarrier<PIPE_V>();
+    auto scales = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_SCALE);
+    for (uint32_t b = 0; b * q.block < n; b++) {
+        uint32_t len = (n - b * q.block) < q.block ? (n - b * q.block) : q.block;
+        AscendC::Muls(dst[b * q.block], dst[b * q.block], scales.GetValue(b), len);
+    }
+}
+
+// loads elements [offset, offset + n) of the work buffer of pe and their scales into UB, read into stage first
+// when pe is only reachable over RoCE
+SHMEM_DEVICE void shmemi_quant_load(const shmemi_quant_t &q, size_t offset, uint32_t n, int pe,
+                                    __gm__ uint8_t *stage)
+{
+    uint32_t raw_bytes = n * shmemi_quant_elem_size(q);
+    uint32_t blocks = (n + q.block - 1) / q.block;
+    __gm__ uint8_t *raw = shmemi_quant_data(q, offset);
+    __gm__ float *scales = shmemi_quant_scales(q, offset);
+    if (shmemi_coll_is_mte(pe)) {
+        raw = reinterpret_cast<__gm__ uint8_t *>(shmem_ptr(raw, pe));
+        scales = reinterpret_cast<__gm__ float *>(shmem_ptr(scales, pe));
+    } else {
+        // the stage may still be stored from UB by the previous chunk
+        AscendC::PipeBarrier<PIPE_ALL>();
+        __gm__ float *stage_scales = (__gm__ float *)(stage + ALIGH_TO(raw_bytes, UB_ALIGN_SIZE));
+        shmem_roce_get_mem_nbi(stage, raw, reinterpret_cast<__ubuf__ uint8_t *>(SHMEM_INTERNAL_UB_BUF_START_ADDR),
+                               raw_bytes, pe);
+        if (q.format == SHMEMX_QUANT_INT8) {
+            shmem_roce_get_mem_nbi(stage_scales, scales,
+                                   reinterpret_cast<__ubuf__ float *>(SHMEM_INTERNAL_UB_BUF_START_ADDR), blocks, pe);
+        }
+        shmemi_coll_roce_quiet(pe);
+        raw = stage;
+        scales = stage_scales;
+    }
+    shmemi_copy_gm2ub(shmemi_coll_ub_ptr<uint8_t>(SHMEMI_QUANT_UB_RAW), raw, raw_bytes);
+    if (q.format == SHMEMX_QUANT_INT8) {
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<float>(SHMEMI_QUANT_UB_SCALE), scales, blocks * sizeof(float));
+        // the scales are read by the scalar unit
+        shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_S>();
+    }
+    shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+}
+
+/* Quantizes the n floats of the accumulator in UB into elements [offset, offset + n) of the local work buffer.
+   With feedback, the accumulator minus its dequantized value is stored into the error buffer at offset. */
+SHMEM_DEVICE void shmemi_quant_store(const shmemi_quant_t &q, size_t offset, uint32_t n, bool feedback)
+{
+    auto acc = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_ACC);
+    auto tmp = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_TMP);
+    uint32_t blocks = (n + q.block - 1) / q.block;
+    if (q.format == SHMEMX_QUANT_BF16) {
+        AscendC::Cast(shmemi_coll_ub_tensor<bfloat16_t>(SHMEMI_QUANT_UB_RAW), acc, AscendC::RoundMode::CAST_RINT, n);
+    } else {
+        auto max = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_MAX);
+        auto work = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_WORK);
+        auto scales = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_SCALE);
+        AscendC::Abs(tmp, acc, n);
+        AscendC::PipeBarrier<PIPE_V>();
+        for (uint32_t b = 0; b < blocks; b++) {
+            uint32_t len = (n - b * q.block) < q.block ? (n - b * q.block) : q.block;
+            AscendC::ReduceMax(max[b * SHMEMI_QUANT_MAX_STRIDE], tmp[b * q.block], work, len);
+            AscendC::PipeBarrier<PIPE_V>();
+        }
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_S>();
+        for (uint32_t b = 0; b < blocks; b++) {
+            float absmax = max.GetValue(b * SHMEMI_QUANT_MAX_STRIDE);
+            float scale = absmax > 0 ? absmax / 127 : 1;
+            scales.SetValue(b, scale);
+            max.SetValue(b * SHMEMI_QUANT_MAX_STRIDE, 1 / scale);
+        }
+        shmemi_coll_pipe_sync<AscendC::HardEvent::S_V>();
+        for (uint32_t b = 0; b < blocks; b++) {
+            uint32_t len = (n - b * q.block) < q.block ? (n - b * q.block) : q.block;
+            AscendC::Muls(tmp[b * q.block], acc[b * q.block], max.GetValue(b * SHMEMI_QUANT_MAX_STRIDE), len);
+        }
+        AscendC::PipeBarrier<PIPE_V>();
+        auto halfs = shmemi_coll_ub_tensor<half>(SHMEMI_QUANT_UB_HALF);
+        AscendC::Cast(halfs, tmp, AscendC::RoundMode::CAST_NONE, n);
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Cast(shmemi_coll_ub_tensor<int8_t>(SHMEMI_QUANT_UB_RAW), halfs, AscendC::RoundMode::CAST_RINT, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::S_MTE3>();
+        shmemi_copy_ub2gm(shmemi_quant_scales(q, offset), shmemi_coll_ub_ptr<float>(SHMEMI_QUANT_UB_SCALE),
+                          blocks * sizeof(float));
+    }
+    shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+    shmemi_copy_ub2gm(shmemi_quant_data(q, offset), shmemi_coll_ub_ptr<uint8_t>(SHMEMI_QUANT_UB_RAW),
+                      n * shmemi_quant_elem_size(q));
+
+    if (feedback) {
+        AscendC::PipeBarrier<PIPE_V>();
+        shmemi_quant_dequant_ub(q, SHMEMI_QUANT_UB_TMP, n);
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Sub(tmp, acc, tmp, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+        shmemi_copy_ub2gm(q.error + offset, shmemi_coll_ub_ptr<float>(SHMEMI_QUANT_UB_TMP), n * sizeof(float));
+    }
+    // the next chunk reuses every buffer
+    AscendC::PipeBarrier<PIPE_ALL>();
+}
+
+// quantizes the share of the calling core of source into the local work buffer, with error feedback if set
+SHMEM_DEVICE void shmemi_quant_source(const shmemi_quant_t &q, __gm__ float *source)
+{
+    size_t first;
+    size_t count;
+    shmemi_quant_core_blocks(0, shmemi_quant_blocks(q), first, count);
+    size_t end = (first + count) * q.block < q.nelems ? (first + count) * q.block : q.nelems;
+    for (size_t offset = first * q.block; offset < end; offset += SHMEMI_QUANT_CHUNK) {
+        uint32_t n = (end - offset) < SHMEMI_QUANT_CHUNK ? (uint32_t)(end - offset) : SHMEMI_QUANT_CHUNK;
+        shmemi_copy_gm2ub(shmemi_coll_ub_ptr<float>(SHMEMI_QUANT_UB_ACC), source + offset, n * sizeof(float));
+        if (q.error != nullptr) {
+            shmemi_copy_gm2ub(shmemi_coll_ub_ptr<float>(SHMEMI_QUANT_UB_TMP), q.error + offset, n * sizeof(float));
+            shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+            auto acc = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_ACC);
+            AscendC::Add(acc, acc, shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_TMP), n);
+            AscendC::PipeBarrier<PIPE_V>();
+        } else {
+            shmemi_coll_pipe_sync<AscendC::HardEvent::MTE2_V>();
+        }
+        shmemi_quant_store(q, offset, n, q.error != nullptr);
+    }
+}
+
+/* Dequantizes the share of the calling core of blocks [begin, end) of the work buffer of member idx into dest at
+   the same offsets, dest being symmetric for the RoCE stage. */
+SHMEM_DEVICE void shmemi_quant_gather(shmemi_team_t *team, const shmemi_quant_t &q, int idx, __gm__ float *dest,
+                                      size_t begin, size_t end)
+{
+    size_t first;
+    size_t count;
+    shmemi_quant_core_blocks(begin, end, first, count);
+    size_t last = (first + count) * q.block < q.nelems ? (first + count) * q.block : q.nelems;
+    int pe = shmemi_team_global_pe(team, idx);
+    for (size_t offset = first * q.block; offset < last; offset += SHMEMI_QUANT_CHUNK) {
+        uint32_t n = (last - offset) < SHMEMI_QUANT_CHUNK ? (uint32_t)(last - offset) : SHMEMI_QUANT_CHUNK;
+        shmemi_quant_load(q, offset, n, pe, (__gm__ uint8_t *)(dest + offset));
+        shmemi_quant_dequant_ub(q, SHMEMI_QUANT_UB_TMP, n);
+        shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE3>();
+        shmemi_copy_ub2gm(dest + offset, shmemi_coll_ub_ptr<float>(SHMEMI_QUANT_UB_TMP), n * sizeof(float));
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+}
+
+/* Sums the share of the calling core of blocks [begin, end) of the work buffers of all members, the calling PE
+   included, and quantizes the sums back into the local work buffer. dest is the RoCE stage. */
+SHMEM_DEVICE void shmemi_quant_reduce(shmemi_team_t *team, const shmemi_quant_t &q, __gm__ float *dest,
+                                      size_t begin, size_t end)
+{
+    auto acc = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_ACC);
+    auto tmp = shmemi_coll_ub_tensor<float>(SHMEMI_QUANT_UB_TMP);
+    size_t first;
+    size_t count;
+    shmemi_quant_core_blocks(begin, end, first, count);
+    size_t last = (first + count) * q.block < q.nelems ? (first + count) * q.block : q.nelems;
+    for (size_t offset = first * q.block; offset < last; offset += SHMEMI_QUANT_CHUNK) {
+        uint32_t n = (last - offset) < SHMEMI_QUANT_CHUNK ? (uint32_t)(last - offset) : SHMEMI_QUANT_CHUNK;
+        AscendC::Duplicate(acc, 0.0f, n);
+        for (int i = 1; i <= team->size; i++) {
+            // the own slice last, its quantized elements are overwritten right after
+            int pe = shmemi_team_global_pe(team, (team->mype + i) % team->size);
+            shmemi_quant_load(q, offset, n, pe, (__gm__ uint8_t *)(dest + offset));
+            shmemi_quant_dequant_ub(q, SHMEMI_QUANT_UB_TMP, n);
+            AscendC::PipeBarrier<PIPE_V>();
+            AscendC::Add(acc, acc, tmp, n);
+            // the next member is loaded into the buffers just consumed
+            shmemi_coll_pipe_sync<AscendC::HardEvent::V_MTE2>();
+        }
+        AscendC::PipeBarrier<PIPE_V>();
+        shmemi_quant_store(q, offset, n, false);
+    }
+}
+
+SHMEM_DEVICE int shmemi_allgather_quant(shmem_team_t tid, __gm__ float *dest, __gm__ float *source, size_t nelems,
+                                        const shmemx_quant_config_t &config)
+{
+    if ASCEND_IS_AIC {
+        return SHMEM_SUCCESS;
+    }
+    shmemi_team_t *team = shmemi_coll_team(tid);
+    shmemi_quant_t q;
+    if (team == nullptr || !shmemi_quant_make(team, config, nelems, q)) {
+        return SHMEM_INVALID_PARAM;
+    }
+
+    shmemi_quant_source(q, source);
+    shmemi_quiet();
+    shmemi_barrier<true>(tid);
+    for (int i = 0; i < team->size; i++) {
+        int idx = (team->mype + i) % team->size;
+        shmemi_quant_gather(team, q, idx, dest + idx * nelems, 0, shmemi_quant_blocks(q));
+    }
+    shmemi_quiet();
+    shmemi_barrier<true>(tid);
+    return SHMEM_SUCCESS;
+}
+
+SHMEM_DEVICE int shmemi_allreduce_quant(shmem_team_t tid, __gm__ float *dest, __gm__ float *source, size_t nelems,
+                                        const shmemx_quant_config_t &config)
+{
+    if ASCEND_IS_AIC {
+        return SHMEM_SUCCESS;
+    }
+    shmemi_team_t *team = shmemi_coll_team(tid);
+    shmemi_quant_t q;
+    if (team == nullptr || !shmemi_quant_make(team, config, nelems, q)) {
+        return SHMEM_INVALID_PARAM;
+    }
+
+    size_t begin;
+    size_t end;
+    shmemi_quant_source(q, source);
+    shmemi_quiet();
+    shmemi_barrier<true>(tid);
+    shmemi_quant_slice(q, team->size, team->mype, begin, end);
+    shmemi_quant_reduce(team, q, dest, begin, end);
+    shmemi_quiet();
+    shmemi_barrier<true>(tid);
+    for (int i = 0; i < team->size; i++) {
+        int idx = (team->mype + i) % team->size;
+        shmemi_quant_slice(q, team->size, idx, begin, end);
+        shmemi_quant_gather(team, q, idx, dest, begin, end);
+    }
+    shmemi_quiet();
+    shmemi_barrier<true>(tid);
+    return SHMEM_SUCCESS;
+}
+
+#endif
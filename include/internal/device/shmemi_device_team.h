@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_TEAM_H
+#define SHMEMI_DEVICE_TEAM_H
+
+#include "shmemi_device_common.h"
+
+/*
+    A team is either strided, member i being the global PE start + i * stride, or, with stride 0, lists its members
+    in its row of the member table, SHMEM_MAX_RANKS global PEs per team slot.
+*/
+
+SHMEM_DEVICE __gm__ int32_t *shmemi_team_members(shmemi_team_t *team)
+{
+    return (__gm__ int32_t *)team->members;
+}
+
+// team view pe to global view pe, pe must be in [0, team->size)
+SHMEM_DEVICE int shmemi_team_global_pe(shmemi_team_t *team, int pe)
+{
+    if (team->stride > 0) {
+        return team->start + pe * team->stride;
+    }
+    return shmemi_team_members(team)[pe];
+}
+
+// global view pe to team view pe, -1 if global_pe is not a member
+SHMEM_DEVICE int shmemi_team_pe(shmemi_team_t *team, int global_pe)
+{
+    if (team->stride > 0) {
+        int n = (global_pe - team->start) / team->stride;
+        if (global_pe < team->start || (global_pe - team->start) % team->stride || n >= team->size) {
+            return -1;
+        }
+        return n;
+    }
+    auto members = shmemi_team_members(team);
+    for (int i = 0; i < team->size; i++) {
+        if (members[i] == global_pe) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// index in leader_pes of the host of team view pe, pe must be in [0, team->size) and team->host_num > 0
+SHMEM_DEVICE int shmemi_team_pe_host(shmemi_team_t *team, int pe)
+{
+    int16_t host = shmemi_get_state()->pe_host[shmemi_team_global_pe(team, pe)];
+    int lo = 0;
+    int hi = team->host_num - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (team->host_ids[mid] < host) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// descriptors are built from the view of the local PE, which only gets one for teams it belongs to
+SHMEM_DEVICE bool shmemi_team_is_member(shmemi_team_t *team)
+{
+    return team != nullptr && team->mype >= 0 && team->mype < team->size;
+}
+
+// epoch counter of the calling core on a team slot, see shmemx_team_epoch_next
+SHMEM_DEVICE __gm__ int32_t *shmemi_team_epoch(int team_idx)
+{
+    uint64_t addr = shmemi_get_state()->team_epoch_pool;
+    addr += team_idx * SHMEM_TEAM_EPOCH_ROW_SIZE + AscendC::GetBlockIdx() * SHMEM_TEAM_EPOCH_SIZE;
+    return (__gm__ int32_t *)addr;
+}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_WORK_H
+#define SHMEMI_DEVICE_WORK_H
+
+#include "kernel_operator.h"
+#include "internal/device/shmemi_device_common.h"
+#include "internal/device/shmemi_device_amo.h"
+#include "internal/device/shmemi_device_coll.h"
+#include "internal/device/sync/shmemi_device_p2p.h"
+
+/*
+    Persistent work queue.
+
+    The queue is a symmetric ring of depth slots behind a header, see shmemi_work_queue_t. Operation n goes to slot
+    n % depth, the producer writes the descriptor, flushes it, then stores n + 1 to the sequence word of the slot. The
+    persistent kernel runs the operations in order on all of its vector cores: every core waits for the sequence of
+    the next slot, runs its share of the operation, and once all cores have met, core 0 sets the completion flag of
+    the descriptor and stores n + 1 to head. A slot is free again once head has passed it.
+
+    Without SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS the host is the only producer and numbers the operations itself,
+    otherwise every producer takes its number with an atomic fetch-add on tail.
+*/
+
+constexpr uint64_t SHMEMI_WORK_INVALID_TICKET = ~0ULL;
+
+SHMEM_DEVICE __gm__ uint8_t *shmemi_work_slot(__gm__ shmemi_work_queue_t *queue, uint64_t depth, uint64_t ticket)
+{
+    return (__gm__ uint8_t *)queue + SHMEM_WORK_QUEUE_HEADER_SIZE + (ticket & (depth - 1)) * SHMEM_WORK_SLOT_SIZE;
+}
+
+SHMEM_DEVICE __gm__ uint64_t *shmemi_work_slot_seq(__gm__ uint8_t *slot)
+{
+    return (__gm__ uint64_t *)(slot + SHMEM_WORK_SLOT_SEQ_OFFSET);
+}
+
+// waits until operation ticket has completed
+SHMEM_DEVICE void shmemi_work_wait(__gm__ shmemi_work_queue_t *queue, uint64_t ticket)
+{
+    shmemi_wait_until<uint64_t>(&queue->head, SHMEM_CMP_GT, ticket);
+}
+
+// ticket of the operation, SHMEMI_WORK_INVALID_TICKET if the queue does not take device producers
+SHMEM_DEVICE uint64_t shmemi_work_submit(const shmemx_work_desc_t &desc)
+{
+    auto queue = (__gm__ shmemi_work_queue_t *)shmemi_get_state()->work_queue;
+    if (queue == nullptr) {
+        return SHMEMI_WORK_INVALID_TICKET;
+    }
+    dcci_cachelines((__gm__ uint8_t *)&queue->depth, 2 * sizeof(uint64_t));
+    uint64_t depth = queue->depth;
+    if ((queue->flags & SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS) == 0) {
+        return SHMEMI_WORK_INVALID_TICKET;
+    }
+
+    uint64_t ticket = shmemi_mte_atomic<uint64_t>(&queue->tail, 1, 0, SHMEMI_AMO_FETCH_ADD, shmemi_get_my_pe());
+    if (ticket >= depth) {
+        // the previous user of the slot has completed
+        shmemi_work_wait(queue, ticket - depth);
+    }
+
+    __gm__ uint8_t *slot = shmemi_work_slot(queue, depth, ticket);
+    const uint64_t *words = reinterpret_cast<const uint64_t *>(&desc);
+    for (uint32_t i = 0; i < sizeof(shmemx_work_desc_t) / sizeof(uint64_t); i++) {
+        shmemi_store((__gm__ uint64_t *)slot + i, words[i]);
+    }
+    dcci_cachelines(slot, sizeof(shmemx_work_desc_t));
+
+    __gm__ uint64_t *seq = shmemi_work_slot_seq(slot);
+    shmemi_store(seq, ticket + 1);
+    dcci_cacheline((__gm__ uint8_t *)seq);
+    return ticket;
+}
+
+// RMA of the share of the calling core, complete when it returns
+SHMEM_DEVICE void shmemi_work_rma(const shmemx_work_desc_t &desc)
+{
+    size_t offset;
+    size_t count;
+    shmemi_coll_core_range<uint8_t>(desc.size, offset, count);
+    if (desc.op == SHMEMX_WORK_GET) {
+        shmemi_coll_get((__gm__ uint8_t *)desc.dest + offset, (__gm__ uint8_t *)desc.source + offset, count,
+                        desc.pe);
+    } else {
+        shmemi_coll_put((__gm__ uint8_t *)desc.dest + offset, (__gm__ uint8_t *)desc.source + offset, count,
+                        desc.pe);
+    }
+    shmemi_coll_quiet_pe(desc.pe);
+}
+
+template <typename T, int OP>
+SHMEM_DEVICE void shmemi_work_reduce_op(const shmemx_work_desc_t &desc)
+{
+    if (desc.op == SHMEMX_WORK_ALLREDUCE) {
+        shmemi_allreduce<T, OP>(desc.team, (__gm__ T *)desc.dest, (__gm__ T *)desc.source, desc.size);
+    } else {
+        shmemi_reduce_scatter<T, OP>(desc.team, (__gm__ T *)desc.dest, (__gm__ T *)desc.source, desc.size);
+    }
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_work_reduce_type(const shmemx_work_desc_t &desc)
+{
+    switch (desc.reduce_op) {
+        case SHMEMI_REDUCE_SUM:
+            shmemi_work_reduce_op<T, SHMEMI_REDUCE_SUM>(desc);
+            break;
+        case SHMEMI_REDUCE_MAX:
+            shmemi_work_reduce_op<T, SHMEMI_REDUCE_MAX>(desc);
+            break;
+        case SHMEMI_REDUCE_MIN:
+            shmemi_work_reduce_op<T, SHMEMI_REDUCE_MIN>(desc);
+            break;
+        default:
+            break;
+    }
+}
+
+SHMEM_DEVICE void shmemi_work_reduce(const shmemx_work_desc_t &desc)
+{
+    switch (desc.dtype) {
+        case SHMEMX_WORK_HALF:
+            shmemi_work_reduce_type<half>(desc);
+            break;
+        case SHMEMX_WORK_BFLOAT16:
+            shmemi_work_reduce_type<bfloat16_t>(desc);
+            break;
+        case SHMEMX_WORK_FLOAT:
+            shmemi_work_reduce_type<float>(desc);
+            break;
+        case SHMEMX_WORK_INT16:
+            shmemi_work_reduce_type<int16_t>(desc);
+            break;
+        case SHMEMX_WORK_INT32:
+            shmemi_work_reduce_type<int32_t>(desc);
+            break;
+        default:
+            break;
+    }
+}
+
+// runs the share of the calling core, signals are left to core 0 once all cores are done
+SHMEM_DEVICE void shmemi_work_run(const shmemx_work_desc_t &desc)
+{
+    switch (desc.op) {
+        case SHMEMX_WORK_PUT:
+        case SHMEMX_WORK_GET:
+        case SHMEMX_WORK_PUT_SIGNAL:
+            shmemi_work_rma(desc);
+            break;
+        case SHMEMX_WORK_BARRIER:
+            shmemi_barrier<true>(desc.team);
+            break;
+        case SHMEMX_WORK_ALLGATHER:
+            shmemi_allgather<uint8_t>(desc.team, (__gm__ uint8_t *)desc.dest, (__gm__ uint8_t *)desc.source,
+                                      desc.size);
+            break;
+        case SHMEMX_WORK_BROADCAST:
+            shmemi_broadcast<uint8_t>(desc.team, (__gm__ uint8_t *)desc.dest, (__gm__ uint8_t *)desc.source,
+                                      desc.size, desc.pe);
+            break;
+        case SHMEMX_WORK_ALLTOALL:
+            shmemi_alltoall<uint8_t>(desc.team, (__gm__ uint8_t *)desc.dest, (__gm__ uint8_t *)desc.source,
+                                     desc.size);
+            break;
+        case SHMEMX_WORK_REDUCE_SCATTER:
+        case SHMEMX_WORK_ALLREDUCE:
+            shmemi_work_reduce(desc);
+            break;
+        default:
+            break;
+    }
+}
+
+// serves the queue until a SHMEMI_WORK_STOP descriptor, called by all vector cores of the persistent kernel
+SHMEM_DEVICE void shmemi_work_loop(__gm__ shmemi_work_queue_t *queue)
+{
+    if ASCEND_IS_AIC {
+        return;
+    }
+    dcci_cachelines((__gm__ uint8_t *)&queue->depth, sizeof(uint64_t));
+    uint64_t depth = queue->depth;
+
+    for (uint64_t ticket = 0;; ticket++) {
+        __gm__ uint8_t *slot = shmemi_work_slot(queue, depth, ticket);
+        shmemi_wait_until<uint64_t>(shmemi_work_slot_seq(slot), SHMEM_CMP_EQ, ticket + 1);
+        dcci_cachelines(slot, sizeof(shmemx_work_desc_t));
+        shmemx_work_desc_t desc;
+        uint64_t *words = reinterpret_cast<uint64_t *>(&desc);
+        for (uint32_t i = 0; i < sizeof(shmemx_work_desc_t) / sizeof(uint64_t); i++) {
+            words[i] = shmemi_load((__gm__ uint64_t *)slot + i);
+        }
+
+        if (desc.op != SHMEMI_WORK_STOP) {
+            shmemi_work_run(desc);
+        }
+        AscendC::PipeBarrier<PIPE_ALL>();
+        // every core has read the slot and done its share
+        shmemi_barrier_core<true>();
+
+        if (AscendC::GetBlockIdx() == 0) {
+            if (desc.op == SHMEMX_WORK_PUT_SIGNAL || desc.op == SHMEMX_WORK_SIGNAL) {
+                shmemix_signal_op((__gm__ int32_t *)desc.sig_addr, desc.signal, desc.sig_op, desc.pe);
+            }
+            if (desc.done_flag != 0) {
+                shmemi_signal_set((__gm__ int32_t *)desc.done_flag, desc.done_value);
+            }
+            shmemi_store(&queue->head, ticket + 1);
+            dcci_cacheline((__gm__ uint8_t *)&queue->head);
+        }
+        if (desc.op == SHMEMI_WORK_STOP) {
+            break;
+        }
+    }
+}
+
+#endif  // SHMEMI_DEVICE_WORK_H
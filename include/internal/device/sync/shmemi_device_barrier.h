@@ -20,6 +20,8 @@ This file provides device-side collective synchronization implementations, ensur
 
 #include "shmemi_device_quiet.h"
 #include "shmemi_device_p2p.h"
+#include "internal/device/shmemi_device_amo.h"
+#include "internal/device/shmemi_device_team.h"
 
 #include "kernel_operator.h"
 
@@ -115,10 +117,10 @@ Refer to https://www.inf.ed.ac.uk/teaching/courses/ppls/BarrierPaper.pdf for mor
   
 2. Implementation details
 
-Current implementation maintains an array of MAX_RANK_SIZE for each rank, with element of pos i indicating whether the rank has received signal of rank i.
+Current implementation maintains an array of one element per round for each rank, with element of round r indicating whether the rank has received signal of round r.
 In each round, every rank writes remote array and check local array to decide whether this round has finished. Once all rounds finished, barrier ends. 
 
-Theoretically, each element is writen by only 1 rank and read by self, involving only p2p synchronization.
+The sender of round r is always the rank at distance 2^r, so each element is writen by only 1 rank and read by self, involving only p2p synchronization.
 However, separate elements may exist on the same cacheline, so that concurrent write acctually happens and may cause wrong result.
 
 For example:
@@ -148,50 +150,77 @@ d. rank n-2 overwrites rank n-1，so rank n may miss rank n-1's signal and wait
 
 To avoid this issue, separate elements must exist on different cachelines. See shmemi_sync_bit for detailed definition.
 
-Additionly, instead of simply write a flag, each rank writes a 64-bit number into the array, indicating how many times this team has performed barrier. 
+Additionly, instead of simply write a flag, each rank writes a 32-bit epoch into the array, indicating how many times this team has performed barrier.
+The epoch makes the per-round elements reusable across barriers without resetting them: a sender may already be in the next barrier and overwrite
+epoch e with e + 1 before the receiver reads it, which the receiver accepts as well (see shmemi_signal_wait_until_eq_for_barrier). The sender can
+not get further ahead, since finishing barrier e + 1 requires the receiver to have arrived at it.
 
-The temporal and spatial complexity of this implementation are O(logN) and O(N), respectively. 
+The temporal and spatial complexity of this implementation are O(logN) and O(logN), respectively. 
 
 3. Futher development
   a. Hierarchical synchronization. 
-    Sync within the host first, then sync between host. May achieve better performance by utilizing low-latency in-host network better.
+    Sync within the host first, then sync between host. Implemented by shmemi_barrier_sys for teams spanning hosts.
 
   b. Group dissemination.
     Group the ranks so that each rank could issue multiple signals and waits concurrently, instead of 1 signal and 1 wait as above.
 
   c. Optimize spatial complexity to O(logN).
+    Done, elements are indexed by round instead of by source rank.
 */
 
+/* Layout of the team sync array, SYNC_ARRAY_SLOTS elements in total.
+   The centralized and the hierarchical barriers use the arrival and release elements, the dissemination barriers
+   use element (round, i) for the i-th signal of a round. Algorithms of a team may be switched between barriers since
+   stale elements always hold an older epoch. The progress element is local, it tracks the split-phase barrier. */
+#define SHMEMI_BARRIER_ARRIVE_SLOT 0
+#define SHMEMI_BARRIER_RELEASE_SLOT 1
+#define SHMEMI_BARRIER_PROGRESS_SLOT 2
+#define SHMEMI_BARRIER_ROUND_SLOT 3
+#define SHMEMI_BARRIER_ROUND_SLOTS (SHMEM_BARRIER_TG_DISSEM_KVAL - 1)
+
+SHMEM_DEVICE __gm__ int32_t *shmemi_barrier_round_slot(__gm__ shmemi_sync_bit *sync_array, int round, int i)
+{
+    return (__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_ROUND_SLOT + round * SHMEMI_BARRIER_ROUND_SLOTS + i);
+}
+
+// sets the barrier flag addr on pe, over MTE within the host and as an RDMA WRITE across hosts
+SHMEM_DEVICE void shmemi_barrier_signal_peer(__gm__ int32_t *addr, int pe, int32_t val)
+{
+    if (shmemi_get_hot_state()->topo_list[pe] & SHMEM_TRANSPORT_MTE) {
+        shmemi_signal_set(addr, pe, val);
+    } else {
+        // zero-byte put, only the signal WQE is posted
+        shmemi_roce_put_signal((__gm__ uint8_t *)addr, nullptr, 0, addr, val, SHMEM_SIGNAL_SET, pe, false);
+    }
+}
+
 SHMEM_DEVICE void shmemi_barrier_npu_v1(shmemi_team_t *team)
 {
     if (AscendC::GetBlockIdx() != 0)
         return;
 
-    int my_pe = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
-    int start = team->start;
-    int stride = team->stride;
     int size = team->size;
     auto sync_array = shmemi_get_team_sync_array(team->team_idx);
     auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
 
     int shift = 1;
-    int my_pe_in_team = (my_pe - start) / stride;
+    int round = 0;
+    int my_pe_in_team = team->mype;
     int32_t count = shmemi_load((__gm__ int32_t *)sync_counter) + 1;
 
     while (shift < size) {
-        int pre_pe_in_team = (my_pe_in_team - shift + size) % size;
         int next_pe_in_team = (my_pe_in_team + shift) % size;
+        int next_pe = shmemi_team_global_pe(team, next_pe_in_team);
+        auto round_flag = shmemi_barrier_round_slot(sync_array, round, 0);
 
-        int pre_pe = start + pre_pe_in_team * stride;
-        int next_pe = start + next_pe_in_team * stride;
-
-        // signal next pe
-        shmemi_signal_set((__gm__ int32_t *)(sync_array + my_pe), next_pe, count);
+        // signal next pe, which may be on another host when the team has no host grouping
+        shmemi_barrier_signal_peer(round_flag, next_pe, count);
 
         // wait pre pe
-        shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)(sync_array + pre_pe), count);
+        shmemi_signal_wait_until_eq_for_barrier(round_flag, count);
 
         shift *= SHIFT_MULTIPLIER;
+        round++;
     }
 
     shmemi_store((__gm__ int32_t *)sync_counter, count);
@@ -206,9 +235,6 @@ SHMEM_DEVICE void shmemi_barrier_npu_v2(shmemi_team_t *team)
     int vec_id = AscendC::GetBlockIdx();
     int vec_size = AscendC::GetBlockNum() * AscendC::GetTaskRation();
 
-    int my_pe = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
-    int start = team->start;
-    int stride = team->stride;
     int size = team->size;
     auto sync_array = shmemi_get_team_sync_array(team->team_idx);
     auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
@@ -217,27 +243,31 @@ SHMEM_DEVICE void shmemi_barrier_npu_v2(shmemi_team_t *team)
     int k = SHMEM_BARRIER_TG_DISSEM_KVAL;
     k = k < size ? k : size;
     k = k < vec_size ? k : vec_size;
-    int my_pe_in_team = (my_pe - start) / stride;
+    if (k < SHIFT_MULTIPLIER) {
+        // a single vector core can not fan out, and shift would never grow
+        shmemi_barrier_npu_v1(team);
+        return;
+    }
+    int my_pe_in_team = team->mype;
     int32_t count = shmemi_load((__gm__ int32_t *)sync_counter) + 1;
 
+    int round = 0;
     while (shift < size) {
         for (int i = vec_id + 1; i < k; i += vec_size) {
             int next_pe_in_team = (my_pe_in_team + i * shift) % size;
-            int next_pe = start + next_pe_in_team * stride;
+            int next_pe = shmemi_team_global_pe(team, next_pe_in_team);
 
             // signal next pe
-            shmemi_signal_set((__gm__ int32_t *)(sync_array + my_pe), next_pe, count);
+            shmemi_signal_set(shmemi_barrier_round_slot(sync_array, round, i - 1), next_pe, count);
         }
 
         for (int i = vec_id + 1; i < k; i += vec_size) {
-            int pre_pe_in_team = (my_pe_in_team - i * shift + size) % size;
-            int pre_pe = start + pre_pe_in_team * stride;
-
-            // wait pre pe
-            shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)(sync_array + pre_pe), count);
+            // wait pre pe, which is i * shift ranks before
+            shmemi_signal_wait_until_eq_for_barrier(shmemi_barrier_round_slot(sync_array, round, i - 1), count);
         }
 
         shift *= k;
+        round++;
     }
 
     shmemi_store((__gm__ int32_t *)sync_counter, count);
@@ -253,9 +283,6 @@ SHMEM_DEVICE void shmemi_barrier_npu_v3(shmemi_team_t *team)
     int vec_id = AscendC::GetBlockIdx();
     int vec_size = AscendC::GetBlockNum() * AscendC::GetTaskRation();
 
-    int my_pe = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
-    int start = team->start;
-    int stride = team->stride;
     int size = team->size;
     auto sync_array = shmemi_get_team_sync_array(team->team_idx);
     auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
@@ -263,26 +290,78 @@ SHMEM_DEVICE void shmemi_barrier_npu_v3(shmemi_team_t *team)
     int k = SHMEM_BARRIER_TG_DISSEM_KVAL;
     k = k < size ? k : size;
     k = k < vec_size ? k : vec_size;
-    int my_pe_in_team = (my_pe - start) / stride;
+    int my_pe_in_team = team->mype;
     int32_t count = shmemi_load((__gm__ int32_t *)sync_counter) + 1;
 
     for (int i = vec_id; i < size; i += k) {
         if (i == my_pe_in_team) {
             // write local
-            shmemi_signal_set((__gm__ int32_t *)sync_array, count);
+            shmemi_signal_set((__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_ARRIVE_SLOT), count);
         } else {
             // read remote
-            int remote_pe = start + i * stride;
-            shmemi_signal_wait_until_eq_for_barrier((__gm__ int32_t *)shmem_ptr(sync_array, remote_pe), count);
+            int remote_pe = shmemi_team_global_pe(team, i);
+            shmemi_signal_wait_until_eq_for_barrier(
+                (__gm__ int32_t *)shmem_ptr(sync_array + SHMEMI_BARRIER_ARRIVE_SLOT, remote_pe), count);
         }
     }
 
     shmemi_store((__gm__ int32_t *)sync_counter, count);
 }
 
-/* Level 3: barrier between hosts, TO BE IMPLEMENTED.*/
-SHMEM_DEVICE void shmemi_barrier_sys()
+/* Level 3: barrier between hosts
+
+Hierarchical Barrier
+
+Team members are grouped by host when the team is created (see shmemi_team_t). The first member of each host in team
+order is the host leader.
+
+  1. Gather:  every member writes its arrival count locally, the leader pulls them over MTE.
+  2. Sync:    leaders run the dissemination barrier above among themselves, signals cross hosts as RDMA WRITEs.
+  3. Release: the leader writes the release count locally, every member pulls it over MTE.
+
+Only leaders touch the scale-out network, with ceil(log2(H)) signals for H hosts, so the barrier costs
+O(N_local + logH) instead of the O(N) remote loads of shmemi_barrier_npu_v3, which can not cross hosts at all.
+
+*/
+
+SHMEM_DEVICE void shmemi_barrier_sys(shmemi_team_t *team)
 {
+    if (AscendC::GetBlockIdx() != 0)
+        return;
+
+    auto sync_array = shmemi_get_team_sync_array(team->team_idx);
+    auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
+    auto arrive = (__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_ARRIVE_SLOT);
+    auto release = (__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_RELEASE_SLOT);
+    int32_t count = shmemi_load((__gm__ int32_t *)sync_counter) + 1;
+
+    if (team->local_rank != 0) {
+        shmemi_signal_set(arrive, count);
+        shmemi_signal_wait_until_eq_for_barrier(shmemi_ptr(release, team->local_pes[0]), count);
+        shmemi_store((__gm__ int32_t *)sync_counter, count);
+        return;
+    }
+
+    // gather
+    for (int i = 1; i < team->local_size; i++) {
+        shmemi_signal_wait_until_eq_for_barrier(shmemi_ptr(arrive, team->local_pes[i]), count);
+    }
+
+    // sync among leaders
+    int host_num = team->host_num;
+    int round = 0;
+    for (int shift = 1; shift < host_num; shift *= SHIFT_MULTIPLIER) {
+        auto round_flag = shmemi_barrier_round_slot(sync_array, round, 0);
+        int next_leader = team->leader_pes[(team->host_rank + shift) % host_num];
+
+        shmemi_barrier_signal_peer(round_flag, next_leader, count);
+        shmemi_signal_wait_until_eq_for_barrier(round_flag, count);
+        round++;
+    }
+
+    // release
+    shmemi_signal_set(release, count);
+    shmemi_store((__gm__ int32_t *)sync_counter, count);
 }
 
 template <bool is_aiv_only = true>
@@ -290,20 +369,202 @@ SHMEM_DEVICE void shmemi_barrier(shmem_team_t tid)
 {
     shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
 
-    int mype = shmemi_get_state()->team_pools[SHMEM_TEAM_WORLD]->mype;
-    int start = team->start;
-    int stride = team->stride;
-    int size = team->size;
-
-    if ((mype - start) % stride != 0) {
+    if (!shmemi_team_is_member(team)) {
         // not in this team
         return;
     }
 
     shmemi_barrier_core<is_aiv_only>();
 
+    // algorithm is chosen per team when the team is created
     if ASCEND_IS_AIV {
-        shmemi_barrier_npu_v3(team);
+        switch (team->barrier_algo) {
+            case SHMEMX_BARRIER_DISSEM:
+                shmemi_barrier_npu_v1(team);
+                break;
+            case SHMEMX_BARRIER_GROUP_DISSEM:
+                shmemi_barrier_npu_v2(team);
+                break;
+            case SHMEMX_BARRIER_HIER:
+                shmemi_barrier_sys(team);
+                break;
+            default:
+                shmemi_barrier_npu_v3(team);
+                break;
+        }
+    }
+
+    shmemi_barrier_core<is_aiv_only>();
+}
+
+/* Split-phase barrier
+
+shmemi_barrier_arrive publishes the arrival of the calling PE and returns, shmemi_barrier_test / shmemi_barrier_wait
+complete it later, so that independent work can overlap the network latency of the barrier.
+
+The epoch is advanced in sync_counter at arrival, and completion is tracked in the local progress element as
+(epoch, stage) so that shmemi_barrier_test can resume where it stopped. Only vector core 0 drives the progress, the
+other cores report what it has observed.
+  - Teams within a host:   stage i means members [0, i) have arrived, members are pulled over MTE.
+  - Teams without a host grouping (host_num == 0): every round of the dissemination among all members takes two
+                           stages, as among the leaders below.
+  - Teams spanning hosts:  members pull the release of the host leader. The leader gathers its host in stages
+                           [0, local_size), then every round of the dissemination among leaders takes two stages,
+                           sending the signal and receiving the one of the round.
+*/
+#define SHMEMI_BARRIER_SPLIT_DONE 0x7fffffff
+
+SHMEM_DEVICE bool shmemi_barrier_flag_reached(__gm__ int32_t *flag, int32_t count, bool blocking)
+{
+    if (blocking) {
+        shmemi_signal_wait_until_eq_for_barrier(flag, count);
+        return true;
+    }
+    dcci_cacheline((__gm__ uint8_t *)flag);
+    int32_t val = *flag;
+    return val == count || val == count + 1;
+}
+
+SHMEM_DEVICE bool shmemi_barrier_split_progress(shmemi_team_t *team, bool blocking)
+{
+    auto sync_array = shmemi_get_team_sync_array(team->team_idx);
+    auto arrive = (__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_ARRIVE_SLOT);
+    auto release = (__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_RELEASE_SLOT);
+    auto progress = (__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_PROGRESS_SLOT);
+    dcci_cacheline((__gm__ uint8_t *)progress);
+    int32_t count = progress[0];
+    int32_t stage = progress[1];
+    bool done = true;
+
+    if (stage == SHMEMI_BARRIER_SPLIT_DONE) {
+        return true;
+    }
+
+    if (team->host_num == 0) {
+        // no host grouping, dissemination among all members, two stages per round as among leaders below
+        int size = team->size;
+        int rounds = 0;
+        for (int shift = 1; shift < size; shift *= SHIFT_MULTIPLIER) {
+            rounds++;
+        }
+        while (stage < rounds * 2) {
+            int round = stage / 2;
+            auto round_flag = shmemi_barrier_round_slot(sync_array, round, 0);
+            if (stage % 2 == 0) {
+                int next_pe = shmemi_team_global_pe(team, (team->mype + (1 << round)) % size);
+                shmemi_barrier_signal_peer(round_flag, next_pe, count);
+            } else if (!shmemi_barrier_flag_reached(round_flag, count, blocking)) {
+                break;
+            }
+            stage++;
+        }
+        done = stage == rounds * 2;
+    } else if (team->host_num == 1) {
+        while (stage < team->size) {
+            auto flag = (__gm__ int32_t *)shmem_ptr(arrive, shmemi_team_global_pe(team, stage));
+            if (!shmemi_barrier_flag_reached(flag, count, blocking)) {
+                break;
+            }
+            stage++;
+        }
+        done = stage == team->size;
+    } else if (team->local_rank != 0) {
+        done = shmemi_barrier_flag_reached(shmemi_ptr(release, team->local_pes[0]), count, blocking);
+    } else {
+        int local_size = team->local_size;
+        int host_num = team->host_num;
+        int rounds = 0;
+        for (int shift = 1; shift < host_num; shift *= SHIFT_MULTIPLIER) {
+            rounds++;
+        }
+        while (stage < local_size) {
+            if (!shmemi_barrier_flag_reached(shmemi_ptr(arrive, team->local_pes[stage]), count, blocking)) {
+                break;
+            }
+            stage++;
+        }
+        while (stage >= local_size && stage < local_size + rounds * 2) {
+            int round = (stage - local_size) / 2;
+            auto round_flag = shmemi_barrier_round_slot(sync_array, round, 0);
+            if ((stage - local_size) % 2 == 0) {
+                int next_leader = team->leader_pes[(team->host_rank + (1 << round)) % host_num];
+                shmemi_barrier_signal_peer(round_flag, next_leader, count);
+            } else if (!shmemi_barrier_flag_reached(round_flag, count, blocking)) {
+                break;
+            }
+            stage++;
+        }
+        done = stage == local_size + rounds * 2;
+        if (done) {
+            shmemi_signal_set(release, count);
+        }
+    }
+
+    progress[1] = done ? SHMEMI_BARRIER_SPLIT_DONE : stage;
+    dcci_cacheline((__gm__ uint8_t *)progress);
+    return done;
+}
+
+template <bool is_aiv_only = true>
+SHMEM_DEVICE void shmemi_barrier_arrive(shmem_team_t tid)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+    if (!shmemi_team_is_member(team)) {
+        return;
+    }
+
+    auto sync_array = shmemi_get_team_sync_array(team->team_idx);
+    auto sync_counter = shmemi_get_team_sync_counter(team->team_idx);
+    auto progress = (__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_PROGRESS_SLOT);
+    bool driver = false;
+    if ASCEND_IS_AIV {
+        driver = AscendC::GetBlockIdx() == 0;
+    }
+
+    // reset progress before other cores may test it
+    int32_t count = shmemi_load((__gm__ int32_t *)sync_counter) + 1;
+    if (driver) {
+        progress[0] = count;
+        progress[1] = 0;
+        dcci_cacheline((__gm__ uint8_t *)progress);
+    }
+
+    // stores of every core happen before the arrival
+    shmemi_barrier_core<is_aiv_only>();
+
+    if (driver) {
+        shmemi_store((__gm__ int32_t *)sync_counter, count);
+        shmemi_signal_set((__gm__ int32_t *)(sync_array + SHMEMI_BARRIER_ARRIVE_SLOT), count);
+    }
+}
+
+SHMEM_DEVICE int shmemi_barrier_test(shmem_team_t tid)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+    if (!shmemi_team_is_member(team)) {
+        return 1;
+    }
+
+    if (AscendC::GetBlockIdx() == 0) {
+        return shmemi_barrier_split_progress(team, false) ? 1 : 0;
+    }
+    auto progress = (__gm__ int32_t *)(shmemi_get_team_sync_array(team->team_idx) + SHMEMI_BARRIER_PROGRESS_SLOT);
+    dcci_cacheline((__gm__ uint8_t *)progress);
+    return progress[1] == SHMEMI_BARRIER_SPLIT_DONE ? 1 : 0;
+}
+
+template <bool is_aiv_only = true>
+SHMEM_DEVICE void shmemi_barrier_wait(shmem_team_t tid)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+    if (!shmemi_team_is_member(team)) {
+        return;
+    }
+
+    if ASCEND_IS_AIV {
+        if (AscendC::GetBlockIdx() == 0) {
+            shmemi_barrier_split_progress(team, true);
+        }
     }
 
     shmemi_barrier_core<is_aiv_only>();
@@ -212,16 +212,137 @@ SHMEM_DEVICE int shmemi_test(__gm__ T *sig_addr, int cmp, T cmp_val)
     return 0;
 }
 
+/*
+    Vector waits over ivars[i * stride], i in [0, nelems), skipping i with status[i] != 0.
+
+    Every poll is a sweep over the remaining elements. A cache line is invalidated once per sweep, and all elements
+    it holds are compared from the same fetch, so flags packed into whole cache lines cost one invalidation per line
+    rather than one per flag. Flags sharing a line must then have a single writer, or be written by MTE/RDMA copies,
+    since a scalar store writes back the whole line. After a sweep without progress, the waiter backs off for
+    SHMEMI_WAIT_BACKOFF_MIN system cycles, or max_backoff if lower, doubled every empty sweep up to max_backoff,
+    which keeps idle waiters off the interconnect. max_backoff 0 spins.
+*/
+#define SHMEMI_WAIT_BACKOFF_MIN 32
+#define SHMEMI_WAIT_NONE (static_cast<size_t>(-1))
+
 template <typename T>
-SHMEM_DEVICE void shmemi_wait_until_all(__gm__ T *sig_addr, size_t nelems, const int *status, int cmp, T cmp_val,
-                                        int stride = SHMEMI_SYNCBIT_SIZE / sizeof(T))
+SHMEM_DEVICE bool shmemi_cmp(T val, int cmp, T cmp_val)
+{
+    switch (cmp) {
+        case SHMEM_CMP_EQ:
+            return val == cmp_val;
+        case SHMEM_CMP_NE:
+            return val != cmp_val;
+        case SHMEM_CMP_GT:
+            return val > cmp_val;
+        case SHMEM_CMP_GE:
+            return val >= cmp_val;
+        case SHMEM_CMP_LT:
+            return val < cmp_val;
+        case SHMEM_CMP_LE:
+            return val <= cmp_val;
+    }
+    return false;
+}
+
+// load of a sweep, line is the cache line already invalidated by this sweep
+template <typename T>
+SHMEM_DEVICE T shmemi_sweep_load(__gm__ T *ivar, uint64_t &line)
+{
+    uint64_t cur = reinterpret_cast<uint64_t>(ivar) / SCALAR_DATA_CACHELINE_SIZE;
+    if (cur != line) {
+        dcci_cacheline((__gm__ uint8_t *)ivar);
+        line = cur;
+    }
+    return *ivar;
+}
+
+// first delay of a wait, never above max_backoff
+SHMEM_DEVICE uint32_t shmemi_wait_backoff_start(uint32_t max_backoff)
+{
+    return (max_backoff < SHMEMI_WAIT_BACKOFF_MIN) ? max_backoff : SHMEMI_WAIT_BACKOFF_MIN;
+}
+
+SHMEM_DEVICE void shmemi_wait_backoff(uint32_t &delay, uint32_t max_backoff)
+{
+    if (max_backoff == 0) {
+        return;
+    }
+    int64_t end = AscendC::GetSystemCycle() + delay;
+    while (AscendC::GetSystemCycle() < end) {
+    }
+    delay = (delay * 2 < max_backoff) ? delay * 2 : max_backoff;
+}
+
+// index of the first element satisfying the condition, SHMEMI_WAIT_NONE if none
+template <typename T>
+SHMEM_DEVICE size_t shmemi_test_any(__gm__ T *ivars, size_t nelems, const int *status, int cmp, T cmp_val,
+                                    int stride = 1)
+{
+    uint64_t line = ~0ULL;
+    for (size_t i = 0; i < nelems; i++) {
+        if (status && status[i] != 0) {
+            continue;
+        }
+        if (shmemi_cmp(shmemi_sweep_load(ivars + i * stride, line), cmp, cmp_val)) {
+            return i;
+        }
+    }
+    return SHMEMI_WAIT_NONE;
+}
+
+// indices of all elements satisfying the condition, returns their count
+template <typename T>
+SHMEM_DEVICE size_t shmemi_test_some(__gm__ T *ivars, size_t nelems, size_t *indices, const int *status, int cmp,
+                                     T cmp_val, int stride = 1)
 {
-    for (int i = 0; i < nelems; i++) {
+    uint64_t line = ~0ULL;
+    size_t num = 0;
+    for (size_t i = 0; i < nelems; i++) {
         if (status && status[i] != 0) {
             continue;
         }
+        if (shmemi_cmp(shmemi_sweep_load(ivars + i * stride, line), cmp, cmp_val)) {
+            indices[num++] = i;
+        }
+    }
+    return num;
+}
+
+SHMEM_DEVICE bool shmemi_wait_all_masked(size_t nelems, const int *status)
+{
+    if (status == nullptr) {
+        return nelems == 0;
+    }
+    for (size_t i = 0; i < nelems; i++) {
+        if (status[i] == 0) {
+            return false;
+        }
+    }
+    return true;
+}
 
-        shmemi_wait_until(sig_addr + i * stride, cmp, cmp_val);
+template <typename T>
+SHMEM_DEVICE void shmemi_wait_until_all(__gm__ T *sig_addr, size_t nelems, const int *status, int cmp, T cmp_val,
+                                        int stride = SHMEMI_SYNCBIT_SIZE / sizeof(T), uint32_t max_backoff = 0)
+{
+    uint32_t delay = shmemi_wait_backoff_start(max_backoff);
+    size_t i = 0;
+    while (i < nelems) {
+        // elements before i are satisfied, sweep the rest from the first one that was not
+        uint64_t line = ~0ULL;
+        size_t first = i;
+        for (; i < nelems; i++) {
+            if (status && status[i] != 0) {
+                continue;
+            }
+            if (!shmemi_cmp(shmemi_sweep_load(sig_addr + i * stride, line), cmp, cmp_val)) {
+                break;
+            }
+        }
+        if (i < nelems && i == first) {
+            shmemi_wait_backoff(delay, max_backoff);
+        }
     }
 }
 
@@ -229,37 +350,48 @@ template <typename T>
 SHMEM_DEVICE int shmemi_test_all(__gm__ T *sig_addr, size_t nelems, const int *status, int cmp, T cmp_val,
                                  int stride = SHMEMI_SYNCBIT_SIZE / sizeof(T))
 {
-    int ret = 1;
-
-    for (int i = 0; i < nelems; i++) {
+    uint64_t line = ~0ULL;
+    for (size_t i = 0; i < nelems; i++) {
         if (status && status[i] != 0) {
             continue;
         }
-
-        dcci_cacheline((__gm__ uint8_t *)(sig_addr + i * stride));
-        switch (cmp) {
-            case SHMEM_CMP_EQ:
-                ret &= (*(sig_addr + i * stride) == cmp_val);
-                break;
-            case SHMEM_CMP_NE:
-                ret &= (*(sig_addr + i * stride) != cmp_val);
-                break;
-            case SHMEM_CMP_GT:
-                ret &= (*(sig_addr + i * stride) > cmp_val);
-                break;
-            case SHMEM_CMP_GE:
-                ret &= (*(sig_addr + i * stride) >= cmp_val);
-                break;
-            case SHMEM_CMP_LT:
-                ret &= (*(sig_addr + i * stride) < cmp_val);
-                break;
-            case SHMEM_CMP_LE:
-                ret &= (*(sig_addr + i * stride) <= cmp_val);
-                break;
+        if (!shmemi_cmp(shmemi_sweep_load(sig_addr + i * stride, line), cmp, cmp_val)) {
+            return 0;
         }
     }
+    return 1;
+}
 
-    return ret;
+// SHMEMI_WAIT_NONE if every element is excluded by status
+template <typename T>
+SHMEM_DEVICE size_t shmemi_wait_until_any(__gm__ T *ivars, size_t nelems, const int *status, int cmp, T cmp_val,
+                                          int stride = 1, uint32_t max_backoff = 0)
+{
+    if (shmemi_wait_all_masked(nelems, status)) {
+        return SHMEMI_WAIT_NONE;
+    }
+    uint32_t delay = shmemi_wait_backoff_start(max_backoff);
+    size_t idx;
+    while ((idx = shmemi_test_any(ivars, nelems, status, cmp, cmp_val, stride)) == SHMEMI_WAIT_NONE) {
+        shmemi_wait_backoff(delay, max_backoff);
+    }
+    return idx;
+}
+
+// 0 if every element is excluded by status
+template <typename T>
+SHMEM_DEVICE size_t shmemi_wait_until_some(__gm__ T *ivars, size_t nelems, size_t *indices, const int *status,
+                                           int cmp, T cmp_val, int stride = 1, uint32_t max_backoff = 0)
+{
+    if (shmemi_wait_all_masked(nelems, status)) {
+        return 0;
+    }
+    uint32_t delay = shmemi_wait_backoff_start(max_backoff);
+    size_t num;
+    while ((num = shmemi_test_some(ivars, nelems, indices, status, cmp, cmp_val, stride)) == 0) {
+        shmemi_wait_backoff(delay, max_backoff);
+    }
+    return num;
 }
 
 #endif
\ No newline at end of file
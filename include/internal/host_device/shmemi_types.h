@@ -15,8 +15,11 @@ extern "C" {
 #endif
 
 #define SHMEM_MAX_RANKS 1024
-#define SHMEM_MAX_TEAMS 32
+#define SHMEM_MAX_TEAMS 1024           // upper bound of the SHMEM_MAX_TEAMS environment variable
+#define SHMEM_DEFAULT_TEAMS 32        // team slots when SHMEM_MAX_TEAMS is not set
+#define SHMEM_TEAM_POOL_CHUNK 32      // team slots allocated together when the pool grows
 #define SHMEM_MAX_LOCAL_SIZE 4UL * 1024 * 1024 * 1024
+#define SHMEM_MAX_ROCE_QP_NUM 8
 
 /* arch related */
 #define SCALAR_DATA_CACHELINE_SIZE 64
@@ -30,11 +33,20 @@ extern "C" {
 #define SHMEMI_SYNCBIT_SIZE SCALAR_DATA_CACHELINE_SIZE
 
 // npu level sync
-#define SYNC_ARRAY_SIZE (SHMEMI_SYNCBIT_SIZE * SHMEM_MAX_RANKS)
-#define SYNC_COUNTER_SIZE SHMEMI_SYNCBIT_SIZE
-#define SYNC_POOL_SIZE (SYNC_ARRAY_SIZE * SHMEM_MAX_TEAMS)
-#define SYNC_COUNTERS_SIZE (SYNC_COUNTER_SIZE * SHMEM_MAX_TEAMS)
 #define SHMEM_BARRIER_TG_DISSEM_KVAL 8
+#define SHMEM_BARRIER_CENTRAL_MAX_LOADS 2   // auto selection keeps the centralized barrier up to size k * this
+#define SHMEM_MAX_LOCAL_RANKS 64        // team members on one host tracked by the hierarchical barrier
+#define SHMEM_MAX_HOSTS 128             // hosts spanned by a team tracked by the hierarchical barrier
+#define SHMEM_LOG_MAX_RANKS 10          // ceil(log_{2}^{SHMEM_MAX_RANKS}), max dissemination rounds
+// arrival, release and split-phase progress slots, then one slot per (round, signal in round)
+#define SYNC_ARRAY_SLOTS (3 + (SHMEM_BARRIER_TG_DISSEM_KVAL - 1) * SHMEM_LOG_MAX_RANKS)
+#define SYNC_ARRAY_SIZE (SHMEMI_SYNCBIT_SIZE * SYNC_ARRAY_SLOTS)
+#define SYNC_COUNTER_SIZE SHMEMI_SYNCBIT_SIZE
+#define SYNC_POOL_SIZE(teams) (SYNC_ARRAY_SIZE * (teams))
+#define SYNC_COUNTERS_SIZE(teams) (SYNC_COUNTER_SIZE * (teams))
+
+// team member table, global PEs of teams with arbitrary membership, one row per team slot of a pool chunk
+#define SHMEM_TEAM_MEMBER_CHUNK_SIZE (SHMEM_TEAM_POOL_CHUNK * SHMEM_MAX_RANKS * sizeof(int32_t))
 
 // core level sync
 #define SHMEM_MAX_AIV_PER_NPU 48
@@ -42,8 +54,78 @@ extern "C" {
 #define SHMEM_CORE_SYNC_POOL_SIZE (SHMEM_MAX_AIV_PER_NPU * SHMEM_LOG_MAX_AIV_PER_NPU * SHMEMI_SYNCBIT_SIZE)
 #define SHMEM_CORE_SYNC_COUNTER_SIZE SHMEMI_SYNCBIT_SIZE
 
+// atomic memory operations, one fetch slot per core for RDMA atomics
+#define SHMEM_AMO_FETCH_SLOT_SIZE SHMEMI_SYNCBIT_SIZE
+#define SHMEM_AMO_FETCH_POOL_SIZE (SHMEM_AMO_FETCH_SLOT_SIZE * SHMEM_MAX_AIV_PER_NPU)
+
+// communication contexts
+#define SHMEM_MAX_CTXS 8
+#define SHMEM_CTX_UB_SIZE (16 * 1024)
+#define SHMEM_CTX_TRACK_SIZE SHMEMI_SYNCBIT_SIZE
+#define SHMEM_CTX_TRACK_POOL_SIZE (SHMEM_CTX_TRACK_SIZE * SHMEM_MAX_AIV_PER_NPU * SHMEM_MAX_CTXS)
+#define SHMEM_CTX_DCCI_MAX_SIZE (64 * 1024)   // larger dirty ranges fall back to flushing the entire cache
+
+// collectives, UB working area of the reductions, between the ctx staging buffers and the internal RoCE buffer
+#define SHMEM_COLL_UB_OFFSET (SHMEM_MAX_CTXS * SHMEM_CTX_UB_SIZE)
+#define SHMEM_COLL_UB_SIZE (48 * 1024)
+#define SHMEM_COLL_OP_NUM 5                 // SHMEMX_COLL_OP_NUM
+#define SHMEM_COLL_TUNE_MAX_RANGES 8        // message size ranges of one collective in a team descriptor
+
+// low-latency allreduce, symmetric pool of the flags, the pair sequences and the data slots written by the peers,
+// each indexed by the host-local index of the writing PE, see shmemi_device_coll.h
+#define SHMEM_COLL_LL_MAX_PES 16
+#define SHMEM_COLL_LL_SLOT_SIZE (64 * 1024)
+#define SHMEM_COLL_LL_FLAG_SIZE (2 * 2 * SHMEM_COLL_LL_MAX_PES * SHMEM_MAX_AIV_PER_NPU * SHMEMI_SYNCBIT_SIZE)
+#define SHMEM_COLL_LL_SEQ_OFFSET SHMEM_COLL_LL_FLAG_SIZE
+#define SHMEM_COLL_LL_DATA_OFFSET (SHMEM_COLL_LL_SEQ_OFFSET + SHMEMI_SYNCBIT_SIZE)
+#define SHMEM_COLL_LL_POOL_SIZE (SHMEM_COLL_LL_DATA_OFFSET + 2 * SHMEM_COLL_LL_MAX_PES * SHMEM_COLL_LL_SLOT_SIZE)
+
+// alltoallv, symmetric pool of the ready and done flags set by every member, then the row of send counts of every
+// member, all indexed by the team rank of the writer and laid out for npes of the world, see shmemi_device_coll.h
+#define SHMEM_COLL_COUNTS_ROW_SIZE(npes) ALIGH_TO((uint64_t)(npes) * sizeof(uint32_t), SCALAR_DATA_CACHELINE_SIZE)
+#define SHMEM_COLL_COUNTS_ROW_OFFSET(npes) (2 * (uint64_t)(npes) * SHMEMI_SYNCBIT_SIZE)
+#define SHMEM_COLL_COUNTS_POOL_SIZE(npes) \
+    (SHMEM_COLL_COUNTS_ROW_OFFSET(npes) + (uint64_t)(npes) * SHMEM_COLL_COUNTS_ROW_SIZE(npes))
+
+// pipelined ring allreduce, symmetric pool of the flags set by the left neighbour per core and lane, then the local
+// words holding the values of the RoCE signals in flight, see shmemi_device_coll.h
+#define SHMEM_COLL_PIPE_CHUNK_SIZE (128 * 1024)     // bytes of a unit pushed by one core
+#define SHMEM_COLL_PIPE_MAX_LANES SHMEM_MAX_ROCE_QP_NUM
+#define SHMEM_COLL_PIPE_SIG_DEPTH 4                 // signals in flight per lane
+#define SHMEM_COLL_PIPE_SIG_OFFSET (SHMEM_MAX_AIV_PER_NPU * SHMEM_COLL_PIPE_MAX_LANES * SHMEMI_SYNCBIT_SIZE)
+#define SHMEM_COLL_PIPE_POOL_SIZE \
+    (SHMEM_COLL_PIPE_SIG_OFFSET * (1 + SHMEM_COLL_PIPE_SIG_DEPTH))
+
+// quantized collectives, the work buffer holds the quantized elements, then the float scale of every block
+#define SHMEM_QUANT_MIN_BLOCK 32
+#define SHMEM_QUANT_MAX_BLOCK 2048
+#define SHMEM_QUANT_DATA_SIZE(nelems, elem_bytes) \
+    ALIGH_TO((uint64_t)(nelems) * (elem_bytes), SCALAR_DATA_CACHELINE_SIZE)
+#define SHMEM_QUANT_SCALE_SIZE(nelems, block) \
+    ALIGH_TO(((uint64_t)(nelems) + (block) - 1) / (block) * sizeof(float), SCALAR_DATA_CACHELINE_SIZE)
+
+// persistent work queue, a header of one cacheline per counter, then depth slots of a descriptor and its sequence
+#define SHMEM_WORK_QUEUE_DEFAULT_DEPTH 256
+#define SHMEM_WORK_QUEUE_MAX_DEPTH 4096
+#define SHMEM_WORK_QUEUE_HEADER_SIZE (4 * SCALAR_DATA_CACHELINE_SIZE)
+#define SHMEM_WORK_SLOT_SIZE (2 * SCALAR_DATA_CACHELINE_SIZE)
+#define SHMEM_WORK_SLOT_SEQ_OFFSET (SHMEM_WORK_SLOT_SIZE - sizeof(uint64_t))   // ticket + 1 once published
+#define SHMEM_WORK_QUEUE_SIZE(depth) (SHMEM_WORK_QUEUE_HEADER_SIZE + (uint64_t)(depth) * SHMEM_WORK_SLOT_SIZE)
+#define SHMEMI_WORK_STOP (-1)                // op of the descriptor ending the persistent kernel
+
+// team scratch, a symmetric arena taken at init and handed out to the teams in granules on first use, then a local
+// epoch counter per (team slot, core), see shmem_team.cpp
+#define SHMEM_TEAM_SCRATCH_GRANULE (64 * 1024)
+#define SHMEM_TEAM_SCRATCH_DEFAULT_SIZE (4UL * 1024 * 1024)     // when SHMEM_TEAM_SCRATCH_SIZE is not set
+#define SHMEM_SCRATCH_ARENA_DEFAULT_SIZE (64UL * 1024 * 1024)   // when SHMEM_SCRATCH_ARENA_SIZE is not set
+#define SHMEM_TEAM_EPOCH_SIZE SHMEMI_SYNCBIT_SIZE
+#define SHMEM_TEAM_EPOCH_ROW_SIZE (SHMEM_TEAM_EPOCH_SIZE * SHMEM_MAX_AIV_PER_NPU)
+#define SHMEM_TEAM_EPOCH_POOL_SIZE(teams) (SHMEM_TEAM_EPOCH_ROW_SIZE * (uint64_t)(teams))
+
 // Total extra
-#define SHMEM_EXTRA_SIZE_UNALIGHED SYNC_POOL_SIZE
+#define SHMEM_EXTRA_SIZE_UNALIGHED \
+    (SYNC_POOL_SIZE(SHMEM_DEFAULT_TEAMS) + SHMEM_AMO_FETCH_POOL_SIZE + SHMEM_COLL_LL_POOL_SIZE + \
+     SHMEM_COLL_PIPE_POOL_SIZE)
 #define SHMEM_EXTRA_SIZE ALIGH_TO(SHMEM_EXTRA_SIZE_UNALIGHED, SHMEM_PAGE_SIZE)
 
 // global_state
@@ -54,13 +136,36 @@ constexpr uint64_t GLOBAL_STATE_SIZE = 4UL * 1024UL * 1024UL; // global_state fi
 // synchronization
 typedef int32_t shmemi_sync_bit[SHMEMI_SYNCBIT_SIZE / sizeof(int32_t)];
 
+// Collective algorithm of a team per message size, algo[i] (shmemx_coll_algo_t, never SHMEMX_COLL_AUTO) is used up
+// to max_bytes[i] bytes per PE, the last range is unbounded.
+typedef struct {
+    int range_num;
+    int algo[SHMEM_COLL_TUNE_MAX_RANGES];
+    uint64_t max_bytes[SHMEM_COLL_TUNE_MAX_RANGES];
+} shmemi_coll_tune_t;
+
 // Team
 typedef struct {
     int mype;           // team view, [0, size]
     int start;          // global view, [0, npes]
-    int stride;         // global view, [1, npes - 1]
+    int stride;         // global view, [1, npes - 1], 0 if the members are listed in the team member table
     int size;           // team view
     int team_idx;
+    int barrier_algo;   // shmemx_barrier_algo_t, never SHMEMX_BARRIER_AUTO once the team is created
+    uint64_t members;   // 'int32_t *' actually, local, global PEs of a team with stride 0
+    uint64_t scratch;       // 'void *' actually, symmetric, 0 until the host allocates it on first use
+    uint64_t scratch_size;  // bytes, a multiple of SHMEM_TEAM_SCRATCH_GRANULE
+
+    // Host hierarchy seen from mype, filled by the host when the team is created.
+    int local_size;                         // team members on the same host as mype
+    int local_rank;                         // index of mype among them, 0 is the host leader
+    int host_num;                           // hosts spanned by the team, 0 if unknown or not tracked
+    int host_rank;                          // index of mype's host among them
+    int local_pes[SHMEM_MAX_LOCAL_RANKS];   // global view, same-host members in team order
+    int leader_pes[SHMEM_MAX_HOSTS];        // global view, leader of each host
+    int16_t host_ids[SHMEM_MAX_HOSTS];      // pe_host of the state of each host, ascending
+
+    shmemi_coll_tune_t coll_tune[SHMEM_COLL_OP_NUM];   // algorithms per shmemx_coll_op_t, filled at creation
 } shmemi_team_t;
 
 // mte_config
@@ -70,18 +175,46 @@ typedef struct {
     uint32_t event_id;       // TEventID, for Shmem memcpy sync.
 } shmemi_mte_config_t;
 
+// ctx, device view of a communication context
+typedef struct {
+    int valid;
+    int team_idx;                       // pe passed to ctx operations is relative to this team
+    uint32_t qp_idx;                    // picks one of the RoCE QPs owned by the issuing core
+    shmemi_mte_config_t mte_config;     // UB staging and event dedicated to this ctx
+} shmemi_ctx_t;
+
+// ctx completion tracking, one cacheline per (ctx, core), only touched by the owning core, all-zero is empty
+typedef struct {
+    uint64_t dirty_lo;                  // GM range [lo, hi) written or read since last ctx quiet
+    uint64_t dirty_hi;
+    int32_t roce_pe_lo;                 // global PEs [lo, hi) with outstanding RoCE WQEs
+    int32_t roce_pe_hi;
+} shmemi_ctx_track_t;
+
+// Header of the persistent work queue, the counters sit in cachelines of their own.
+typedef struct {
+    uint64_t tail;      // tickets taken by producers that share the queue, SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS only
+    uint8_t tail_pad[SCALAR_DATA_CACHELINE_SIZE - sizeof(uint64_t)];
+    uint64_t head;      // operations completed, only written by the persistent kernel
+    uint8_t head_pad[SCALAR_DATA_CACHELINE_SIZE - sizeof(uint64_t)];
+    uint64_t depth;     // slots, a power of two
+    uint64_t flags;     // of shmemx_work_queue_start
+    uint8_t conf_pad[2 * SCALAR_DATA_CACHELINE_SIZE - 2 * sizeof(uint64_t)];
+} shmemi_work_queue_t;
+
 // state
+// Read-mostly header first, every kernel touches it, while the per-PE tables written once at init sit at the end.
+// update_device_state() copies the span from the first to the last byte that changed since the last update, then
+// state_version in a separate copy, so keep fields that change together next to each other.
 typedef struct {
     int version;
     int mype;
     int npes;
+    uint64_t state_version;     // bumped by every update_device_state() that changes the state
     void *heap_base;
-    void *p2p_heap_base[SHMEM_MAX_RANKS];
-    void *rdma_heap_base[SHMEM_MAX_RANKS];
-    void *sdma_heap_base[SHMEM_MAX_RANKS];
-    uint8_t topo_list[SHMEM_MAX_RANKS];
     size_t heap_size;
 
+    // Descriptors live in chunks of SHMEM_TEAM_POOL_CHUNK slots allocated as the pool grows, null for free slots.
     shmemi_team_t *team_pools[SHMEM_MAX_TEAMS];
     
     // Using shmemi_sync_bit instead of basic types to shmemi_store flag, avoiding concurrent write due to cacheline sharing.
@@ -91,6 +224,7 @@ typedef struct {
     uint64_t sync_counter;
     uint64_t core_sync_pool;
     uint64_t core_sync_counter;
+    uint64_t amo_fetch_pool;    // symmetric, landing slots for RDMA atomic fetch results
     uint64_t host_hash;
 
     bool is_shmem_initialized;
@@ -98,6 +232,21 @@ typedef struct {
 
     shmemi_mte_config_t mte_config;
     uint64_t qp_info;
+
+    shmemi_ctx_t ctx_pools[SHMEM_MAX_CTXS];
+    uint64_t ctx_track_pool;    // 'shmemi_ctx_track_t *' actually, local
+    uint64_t work_queue;        // 'shmemi_work_queue_t *' actually, symmetric, 0 unless the work kernel runs
+    uint64_t coll_ll_pool;      // symmetric, SHMEM_COLL_LL_POOL_SIZE bytes of the low-latency allreduce
+    uint64_t coll_counts_pool;  // symmetric, SHMEM_COLL_COUNTS_POOL_SIZE(npes) bytes of the alltoallv counts
+    uint64_t coll_pipe_pool;    // symmetric, SHMEM_COLL_PIPE_POOL_SIZE bytes of the pipelined ring allreduce
+    uint64_t team_epoch_pool;   // 'shmemi_sync_bit *' actually, local, epoch of every (team slot, core)
+
+    // per-PE tables
+    uint8_t topo_list[SHMEM_MAX_RANKS];
+    int16_t pe_host[SHMEM_MAX_RANKS];   // host of every PE, hosts numbered in order of their first PE
+    void *p2p_heap_base[SHMEM_MAX_RANKS];
+    void *rdma_heap_base[SHMEM_MAX_RANKS];
+    void *sdma_heap_base[SHMEM_MAX_RANKS];
 } shmemi_device_host_state_t;
 
 #ifdef __cplusplus
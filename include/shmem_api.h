@@ -12,17 +12,24 @@
 
 #if defined(__CCE_AICORE__) || defined(__CCE_KT_TEST__)
 #include "device/shmem_device_def.h"
+#include "device/shmem_device_amo.h"
+#include "device/shmem_device_coll.h"
+#include "device/shmem_device_ctx.h"
 #include "device/shmem_device_rma.h"
 #include "device/shmemx_device_rma.h"
 #include "device/shmem_device_sync.h"
 #include "device/shmem_device_team.h"
+#include "device/shmemx_device_work.h"
 #endif
 
 #include "host/shmem_host_def.h"
+#include "host/shmem_host_amo.h"
+#include "host/shmem_host_coll.h"
 #include "host/shmem_host_heap.h"
 #include "host/shmem_host_init.h"
 #include "host/shmem_host_rma.h"
 #include "host/shmem_host_sync.h"
 #include "host/shmem_host_team.h"
+#include "host/shmemx_host_work.h"
 
 #endif // SHMEM_API_H
\ No newline at end of file
@@ -18,10 +18,32 @@ SHMEM_GLOBAL void k_shmem_barrier(int32_t tid)
     shmemi_barrier<false>(tid);
 }
 
+SHMEM_GLOBAL void k_shmem_barrier_arrive(int32_t tid)
+{
+    shmemi_barrier_arrive<false>(tid);
+}
+
+SHMEM_GLOBAL void k_shmem_barrier_wait(int32_t tid)
+{
+    shmemi_barrier_wait<false>(tid);
+}
+
 // interfaces
 int32_t shmemi_barrier_on_stream(shmem_team_t tid, aclrtStream stream)
 {
-    // call barrier kernel
+    // call barrier kernel, completion is ordered on the stream only
     k_shmem_barrier<<<1, nullptr, stream>>>((int32_t)tid);
-    return aclrtSynchronizeStream(stream);
-}
\ No newline at end of file
+    return 0;
+}
+
+int32_t shmemi_barrier_arrive_on_stream(shmem_team_t tid, aclrtStream stream)
+{
+    k_shmem_barrier_arrive<<<1, nullptr, stream>>>((int32_t)tid);
+    return 0;
+}
+
+int32_t shmemi_barrier_wait_on_stream(shmem_team_t tid, aclrtStream stream)
+{
+    k_shmem_barrier_wait<<<1, nullptr, stream>>>((int32_t)tid);
+    return 0;
+}
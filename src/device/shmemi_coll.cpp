@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "acl/acl.h"
+#include "kernel_operator.h"
+
+#include "shmem_api.h"
+#include "shmemi_device_coll.h"
+
+// kernels
+SHMEM_GLOBAL void k_shmem_allgather(uint64_t ffts, int32_t tid, GM_ADDR dest, GM_ADDR source, uint64_t nbytes)
+{
+    shmemx_set_ffts_config(ffts);
+    shmemi_allgather<uint8_t>(tid, (__gm__ uint8_t *)dest, (__gm__ uint8_t *)source, nbytes);
+}
+
+SHMEM_GLOBAL void k_shmem_broadcast(uint64_t ffts, int32_t tid, GM_ADDR dest, GM_ADDR source, uint64_t nbytes,
+                                    int32_t pe_root)
+{
+    shmemx_set_ffts_config(ffts);
+    shmemi_broadcast<uint8_t>(tid, (__gm__ uint8_t *)dest, (__gm__ uint8_t *)source, nbytes, pe_root);
+}
+
+SHMEM_GLOBAL void k_shmem_alltoall(uint64_t ffts, int32_t tid, GM_ADDR dest, GM_ADDR source, uint64_t nbytes)
+{
+    shmemx_set_ffts_config(ffts);
+    shmemi_alltoall<uint8_t>(tid, (__gm__ uint8_t *)dest, (__gm__ uint8_t *)source, nbytes);
+}
+
+template <typename T>
+SHMEM_DEVICE void shmemi_alltoallv_kernel(int32_t tid, GM_ADDR dest, uint64_t dest_stride, GM_ADDR source,
+                                          GM_ADDR send_counts, GM_ADDR send_offsets, GM_ADDR recv_counts,
+                                          GM_ADDR recv_offsets, GM_ADDR truncated)
+{
+    shmemi_alltoallv<T>(tid, (__gm__ T *)dest, dest_stride, (__gm__ T *)source, (__gm__ uint32_t *)send_counts,
+                        (__gm__ uint32_t *)send_offsets, (__gm__ uint32_t *)recv_counts,
+                        (__gm__ uint64_t *)recv_offsets, (__gm__ uint32_t *)truncated);
+}
+
+// counts are in elements, the element size picks the type
+SHMEM_GLOBAL void k_shmem_alltoallv(uint64_t ffts, int32_t tid, GM_ADDR dest, uint64_t dest_stride, GM_ADDR source,
+                                    GM_ADDR send_counts, GM_ADDR send_offsets, GM_ADDR recv_counts,
+                                    GM_ADDR recv_offsets, GM_ADDR truncated, uint32_t elem_size)
+{
+    shmemx_set_ffts_config(ffts);
+    switch (elem_size) {
+        case sizeof(int8_t):
+            shmemi_alltoallv_kernel<int8_t>(tid, dest, dest_stride, source, send_counts, send_offsets, recv_counts,
+                                            recv_offsets, truncated);
+            break;
+        case sizeof(int16_t):
+            shmemi_alltoallv_kernel<int16_t>(tid, dest, dest_stride, source, send_counts, send_offsets, recv_counts,
+                                             recv_offsets, truncated);
+            break;
+        case sizeof(int64_t):
+            shmemi_alltoallv_kernel<int64_t>(tid, dest, dest_stride, source, send_counts, send_offsets, recv_counts,
+                                             recv_offsets, truncated);
+            break;
+        default:
+            shmemi_alltoallv_kernel<int32_t>(tid, dest, dest_stride, source, send_counts, send_offsets, recv_counts,
+                                             recv_offsets, truncated);
+            break;
+    }
+}
+
+SHMEM_GLOBAL void k_shmem_allgather_quant(uint64_t ffts, int32_t tid, GM_ADDR dest, GM_ADDR source, uint64_t nelems,
+                                         int32_t format, uint32_t block_size, GM_ADDR work, GM_ADDR error)
+{
+    shmemx_set_ffts_config(ffts);
+    shmemx_quant_config_t config = {format, block_size, (uint64_t)work, (uint64_t)error};
+    shmemi_allgather_quant(tid, (__gm__ float *)dest, (__gm__ float *)source, nelems, config);
+}
+
+SHMEM_GLOBAL void k_shmem_allreduce_quant(uint64_t ffts, int32_t tid, GM_ADDR dest, GM_ADDR source, uint64_t nelems,
+                                         int32_t format, uint32_t block_size, GM_ADDR work, GM_ADDR error)
+{
+    shmemx_set_ffts_config(ffts);
+    shmemx_quant_config_t config = {format, block_size, (uint64_t)work, (uint64_t)error};
+    shmemi_allreduce_quant(tid, (__gm__ float *)dest, (__gm__ float *)source, nelems, config);
+}
+
+#define SHMEMI_TYPENAME_OP_REDUCE_KERNEL(NAME, TYPE, OP, REDUCE_OP)                                                  \
+    SHMEM_GLOBAL void k_shmem_##NAME##_##OP##_allreduce(uint64_t ffts, int32_t tid, GM_ADDR dest, GM_ADDR source,  \
+                                                        uint64_t nelems)                                           \
+    {                                                                                                              \
+        shmemx_set_ffts_config(ffts);                                                                              \
+        shmemi_allreduce<TYPE, SHMEMI_REDUCE_##REDUCE_OP>(tid, (__gm__ TYPE *)dest, (__gm__ TYPE *)source,         \
+                                                          nelems);                                                 \
+    }                                                                                                              \
+                                                                                                                   \
+    SHMEM_GLOBAL void k_shmem_##NAME##_##OP##_reduce_scatter(uint64_t ffts, int32_t tid, GM_ADDR dest,             \
+                                                             GM_ADDR source, uint64_t nelems)                      \
+    {                                                                                                              \
+        shmemx_set_ffts_config(ffts);                                                                              \
+        shmemi_reduce_scatter<TYPE, SHMEMI_REDUCE_##REDUCE_OP>(tid, (__gm__ TYPE *)dest, (__gm__ TYPE *)source,    \
+                                                               nelems);                                            \
+    }
+
+#define SHMEMI_TYPENAME_REDUCE_KERNEL(NAME, TYPE)                \
+    SHMEMI_TYPENAME_OP_REDUCE_KERNEL(NAME, TYPE, sum, SUM)       \
+    SHMEMI_TYPENAME_OP_REDUCE_KERNEL(NAME, TYPE, max, MAX)       \
+    SHMEMI_TYPENAME_OP_REDUCE_KERNEL(NAME, TYPE, min, MIN)
+
+SHMEM_REDUCE_TYPE_FUNC(SHMEMI_TYPENAME_REDUCE_KERNEL);
+#undef SHMEMI_TYPENAME_REDUCE_KERNEL
+#undef SHMEMI_TYPENAME_OP_REDUCE_KERNEL
+
+// interfaces
+int32_t shmemi_allgather_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source, size_t nbytes,
+                                   uint32_t block_dim, uint64_t ffts, aclrtStream stream)
+{
+    k_shmem_allgather<<<block_dim, nullptr, stream>>>(ffts, (int32_t)tid, dest, source, (uint64_t)nbytes);
+    return 0;
+}
+
+int32_t shmemi_broadcast_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source, size_t nbytes, int pe_root,
+                                   uint32_t block_dim, uint64_t ffts, aclrtStream stream)
+{
+    k_shmem_broadcast<<<block_dim, nullptr, stream>>>(ffts, (int32_t)tid, dest, source, (uint64_t)nbytes,
+                                                      (int32_t)pe_root);
+    return 0;
+}
+
+int32_t shmemi_alltoall_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source, size_t nbytes,
+                                  uint32_t block_dim, uint64_t ffts, aclrtStream stream)
+{
+    k_shmem_alltoall<<<block_dim, nullptr, stream>>>(ffts, (int32_t)tid, dest, source, (uint64_t)nbytes);
+    return 0;
+}
+
+int32_t shmemi_alltoallv_on_stream(shmem_team_t tid, uint8_t *dest, size_t dest_stride, uint8_t *source,
+                                   uint32_t *send_counts, uint32_t *send_offsets, uint32_t *recv_counts,
+                                   uint64_t *recv_offsets, uint32_t *truncated, size_t elem_size, uint32_t block_dim,
+                                   uint64_t ffts, aclrtStream stream)
+{
+    k_shmem_alltoallv<<<block_dim, nullptr, stream>>>(ffts, (int32_t)tid, dest, (uint64_t)dest_stride, source,
+                                                      (uint8_t *)send_counts, (uint8_t *)send_offsets,
+                                                      (uint8_t *)recv_counts, (uint8_t *)recv_offsets,
+                                                      (uint8_t *)truncated, (uint32_t)elem_size);
+    return 0;
+}
+
+int32_t shmemi_allgather_quant_on_stream(shmem_team_t tid, float *dest, float *source, size_t nelems,
+                                         const shmemx_quant_config_t &config, uint32_t block_dim, uint64_t ffts,
+                                         aclrtStream stream)
+{
+    k_shmem_allgather_quant<<<block_dim, nullptr, stream>>>(ffts, (int32_t)tid, (uint8_t *)dest, (uint8_t *)source,
+                                                            (uint64_t)nelems, config.format, config.block_size,
+                                                            (uint8_t *)config.work, (uint8_t *)config.error);
+    return 0;
+}
+
+int32_t shmemi_allreduce_quant_on_stream(shmem_team_t tid, float *dest, float *source, size_t nelems,
+                                         const shmemx_quant_config_t &config, uint32_t block_dim, uint64_t ffts,
+                                         aclrtStream stream)
+{
+    k_shmem_allreduce_quant<<<block_dim, nullptr, stream>>>(ffts, (int32_t)tid, (uint8_t *)dest, (uint8_t *)source,
+                                                            (uint64_t)nelems, config.format, config.block_size,
+                                                            (uint8_t *)config.work, (uint8_t *)config.error);
+    return 0;
+}
+
+#define SHMEMI_TYPENAME_OP_REDUCE_LAUNCH_IMPL(NAME, OP)                                                              \
+    int32_t shmemi_##NAME##_##OP##_allreduce_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source,           \
+                                                       size_t nelems, uint32_t block_dim, uint64_t ffts,           \
+                                                       aclrtStream stream)                                         \
+    {                                                                                                              \
+        k_shmem_##NAME##_##OP##_allreduce<<<block_dim, nullptr, stream>>>(ffts, (int32_t)tid, dest, source,        \
+                                                                          (uint64_t)nelems);                       \
+        return 0;                                                                                                  \
+    }                                                                                                              \
+                                                                                                                   \
+    int32_t shmemi_##NAME##_##OP##_reduce_scatter_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source,      \
+                                                            size_t nelems, uint32_t block_dim, uint64_t ffts,      \
+                                                            aclrtStream stream)                                    \
+    {                                                                                                              \
+        k_shmem_##NAME##_##OP##_reduce_scatter<<<block_dim, nullptr, stream>>>(ffts, (int32_t)tid, dest, source,   \
+                                                                               (uint64_t)nelems);                  \
+        return 0;                                                                                                  \
+    }
+
+#define SHMEMI_TYPENAME_REDUCE_LAUNCH_IMPL(NAME, TYPE)      \
+    SHMEMI_TYPENAME_OP_REDUCE_LAUNCH_IMPL(NAME, sum)        \
+    SHMEMI_TYPENAME_OP_REDUCE_LAUNCH_IMPL(NAME, max)        \
+    SHMEMI_TYPENAME_OP_REDUCE_LAUNCH_IMPL(NAME, min)
+
+SHMEM_HOST_REDUCE_TYPE_FUNC(SHMEMI_TYPENAME_REDUCE_LAUNCH_IMPL);
+#undef SHMEMI_TYPENAME_REDUCE_LAUNCH_IMPL
+#undef SHMEMI_TYPENAME_OP_REDUCE_LAUNCH_IMPL
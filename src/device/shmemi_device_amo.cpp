@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "shmemi_device_amo.h"
+#include "kernel_operator.h"
+
+// kernels
+#define SHMEMI_TYPENAME_ATOMIC(NAME, TYPE)                                                              \
+    SHMEM_GLOBAL void shmemi_##NAME##_atomic(GM_ADDR dst, TYPE value, TYPE cond, int op, int pe,        \
+                                             GM_ADDR fetch_addr)                                        \
+    {                                                                                                   \
+        /* An AMO must be issued exactly once, use the first vector core only */                        \
+        if ASCEND_IS_AIC {                                                                              \
+            return;                                                                                     \
+        }                                                                                               \
+        if (AscendC::GetBlockIdx() != 0) {                                                              \
+            return;                                                                                     \
+        }                                                                                               \
+        TYPE old = shmemi_atomic<TYPE>((__gm__ TYPE *)dst, value, cond, op, pe);                        \
+        if (fetch_addr != nullptr) {                                                                    \
+            shmemi_store((__gm__ TYPE *)fetch_addr, old);                                               \
+            dcci_cacheline((__gm__ uint8_t *)fetch_addr);                                               \
+        }                                                                                               \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEMI_TYPENAME_ATOMIC)
+#undef SHMEMI_TYPENAME_ATOMIC
+
+// kernel function calling entrance
+#define SHMEMI_TYPENAME_PREPARE_AMO(NAME, TYPE)                                                                  \
+    int32_t shmemi_prepare_and_post_amo_##NAME(const char *api_name, shmemi_amo_op_t op, uint8_t *dst_ptr,       \
+                                               TYPE value, TYPE cond, int pe, uint8_t *fetch_ptr,                \
+                                               aclrtStream acl_strm)                                             \
+    {                                                                                                            \
+        shmemi_##NAME##_atomic<<<1, 0, acl_strm>>>(dst_ptr, value, cond, (int)op, pe, fetch_ptr);                \
+        return 0;                                                                                                \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEMI_TYPENAME_PREPARE_AMO)
+#undef SHMEMI_TYPENAME_PREPARE_AMO
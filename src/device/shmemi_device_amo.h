@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_AMO_LAUNCH_H
+#define SHMEMI_DEVICE_AMO_LAUNCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <acl/acl.h>
+#include "shmem_api.h"
+#include "host_device/shmem_types.h"
+
+// internal kernels calling, fetch_ptr is a device address receiving the fetched value, may be nullptr
+#define SHMEMI_TYPENAME_PREPARE_AMO(NAME, TYPE)                                                                  \
+    int32_t shmemi_prepare_and_post_amo_##NAME(const char *api_name, shmemi_amo_op_t op, uint8_t *dst_ptr,       \
+                                               TYPE value, TYPE cond, int pe, uint8_t *fetch_ptr,                \
+                                               aclrtStream acl_strm);
+
+SHMEM_AMO_TYPE_FUNC(SHMEMI_TYPENAME_PREPARE_AMO)
+#undef SHMEMI_TYPENAME_PREPARE_AMO
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_DEVICE_COLL_LAUNCH_H
+#define SHMEMI_DEVICE_COLL_LAUNCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <acl/acl.h>
+#include "host/shmem_host_coll.h"
+
+// internal kernels calling, data movement is type agnostic and counted in bytes
+int32_t shmemi_allgather_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source, size_t nbytes,
+                                   uint32_t block_dim, uint64_t ffts, aclrtStream stream);
+int32_t shmemi_broadcast_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source, size_t nbytes, int pe_root,
+                                   uint32_t block_dim, uint64_t ffts, aclrtStream stream);
+int32_t shmemi_alltoall_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source, size_t nbytes,
+                                  uint32_t block_dim, uint64_t ffts, aclrtStream stream);
+// counts and offsets in elements of elem_size bytes
+int32_t shmemi_alltoallv_on_stream(shmem_team_t tid, uint8_t *dest, size_t dest_stride, uint8_t *source,
+                                   uint32_t *send_counts, uint32_t *send_offsets, uint32_t *recv_counts,
+                                   uint64_t *recv_offsets, uint32_t *truncated, size_t elem_size, uint32_t block_dim,
+                                   uint64_t ffts, aclrtStream stream);
+
+// quantized collectives of float elements
+int32_t shmemi_allgather_quant_on_stream(shmem_team_t tid, float *dest, float *source, size_t nelems,
+                                         const shmemx_quant_config_t &config, uint32_t block_dim, uint64_t ffts,
+                                         aclrtStream stream);
+int32_t shmemi_allreduce_quant_on_stream(shmem_team_t tid, float *dest, float *source, size_t nelems,
+                                         const shmemx_quant_config_t &config, uint32_t block_dim, uint64_t ffts,
+                                         aclrtStream stream);
+
+// persistent kernel serving the work queue until a SHMEMI_WORK_STOP descriptor, never completes before it
+int32_t shmemi_work_loop_on_stream(uint8_t *queue, uint32_t block_dim, uint64_t ffts, aclrtStream stream);
+
+// reductions, counted in elements
+#define SHMEMI_TYPENAME_OP_REDUCE_LAUNCH(NAME, OP)                                                                   \
+    int32_t shmemi_##NAME##_##OP##_allreduce_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source,           \
+                                                       size_t nelems, uint32_t block_dim, uint64_t ffts,           \
+                                                       aclrtStream stream);                                        \
+    int32_t shmemi_##NAME##_##OP##_reduce_scatter_on_stream(shmem_team_t tid, uint8_t *dest, uint8_t *source,      \
+                                                            size_t nelems, uint32_t block_dim, uint64_t ffts,      \
+                                                            aclrtStream stream)
+
+#define SHMEMI_TYPENAME_REDUCE_LAUNCH(NAME, TYPE)  \
+    SHMEMI_TYPENAME_OP_REDUCE_LAUNCH(NAME, sum);   \
+    SHMEMI_TYPENAME_OP_REDUCE_LAUNCH(NAME, max);   \
+    SHMEMI_TYPENAME_OP_REDUCE_LAUNCH(NAME, min)
+
+SHMEM_HOST_REDUCE_TYPE_FUNC(SHMEMI_TYPENAME_REDUCE_LAUNCH);
+
+#endif
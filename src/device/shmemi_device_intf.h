@@ -18,4 +18,11 @@ int32_t shmemi_memset(int32_t *array, int32_t len, int32_t val, int32_t count);
 
 int32_t shmemi_barrier_on_stream(shmem_team_t tid, void *stream);
 
+// split-phase barrier, enqueued on the stream only
+int32_t shmemi_barrier_arrive_on_stream(shmem_team_t tid, void *stream);
+int32_t shmemi_barrier_wait_on_stream(shmem_team_t tid, void *stream);
+
+// allgather (color, key) of every team member into the symmetric buf, 2 * n_pes int32, ends with a team barrier
+int32_t shmemi_team_exchange_on_stream(shmem_team_t tid, int32_t *buf, int32_t color, int32_t key, void *stream);
+
 #endif
\ No newline at end of file
@@ -119,5 +119,5 @@ SHMEM_TYPE_FUNC(SHMEMI_TYPENAME_G)
         shmemi_##NAME##_p<<<block_size, 0, acl_strm>>>(dst_ptr, value, pe);                                 \
     }
 
-SHMEM_TYPE_FUNC(SHMEMI_TYPENAME_PREPARE_RMA_P)
+SHMEMI_RMA_P_TYPE_FUNC(SHMEMI_TYPENAME_PREPARE_RMA_P)
 #undef SHMEMI_TYPENAME_PREPARE_RMA_P
@@ -16,11 +16,26 @@
 #include "shmem_api.h"
 #include "host_device/shmem_types.h"
 
+/* Types of the shmem_p launchers, spelled alike on host and device. half and bfloat16 are spelled differently, the
+   host puts them with the uint16 launcher, which moves the same bits. */
+#define SHMEMI_RMA_P_TYPE_FUNC(FUNC) \
+    FUNC(float, float);              \
+    FUNC(double, double);            \
+    FUNC(int8, int8_t);              \
+    FUNC(int16, int16_t);            \
+    FUNC(int32, int32_t);            \
+    FUNC(int64, int64_t);            \
+    FUNC(uint8, uint8_t);            \
+    FUNC(uint16, uint16_t);          \
+    FUNC(uint32, uint32_t);          \
+    FUNC(uint64, uint64_t);          \
+    FUNC(char, char)
+
 #define SHMEMI_TYPENAME_PREPARE_RMA_P(NAME, TYPE)                                                           \
     void shmemi_prepare_and_post_rma_##NAME##_p(const char *api_name, uint8_t *dst_ptr, TYPE value, int pe, \
                                                 aclrtStream acl_strm, size_t block_size);
 
-SHMEM_TYPE_FUNC(SHMEMI_TYPENAME_PREPARE_RMA_P)
+SHMEMI_RMA_P_TYPE_FUNC(SHMEMI_TYPENAME_PREPARE_RMA_P)
 #undef SHMEMI_TYPENAME_PREPARE_RMA_P
 
 // internal kernels calling
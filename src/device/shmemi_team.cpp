@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "acl/acl.h"
+#include "kernel_operator.h"
+
+#include "shmem_api.h"
+
+// kernels
+SHMEM_GLOBAL void k_shmem_team_exchange(int32_t tid, GM_ADDR buf, int32_t color, int32_t key)
+{
+    shmemi_team_t *team = shmemi_get_state()->team_pools[tid];
+    if ASCEND_IS_AIV {
+        if (AscendC::GetBlockIdx() == 0) {
+            // slot mype of every member gets (color, key), remote hosts are reached with RDMA WRITEs
+            auto slot = (__gm__ int32_t *)buf + team->mype * 2;
+            for (int i = 0; i < team->size; i++) {
+                int pe = shmemi_team_global_pe(team, i);
+                shmemi_barrier_signal_peer(slot, pe, color);
+                shmemi_barrier_signal_peer(slot + 1, pe, key);
+            }
+            shmemi_quiet();
+        }
+    }
+    shmemi_barrier<false>(tid);
+}
+
+// interfaces
+int32_t shmemi_team_exchange_on_stream(shmem_team_t tid, int32_t *buf, int32_t color, int32_t key,
+                                       aclrtStream stream)
+{
+    k_shmem_team_exchange<<<1, nullptr, stream>>>((int32_t)tid, (GM_ADDR)buf, color, key);
+    return 0;
+}
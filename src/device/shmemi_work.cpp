@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "acl/acl.h"
+#include "kernel_operator.h"
+
+#include "shmem_api.h"
+#include "shmemi_device_coll.h"
+
+// kernels
+SHMEM_GLOBAL void k_shmem_work_loop(uint64_t ffts, GM_ADDR queue)
+{
+    shmemx_set_ffts_config(ffts);
+    shmemi_work_loop((__gm__ shmemi_work_queue_t *)queue);
+}
+
+// interfaces
+int32_t shmemi_work_loop_on_stream(uint8_t *queue, uint32_t block_dim, uint64_t ffts, aclrtStream stream)
+{
+    k_shmem_work_loop<<<block_dim, nullptr, stream>>>(ffts, queue);
+    return 0;
+}
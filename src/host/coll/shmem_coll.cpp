@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+#include "host/shmem_host_coll.h"
+#include "host/shmem_host_sync.h"
+#include "host/shmem_host_team.h"
+#include "shmemi_device_coll.h"
+#include "host_device/shmem_types.h"
+
+// one core per 256KB moved by the calling PE, small collectives are bound by the barriers and stay on few cores
+constexpr size_t SHMEM_COLL_BYTES_PER_CORE = 256 * 1024;
+constexpr uint32_t SHMEM_COLL_MAX_BLOCK_DIM = 16;
+
+static uint32_t shmemi_coll_block_dim(size_t nbytes)
+{
+    size_t block_dim = (nbytes + SHMEM_COLL_BYTES_PER_CORE - 1) / SHMEM_COLL_BYTES_PER_CORE;
+    if (block_dim == 0) {
+        return 1;
+    }
+    return block_dim > SHMEM_COLL_MAX_BLOCK_DIM ? SHMEM_COLL_MAX_BLOCK_DIM : (uint32_t)block_dim;
+}
+
+int32_t shmemi_coll_ll_init()
+{
+    g_state.coll_ll_pool = (uint64_t)shmem_malloc(SHMEM_COLL_LL_POOL_SIZE);
+    if (g_state.coll_ll_pool == 0) {
+        SHM_LOG_ERROR("malloc coll ll pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    // only flags and sequences need to start at 0, the data slots are read once flagged
+    auto ret = aclrtMemset((void *)g_state.coll_ll_pool, SHMEM_COLL_LL_DATA_OFFSET, 0, SHMEM_COLL_LL_DATA_OFFSET);
+    if (ret != 0) {
+        shmemi_coll_ll_finalize();
+        SHM_LOG_ERROR("memset coll ll pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_coll_ll_finalize()
+{
+    if (g_state.coll_ll_pool != 0) {
+        shmem_free(reinterpret_cast<void *>(g_state.coll_ll_pool));
+        g_state.coll_ll_pool = 0;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_coll_counts_init()
+{
+    uint64_t pool_size = SHMEM_COLL_COUNTS_POOL_SIZE(g_state.npes);
+    g_state.coll_counts_pool = (uint64_t)shmem_malloc(pool_size);
+    if (g_state.coll_counts_pool == 0) {
+        SHM_LOG_ERROR("malloc coll counts pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    // the flags must start at 0, the rows are read once flagged
+    uint64_t flags_size = SHMEM_COLL_COUNTS_ROW_OFFSET(g_state.npes);
+    auto ret = aclrtMemset((void *)g_state.coll_counts_pool, flags_size, 0, flags_size);
+    if (ret != 0) {
+        shmemi_coll_counts_finalize();
+        SHM_LOG_ERROR("memset coll counts pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_coll_counts_finalize()
+{
+    if (g_state.coll_counts_pool != 0) {
+        shmem_free(reinterpret_cast<void *>(g_state.coll_counts_pool));
+        g_state.coll_counts_pool = 0;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_coll_pipe_init()
+{
+    // every call resets the flags it waits on before its opening barrier, nothing to clear here
+    g_state.coll_pipe_pool = (uint64_t)shmem_malloc(SHMEM_COLL_PIPE_POOL_SIZE);
+    if (g_state.coll_pipe_pool == 0) {
+        SHM_LOG_ERROR("malloc coll pipe pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_coll_pipe_finalize()
+{
+    if (g_state.coll_pipe_pool != 0) {
+        shmem_free(reinterpret_cast<void *>(g_state.coll_pipe_pool));
+        g_state.coll_pipe_pool = 0;
+    }
+    return SHMEM_SUCCESS;
+}
+
+static bool shmemi_coll_in_heap(const void *ptr, size_t nbytes)
+{
+    uint64_t lower_bound = (uint64_t)g_state.heap_base;
+    uint64_t upper_bound = lower_bound + g_state.heap_size;
+    return (uint64_t)ptr >= lower_bound && (uint64_t)ptr <= upper_bound && nbytes <= upper_bound - (uint64_t)ptr;
+}
+
+// team size on success, a negative error code otherwise
+static int shmemi_coll_check(const char *api_name, shmem_team_t team, const void *dest, size_t dest_bytes,
+                             const void *source, size_t source_bytes)
+{
+    int n_pes = shmem_team_n_pes(team);
+    if (n_pes < 0) {
+        SHM_LOG_ERROR(api_name << " failed. input team is invalid!, team: " << team);
+        return SHMEM_INVALID_PARAM;
+    }
+    if (!shmemi_coll_in_heap(dest, dest_bytes) || !shmemi_coll_in_heap(source, source_bytes)) {
+        SHM_LOG_ERROR(api_name << " failed. PE: " << g_state.mype << " got illegal symmetric address");
+        return SHMEM_INVALID_PARAM;
+    }
+    return n_pes;
+}
+
+#define SHMEM_TYPENAME_ALLGATHER_ON_STREAM(NAME, TYPE)                                                             \
+    int shmem_##NAME##_allgather_on_stream(shmem_team_t team, TYPE *dest, TYPE *source, size_t nelems,             \
+                                           aclrtStream stream)                                                     \
+    {                                                                                                              \
+        size_t nbytes = nelems * sizeof(TYPE);                                                                     \
+        int n_pes = shmemi_coll_check(__func__, team, dest, 0, source, nbytes);                                    \
+        if (n_pes < 0) {                                                                                           \
+            return n_pes;                                                                                          \
+        }                                                                                                          \
+        if (!shmemi_coll_in_heap(dest, nbytes * n_pes)) {                                                          \
+            SHM_LOG_ERROR(__func__ << " failed. dest exceeds the symmetric heap");                                 \
+            return SHMEM_INVALID_PARAM;                                                                            \
+        }                                                                                                          \
+        SHMEM_CHECK_RET(shmemi_allgather_on_stream(team, (uint8_t *)dest, (uint8_t *)source, nbytes,               \
+                                                   shmemi_coll_block_dim(nbytes * n_pes),                          \
+                                                   shmemx_get_ffts_config(), stream));                             \
+        return SHMEM_SUCCESS;                                                                                      \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLGATHER_ON_STREAM)
+#undef SHMEM_TYPENAME_ALLGATHER_ON_STREAM
+
+#define SHMEM_TYPENAME_BROADCAST_ON_STREAM(NAME, TYPE)                                                             \
+    int shmem_##NAME##_broadcast_on_stream(shmem_team_t team, TYPE *dest, TYPE *source, size_t nelems,             \
+                                           int pe_root, aclrtStream stream)                                        \
+    {                                                                                                              \
+        size_t nbytes = nelems * sizeof(TYPE);                                                                     \
+        int n_pes = shmemi_coll_check(__func__, team, dest, nbytes, source, nbytes);                               \
+        if (n_pes < 0) {                                                                                           \
+            return n_pes;                                                                                          \
+        }                                                                                                          \
+        if (pe_root < 0 || pe_root >= n_pes) {                                                                     \
+            SHM_LOG_ERROR(__func__ << " failed. PE: " << g_state.mype << " got illegal root " << pe_root);         \
+            return SHMEM_INVALID_PARAM;                                                                            \
+        }                                                                                                          \
+        SHMEM_CHECK_RET(shmemi_broadcast_on_stream(team, (uint8_t *)dest, (uint8_t *)source, nbytes, pe_root,      \
+                                                   shmemi_coll_block_dim(nbytes), shmemx_get_ffts_config(),        \
+                                                   stream));                                                       \
+        return SHMEM_SUCCESS;                                                                                      \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_BROADCAST_ON_STREAM)
+#undef SHMEM_TYPENAME_BROADCAST_ON_STREAM
+
+#define SHMEM_TYPENAME_ALLTOALL_ON_STREAM(NAME, TYPE)                                                              \
+    int shmem_##NAME##_alltoall_on_stream(shmem_team_t team, TYPE *dest, TYPE *source, size_t nelems,              \
+                                          aclrtStream stream)                                                      \
+    {                                                                                                              \
+        size_t nbytes = nelems * sizeof(TYPE);                                                                     \
+        int n_pes = shmemi_coll_check(__func__, team, dest, 0, source, 0);                                         \
+        if (n_pes < 0) {                                                                                           \
+            return n_pes;                                                                                          \
+        }                                                                                                          \
+        if (!shmemi_coll_in_heap(dest, nbytes * n_pes) || !shmemi_coll_in_heap(source, nbytes * n_pes)) {          \
+            SHM_LOG_ERROR(__func__ << " failed. buffers exceed the symmetric heap");                               \
+            return SHMEM_INVALID_PARAM;                                                                            \
+        }                                                                                                          \
+        SHMEM_CHECK_RET(shmemi_alltoall_on_stream(team, (uint8_t *)dest, (uint8_t *)source, nbytes,                \
+                                                  shmemi_coll_block_dim(nbytes * n_pes),                           \
+                                                  shmemx_get_ffts_config(), stream));                              \
+        return SHMEM_SUCCESS;                                                                                      \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLTOALL_ON_STREAM)
+#undef SHMEM_TYPENAME_ALLTOALL_ON_STREAM
+
+// block sizes are only known on the device, every call gets all cores
+#define SHMEM_TYPENAME_ALLTOALLV_ON_STREAM(NAME, TYPE)                                                             \
+    int shmemx_##NAME##_alltoallv_on_stream(shmem_team_t team, TYPE *dest, size_t dest_stride, TYPE *source,       \
+                                            uint32_t *send_counts, uint32_t *send_offsets, uint32_t *recv_counts,  \
+                                            uint64_t *recv_offsets, uint32_t *truncated, aclrtStream stream)       \
+    {                                                                                                              \
+        int n_pes = shmemi_coll_check(__func__, team, dest, 0, source, 0);                                         \
+        if (n_pes < 0) {                                                                                           \
+            return n_pes;                                                                                          \
+        }                                                                                                          \
+        if (send_counts == nullptr) {                                                                              \
+            SHM_LOG_ERROR(__func__ << " failed. send_counts is null");                                             \
+            return SHMEM_INVALID_PARAM;                                                                            \
+        }                                                                                                          \
+        SHMEM_CHECK_RET(shmemi_alltoallv_on_stream(team, (uint8_t *)dest, dest_stride, (uint8_t *)source,          \
+                                                   send_counts, send_offsets, recv_counts, recv_offsets,           \
+                                                   truncated, sizeof(TYPE), SHMEM_COLL_MAX_BLOCK_DIM,              \
+                                                   shmemx_get_ffts_config(), stream));                             \
+        return SHMEM_SUCCESS;                                                                                      \
+    }
+
+SHMEM_TYPE_FUNC(SHMEM_TYPENAME_ALLTOALLV_ON_STREAM)
+#undef SHMEM_TYPENAME_ALLTOALLV_ON_STREAM
+
+#define SHMEM_TYPENAME_OP_REDUCE_ON_STREAM(NAME, TYPE, OP)                                                         \
+    int shmem_##NAME##_##OP##_allreduce_on_stream(shmem_team_t team, TYPE *dest, TYPE *source, size_t nelems,      \
+                                                  aclrtStream stream)                                              \
+    {                                                                                                              \
+        size_t nbytes = nelems * sizeof(TYPE);                                                                     \
+        int n_pes = shmemi_coll_check(__func__, team, dest, nbytes, source, nbytes);                               \
+        if (n_pes < 0) {                                                                                           \
+            return n_pes;                                                                                          \
+        }                                                                                                          \
+        SHMEM_CHECK_RET(shmemi_##NAME##_##OP##_allreduce_on_stream(team, (uint8_t *)dest, (uint8_t *)source,      \
+                                                                   nelems, shmemi_coll_block_dim(nbytes),          \
+                                                                   shmemx_get_ffts_config(), stream));             \
+        return SHMEM_SUCCESS;                                                                                      \
+    }                                                                                                              \
+                                                                                                                   \
+    int shmem_##NAME##_##OP##_reduce_scatter_on_stream(shmem_team_t team, TYPE *dest, TYPE *source,                \
+                                                       size_t nelems, aclrtStream stream)                          \
+    {                                                                                                              \
+        size_t nbytes = nelems * sizeof(TYPE);                                                                     \
+        int n_pes = shmemi_coll_check(__func__, team, dest, nbytes, source, 0);                                    \
+        if (n_pes < 0) {                                                                                           \
+            return n_pes;                                                                                          \
+        }                                                                                                          \
+        if (!shmemi_coll_in_heap(source, nbytes * n_pes)) {                                                        \
+            SHM_LOG_ERROR(__func__ << " failed. source exceeds the symmetric heap");                               \
+            return SHMEM_INVALID_PARAM;                                                                            \
+        }                                                                                                          \
+        SHMEM_CHECK_RET(shmemi_##NAME##_##OP##_reduce_scatter_on_stream(team, (uint8_t *)dest, (uint8_t *)source, \
+                                                                        nelems, shmemi_coll_block_dim(nbytes),     \
+                                                                        shmemx_get_ffts_config(), stream));        \
+        return SHMEM_SUCCESS;                                                                                      \
+    }
+
+#define SHMEM_TYPENAME_REDUCE_ON_STREAM(NAME, TYPE)    \
+    SHMEM_TYPENAME_OP_REDUCE_ON_STREAM(NAME, TYPE, sum) \
+    SHMEM_TYPENAME_OP_REDUCE_ON_STREAM(NAME, TYPE, max) \
+    SHMEM_TYPENAME_OP_REDUCE_ON_STREAM(NAME, TYPE, min)
+
+SHMEM_HOST_REDUCE_TYPE_FUNC(SHMEM_TYPENAME_REDUCE_ON_STREAM)
+#undef SHMEM_TYPENAME_REDUCE_ON_STREAM
+#undef SHMEM_TYPENAME_OP_REDUCE_ON_STREAM
+
+size_t shmemx_quant_work_size(size_t nelems, const shmemx_quant_config_t *config)
+{
+    if (config == nullptr || config->format < 0 || config->format >= SHMEMX_QUANT_FORMAT_NUM) {
+        return 0;
+    }
+    uint32_t block = config->block_size;
+    if (block < SHMEM_QUANT_MIN_BLOCK || block > SHMEM_QUANT_MAX_BLOCK || (block & (block - 1)) != 0) {
+        return 0;
+    }
+    if (config->format == SHMEMX_QUANT_BF16) {
+        return SHMEM_QUANT_DATA_SIZE(nelems, sizeof(uint16_t));
+    }
+    return SHMEM_QUANT_DATA_SIZE(nelems, sizeof(int8_t)) + SHMEM_QUANT_SCALE_SIZE(nelems, block);
+}
+
+// team size on success, a negative error code otherwise, source and error are local and only checked for null.
+// run is config with the scratch of the team as work buffer when config has none.
+static int shmemi_quant_check(const char *api_name, shmem_team_t team, const void *dest, size_t dest_bytes,
+                              const void *source, size_t nelems, const shmemx_quant_config_t *config,
+                              shmemx_quant_config_t &run)
+{
+    int n_pes = shmem_team_n_pes(team);
+    if (n_pes < 0) {
+        SHM_LOG_ERROR(api_name << " failed. input team is invalid!, team: " << team);
+        return SHMEM_INVALID_PARAM;
+    }
+    if (!shmemi_coll_in_heap(dest, dest_bytes)) {
+        SHM_LOG_ERROR(api_name << " failed. PE: " << g_state.mype << " got illegal symmetric address");
+        return SHMEM_INVALID_PARAM;
+    }
+    size_t work_size = shmemx_quant_work_size(nelems, config);
+    if (work_size == 0) {
+        SHM_LOG_ERROR(api_name << " failed. invalid quantization config");
+        return SHMEM_INVALID_PARAM;
+    }
+    run = *config;
+    if (run.work == 0) {
+        void *scratch = nullptr;
+        if (shmemx_team_get_scratch(team, work_size, &scratch) != SHMEM_SUCCESS) {
+            SHM_LOG_ERROR(api_name << " failed. work needs " << work_size << " bytes of the team scratch");
+            return SHMEM_INVALID_PARAM;
+        }
+        run.work = reinterpret_cast<uint64_t>(scratch);
+    }
+    if (!shmemi_coll_in_heap((void *)run.work, work_size)) {
+        SHM_LOG_ERROR(api_name << " failed. work needs " << work_size << " bytes of the symmetric heap");
+        return SHMEM_INVALID_PARAM;
+    }
+    if (source == nullptr) {
+        SHM_LOG_ERROR(api_name << " failed. source is null");
+        return SHMEM_INVALID_PARAM;
+    }
+    return n_pes;
+}
+
+int shmemx_float_allgather_quant_on_stream(shmem_team_t team, float *dest, float *source, size_t nelems,
+                                           const shmemx_quant_config_t *config, aclrtStream stream)
+{
+    shmemx_quant_config_t run;
+    int n_pes = shmemi_quant_check(__func__, team, dest, 0, source, nelems, config, run);
+    if (n_pes < 0) {
+        return n_pes;
+    }
+    if (!shmemi_coll_in_heap(dest, nelems * sizeof(float) * n_pes)) {
+        SHM_LOG_ERROR(__func__ << " failed. dest exceeds the symmetric heap");
+        return SHMEM_INVALID_PARAM;
+    }
+    SHMEM_CHECK_RET(shmemi_allgather_quant_on_stream(team, dest, source, nelems, run,
+                                                     shmemi_coll_block_dim(nelems * sizeof(float) * n_pes),
+                                                     shmemx_get_ffts_config(), stream));
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_float_sum_allreduce_quant_on_stream(shmem_team_t team, float *dest, float *source, size_t nelems,
+                                               const shmemx_quant_config_t *config, aclrtStream stream)
+{
+    shmemx_quant_config_t run;
+    int n_pes = shmemi_quant_check(__func__, team, dest, nelems * sizeof(float), source, nelems, config, run);
+    if (n_pes < 0) {
+        return n_pes;
+    }
+    SHMEM_CHECK_RET(shmemi_allreduce_quant_on_stream(team, dest, source, nelems, run,
+                                                     shmemi_coll_block_dim(nelems * sizeof(float)),
+                                                     shmemx_get_ffts_config(), stream));
+    return SHMEM_SUCCESS;
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <cstddef>
+#include <iostream>
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+#include "host/shmem_host_amo.h"
+#include "host/shmem_host_team.h"
+#include "host/shmemx_host_work.h"
+#include "shmemi_device_coll.h"
+#include "host_device/shmem_types.h"
+
+// host view of the running work queue, queue is null while the persistent kernel is stopped
+static struct {
+    uint8_t *queue;
+    uint64_t depth;
+    int flags;
+    uint64_t tail;          // next ticket when the host is the only producer
+    uint64_t head;          // last head read back from the device
+    aclrtStream stream;
+} g_work = {nullptr, 0, 0, 0, 0, nullptr};
+
+static const size_t g_work_dtype_size[SHMEMX_WORK_DTYPE_NUM] = {
+    sizeof(shmem_half_t), sizeof(shmem_bfloat16_t), sizeof(float), sizeof(int16_t), sizeof(int32_t)
+};
+
+static bool shmemi_work_in_heap(uint64_t ptr, uint64_t nbytes)
+{
+    uint64_t lower_bound = (uint64_t)g_state.heap_base;
+    uint64_t upper_bound = lower_bound + g_state.heap_size;
+    return ptr >= lower_bound && ptr <= upper_bound && nbytes <= upper_bound - ptr;
+}
+
+static uint8_t *shmemi_work_slot(uint64_t ticket)
+{
+    return g_work.queue + SHMEM_WORK_QUEUE_HEADER_SIZE + (ticket & (g_work.depth - 1)) * SHMEM_WORK_SLOT_SIZE;
+}
+
+static int32_t shmemi_work_read_head()
+{
+    uint8_t *head = g_work.queue + offsetof(shmemi_work_queue_t, head);
+    auto ret = aclrtMemcpy(&g_work.head, sizeof(uint64_t), head, sizeof(uint64_t), ACL_MEMCPY_DEVICE_TO_HOST);
+    if (ret != 0) {
+        SHM_LOG_ERROR("read work queue head failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+static bool shmemi_work_check_rma(const shmemx_work_desc_t *desc)
+{
+    if (desc->pe < 0 || desc->pe >= g_state.npes) {
+        SHM_LOG_ERROR("work descriptor got illegal PE " << desc->pe);
+        return false;
+    }
+    if (desc->op == SHMEMX_WORK_SIGNAL) {
+        return true;
+    }
+    uint64_t remote = desc->op == SHMEMX_WORK_GET ? desc->source : desc->dest;
+    if (!shmemi_work_in_heap(remote, desc->size)) {
+        SHM_LOG_ERROR("work descriptor got illegal symmetric address");
+        return false;
+    }
+    return true;
+}
+
+static bool shmemi_work_check_coll(const shmemx_work_desc_t *desc)
+{
+    int n_pes = shmem_team_n_pes(desc->team);
+    if (n_pes <= 0) {
+        SHM_LOG_ERROR("work descriptor got invalid team " << desc->team);
+        return false;
+    }
+    if (desc->op == SHMEMX_WORK_BARRIER) {
+        return true;
+    }
+    uint64_t source_bytes = desc->size;
+    uint64_t dest_bytes = desc->size;
+    switch (desc->op) {
+        case SHMEMX_WORK_ALLGATHER:
+            dest_bytes *= n_pes;
+            break;
+        case SHMEMX_WORK_BROADCAST:
+            if (desc->pe < 0 || desc->pe >= n_pes) {
+                SHM_LOG_ERROR("work descriptor got illegal root " << desc->pe);
+                return false;
+            }
+            break;
+        case SHMEMX_WORK_ALLTOALL:
+            source_bytes *= n_pes;
+            dest_bytes *= n_pes;
+            break;
+        default:
+            if (desc->dtype < 0 || desc->dtype >= SHMEMX_WORK_DTYPE_NUM || desc->reduce_op < SHMEMI_REDUCE_SUM ||
+                desc->reduce_op > SHMEMI_REDUCE_MIN) {
+                SHM_LOG_ERROR("work descriptor got illegal dtype " << desc->dtype << " or reduce op "
+                              << desc->reduce_op);
+                return false;
+            }
+            source_bytes *= g_work_dtype_size[desc->dtype];
+            dest_bytes *= g_work_dtype_size[desc->dtype];
+            if (desc->op == SHMEMX_WORK_REDUCE_SCATTER) {
+                source_bytes *= n_pes;
+            }
+            break;
+    }
+    if (!shmemi_work_in_heap(desc->dest, dest_bytes) || !shmemi_work_in_heap(desc->source, source_bytes)) {
+        SHM_LOG_ERROR("work descriptor got illegal symmetric address");
+        return false;
+    }
+    return true;
+}
+
+static bool shmemi_work_check(const shmemx_work_desc_t *desc)
+{
+    if (desc->op < 0 || desc->op >= SHMEMX_WORK_OP_NUM) {
+        SHM_LOG_ERROR("work descriptor got illegal op " << desc->op);
+        return false;
+    }
+    if ((desc->op == SHMEMX_WORK_PUT_SIGNAL || desc->op == SHMEMX_WORK_SIGNAL) &&
+        ((desc->sig_op != SHMEM_SIGNAL_SET && desc->sig_op != SHMEM_SIGNAL_ADD) ||
+         !shmemi_work_in_heap(desc->sig_addr, sizeof(int32_t)))) {
+        SHM_LOG_ERROR("work descriptor got illegal signal");
+        return false;
+    }
+    switch (desc->op) {
+        case SHMEMX_WORK_NOP:
+            return true;
+        case SHMEMX_WORK_PUT:
+        case SHMEMX_WORK_GET:
+        case SHMEMX_WORK_PUT_SIGNAL:
+        case SHMEMX_WORK_SIGNAL:
+            return shmemi_work_check_rma(desc);
+        default:
+            return shmemi_work_check_coll(desc);
+    }
+}
+
+// writes the descriptor to the next slot, waiting for the slot to be free
+static int32_t shmemi_work_post(const shmemx_work_desc_t *desc, uint64_t *ticket)
+{
+    uint64_t t;
+    if (g_work.flags & SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS) {
+        uint64_t *tail = (uint64_t *)(g_work.queue + offsetof(shmemi_work_queue_t, tail));
+        t = shmem_uint64_atomic_fetch_add(tail, 1, g_state.mype);
+    } else {
+        t = g_work.tail++;
+    }
+    while (t >= g_work.head + g_work.depth) {
+        SHMEM_CHECK_RET(shmemi_work_read_head());
+    }
+
+    uint8_t *slot = shmemi_work_slot(t);
+    auto ret = aclrtMemcpy(slot, sizeof(shmemx_work_desc_t), desc, sizeof(shmemx_work_desc_t),
+                           ACL_MEMCPY_HOST_TO_DEVICE);
+    if (ret != 0) {
+        SHM_LOG_ERROR("write work descriptor failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    // the sequence publishes the descriptor, so it is written last
+    uint64_t seq = t + 1;
+    ret = aclrtMemcpy(slot + SHMEM_WORK_SLOT_SEQ_OFFSET, sizeof(uint64_t), &seq, sizeof(uint64_t),
+                      ACL_MEMCPY_HOST_TO_DEVICE);
+    if (ret != 0) {
+        SHM_LOG_ERROR("publish work descriptor failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    if (ticket != nullptr) {
+        *ticket = t;
+    }
+    return SHMEM_SUCCESS;
+}
+
+static void shmemi_work_release()
+{
+    if (g_work.stream != nullptr) {
+        aclrtDestroyStream(g_work.stream);
+        g_work.stream = nullptr;
+    }
+    if (g_work.queue != nullptr) {
+        g_state.work_queue = 0;
+        update_device_state();
+        shmem_free(g_work.queue);
+        g_work.queue = nullptr;
+    }
+}
+
+int shmemx_work_queue_start(uint32_t depth, uint32_t block_dim, int flags)
+{
+    if (g_work.queue != nullptr) {
+        SHM_LOG_ERROR("work queue is already running");
+        return SHMEM_INVALID_PARAM;
+    }
+    depth = depth == 0 ? SHMEM_WORK_QUEUE_DEFAULT_DEPTH : depth;
+    if (depth > SHMEM_WORK_QUEUE_MAX_DEPTH || (depth & (depth - 1)) != 0) {
+        SHM_LOG_ERROR("work queue depth " << depth << " is not a power of two up to " << SHMEM_WORK_QUEUE_MAX_DEPTH);
+        return SHMEM_INVALID_PARAM;
+    }
+    if (block_dim == 0 || block_dim > SHMEM_MAX_AIV_PER_NPU / 2) {
+        SHM_LOG_ERROR("work queue block_dim " << block_dim << " is out of range");
+        return SHMEM_INVALID_PARAM;
+    }
+    if ((flags & ~SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS) != 0) {
+        SHM_LOG_ERROR("work queue got illegal flags " << flags);
+        return SHMEM_INVALID_PARAM;
+    }
+
+    size_t size = SHMEM_WORK_QUEUE_SIZE(depth);
+    g_work.queue = (uint8_t *)shmem_malloc(size);
+    if (g_work.queue == nullptr) {
+        SHM_LOG_ERROR("malloc work queue failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    g_work.depth = depth;
+    g_work.flags = flags;
+    g_work.tail = 0;
+    g_work.head = 0;
+
+    shmemi_work_queue_t header = {};
+    header.depth = depth;
+    header.flags = (uint64_t)flags;
+    auto ret = aclrtMemset(g_work.queue, size, 0, size);
+    if (ret == 0) {
+        ret = aclrtMemcpy(g_work.queue, sizeof(header), &header, sizeof(header), ACL_MEMCPY_HOST_TO_DEVICE);
+    }
+    if (ret == 0) {
+        ret = aclrtCreateStream(&g_work.stream);
+    }
+    if (ret != 0) {
+        shmemi_work_release();
+        SHM_LOG_ERROR("set up work queue failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+
+    g_state.work_queue = (uint64_t)g_work.queue;
+    ret = update_device_state();
+    if (ret == 0) {
+        ret = shmemi_work_loop_on_stream(g_work.queue, block_dim, shmemx_get_ffts_config(), g_work.stream);
+    }
+    if (ret != 0) {
+        shmemi_work_release();
+        SHM_LOG_ERROR("launch work queue kernel failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_work_queue_stop(void)
+{
+    if (g_work.queue == nullptr) {
+        SHM_LOG_ERROR("work queue is not running");
+        return SHMEM_INVALID_PARAM;
+    }
+    shmemx_work_desc_t stop = {};
+    stop.op = SHMEMI_WORK_STOP;
+    SHMEM_CHECK_RET(shmemi_work_post(&stop, nullptr));
+    auto ret = aclrtSynchronizeStream(g_work.stream);
+    shmemi_work_release();
+    if (ret != 0) {
+        SHM_LOG_ERROR("work queue kernel failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_work_submit(const shmemx_work_desc_t *desc, uint64_t *ticket)
+{
+    if (g_work.queue == nullptr) {
+        SHM_LOG_ERROR("work queue is not running");
+        return SHMEM_INVALID_PARAM;
+    }
+    SHM_ASSERT_RETURN(desc != nullptr, SHMEM_INVALID_PARAM);
+    if (!shmemi_work_check(desc)) {
+        return SHMEM_INVALID_PARAM;
+    }
+    return shmemi_work_post(desc, ticket);
+}
+
+int shmemx_work_test(uint64_t ticket, int *done)
+{
+    if (g_work.queue == nullptr) {
+        SHM_LOG_ERROR("work queue is not running");
+        return SHMEM_INVALID_PARAM;
+    }
+    SHM_ASSERT_RETURN(done != nullptr, SHMEM_INVALID_PARAM);
+    if (ticket >= g_work.head) {
+        SHMEM_CHECK_RET(shmemi_work_read_head());
+    }
+    *done = ticket < g_work.head ? 1 : 0;
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_work_wait(uint64_t ticket)
+{
+    if (g_work.queue == nullptr) {
+        SHM_LOG_ERROR("work queue is not running");
+        return SHMEM_INVALID_PARAM;
+    }
+    while (ticket >= g_work.head) {
+        SHMEM_CHECK_RET(shmemi_work_read_head());
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_work_queue_finalize()
+{
+    if (g_work.queue != nullptr) {
+        return shmemx_work_queue_stop();
+    }
+    return SHMEM_SUCCESS;
+}
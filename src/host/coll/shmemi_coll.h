@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef SHMEMI_COLL_H
+#define SHMEMI_COLL_H
+
+#include "stdint.h"
+#include "internal/host_device/shmemi_types.h"
+
+// loads the built-in tuning table, then the rows of SHMEM_COLL_TUNE_FILE when set
+int32_t shmemi_coll_tune_init();
+
+void shmemi_coll_tune_finalize();
+
+// fills team->coll_tune from the tuning table, the hierarchy of the team must be built
+void shmemi_coll_tune_team(shmemi_team_t *team);
+
+bool shmemi_coll_algo_supported(const shmemi_team_t *team, int op, int algo);
+
+// adds a row for teams of the size and the transport mix of team, replacing a row with the same key
+int32_t shmemi_coll_tune_add(const shmemi_team_t *team, int op, uint64_t max_bytes, int algo);
+
+// allocates the flags and data slots of the low-latency allreduce
+int32_t shmemi_coll_ll_init();
+
+int32_t shmemi_coll_ll_finalize();
+
+// allocates the count matrix and the flags of alltoallv
+int32_t shmemi_coll_counts_init();
+
+int32_t shmemi_coll_counts_finalize();
+
+// allocates the flags and signal words of the pipelined ring allreduce
+int32_t shmemi_coll_pipe_init();
+
+int32_t shmemi_coll_pipe_finalize();
+
+// stops the persistent work kernel if it still runs
+int32_t shmemi_work_queue_finalize();
+
+#endif  // SHMEMI_COLL_H
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "shmemi_host_common.h"
+#include "host_device/shmem_types.h"
+
+static_assert(SHMEM_COLL_OP_NUM == SHMEMX_COLL_OP_NUM, "team descriptors hold one tuning per collective");
+
+/*
+    The tuning table maps (collective, team size, transport mix, bytes per PE) to an algorithm. A row applies to
+    teams of up to max_pes members, teams take the rows of the smallest max_pes covering them, and the algorithm of
+    a row applies up to max_bytes. The transport mix is mte for teams within one host and mix for teams spanning
+    hosts. Teams copy their rows into their descriptor at creation, kernels look them up from there.
+
+    SHMEM_COLL_TUNE_FILE names a file of rows "op max_pes transport max_bytes algo", # starts a comment, and
+    max_bytes may be inf. Its rows replace the built-in rows with the same (op, max_pes, transport, max_bytes).
+    shmemx_coll_tune_save writes the table in the same format.
+*/
+
+enum coll_transport_t {
+    COLL_TRANSPORT_MTE = 0,
+    COLL_TRANSPORT_MIX,
+    COLL_TRANSPORT_NUM
+};
+
+struct coll_tune_row {
+    int op;
+    int max_pes;
+    int transport;
+    uint64_t max_bytes;
+    int algo;
+};
+
+constexpr uint64_t COLL_TUNE_INF = UINT64_MAX;
+
+static const char *g_coll_op_names[SHMEMX_COLL_OP_NUM] = {
+    "allgather", "broadcast", "alltoall", "reduce_scatter", "allreduce"
+};
+static const char *g_coll_algo_names[SHMEMX_COLL_ALGO_NUM] = {
+    "auto", "one_shot", "two_shot", "ring", "recursive_doubling", "hier", "ll_one_shot", "ll_two_shot",
+    "pipe_ring"
+};
+static const char *g_coll_transport_names[COLL_TRANSPORT_NUM] = {"mte", "mix"};
+
+// Within a host every peer is one MTE read away and one-shot wins, except for large allreduce where every member
+// reading all of the data costs more than the second pass of two-shot. Small allreduce is bound by its two team
+// barriers, the low-latency variants replace them with flags set along the data. Across hosts the RoCE reads
+// dominate: few large steps win for small messages, ring and hierarchical schemes keep each link busy once for
+// large ones, and the pipelined ring keeps it busy without a barrier between the steps.
+static const coll_tune_row g_coll_tune_defaults[] = {
+    {SHMEMX_COLL_ALLGATHER, SHMEM_MAX_RANKS, COLL_TRANSPORT_MTE, COLL_TUNE_INF, SHMEMX_COLL_ONE_SHOT},
+    {SHMEMX_COLL_BROADCAST, SHMEM_MAX_RANKS, COLL_TRANSPORT_MTE, COLL_TUNE_INF, SHMEMX_COLL_ONE_SHOT},
+    {SHMEMX_COLL_ALLTOALL, SHMEM_MAX_RANKS, COLL_TRANSPORT_MTE, COLL_TUNE_INF, SHMEMX_COLL_ONE_SHOT},
+    {SHMEMX_COLL_REDUCE_SCATTER, SHMEM_MAX_RANKS, COLL_TRANSPORT_MTE, COLL_TUNE_INF, SHMEMX_COLL_ONE_SHOT},
+    {SHMEMX_COLL_ALLREDUCE, SHMEM_MAX_RANKS, COLL_TRANSPORT_MTE, 32 * 1024, SHMEMX_COLL_LL_ONE_SHOT},
+    {SHMEMX_COLL_ALLREDUCE, SHMEM_MAX_RANKS, COLL_TRANSPORT_MTE, 256 * 1024, SHMEMX_COLL_LL_TWO_SHOT},
+    {SHMEMX_COLL_ALLREDUCE, SHMEM_MAX_RANKS, COLL_TRANSPORT_MTE, COLL_TUNE_INF, SHMEMX_COLL_TWO_SHOT},
+    {SHMEMX_COLL_ALLGATHER, SHMEM_MAX_RANKS, COLL_TRANSPORT_MIX, 1024 * 1024, SHMEMX_COLL_HIER},
+    {SHMEMX_COLL_ALLGATHER, SHMEM_MAX_RANKS, COLL_TRANSPORT_MIX, COLL_TUNE_INF, SHMEMX_COLL_RING},
+    {SHMEMX_COLL_BROADCAST, SHMEM_MAX_RANKS, COLL_TRANSPORT_MIX, 64 * 1024, SHMEMX_COLL_RECURSIVE_DOUBLING},
+    {SHMEMX_COLL_BROADCAST, SHMEM_MAX_RANKS, COLL_TRANSPORT_MIX, COLL_TUNE_INF, SHMEMX_COLL_HIER},
+    {SHMEMX_COLL_ALLTOALL, SHMEM_MAX_RANKS, COLL_TRANSPORT_MIX, COLL_TUNE_INF, SHMEMX_COLL_ONE_SHOT},
+    {SHMEMX_COLL_REDUCE_SCATTER, SHMEM_MAX_RANKS, COLL_TRANSPORT_MIX, COLL_TUNE_INF, SHMEMX_COLL_ONE_SHOT},
+    {SHMEMX_COLL_ALLREDUCE, SHMEM_MAX_RANKS, COLL_TRANSPORT_MIX, 32 * 1024, SHMEMX_COLL_RECURSIVE_DOUBLING},
+    {SHMEMX_COLL_ALLREDUCE, SHMEM_MAX_RANKS, COLL_TRANSPORT_MIX, COLL_TUNE_INF, SHMEMX_COLL_PIPE_RING},
+};
+
+static std::vector<coll_tune_row> g_coll_tune_rows;
+
+inline int coll_team_transport(const shmemi_team_t *team)
+{
+    return team->host_num > 1 ? COLL_TRANSPORT_MIX : COLL_TRANSPORT_MTE;
+}
+
+inline int coll_default_algo(int op)
+{
+    return op == SHMEMX_COLL_ALLREDUCE ? SHMEMX_COLL_TWO_SHOT : SHMEMX_COLL_ONE_SHOT;
+}
+
+inline int coll_name_index(const char *const *names, int num, const std::string &name)
+{
+    for (int i = 0; i < num; i++) {
+        if (name == names[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void coll_tune_put(const coll_tune_row &row)
+{
+    for (auto &cur : g_coll_tune_rows) {
+        if (cur.op == row.op && cur.max_pes == row.max_pes && cur.transport == row.transport &&
+            cur.max_bytes == row.max_bytes) {
+            cur.algo = row.algo;
+            return;
+        }
+    }
+    g_coll_tune_rows.push_back(row);
+}
+
+static int32_t coll_tune_load(const char *path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        SHM_LOG_ERROR("open SHMEM_COLL_TUNE_FILE " << path << " failed.");
+        return SHMEM_INVALID_PARAM;
+    }
+    std::string line;
+    int line_no = 0;
+    while (std::getline(file, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream iss(line);
+        std::string op;
+        std::string transport;
+        std::string bytes;
+        std::string algo;
+        int max_pes = 0;
+        if (!(iss >> op)) {
+            continue;
+        }
+        coll_tune_row row;
+        row.op = coll_name_index(g_coll_op_names, SHMEMX_COLL_OP_NUM, op);
+        row.algo = -1;
+        row.transport = -1;
+        if (iss >> max_pes >> transport >> bytes >> algo) {
+            row.max_pes = max_pes;
+            row.transport = coll_name_index(g_coll_transport_names, COLL_TRANSPORT_NUM, transport);
+            row.algo = coll_name_index(g_coll_algo_names, SHMEMX_COLL_ALGO_NUM, algo);
+            char *end = nullptr;
+            row.max_bytes = (bytes == "inf") ? COLL_TUNE_INF : strtoull(bytes.c_str(), &end, 10);
+            if (bytes != "inf" && (end == bytes.c_str() || *end != '\0')) {
+                row.algo = -1;
+            }
+        }
+        if (row.op < 0 || row.transport < 0 || row.algo <= SHMEMX_COLL_AUTO || max_pes < 1 ||
+            max_pes > SHMEM_MAX_RANKS) {
+            SHM_LOG_ERROR("SHMEM_COLL_TUNE_FILE " << path << " line " << line_no
+                          << " is invalid, expect \"op max_pes transport max_bytes algo\".");
+            return SHMEM_INVALID_PARAM;
+        }
+        coll_tune_put(row);
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_coll_tune_init()
+{
+    g_coll_tune_rows.assign(std::begin(g_coll_tune_defaults), std::end(g_coll_tune_defaults));
+    const char *path = std::getenv("SHMEM_COLL_TUNE_FILE");
+    if (path != nullptr) {
+        return coll_tune_load(path);
+    }
+    return SHMEM_SUCCESS;
+}
+
+void shmemi_coll_tune_finalize()
+{
+    g_coll_tune_rows.clear();
+}
+
+bool shmemi_coll_algo_supported(const shmemi_team_t *team, int op, int algo)
+{
+    switch (algo) {
+        case SHMEMX_COLL_ONE_SHOT:
+            return true;
+        case SHMEMX_COLL_TWO_SHOT:
+            return op == SHMEMX_COLL_ALLREDUCE;
+        case SHMEMX_COLL_RING:
+            return op == SHMEMX_COLL_ALLGATHER || op == SHMEMX_COLL_ALLREDUCE;
+        case SHMEMX_COLL_RECURSIVE_DOUBLING:
+            if (op == SHMEMX_COLL_BROADCAST) {
+                return true;
+            }
+            return (op == SHMEMX_COLL_ALLGATHER || op == SHMEMX_COLL_ALLREDUCE) && (team->size & (team->size - 1)) == 0;
+        case SHMEMX_COLL_HIER:
+            return (op == SHMEMX_COLL_ALLGATHER || op == SHMEMX_COLL_BROADCAST) && team->host_num > 1;
+        case SHMEMX_COLL_LL_ONE_SHOT:
+        case SHMEMX_COLL_LL_TWO_SHOT:
+            // larger messages or teams fall back to the barrier-based variant on device
+            return op == SHMEMX_COLL_ALLREDUCE && team->host_num <= 1;
+        case SHMEMX_COLL_PIPE_RING:
+            // dest aliasing source falls back to ring on device
+            return op == SHMEMX_COLL_ALLREDUCE;
+        default:
+            return false;
+    }
+}
+
+static void coll_tune_team_op(shmemi_team_t *team, int op)
+{
+    int transport = coll_team_transport(team);
+    int max_pes = 0;
+    for (const auto &row : g_coll_tune_rows) {
+        if (row.op != op || row.transport != transport) {
+            continue;
+        }
+        bool covers = row.max_pes >= team->size;
+        bool cur_covers = max_pes >= team->size;
+        // the smallest size class covering the team, the largest one when none covers it
+        if (max_pes == 0 || (covers && (!cur_covers || row.max_pes < max_pes)) ||
+            (!covers && !cur_covers && row.max_pes > max_pes)) {
+            max_pes = row.max_pes;
+        }
+    }
+
+    std::vector<coll_tune_row> rows;
+    for (const auto &row : g_coll_tune_rows) {
+        if (row.op == op && row.transport == transport && row.max_pes == max_pes) {
+            rows.push_back(row);
+        }
+    }
+    std::sort(rows.begin(), rows.end(),
+              [](const coll_tune_row &a, const coll_tune_row &b) { return a.max_bytes < b.max_bytes; });
+
+    shmemi_coll_tune_t *tune = &team->coll_tune[op];
+    tune->range_num = 0;
+    for (const auto &row : rows) {
+        int algo = shmemi_coll_algo_supported(team, op, row.algo) ? row.algo : coll_default_algo(op);
+        int last = tune->range_num - 1;
+        if (last >= 0 && (tune->algo[last] == algo || tune->range_num == SHMEM_COLL_TUNE_MAX_RANGES)) {
+            // the last range takes over sizes beyond the table, so it may as well absorb the overflow
+            tune->max_bytes[last] = row.max_bytes;
+            continue;
+        }
+        tune->algo[tune->range_num] = algo;
+        tune->max_bytes[tune->range_num] = row.max_bytes;
+        tune->range_num++;
+    }
+    if (tune->range_num == 0) {
+        tune->algo[0] = coll_default_algo(op);
+        tune->max_bytes[0] = COLL_TUNE_INF;
+        tune->range_num = 1;
+    }
+}
+
+void shmemi_coll_tune_team(shmemi_team_t *team)
+{
+    for (int op = 0; op < SHMEMX_COLL_OP_NUM; op++) {
+        coll_tune_team_op(team, op);
+    }
+}
+
+int32_t shmemi_coll_tune_add(const shmemi_team_t *team, int op, uint64_t max_bytes, int algo)
+{
+    if (op < 0 || op >= SHMEMX_COLL_OP_NUM || algo <= SHMEMX_COLL_AUTO || algo >= SHMEMX_COLL_ALGO_NUM) {
+        SHM_LOG_ERROR("input coll op " << op << " or algo " << algo << " is invalid.");
+        return SHMEM_INVALID_PARAM;
+    }
+    if (!shmemi_coll_algo_supported(team, op, algo)) {
+        SHM_LOG_ERROR("coll algo " << g_coll_algo_names[algo] << " can not run " << g_coll_op_names[op]
+                      << " on a team of " << team->size << " PEs over " << team->host_num << " hosts.");
+        return SHMEM_INVALID_PARAM;
+    }
+    coll_tune_put({op, team->size, coll_team_transport(team), max_bytes, algo});
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_coll_tune_save(const char *path)
+{
+    SHM_ASSERT_RETURN(path != nullptr, SHMEM_INVALID_PARAM);
+    std::vector<coll_tune_row> rows = g_coll_tune_rows;
+    std::sort(rows.begin(), rows.end(), [](const coll_tune_row &a, const coll_tune_row &b) {
+        if (a.op != b.op) {
+            return a.op < b.op;
+        }
+        if (a.transport != b.transport) {
+            return a.transport < b.transport;
+        }
+        if (a.max_pes != b.max_pes) {
+            return a.max_pes < b.max_pes;
+        }
+        return a.max_bytes < b.max_bytes;
+    });
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        SHM_LOG_ERROR("open coll tuning file " << path << " failed.");
+        return SHMEM_INVALID_PARAM;
+    }
+    file << "# op max_pes transport max_bytes algo\n";
+    for (const auto &row : rows) {
+        file << g_coll_op_names[row.op] << " " << row.max_pes << " " << g_coll_transport_names[row.transport] << " ";
+        if (row.max_bytes == COLL_TUNE_INF) {
+            file << "inf";
+        } else {
+            file << row.max_bytes;
+        }
+        file << " " << g_coll_algo_names[row.algo] << "\n";
+    }
+    if (!file.good()) {
+        SHM_LOG_ERROR("write coll tuning file " << path << " failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
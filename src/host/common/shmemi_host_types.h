@@ -70,6 +70,7 @@ typedef struct shmemi_transport {
     void (*fence)(struct shmemi_transport *t);
     int32_t     logical_dev_id;
     int32_t     dev_id;
+    uint32_t    qp_num;
 } shmemi_transport_t;
 
 typedef struct {
@@ -80,6 +81,11 @@ typedef struct {
     
     // other options
     bool rdma_enabled;
+    uint32_t roce_qp_num;
+    int barrier_algo;       // SHMEM_BARRIER_ALGO, shmemx_barrier_algo_t applied to every new team
+    int max_teams;          // SHMEM_MAX_TEAMS, team slots with a symmetric sync array, a multiple of the pool chunk
+    uint64_t scratch_arena_size;    // SHMEM_SCRATCH_ARENA_SIZE, symmetric bytes the team scratches are taken from
+    uint64_t team_scratch_size;     // SHMEM_TEAM_SCRATCH_SIZE, scratch of a team unless set per team
 } shmemi_options_t;
 
 // host only state
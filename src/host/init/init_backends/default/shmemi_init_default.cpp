@@ -43,9 +43,10 @@ int shmemi_init_default::finalize_device_state()
     return SHMEM_SUCCESS;
 }
 
-int shmemi_init_default::update_device_state(void* host_ptr, size_t size)
+int shmemi_init_default::update_device_state(void* host_ptr, size_t offset, size_t size)
 {
-    SHMEM_CHECK_RET(aclrtMemcpy(global_state_d->get_ptr(), size, host_ptr, size, ACL_MEMCPY_HOST_TO_DEVICE));
+    void *device_ptr = (uint8_t *)global_state_d->get_ptr() + offset;
+    SHMEM_CHECK_RET(aclrtMemcpy(device_ptr, size, (uint8_t *)host_ptr + offset, size, ACL_MEMCPY_HOST_TO_DEVICE));
     return SHMEM_SUCCESS;
 }
 
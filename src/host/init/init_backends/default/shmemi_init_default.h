@@ -32,7 +32,7 @@ public:
 
     int init_device_state() override;
     int finalize_device_state() override;
-    int update_device_state(void* host_ptr, size_t size) override;
+    int update_device_state(void* host_ptr, size_t offset, size_t size) override;
 
     int reserve_heap(shmemi_device_host_state_t &g_state) override;
     int setup_heap(shmemi_device_host_state_t &g_state) override;
@@ -74,13 +74,14 @@ int shmemi_init_mf::init_device_state()
     return SHMEM_SUCCESS;
 }
 
-int shmemi_init_mf::update_device_state(void* host_ptr, size_t size)
+int shmemi_init_mf::update_device_state(void* host_ptr, size_t offset, size_t size)
 {
     if (g_smem_handle == nullptr) {
         SHM_LOG_ERROR("smem_shm_create Not Success, update_device_state Failed");
         return SHMEM_SMEM_ERROR;
     }
-    return smem_shm_set_extra_context(g_smem_handle, host_ptr, size);
+    // the extra context is always written from its start, only the clean tail is skipped
+    return smem_shm_set_extra_context(g_smem_handle, host_ptr, offset + size);
 }
 
 int shmemi_init_mf::finalize_device_state()
@@ -19,7 +19,8 @@ class shmemi_init_base {
 public:
     virtual int init_device_state() = 0;
     virtual int finalize_device_state() = 0;
-    virtual int update_device_state(void* host_ptr, size_t size) = 0;
+    // copy bytes [offset, offset + size) of the state at host_ptr to the device
+    virtual int update_device_state(void* host_ptr, size_t offset, size_t size) = 0;
 
     virtual int reserve_heap(shmemi_device_host_state_t &g_state) = 0;
     virtual int setup_heap(shmemi_device_host_state_t &g_state) = 0;
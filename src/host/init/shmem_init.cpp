@@ -16,6 +16,8 @@
 #include <netdb.h>
 #include <arpa/inet.h>
 #include <functional>
+#include <algorithm>
+#include <cstddef>
 
 #include "acl/acl.h"
 #include "shmemi_host_common.h"
@@ -28,6 +30,7 @@ using namespace std;
 constexpr int DEFAULT_FLAG = 0;
 constexpr int DEFAULT_ID = 0;
 constexpr int DEFAULT_TIMEOUT = 120;
+constexpr uint32_t DEFAULT_ROCE_QP_NUM = 1;
 constexpr int DEFAULT_TEVENT = 0;
 constexpr int DEFAULT_BLOCK_NUM = 1;
 
@@ -37,22 +40,32 @@ constexpr int DEFAULT_BLOCK_NUM = 1;
         (1 << 16) + sizeof(shmemi_device_host_state_t), /* version */                    \
             (DEFAULT_MY_PE),                            /* mype */                       \
             (DEFAULT_N_PES),                            /* npes */                       \
+            0,                                          /* state_version */              \
             NULL,                                       /* heap_base */                  \
-            {NULL},                                     /* p2p_heap_base */              \
-            {NULL},                                     /* rdma_heap_base */             \
-            {NULL},                                     /* sdma_heap_base */             \
-            {},                                         /* topo_list */                  \
             SIZE_MAX,                                   /* heap_size */                  \
             {NULL},                                     /* team_pools */                 \
             0,                                          /* sync_pool */                  \
             0,                                          /* sync_counter */               \
             0,                                          /* core_sync_pool */             \
             0,                                          /* core_sync_counter */          \
+            0,                                          /* amo_fetch_pool */             \
             0,                                          /* host_hash */                  \
             false,                                      /* shmem_is_shmem_initialized */ \
             false,                                      /* shmem_is_shmem_created */     \
             {0, 16 * 1024, 0},                          /* shmem_mte_config */           \
             0,                                          /* qp_info */                    \
+            {},                                         /* ctx_pools */                  \
+            0,                                          /* ctx_track_pool */             \
+            0,                                          /* work_queue */                 \
+            0,                                          /* coll_ll_pool */               \
+            0,                                          /* coll_counts_pool */           \
+            0,                                          /* coll_pipe_pool */             \
+            0,                                          /* team_epoch_pool */            \
+            {},                                         /* topo_list */                  \
+            {},                                         /* pe_host */                    \
+            {NULL},                                     /* p2p_heap_base */              \
+            {NULL},                                     /* rdma_heap_base */             \
+            {NULL},                                     /* sdma_heap_base */             \
     }
 
 shmemi_device_host_state_t g_state = SHMEM_DEVICE_HOST_STATE_INITIALIZER;
@@ -67,9 +80,63 @@ int32_t version_compatible()
     return status;
 }
 
+// Bytes from the environment variable name, rounded up to a multiple of align, value is left as is when it is unset.
+static int32_t shmemi_size_option(const char *name, uint64_t align, uint64_t &value)
+{
+    const char *env = std::getenv(name);
+    if (env == nullptr) {
+        return SHMEM_SUCCESS;
+    }
+    char *end = nullptr;
+    unsigned long long bytes = strtoull(env, &end, 10);
+    if (end == env || *end != '\0' || env[0] == '-' || bytes > SHMEM_MAX_LOCAL_SIZE) {
+        SHM_LOG_ERROR(name << " " << env << " is invalid, expect bytes in [0, " << SHMEM_MAX_LOCAL_SIZE << "].");
+        return SHMEM_INVALID_PARAM;
+    }
+    value = ALIGH_TO(static_cast<uint64_t>(bytes), align);
+    return SHMEM_SUCCESS;
+}
+
 int32_t shmemi_options_init()
 {
     int32_t status = SHMEM_SUCCESS;
+
+    static const char *barrier_algo_names[SHMEMX_BARRIER_ALGO_NUM] = {
+        "auto", "dissem", "group_dissem", "central", "hier"
+    };
+    g_host_state.options.barrier_algo = SHMEMX_BARRIER_AUTO;
+    const char *barrier_algo = std::getenv("SHMEM_BARRIER_ALGO");
+    if (barrier_algo != nullptr) {
+        int algo = 0;
+        while (algo < SHMEMX_BARRIER_ALGO_NUM && strcmp(barrier_algo, barrier_algo_names[algo]) != 0) {
+            algo++;
+        }
+        if (algo == SHMEMX_BARRIER_ALGO_NUM) {
+            SHM_LOG_ERROR("SHMEM_BARRIER_ALGO " << barrier_algo
+                          << " is invalid, expect one of auto, dissem, group_dissem, central, hier.");
+            return SHMEM_INVALID_PARAM;
+        }
+        g_host_state.options.barrier_algo = algo;
+    }
+
+    g_host_state.options.max_teams = SHMEM_DEFAULT_TEAMS;
+    const char *max_teams = std::getenv("SHMEM_MAX_TEAMS");
+    if (max_teams != nullptr) {
+        char *end = nullptr;
+        long value = strtol(max_teams, &end, 10);
+        if (end == max_teams || *end != '\0' || value < 1 || value > SHMEM_MAX_TEAMS) {
+            SHM_LOG_ERROR("SHMEM_MAX_TEAMS " << max_teams << " is invalid, expect [1, " << SHMEM_MAX_TEAMS << "].");
+            return SHMEM_INVALID_PARAM;
+        }
+        g_host_state.options.max_teams = ALIGH_TO(static_cast<int>(value), SHMEM_TEAM_POOL_CHUNK);
+    }
+
+    g_host_state.options.scratch_arena_size = SHMEM_SCRATCH_ARENA_DEFAULT_SIZE;
+    g_host_state.options.team_scratch_size = SHMEM_TEAM_SCRATCH_DEFAULT_SIZE;
+    SHMEM_CHECK_RET(shmemi_size_option("SHMEM_SCRATCH_ARENA_SIZE", SHMEM_TEAM_SCRATCH_GRANULE,
+                                       g_host_state.options.scratch_arena_size));
+    SHMEM_CHECK_RET(shmemi_size_option("SHMEM_TEAM_SCRATCH_SIZE", SHMEM_TEAM_SCRATCH_GRANULE,
+                                       g_host_state.options.team_scratch_size));
     return status;
 }
 
@@ -103,6 +170,13 @@ int32_t shmemi_state_init_attr(shmem_init_attr_t *attributes)
     g_state.mype = attributes->my_rank;
     g_state.npes = attributes->n_ranks;
     g_state.heap_size = attributes->local_mem_size + SHMEM_EXTRA_SIZE;
+    // sync arrays of the team slots beyond the default ones
+    if (g_host_state.options.max_teams > SHMEM_DEFAULT_TEAMS) {
+        g_state.heap_size +=
+            ALIGH_TO(SYNC_POOL_SIZE(g_host_state.options.max_teams - SHMEM_DEFAULT_TEAMS), SHMEM_PAGE_SIZE);
+    }
+    // alltoallv counts, quadratic in the PE count
+    g_state.heap_size += ALIGH_TO(SHMEM_COLL_COUNTS_POOL_SIZE(g_state.npes), SHMEM_PAGE_SIZE);
     g_state.host_hash = shmemi_get_host_hash();
 
     aclrtStream stream = nullptr;
@@ -125,6 +199,10 @@ int32_t check_attr(shmem_init_attr_t *attributes)
     } else if (attributes->my_rank >= attributes->n_ranks) {
         SHM_LOG_ERROR("n_ranks:" << attributes->n_ranks << " cannot be less than my_rank:" << attributes->my_rank);
         return SHMEM_INVALID_PARAM;
+    } else if (attributes->option_attr.roce_qp_num > SHMEM_MAX_ROCE_QP_NUM) {
+        SHM_LOG_ERROR("roce_qp_num: " << attributes->option_attr.roce_qp_num << " cannot be more than "
+                                      << SHMEM_MAX_ROCE_QP_NUM);
+        return SHMEM_INVALID_VALUE;
     } else if (attributes->local_mem_size <= 0) {
         SHM_LOG_ERROR("local_mem_size:" << attributes->local_mem_size << " cannot be less or equal 0");
         return SHMEM_INVALID_VALUE;
@@ -139,9 +217,51 @@ int32_t shmemi_control_barrier_all()
     return g_boot_handle.barrier(&g_boot_handle);
 }
 
+// Copy of the state last published to the device, update_device_state() only sends the bytes that differ from it.
+static shmemi_device_host_state_t g_state_published;
+static bool g_state_published_valid = false;
+
 int32_t update_device_state()
 {
-    return init_manager->update_device_state((void *)&g_state, sizeof(shmemi_device_host_state_t));
+    auto cur = reinterpret_cast<const uint8_t *>(&g_state);
+    auto old = reinterpret_cast<const uint8_t *>(&g_state_published);
+    size_t first = 0;
+    size_t last = sizeof(shmemi_device_host_state_t);
+    if (g_state_published_valid) {
+        while (first < last && cur[first] == old[first]) {
+            first++;
+        }
+        if (first == last) {
+            return SHMEM_SUCCESS;
+        }
+        while (cur[last - 1] == old[last - 1]) {
+            last--;
+        }
+    }
+
+    auto ret = init_manager->update_device_state((void *)&g_state, first, last - first);
+    if (ret != SHMEM_SUCCESS) {
+        SHM_LOG_ERROR("update device state failed, ret: " << ret);
+        return ret;
+    }
+
+    // publish the version in its own copy after the data, a device reader never sees a new version with stale fields
+    g_state.state_version++;
+    ret = init_manager->update_device_state((void *)&g_state, offsetof(shmemi_device_host_state_t, state_version),
+                                            sizeof(g_state.state_version));
+    if (ret != SHMEM_SUCCESS) {
+        g_state.state_version--;
+        SHM_LOG_ERROR("update device state version failed, ret: " << ret);
+        return ret;
+    }
+    memcpy(&g_state_published, &g_state, sizeof(shmemi_device_host_state_t));
+    g_state_published_valid = true;
+    return SHMEM_SUCCESS;
+}
+
+uint64_t shmemx_state_version()
+{
+    return g_state.state_version;
 }
 
 int32_t shmem_set_data_op_engine_type(shmem_init_attr_t *attributes, data_op_engine_type_t value)
@@ -158,6 +278,17 @@ int32_t shmem_set_timeout(shmem_init_attr_t *attributes, uint32_t value)
     return SHMEM_SUCCESS;
 }
 
+int32_t shmem_set_roce_qp_num(shmem_init_attr_t *attributes, uint32_t value)
+{
+    SHM_ASSERT_RETURN(attributes != nullptr, SHMEM_INVALID_PARAM);
+    if (value == 0 || value > SHMEM_MAX_ROCE_QP_NUM) {
+        SHM_LOG_ERROR("roce_qp_num: " << value << " should be in [1, " << SHMEM_MAX_ROCE_QP_NUM << "]");
+        return SHMEM_INVALID_PARAM;
+    }
+    attributes->option_attr.roce_qp_num = value;
+    return SHMEM_SUCCESS;
+}
+
 int32_t shmem_set_attr(int32_t my_rank, int32_t n_ranks, uint64_t local_mem_size, const char *ip_port,
                        shmem_init_attr_t **attributes)
 {
@@ -187,7 +318,7 @@ int32_t shmem_set_attr(int32_t my_rank, int32_t n_ranks, uint64_t local_mem_size
     g_attr.ip_port = g_ipport;
     g_attr.local_mem_size = local_mem_size;
     g_attr.option_attr = {attr_version, SHMEM_DATA_OP_MTE, DEFAULT_TIMEOUT, 
-                               DEFAULT_TIMEOUT, DEFAULT_TIMEOUT};
+                               DEFAULT_TIMEOUT, DEFAULT_TIMEOUT, DEFAULT_ROCE_QP_NUM};
     // g_attr_init = true;
     return SHMEM_SUCCESS;
 }
@@ -213,6 +344,8 @@ int32_t shmem_init_attr(shmemx_bootstrap_t bootstrap_flags, shmem_init_attr_t *a
     SHMEM_CHECK_RET(check_attr(attributes));
     SHMEM_CHECK_RET(version_compatible());
     SHMEM_CHECK_RET(shmemi_options_init());
+    g_host_state.options.roce_qp_num =
+        attributes->option_attr.roce_qp_num == 0 ? DEFAULT_ROCE_QP_NUM : attributes->option_attr.roce_qp_num;
 
     // bootstrap init
     shmemi_bootstrap_attr_t attr = {};
@@ -226,13 +359,20 @@ int32_t shmem_init_attr(shmemx_bootstrap_t bootstrap_flags, shmem_init_attr_t *a
 #endif
     SHMEM_CHECK_RET(shmemi_state_init_attr(attributes));
     SHMEM_CHECK_RET(init_manager->init_device_state());
+    g_state_published_valid = false;
     SHMEM_CHECK_RET(init_manager->reserve_heap(g_state));
     SHMEM_CHECK_RET(init_manager->transport_init(g_state));
     SHMEM_CHECK_RET(init_manager->setup_heap(g_state));
     
     // shmem submodules init
     SHMEM_CHECK_RET(memory_manager_initialize(g_state.heap_base, g_state.heap_size));
+    SHMEM_CHECK_RET(shmemi_coll_tune_init());
     SHMEM_CHECK_RET(shmemi_team_init(g_state.mype, g_state.npes));
+    SHMEM_CHECK_RET(shmemi_amo_init());
+    SHMEM_CHECK_RET(shmemi_coll_ll_init());
+    SHMEM_CHECK_RET(shmemi_coll_counts_init());
+    SHMEM_CHECK_RET(shmemi_coll_pipe_init());
+    SHMEM_CHECK_RET(shmemi_ctx_init());
     SHMEM_CHECK_RET(shmemi_sync_init());
     g_state.is_shmem_initialized = true;
     SHMEM_CHECK_RET(update_device_state());
@@ -242,7 +382,14 @@ int32_t shmem_init_attr(shmemx_bootstrap_t bootstrap_flags, shmem_init_attr_t *a
 
 int32_t shmem_finalize()
 {
+    SHMEM_CHECK_RET(shmemi_work_queue_finalize());
+    SHMEM_CHECK_RET(shmemi_ctx_finalize());
+    SHMEM_CHECK_RET(shmemi_coll_pipe_finalize());
+    SHMEM_CHECK_RET(shmemi_coll_counts_finalize());
+    SHMEM_CHECK_RET(shmemi_coll_ll_finalize());
+    SHMEM_CHECK_RET(shmemi_amo_finalize());
     SHMEM_CHECK_RET(shmemi_team_finalize());
+    shmemi_coll_tune_finalize();
     delete init_manager;
 
     shmemi_bootstrap_finalize();
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+#include "host/shmem_host_amo.h"
+#include "shmemi_device_amo.h"
+#include "host_device/shmem_types.h"
+
+// device side landing buffer for host fetching AMOs
+static void *g_amo_fetch_result = nullptr;
+
+int32_t shmemi_amo_init()
+{
+    g_state.amo_fetch_pool = (uint64_t)shmem_malloc(SHMEM_AMO_FETCH_POOL_SIZE);
+    if (g_state.amo_fetch_pool == 0) {
+        SHM_LOG_ERROR("malloc amo fetch pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    auto ret = aclrtMemset((void *)g_state.amo_fetch_pool, SHMEM_AMO_FETCH_POOL_SIZE, 0, SHMEM_AMO_FETCH_POOL_SIZE);
+    if (ret != 0) {
+        shmemi_amo_finalize();
+        SHM_LOG_ERROR("memset amo fetch pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+
+    ret = aclrtMalloc(&g_amo_fetch_result, SHMEM_AMO_FETCH_SLOT_SIZE, ACL_MEM_MALLOC_HUGE_FIRST);
+    if (ret != 0 || g_amo_fetch_result == nullptr) {
+        shmemi_amo_finalize();
+        SHM_LOG_ERROR("malloc amo fetch result failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_amo_finalize()
+{
+    if (g_amo_fetch_result != nullptr) {
+        aclrtFree(g_amo_fetch_result);
+        g_amo_fetch_result = nullptr;
+    }
+    if (g_state.amo_fetch_pool != 0) {
+        shmem_free(reinterpret_cast<void *>(g_state.amo_fetch_pool));
+        g_state.amo_fetch_pool = 0;
+    }
+    return SHMEM_SUCCESS;
+}
+
+static inline bool shmemi_amo_check(const char *api_name, void *dst, int pe)
+{
+    if (pe < 0 || pe >= g_state.npes) {
+        SHM_LOG_ERROR(api_name << " failed. PE: " << g_state.mype << " got illegal PE " << pe);
+        return false;
+    }
+    uint64_t lower_bound = (uint64_t)g_state.heap_base;
+    uint64_t upper_bound = lower_bound + g_state.heap_size;
+    if ((uint64_t)dst < lower_bound || (uint64_t)dst >= upper_bound) {
+        SHM_LOG_ERROR(api_name << " failed. PE: " << g_state.mype << " got illegal symmetric address");
+        return false;
+    }
+    return true;
+}
+
+#define SHMEM_TYPENAME_POST_AMO(NAME, TYPE)                                                                    \
+    static int shmemi_##NAME##_amo_on_stream(const char *api_name, shmemi_amo_op_t op, TYPE *dst, TYPE value,  \
+                                             TYPE cond, int pe, TYPE *fetched, aclrtStream stream)             \
+    {                                                                                                          \
+        if (!shmemi_amo_check(api_name, dst, pe)) {                                                            \
+            return SHMEM_INVALID_PARAM;                                                                        \
+        }                                                                                                      \
+        int ret = shmemi_prepare_and_post_amo_##NAME(api_name, op, (uint8_t *)dst, value, cond, pe,            \
+                                                     (uint8_t *)fetched, stream);                              \
+        if (ret < 0) {                                                                                         \
+            SHM_LOG_ERROR(api_name << " device calling atomic failed");                                        \
+            return SHMEM_INNER_ERROR;                                                                          \
+        }                                                                                                      \
+        return SHMEM_SUCCESS;                                                                                  \
+    }                                                                                                          \
+                                                                                                               \
+    static void shmemi_##NAME##_post_amo(const char *api_name, shmemi_amo_op_t op, TYPE *dst, TYPE value,      \
+                                         TYPE cond, int pe)                                                    \
+    {                                                                                                          \
+        shmemi_##NAME##_amo_on_stream(api_name, op, dst, value, cond, pe, nullptr,                             \
+                                      g_state_host.default_stream);                                            \
+    }                                                                                                          \
+                                                                                                               \
+    static TYPE shmemi_##NAME##_post_fetch_amo(const char *api_name, shmemi_amo_op_t op, TYPE *dst, TYPE value, \
+                                               TYPE cond, int pe)                                              \
+    {                                                                                                          \
+        TYPE fetched = 0;                                                                                      \
+        int ret = shmemi_##NAME##_amo_on_stream(api_name, op, dst, value, cond, pe,                            \
+                                                (TYPE *)g_amo_fetch_result, g_state_host.default_stream);      \
+        if (ret != SHMEM_SUCCESS) {                                                                            \
+            return fetched;                                                                                    \
+        }                                                                                                      \
+        ret = aclrtSynchronizeStream(g_state_host.default_stream);                                             \
+        if (ret != 0) {                                                                                        \
+            SHM_LOG_ERROR(api_name << " synchronize stream failed, ret: " << ret);                             \
+            return fetched;                                                                                    \
+        }                                                                                                      \
+        ret = aclrtMemcpy(&fetched, sizeof(TYPE), g_amo_fetch_result, sizeof(TYPE), ACL_MEMCPY_DEVICE_TO_HOST); \
+        if (ret != 0) {                                                                                        \
+            SHM_LOG_ERROR(api_name << " copy fetched value failed, ret: " << ret);                             \
+        }                                                                                                      \
+        return fetched;                                                                                        \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_POST_AMO)
+#undef SHMEM_TYPENAME_POST_AMO
+
+#define SHMEM_TYPENAME_ATOMIC(NAME, TYPE)                                                                      \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_fetch(TYPE *src, int pe)                                         \
+    {                                                                                                          \
+        return shmemi_##NAME##_post_fetch_amo("shmem_" #NAME "_atomic_fetch", SHMEMI_AMO_FETCH, src, 0, 0, pe); \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API void shmem_##NAME##_atomic_set(TYPE *dst, TYPE value, int pe)                               \
+    {                                                                                                          \
+        shmemi_##NAME##_post_amo("shmem_" #NAME "_atomic_set", SHMEMI_AMO_SET, dst, value, 0, pe);             \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_swap(TYPE *dst, TYPE value, int pe)                              \
+    {                                                                                                          \
+        return shmemi_##NAME##_post_fetch_amo("shmem_" #NAME "_atomic_swap", SHMEMI_AMO_SWAP, dst, value, 0,   \
+                                              pe);                                                             \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API TYPE shmem_##NAME##_atomic_compare_swap(TYPE *dst, TYPE cond, TYPE value, int pe)           \
+    {                                                                                                          \
+        return shmemi_##NAME##_post_fetch_amo("shmem_" #NAME "_atomic_compare_swap", SHMEMI_AMO_COMPARE_SWAP,  \
+                                              dst, value, cond, pe);                                           \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC)
+#undef SHMEM_TYPENAME_ATOMIC
+
+#define SHMEM_TYPENAME_ATOMIC_ON_STREAM(NAME, TYPE)                                                            \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_fetch_on_stream(TYPE *src, int pe, TYPE *fetched,                \
+                                                              aclrtStream stream)                              \
+    {                                                                                                          \
+        return shmemi_##NAME##_amo_on_stream("shmemx_" #NAME "_atomic_fetch_on_stream", SHMEMI_AMO_FETCH, src, \
+                                             0, 0, pe, fetched, stream);                                       \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_set_on_stream(TYPE *dst, TYPE value, int pe, aclrtStream stream) \
+    {                                                                                                          \
+        return shmemi_##NAME##_amo_on_stream("shmemx_" #NAME "_atomic_set_on_stream", SHMEMI_AMO_SET, dst,     \
+                                             value, 0, pe, nullptr, stream);                                   \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_swap_on_stream(TYPE *dst, TYPE value, int pe, TYPE *fetched,     \
+                                                             aclrtStream stream)                               \
+    {                                                                                                          \
+        return shmemi_##NAME##_amo_on_stream("shmemx_" #NAME "_atomic_swap_on_stream", SHMEMI_AMO_SWAP, dst,   \
+                                             value, 0, pe, fetched, stream);                                   \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API int shmemx_##NAME##_atomic_compare_swap_on_stream(TYPE *dst, TYPE cond, TYPE value, int pe, \
+                                                                     TYPE *fetched, aclrtStream stream)        \
+    {                                                                                                          \
+        return shmemi_##NAME##_amo_on_stream("shmemx_" #NAME "_atomic_compare_swap_on_stream",                 \
+                                             SHMEMI_AMO_COMPARE_SWAP, dst, value, cond, pe, fetched, stream);  \
+    }
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_ON_STREAM)
+#undef SHMEM_TYPENAME_ATOMIC_ON_STREAM
+
+#define SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, OP_FUNC, FETCH_OP_FUNC, OP)                                       \
+    SHMEM_HOST_API void shmem_##NAME##_##OP_FUNC(TYPE *dst, TYPE value, int pe)                                \
+    {                                                                                                          \
+        shmemi_##NAME##_post_amo("shmem_" #NAME "_" #OP_FUNC, SHMEMI_AMO_##OP, dst, value, 0, pe);             \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API TYPE shmem_##NAME##_##FETCH_OP_FUNC(TYPE *dst, TYPE value, int pe)                          \
+    {                                                                                                          \
+        return shmemi_##NAME##_post_fetch_amo("shmem_" #NAME "_" #FETCH_OP_FUNC, SHMEMI_AMO_FETCH_##OP, dst,   \
+                                              value, 0, pe);                                                   \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API int shmemx_##NAME##_##OP_FUNC##_on_stream(TYPE *dst, TYPE value, int pe,                    \
+                                                             aclrtStream stream)                               \
+    {                                                                                                          \
+        return shmemi_##NAME##_amo_on_stream("shmemx_" #NAME "_" #OP_FUNC "_on_stream", SHMEMI_AMO_##OP, dst,  \
+                                             value, 0, pe, nullptr, stream);                                   \
+    }                                                                                                          \
+                                                                                                               \
+    SHMEM_HOST_API int shmemx_##NAME##_##FETCH_OP_FUNC##_on_stream(TYPE *dst, TYPE value, int pe,              \
+                                                                    TYPE *fetched, aclrtStream stream)         \
+    {                                                                                                          \
+        return shmemi_##NAME##_amo_on_stream("shmemx_" #NAME "_" #FETCH_OP_FUNC "_on_stream",                  \
+                                             SHMEMI_AMO_FETCH_##OP, dst, value, 0, pe, fetched, stream);       \
+    }
+
+#define SHMEM_TYPENAME_ATOMIC_ADD(NAME, TYPE) \
+    SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, atomic_add, atomic_fetch_add, ADD)
+#define SHMEM_TYPENAME_ATOMIC_AND(NAME, TYPE) \
+    SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, atomic_and, atomic_fetch_and, AND)
+#define SHMEM_TYPENAME_ATOMIC_OR(NAME, TYPE) \
+    SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, atomic_or, atomic_fetch_or, OR)
+#define SHMEM_TYPENAME_ATOMIC_XOR(NAME, TYPE) \
+    SHMEM_TYPENAME_ATOMIC_OP(NAME, TYPE, atomic_xor, atomic_fetch_xor, XOR)
+
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_ADD)
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_AND)
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_OR)
+SHMEM_AMO_TYPE_FUNC(SHMEM_TYPENAME_ATOMIC_XOR)
+#undef SHMEM_TYPENAME_ATOMIC_ADD
+#undef SHMEM_TYPENAME_ATOMIC_AND
+#undef SHMEM_TYPENAME_ATOMIC_OR
+#undef SHMEM_TYPENAME_ATOMIC_XOR
+#undef SHMEM_TYPENAME_ATOMIC_OP
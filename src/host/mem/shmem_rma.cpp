@@ -45,6 +45,7 @@ int32_t shmem_mte_set_ub_params(uint64_t offset, uint32_t ub_size, uint32_t even
     g_state.mte_config.shmem_ub = offset;
     g_state.mte_config.ub_size = ub_size;
     g_state.mte_config.event_id = event_id;
+    g_state.ctx_pools[SHMEM_CTX_DEFAULT].mte_config = g_state.mte_config;
     SHMEM_CHECK_RET(update_device_state());
     return SHMEM_SUCCESS;
 }
@@ -195,7 +196,7 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL)
 SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_NBI)
 #undef SHMEM_PUT_TYPENAME_MEM_SIGNAL_NBI
 
-#define SHMEM_TYPENAME_P(NAME, TYPE)                                                                                   \
+#define SHMEM_TYPENAME_P_LAUNCH(NAME, TYPE, LAUNCH)                                                                    \
     /**                                                                                                                \
      * @brief Provide a low latency put capability for single element of most basic types.                             \
      *                                                                                                                 \
@@ -205,12 +206,18 @@ SHMEM_TYPE_FUNC(SHMEM_PUT_TYPENAME_MEM_SIGNAL_NBI)
      */                                                                                                                \
     SHMEM_HOST_API void shmem_##NAME##_p(TYPE *dst, const TYPE value, int pe)                                          \
     {                                                                                                                  \
-        shmemi_prepare_and_post_rma_##NAME##_p("shmem_" #NAME "_p", (uint8_t *)dst, value, pe,                         \
-                                               g_state_host.default_stream, g_state_host.default_block_num);           \
+        shmemi_prepare_and_post_rma_##LAUNCH##_p("shmem_" #NAME "_p", (uint8_t *)dst, value, pe,                       \
+                                                 g_state_host.default_stream, g_state_host.default_block_num);         \
     }
 
-SHMEM_TYPE_FUNC(SHMEM_TYPENAME_P)
+#define SHMEM_TYPENAME_P(NAME, TYPE) SHMEM_TYPENAME_P_LAUNCH(NAME, TYPE, NAME)
+
+SHMEMI_RMA_P_TYPE_FUNC(SHMEM_TYPENAME_P)
+// 16-bit floats are put by their bits
+SHMEM_TYPENAME_P_LAUNCH(half, shmem_half_t, uint16)
+SHMEM_TYPENAME_P_LAUNCH(bfloat16, shmem_bfloat16_t, uint16)
 #undef SHMEM_TYPENAME_P
+#undef SHMEM_TYPENAME_P_LAUNCH
 
 #define SHMEM_TYPENAME_G(NAME, TYPE)                                                                                   \
     /**                                                                                                                \
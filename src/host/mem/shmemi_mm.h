@@ -59,4 +59,7 @@ private:
 int32_t memory_manager_initialize(void *base, uint64_t size);
 void memory_manager_destroy();
 
+int32_t shmemi_amo_init();
+int32_t shmemi_amo_finalize();
+
 #endif  // SHMEMI_MM_H
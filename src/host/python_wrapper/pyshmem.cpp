@@ -83,6 +83,15 @@ int32_t set_timeout(shmem_init_attr_t &attributes, uint32_t value)
     return ret;
 }
 
+int32_t set_roce_qp_num(shmem_init_attr_t &attributes, uint32_t value)
+{
+    int ret = shmem_set_roce_qp_num(&attributes, value);
+    if (ret != 0) {
+        throw std::runtime_error("set roce qp num failed");
+    }
+    return ret;
+}
+
 int32_t shmem_set_attributes(int32_t my_rank, int32_t n_ranks, uint64_t local_mem_size, const char *ip_port,
                              shmem_init_attr_t &attributes)
 {
@@ -167,7 +176,8 @@ void DefineShmemAttr(py::module_ &m)
         .def_readwrite("data_op_engine_type", &shmem_init_optional_attr_t::data_op_engine_type)
         .def_readwrite("shm_init_timeout", &shmem_init_optional_attr_t::shm_init_timeout)
         .def_readwrite("shm_create_timeout", &shmem_init_optional_attr_t::shm_create_timeout)
-        .def_readwrite("control_operation_timeout", &shmem_init_optional_attr_t::control_operation_timeout);
+        .def_readwrite("control_operation_timeout", &shmem_init_optional_attr_t::control_operation_timeout)
+        .def_readwrite("roce_qp_num", &shmem_init_optional_attr_t::roce_qp_num);
 
     py::class_<shmem_init_attr_t>(m, "InitAttr")
         .def(py::init([]() {
@@ -262,6 +272,16 @@ Returns:
     On success, returns 0. On error, error code on failure.
     )");
 
+    m.def("shmem_set_roce_qp_num", &shm::set_roce_qp_num, py::call_guard<py::gil_scoped_release>(),
+          py::arg("attributes"), py::arg("value"), R"(
+Modify the number of RoCE QPs created per peer in the attributes that will be used for initialization.
+Arguments:
+    attributes(InitAttr): Attributes set.
+    value(int): Number of RoCE QPs per peer, from 1 to 8.
+Returns:
+    On success, returns 0. On error, error code on failure.
+    )");
+
     m.def("register_decrypt_handler", &shm::register_python_decrypt_handler, py::call_guard<py::gil_scoped_release>(),
           py::arg("py_decrypt_func"), R"(
 Register a Python decrypt handler.
@@ -435,6 +455,27 @@ Returns:
     On success, returns new x team id and new y team id. On error, (-1, -1) is returned.
     )");
 
+    m.def(
+        "team_split",
+        [](int parent, int color, int key) {
+            shmem_team_t new_team;
+            auto ret = shmemx_team_split(parent, color, key, &new_team);
+            if (ret != 0) {
+                throw std::runtime_error("shmemx_team_split failed");
+            }
+            return new_team;
+        },
+        py::call_guard<py::gil_scoped_release>(), py::arg("parent"), py::arg("color"), py::arg("key"), R"(
+Collective Interface. Split team from an existing parent team by color, members are ordered by key
+
+Arguments:
+    parent(int): parent team id
+    color(int): PEs with the same color join the same team, a negative color joins no team
+    key(int): orders the PEs inside the new team, ties are broken by the PE number in parent team
+Returns:
+    On success, returns new team id, -1 for a negative color.
+    )");
+
     m.def(
         "shmem_team_get_config",
         [](int team) {
@@ -17,6 +17,7 @@
 #include "common/shmemi_host_types.h"
 #include "init/shmemi_init.h"
 #include "team/shmemi_team.h"
+#include "coll/shmemi_coll.h"
 #include "mem/shmemi_mm.h"
 #include "sync/shmemi_sync.h"
 #include "bootstrap/shmemi_bootstrap.h"
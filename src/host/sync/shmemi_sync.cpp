@@ -35,8 +35,22 @@ uint64_t shmemx_get_ffts_config()
 
 void shmem_barrier(shmem_team_t tid)
 {
-    // using default stream to do barrier
+    // device work issued on the default stream completes first
+    if (aclrtSynchronizeStream(nullptr) != ACL_SUCCESS) {
+        SHM_LOG_ERROR("synchronize default stream failed before barrier, team: " << tid);
+        return;
+    }
+    // the world is synchronized by the bootstrap alone, no kernel launch is needed
+    if (tid == SHMEM_TEAM_WORLD) {
+        if (shmemi_control_barrier_all() != 0) {
+            SHM_LOG_ERROR("control barrier failed.");
+        }
+        return;
+    }
     shmemi_barrier_on_stream(tid, nullptr);
+    if (aclrtSynchronizeStream(nullptr) != ACL_SUCCESS) {
+        SHM_LOG_ERROR("synchronize default stream failed after barrier, team: " << tid);
+    }
 }
 
 void shmem_barrier_all()
@@ -52,4 +66,39 @@ void shmem_barrier_on_stream(shmem_team_t tid, aclrtStream stream)
 void shmem_barrier_all_on_stream(aclrtStream stream)
 {
     shmemi_barrier_on_stream(SHMEM_TEAM_WORLD, stream);
-}
\ No newline at end of file
+}
+
+int shmemx_barrier_on_stream_event(shmem_team_t tid, aclrtStream stream, aclrtEvent event)
+{
+    if (shmem_team_n_pes(tid) < 0) {
+        SHM_LOG_ERROR("input team is invalid!, team: " << tid);
+        return SHMEM_INVALID_PARAM;
+    }
+    SHMEM_CHECK_RET(shmemi_barrier_on_stream(tid, stream));
+    if (event != nullptr) {
+        auto ret = aclrtRecordEvent(event, stream);
+        if (ret != ACL_SUCCESS) {
+            SHM_LOG_ERROR("record barrier event failed, ret: " << ret);
+            return SHMEM_INNER_ERROR;
+        }
+    }
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_barrier_arrive_on_stream(shmem_team_t tid, aclrtStream stream)
+{
+    if (shmem_team_n_pes(tid) < 0) {
+        SHM_LOG_ERROR("input team is invalid!, team: " << tid);
+        return SHMEM_INVALID_PARAM;
+    }
+    return shmemi_barrier_arrive_on_stream(tid, stream);
+}
+
+int shmemx_barrier_wait_on_stream(shmem_team_t tid, aclrtStream stream)
+{
+    if (shmem_team_n_pes(tid) < 0) {
+        SHM_LOG_ERROR("input team is invalid!, team: " << tid);
+        return SHMEM_INVALID_PARAM;
+    }
+    return shmemi_barrier_wait_on_stream(tid, stream);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+
+inline bool is_valid_ctx(shmem_ctx_t ctx)
+{
+    return (g_state.is_shmem_initialized && ctx >= 0 && ctx < SHMEM_MAX_CTXS && g_state.ctx_pools[ctx].valid);
+}
+
+int32_t shmemi_ctx_init()
+{
+    // SHMEM_CTX_DEFAULT shares UB and event with the non-ctx RMA interfaces
+    g_state.ctx_pools[SHMEM_CTX_DEFAULT] = shmemi_ctx_t{1, SHMEM_TEAM_WORLD, 0, g_state.mte_config};
+    for (int32_t i = SHMEM_CTX_DEFAULT + 1; i < SHMEM_MAX_CTXS; i++) {
+        g_state.ctx_pools[i].valid = 0;
+    }
+
+    auto ret = aclrtMalloc((void **)&(g_state.ctx_track_pool), SHMEM_CTX_TRACK_POOL_SIZE, ACL_MEM_MALLOC_HUGE_FIRST);
+    if (ret != 0 || g_state.ctx_track_pool == 0) {
+        shmemi_ctx_finalize();
+        SHM_LOG_ERROR("malloc ctx track pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    ret = aclrtMemset((void *)g_state.ctx_track_pool, SHMEM_CTX_TRACK_POOL_SIZE, 0, SHMEM_CTX_TRACK_POOL_SIZE);
+    if (ret != 0) {
+        shmemi_ctx_finalize();
+        SHM_LOG_ERROR("memset ctx track pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_ctx_finalize()
+{
+    for (int32_t i = 0; i < SHMEM_MAX_CTXS; i++) {
+        g_state.ctx_pools[i].valid = 0;
+    }
+    if (g_state.ctx_track_pool != 0) {
+        aclrtFree(reinterpret_cast<void *>(g_state.ctx_track_pool));
+        g_state.ctx_track_pool = 0;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_ctx_count(shmem_team_t team)
+{
+    int32_t count = 0;
+    for (int32_t i = 0; i < SHMEM_MAX_CTXS; i++) {
+        if (g_state.ctx_pools[i].valid && g_state.ctx_pools[i].team_idx == team) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void shmemi_ctx_destroy_team(shmem_team_t team)
+{
+    for (int32_t i = SHMEM_CTX_DEFAULT + 1; i < SHMEM_MAX_CTXS; i++) {
+        if (g_state.ctx_pools[i].valid && g_state.ctx_pools[i].team_idx == team) {
+            g_state.ctx_pools[i].valid = 0;
+        }
+    }
+}
+
+int shmem_team_create_ctx(shmem_team_t team, long options, shmem_ctx_t *ctx)
+{
+    if (ctx == nullptr) {
+        SHM_LOG_ERROR("output ctx is null.");
+        return SHMEM_INVALID_PARAM;
+    }
+    *ctx = SHMEM_CTX_INVALID;
+    if (!g_state.is_shmem_initialized || shmem_team_n_pes(team) <= 0) {
+        SHM_LOG_ERROR("create ctx failed, input team is invalid, team: " << team);
+        return SHMEM_INVALID_PARAM;
+    }
+
+    int32_t ctx_idx = SHMEM_CTX_INVALID;
+    for (int32_t i = SHMEM_CTX_DEFAULT + 1; i < SHMEM_MAX_CTXS; i++) {
+        if (!g_state.ctx_pools[i].valid) {
+            ctx_idx = i;
+            break;
+        }
+    }
+    if (ctx_idx == SHMEM_CTX_INVALID) {
+        SHM_LOG_ERROR("create ctx failed, ctx num is full!");
+        return SHMEM_INNER_ERROR;
+    }
+
+    // Each ctx gets its own UB slice, event and QP by default, see shmemx_ctx_set_ub_params to relocate the UB.
+    shmemi_mte_config_t mte_config = {ctx_idx * SHMEM_CTX_UB_SIZE, SHMEM_CTX_UB_SIZE, (uint32_t)ctx_idx};
+    g_state.ctx_pools[ctx_idx] = shmemi_ctx_t{1, team, (uint32_t)ctx_idx, mte_config};
+    if (update_device_state() != SHMEM_SUCCESS) {
+        g_state.ctx_pools[ctx_idx].valid = 0;
+        SHM_LOG_ERROR("create ctx failed, update state failed!");
+        return SHMEM_INNER_ERROR;
+    }
+    SHM_LOG_INFO("create ctx " << ctx_idx << " on team " << team << " options " << options);
+    *ctx = ctx_idx;
+    return SHMEM_SUCCESS;
+}
+
+int shmem_ctx_create(long options, shmem_ctx_t *ctx)
+{
+    return shmem_team_create_ctx(SHMEM_TEAM_WORLD, options, ctx);
+}
+
+void shmem_ctx_destroy(shmem_ctx_t ctx)
+{
+    if (ctx == SHMEM_CTX_DEFAULT || !is_valid_ctx(ctx)) {
+        SHM_LOG_WARN("input ctx is invalid!, ctx: " << ctx);
+        return;
+    }
+    g_state.ctx_pools[ctx].valid = 0;
+    if (update_device_state() != SHMEM_SUCCESS) {
+        SHM_LOG_WARN("update state failed when destroy ctx!");
+    }
+}
+
+int shmem_ctx_get_team(shmem_ctx_t ctx, shmem_team_t *team)
+{
+    if (team == nullptr) {
+        SHM_LOG_ERROR("output team is null.");
+        return SHMEM_INVALID_PARAM;
+    }
+    if (!is_valid_ctx(ctx)) {
+        *team = SHMEM_TEAM_INVALID;
+        return SHMEM_INVALID_PARAM;
+    }
+    *team = g_state.ctx_pools[ctx].team_idx;
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_ctx_set_ub_params(shmem_ctx_t ctx, uint64_t offset, uint32_t ub_size, uint32_t event_id)
+{
+    if (!is_valid_ctx(ctx)) {
+        SHM_LOG_ERROR("input ctx is invalid!, ctx: " << ctx);
+        return SHMEM_INVALID_PARAM;
+    }
+    g_state.ctx_pools[ctx].mte_config = shmemi_mte_config_t{offset, ub_size, event_id};
+    if (ctx == SHMEM_CTX_DEFAULT) {
+        g_state.mte_config = g_state.ctx_pools[ctx].mte_config;
+    }
+    SHMEM_CHECK_RET(update_device_state());
+    return SHMEM_SUCCESS;
+}
@@ -12,16 +12,56 @@
 #include <stdlib.h>
 #include <string.h>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <new>
+#include <iterator>
 
 #include "acl/acl.h"
 #include "shmemi_host_common.h"
 #include "shmemi_device_intf.h"
 using namespace std;
 
-uint64_t g_team_mask = 0;
-shmemi_team_t *g_shmem_team_pool = nullptr;
+static int32_t g_vec_core_num = SHMEM_MAX_AIV_PER_NPU;
+
+// Team slots come in chunks of SHMEM_TEAM_POOL_CHUNK, allocated once every slot before them is taken. A chunk never
+// moves, so the descriptors published in g_state.team_pools stay valid while the pool grows. Per-PE data stays out
+// of the descriptors, members in their own rows and hosts in g_state.pe_host, so a team update copies little.
+struct team_chunk {
+    shmemi_team_t teams[SHMEM_TEAM_POOL_CHUNK];
+    int32_t members[SHMEM_TEAM_POOL_CHUNK * SHMEM_MAX_RANKS];   // host copy of the device member rows
+    shmemi_team_t *device_teams;
+    int32_t *device_members;
+};
+static std::vector<team_chunk *> g_team_chunks;
+
+// Free slots of the allocated chunks, one bit per slot, plus one summary bit per word holding a free slot. The lowest
+// free slot is two bit scans away, and PEs creating the same teams in the same order agree on it.
+constexpr int32_t TEAM_SLOT_WORD_BITS = 64;
+static_assert(SHMEM_MAX_TEAMS <= TEAM_SLOT_WORD_BITS * TEAM_SLOT_WORD_BITS, "team slot bitmap is two levels deep");
+static uint64_t g_team_free_words[SHMEM_MAX_TEAMS / TEAM_SLOT_WORD_BITS] = {};
+static uint64_t g_team_free_summary = 0;
+
+// Symmetric, (color, key) of every parent member during shmemx_team_split.
+static int32_t *g_team_split_buf = nullptr;
+
+// Team scratch. shmem_malloc is collective over all PEs while a team only involves its members, so the scratches
+// are taken from an arena of the symmetric heap, one bit per granule handed out to the teams of the calling PE. The
+// arena is taken by the first scratch request, which has to come from a team of all PEs. Members of a team agree on
+// the lowest run of granules free on all of them, which puts the scratch at the same offset everywhere.
+constexpr int32_t SCRATCH_WORD_BITS = 64;
+struct team_scratch_info {
+    uint64_t target_size;   // bytes of the next allocation
+    uint64_t peak_request;
+    uint64_t requests;
+    uint64_t failures;
+    uint64_t allocations;
+};
+static uint8_t *g_scratch_arena = nullptr;
+static int32_t g_scratch_granules = 0;
+static std::vector<uint64_t> g_scratch_used;
+static team_scratch_info g_team_scratch[SHMEM_MAX_TEAMS];
 
 inline std::string team_config2string(shmemi_team_t *config)
 {
@@ -35,82 +75,456 @@ inline std::string team_config2string(shmemi_team_t *config)
     return oss.str();
 }
 
+inline int32_t team_slot_num()
+{
+    return static_cast<int32_t>(g_team_chunks.size()) * SHMEM_TEAM_POOL_CHUNK;
+}
+
+inline shmemi_team_t &team_host(int32_t team_idx)
+{
+    return g_team_chunks[team_idx / SHMEM_TEAM_POOL_CHUNK]->teams[team_idx % SHMEM_TEAM_POOL_CHUNK];
+}
+
+inline int32_t *team_host_members(int32_t team_idx)
+{
+    return g_team_chunks[team_idx / SHMEM_TEAM_POOL_CHUNK]->members +
+           (team_idx % SHMEM_TEAM_POOL_CHUNK) * SHMEM_MAX_RANKS;
+}
+
+inline int32_t *team_device_members(int32_t team_idx)
+{
+    return g_team_chunks[team_idx / SHMEM_TEAM_POOL_CHUNK]->device_members +
+           (team_idx % SHMEM_TEAM_POOL_CHUNK) * SHMEM_MAX_RANKS;
+}
+
+inline bool team_slot_in_use(int32_t team_idx)
+{
+    return team_idx >= 0 && team_idx < team_slot_num() &&
+           !(g_team_free_words[team_idx / TEAM_SLOT_WORD_BITS] >> (team_idx % TEAM_SLOT_WORD_BITS) & 1);
+}
+
+inline void team_slot_free(int32_t team_idx)
+{
+    int32_t word = team_idx / TEAM_SLOT_WORD_BITS;
+    g_team_free_words[word] |= 1ULL << (team_idx % TEAM_SLOT_WORD_BITS);
+    g_team_free_summary |= 1ULL << word;
+}
+
+inline void team_chunk_release(team_chunk *chunk)
+{
+    if (chunk->device_teams != nullptr) {
+        aclrtFree(chunk->device_teams);
+    }
+    if (chunk->device_members != nullptr) {
+        aclrtFree(chunk->device_members);
+    }
+    delete chunk;
+}
+
+// Add SHMEM_TEAM_POOL_CHUNK free slots, up to SHMEM_MAX_TEAMS slots in all.
+static int32_t team_pool_grow()
+{
+    if (team_slot_num() >= g_host_state.options.max_teams) {
+        SHM_LOG_ERROR("team pool is full, " << team_slot_num() << " teams, raise SHMEM_MAX_TEAMS for more.");
+        return SHMEM_INNER_ERROR;
+    }
+    team_chunk *chunk = new (std::nothrow) team_chunk();
+    if (chunk == nullptr) {
+        SHM_LOG_ERROR("malloc host team pool chunk failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    auto ret = aclrtMalloc((void **)&chunk->device_teams, SHMEM_TEAM_POOL_CHUNK * sizeof(shmemi_team_t),
+                           ACL_MEM_MALLOC_HUGE_FIRST);
+    if (ret == 0) {
+        ret = aclrtMalloc((void **)&chunk->device_members, SHMEM_TEAM_MEMBER_CHUNK_SIZE, ACL_MEM_MALLOC_HUGE_FIRST);
+    }
+    if (ret != 0) {
+        team_chunk_release(chunk);
+        SHM_LOG_ERROR("malloc device team pool chunk failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    for (int32_t i = 0; i < SHMEM_TEAM_POOL_CHUNK; i++) {
+        chunk->teams[i] = shmemi_team_t{-1, -1, -1, -1, -1};
+    }
+
+    int32_t first = team_slot_num();
+    g_team_chunks.push_back(chunk);
+    for (int32_t i = 0; i < SHMEM_TEAM_POOL_CHUNK; i++) {
+        team_slot_free(first + i);
+    }
+    return SHMEM_SUCCESS;
+}
+
+// Take the lowest free slot, growing the pool when it is full, -1 if it can not grow.
+static int32_t team_slot_alloc()
+{
+    if (g_team_free_summary == 0 && team_pool_grow() != SHMEM_SUCCESS) {
+        return -1;
+    }
+    int32_t word = __builtin_ctzll(g_team_free_summary);
+    int32_t bit = __builtin_ctzll(g_team_free_words[word]);
+    g_team_free_words[word] &= ~(1ULL << bit);
+    if (g_team_free_words[word] == 0) {
+        g_team_free_summary &= ~(1ULL << word);
+    }
+    return word * TEAM_SLOT_WORD_BITS + bit;
+}
+
 inline bool is_valid_team(shmem_team_t &team)
 {
-    return (g_state.is_shmem_initialized && g_shmem_team_pool != nullptr && team >= 0 && team < SHMEM_MAX_TEAMS &&
-            (g_team_mask >> team & 1));
+    return g_state.is_shmem_initialized && team_slot_in_use(team);
+}
+
+inline bool scratch_granule_used(int32_t granule)
+{
+    return g_scratch_used[granule / SCRATCH_WORD_BITS] >> (granule % SCRATCH_WORD_BITS) & 1;
+}
+
+inline void scratch_granules_mark(int32_t first, int32_t num, bool used)
+{
+    for (int32_t g = first; g < first + num; g++) {
+        uint64_t bit = 1ULL << (g % SCRATCH_WORD_BITS);
+        g_scratch_used[g / SCRATCH_WORD_BITS] = used ? (g_scratch_used[g / SCRATCH_WORD_BITS] | bit) :
+                                                       (g_scratch_used[g / SCRATCH_WORD_BITS] & ~bit);
+    }
+}
+
+// lowest first >= from with granules [first, first + num) free on the calling PE, -1 if there is none
+static int32_t scratch_fit(int32_t from, int32_t num)
+{
+    int32_t run = 0;
+    for (int32_t g = from; g < g_scratch_granules; g++) {
+        run = scratch_granule_used(g) ? 0 : run + 1;
+        if (run == num) {
+            return g - num + 1;
+        }
+    }
+    return -1;
+}
+
+inline uint64_t scratch_arena_used()
+{
+    uint64_t granules = 0;
+    for (uint64_t word : g_scratch_used) {
+        granules += __builtin_popcountll(word);
+    }
+    return granules * SHMEM_TEAM_SCRATCH_GRANULE;
+}
+
+inline uint8_t *team_epoch_row(int32_t team_idx)
+{
+    return reinterpret_cast<uint8_t *>(g_state.team_epoch_pool) + team_idx * SHMEM_TEAM_EPOCH_ROW_SIZE;
+}
+
+// A new team holds no scratch yet and starts its epochs from 0.
+inline int32_t team_scratch_reset(int32_t team_idx)
+{
+    g_team_scratch[team_idx] = team_scratch_info{g_host_state.options.team_scratch_size, 0, 0, 0, 0};
+    auto ret = aclrtMemset(team_epoch_row(team_idx), SHMEM_TEAM_EPOCH_ROW_SIZE, 0, SHMEM_TEAM_EPOCH_ROW_SIZE);
+    if (ret != 0) {
+        SHM_LOG_ERROR("memset team epoch failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+// Give the granules back to the arena of the calling PE, the device descriptor is left to the caller.
+inline void team_scratch_release(int32_t team_idx)
+{
+    shmemi_team_t &team = team_host(team_idx);
+    if (team.scratch != 0) {
+        int32_t first = static_cast<int32_t>((reinterpret_cast<uint8_t *>(team.scratch) - g_scratch_arena) /
+                                             SHMEM_TEAM_SCRATCH_GRANULE);
+        scratch_granules_mark(first, static_cast<int32_t>(team.scratch_size / SHMEM_TEAM_SCRATCH_GRANULE), false);
+    }
+    team.scratch = 0;
+    team.scratch_size = 0;
 }
 
 inline void device_team_destroy(int32_t team_idx)
 {
-    // device_ptr Free
-    shmemi_team_t *device_team_ptr = g_state.team_pools[team_idx];
-    if (device_team_ptr != nullptr) {
-        if (aclrtFree((void *)device_team_ptr) != ACL_SUCCESS) {
-            SHM_LOG_ERROR("aclrtFree for device_team_ptr failed for team " << team_idx);
+    // the descriptor slot stays in its chunk for the next team
+    g_state.team_pools[team_idx] = nullptr;
+}
+
+// team view pe to global view pe, the host counterpart of shmemi_team_global_pe
+inline int32_t team_global_pe(const shmemi_team_t *team, int32_t pe)
+{
+    if (team->stride > 0) {
+        return team->start + pe * team->stride;
+    }
+    return team_host_members(team->team_idx)[pe];
+}
+
+// global view pe to team view pe, -1 if global_pe is not a member
+inline int32_t team_pe(const shmemi_team_t *team, int32_t global_pe)
+{
+    if (team->stride > 0) {
+        int32_t n = (global_pe - team->start) / team->stride;
+        if (global_pe < team->start || (global_pe - team->start) % team->stride || n >= team->size) {
+            return -1;
+        }
+        return n;
+    }
+    const int32_t *members = team_host_members(team->team_idx);
+    const int32_t *found = std::find(members, members + team->size, global_pe);
+    return found == members + team->size ? -1 : static_cast<int32_t>(found - members);
+}
+
+/* Group the team members by host for the hierarchical barrier. The leader of a host is its first member in team
+   order, and hosts are ordered by their leaders. */
+inline void team_hierarchy_build(shmemi_team_t *team)
+{
+    team->local_size = 0;
+    team->local_rank = 0;
+    team->host_num = 0;
+    team->host_rank = 0;
+    if (g_host_state.pe_info == nullptr) {
+        return;
+    }
+
+    // hosts in ascending g_state.pe_host, the device finds the host of a member by a binary search in host_ids
+    int32_t global_pe = team_global_pe(team, team->mype);
+    int16_t my_host = g_state.pe_host[global_pe];
+    std::vector<int16_t> hosts;
+    for (int32_t i = 0; i < team->size; i++) {
+        int32_t pe = team_global_pe(team, i);
+        int16_t host = g_state.pe_host[pe];
+        if (host == my_host) {
+            if (team->local_size == SHMEM_MAX_LOCAL_RANKS) {
+                SHM_LOG_WARN("team " << team->team_idx << " has more than " << SHMEM_MAX_LOCAL_RANKS
+                                     << " members on one host, hierarchical barrier disabled.");
+                return;
+            }
+            if (pe == global_pe) {
+                team->local_rank = team->local_size;
+            }
+            team->local_pes[team->local_size++] = pe;
+        }
+        hosts.push_back(host);
+    }
+    std::sort(hosts.begin(), hosts.end());
+    hosts.erase(std::unique(hosts.begin(), hosts.end()), hosts.end());
+    if (hosts.size() > SHMEM_MAX_HOSTS) {
+        SHM_LOG_WARN("team " << team->team_idx << " spans more than " << SHMEM_MAX_HOSTS
+                             << " hosts, hierarchical barrier disabled.");
+        return;
+    }
+
+    // the leader of a host is its first member in team order
+    std::vector<bool> led(hosts.size(), false);
+    for (int32_t i = 0; i < team->size; i++) {
+        int32_t pe = team_global_pe(team, i);
+        size_t h = std::lower_bound(hosts.begin(), hosts.end(), g_state.pe_host[pe]) - hosts.begin();
+        if (!led[h]) {
+            team->leader_pes[h] = pe;
+            led[h] = true;
         }
-        g_state.team_pools[team_idx] = nullptr;
     }
+    for (size_t h = 0; h < hosts.size(); h++) {
+        team->host_ids[h] = hosts[h];
+    }
+    team->host_rank = static_cast<int>(std::lower_bound(hosts.begin(), hosts.end(), my_host) - hosts.begin());
+    team->host_num = static_cast<int>(hosts.size());
+}
+
+/* Barrier algorithm for SHMEMX_BARRIER_AUTO. Teams spanning hosts need the hierarchical barrier. Within a host the
+   centralized barrier wins while every vector core pulls only a few peers, group dissemination wins beyond, and the
+   plain dissemination barrier is left for devices that can not run k >= 2 vector cores. Without a host grouping the
+   team may still span hosts, and only the plain dissemination barrier signals peers over RoCE. */
+inline int team_barrier_algo_select(const shmemi_team_t *team)
+{
+    if (team->host_num > 1) {
+        return SHMEMX_BARRIER_HIER;
+    }
+    if (team->host_num == 0) {
+        return SHMEMX_BARRIER_DISSEM;
+    }
+    int32_t k = std::min({SHMEM_BARRIER_TG_DISSEM_KVAL, g_vec_core_num, team->size});
+    if (k < 2) {
+        return SHMEMX_BARRIER_DISSEM;
+    }
+    if (team->size <= k * SHMEM_BARRIER_CENTRAL_MAX_LOADS) {
+        return SHMEMX_BARRIER_CENTRAL;
+    }
+    return SHMEMX_BARRIER_GROUP_DISSEM;
+}
+
+/* The hierarchical barrier needs the host grouping of the team, the plain dissemination barrier spans any team. The
+   other barriers load flags over MTE and are confined to one host. */
+inline bool team_barrier_algo_supported(const shmemi_team_t *team, int algo)
+{
+    if (algo == SHMEMX_BARRIER_HIER) {
+        return team->host_num > 0;
+    }
+    if (algo == SHMEMX_BARRIER_DISSEM) {
+        return true;
+    }
+    return team->host_num == 1;
+}
+
+inline void team_barrier_algo_init(shmemi_team_t *team)
+{
+    int algo = g_host_state.options.barrier_algo;
+    if (algo != SHMEMX_BARRIER_AUTO && !team_barrier_algo_supported(team, algo)) {
+        SHM_LOG_WARN("SHMEM_BARRIER_ALGO " << algo << " can not span team " << team_config2string(team)
+                                           << ", select automatically.");
+        algo = SHMEMX_BARRIER_AUTO;
+    }
+    team->barrier_algo = (algo == SHMEMX_BARRIER_AUTO) ? team_barrier_algo_select(team) : algo;
+}
+
+// Copy the host descriptor of a published team over its device one.
+inline int32_t device_team_sync(int32_t team_idx)
+{
+    auto ret = aclrtMemcpy(g_state.team_pools[team_idx], sizeof(shmemi_team_t), &team_host(team_idx),
+                           sizeof(shmemi_team_t), ACL_MEMCPY_HOST_TO_DEVICE);
+    if (ret != 0) {
+        SHM_LOG_ERROR("memcpy device team info failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
 }
 
 inline int32_t device_team_update(int team_idx, shmemi_team_t *host_team_ptr)
 {
-    // device_ptr Malloc
-    void *team_ptr = nullptr;
-    SHMEM_CHECK_RET(aclrtMalloc(&team_ptr, sizeof(shmemi_team_t), ACL_MEM_MALLOC_NORMAL_ONLY));
-    auto ret = aclrtMemcpy((shmemi_team_t *)team_ptr, sizeof(shmemi_team_t), host_team_ptr, sizeof(shmemi_team_t),
+    shmemi_team_t *team_ptr = g_team_chunks[team_idx / SHMEM_TEAM_POOL_CHUNK]->device_teams +
+                              team_idx % SHMEM_TEAM_POOL_CHUNK;
+    auto ret = aclrtMemcpy(team_ptr, sizeof(shmemi_team_t), host_team_ptr, sizeof(shmemi_team_t),
                            ACL_MEMCPY_HOST_TO_DEVICE);
     if (ret != 0) {
         SHM_LOG_ERROR("memcpy device team info failed, ret: " << ret);
-        aclrtFree(team_ptr);
         return SHMEM_INNER_ERROR;
     }
-    g_state.team_pools[team_idx] = (shmemi_team_t *)team_ptr;
+    if (host_team_ptr->stride == 0) {
+        size_t members_size = host_team_ptr->size * sizeof(int32_t);
+        ret = aclrtMemcpy(team_device_members(team_idx), members_size, team_host_members(team_idx), members_size,
+                          ACL_MEMCPY_HOST_TO_DEVICE);
+        if (ret != 0) {
+            SHM_LOG_ERROR("memcpy device team members failed, ret: " << ret);
+            return SHMEM_INNER_ERROR;
+        }
+    }
+    g_state.team_pools[team_idx] = team_ptr;
     return SHMEM_SUCCESS;
 }
 
-int32_t shmemi_team_init(int32_t rank, int32_t size)
+// Drop a team without updating the device state, callers update it once for a batch of teams.
+inline void team_release(shmem_team_t team)
+{
+    team_scratch_release(team);
+    shmemi_ctx_destroy_team(team);
+    device_team_destroy(team);
+    team_slot_free(team);
+}
+
+/* Take a free slot for a team seen from mype and fill its device descriptor, members lists the global PEs of a team
+   with stride 0. The device state is not updated, so that a batch of teams costs one update. */
+inline int32_t team_create(shmemi_team_t &my_team, const int32_t *members)
 {
-    /* Initialize SHMEM_TEAM_WORLD */
-    g_shmem_team_pool = (shmemi_team_t *)calloc(SHMEM_MAX_TEAMS, sizeof(shmemi_team_t));
-    if (g_shmem_team_pool == nullptr) {
-        SHM_LOG_ERROR("malloc host shmem team pool failed.");
+    my_team.team_idx = team_slot_alloc();
+    if (my_team.team_idx == -1) {
+        SHM_LOG_ERROR("create team failed, team num is full!");
         return SHMEM_INNER_ERROR;
     }
-    for (int i = 0; i < SHMEM_MAX_TEAMS; i++) {
-        g_shmem_team_pool[i] = shmemi_team_t{-1, -1, -1, -1, -1};
+    my_team.members = 0;
+    if (my_team.stride == 0) {
+        std::copy(members, members + my_team.size, team_host_members(my_team.team_idx));
+        my_team.members = reinterpret_cast<uint64_t>(team_device_members(my_team.team_idx));
+    }
+
+    team_hierarchy_build(&my_team);
+    team_barrier_algo_init(&my_team);
+    shmemi_coll_tune_team(&my_team);
+    my_team.scratch = 0;
+    my_team.scratch_size = 0;
+    team_host(my_team.team_idx) = my_team;
+    if (team_scratch_reset(my_team.team_idx) != 0 ||
+        device_team_update(my_team.team_idx, &team_host(my_team.team_idx)) != 0) {
+        team_release(my_team.team_idx);
+        SHM_LOG_ERROR("create team failed, update device team failed!");
+        return SHMEM_INNER_ERROR;
+    }
+    return SHMEM_SUCCESS;
+}
+
+int32_t shmemi_team_init(int32_t rank, int32_t size)
+{
+    /* Initialize SHMEM_TEAM_WORLD, the first slot of the first pool chunk */
+    if (team_slot_alloc() != SHMEM_TEAM_WORLD) {
+        shmemi_team_finalize();
+        SHM_LOG_ERROR("malloc team pool failed.");
+        return SHMEM_INNER_ERROR;
     }
 
-    shmemi_team_t &shmem_team_world = g_shmem_team_pool[SHMEM_TEAM_WORLD];
+    shmemi_team_t &shmem_team_world = team_host(SHMEM_TEAM_WORLD);
     shmem_team_world.team_idx = SHMEM_TEAM_WORLD;
     shmem_team_world.start = 0;
     shmem_team_world.stride = 1;
     shmem_team_world.size = size;
     shmem_team_world.mype = rank;
-    g_team_mask |= 1ULL << SHMEM_TEAM_WORLD;
+    shmem_team_world.members = 0;
+    shmem_team_world.scratch = 0;
+    shmem_team_world.scratch_size = 0;
+
+    // C220 has two vector cores per AI core
+    int32_t device_id = 0;
+    int64_t aicore_num = 0;
+    if (aclrtGetDevice(&device_id) == ACL_SUCCESS &&
+        aclrtGetDeviceInfo(device_id, ACL_DEV_ATTR_AICORE_CORE_NUM, &aicore_num) == ACL_SUCCESS && aicore_num > 0) {
+        g_vec_core_num = static_cast<int32_t>(aicore_num * 2);
+    }
+    team_hierarchy_build(&shmem_team_world);
+    team_barrier_algo_init(&shmem_team_world);
+    shmemi_coll_tune_team(&shmem_team_world);
     SHMEM_CHECK_RET(device_team_update(SHMEM_TEAM_WORLD, &shmem_team_world));
 
-    /* Initialize TEAM SYNC */
-    g_state.sync_pool = (uint64_t)shmem_malloc(SYNC_POOL_SIZE);
+    /* Initialize TEAM SPLIT exchange buffer */
+    g_team_split_buf = (int32_t *)shmem_malloc(2 * size * sizeof(int32_t));
+    if (g_team_split_buf == nullptr) {
+        shmemi_team_finalize();
+        SHM_LOG_ERROR("malloc team split buffer failed.");
+        return SHMEM_INNER_ERROR;
+    }
+
+    /* Initialize TEAM SCRATCH. The arena is taken from the heap by the first scratch request, the epochs of every
+       slot are local and reset when a team takes the slot. */
+    size_t epoch_pool_size = SHMEM_TEAM_EPOCH_POOL_SIZE(g_host_state.options.max_teams);
+    auto ret = aclrtMalloc((void **)&(g_state.team_epoch_pool), epoch_pool_size, ACL_MEM_MALLOC_HUGE_FIRST);
+    if (ret != 0 || g_state.team_epoch_pool == 0) {
+        shmemi_team_finalize();
+        SHM_LOG_ERROR("malloc team epoch pool failed.");
+        return SHMEM_INNER_ERROR;
+    }
+    if (team_scratch_reset(SHMEM_TEAM_WORLD) != 0) {
+        shmemi_team_finalize();
+        return SHMEM_INNER_ERROR;
+    }
+
+    /* Initialize TEAM SYNC. Sync arrays are symmetric and shmem_malloc is collective over all PEs, while teams are
+       created by the members of their parent only, so the arrays of every slot the pool may grow to are taken here. */
+    size_t sync_pool_size = SYNC_POOL_SIZE(g_host_state.options.max_teams);
+    size_t sync_counters_size = SYNC_COUNTERS_SIZE(g_host_state.options.max_teams);
+    g_state.sync_pool = (uint64_t)shmem_malloc(sync_pool_size);
     if (g_state.sync_pool == 0) {
         shmemi_team_finalize();
         SHM_LOG_ERROR("malloc sync pool failed.");
         return SHMEM_INNER_ERROR;
     }
-    auto ret = aclrtMemset((void *)g_state.sync_pool, SYNC_POOL_SIZE, 0, SYNC_POOL_SIZE);
+    ret = aclrtMemset((void *)g_state.sync_pool, sync_pool_size, 0, sync_pool_size);
     if (ret != 0) {
         shmemi_team_finalize();
         SHM_LOG_ERROR("memset sync pool failed.");
         return SHMEM_INNER_ERROR;
     }
 
-    ret = aclrtMalloc((void **)&(g_state.sync_counter), SYNC_COUNTERS_SIZE, ACL_MEM_MALLOC_HUGE_FIRST);
+    ret = aclrtMalloc((void **)&(g_state.sync_counter), sync_counters_size, ACL_MEM_MALLOC_HUGE_FIRST);
     if (ret != 0 || g_state.sync_counter == 0) {
         shmemi_team_finalize();
         SHM_LOG_ERROR("malloc sync counter failed.");
         return SHMEM_INNER_ERROR;
     }
-    ret = aclrtMemset((void *)g_state.sync_counter, SYNC_COUNTERS_SIZE, 0, SYNC_COUNTERS_SIZE);
+    ret = aclrtMemset((void *)g_state.sync_counter, sync_counters_size, 0, sync_counters_size);
     if (ret != 0) {
         shmemi_team_finalize();
         SHM_LOG_ERROR("memset sync counter failed.");
@@ -145,23 +559,11 @@ int32_t shmemi_team_init(int32_t rank, int32_t size)
     return 0;
 }
 
-int32_t first_free_idx_fetch()
-{
-    int32_t shmem_max_teams = SHMEM_MAX_TEAMS;
-    for (int32_t i = 0; i < shmem_max_teams; i++) {
-        if (!((g_team_mask >> i) & 1)) {
-            g_team_mask |= 1ULL << i;
-            return i;
-        }
-    }
-    return -1;
-}
-
 int32_t shmemi_team_finalize()
 {
     /* Destroy all undestroyed teams */
-    int32_t shmem_max_teams = SHMEM_MAX_TEAMS;
-    for (int32_t i = 0; i < shmem_max_teams; i++) {
+    int32_t team_num = team_slot_num();
+    for (int32_t i = 0; i < team_num; i++) {
         if (is_valid_team(i)) {
             shmem_team_destroy(i);
         }
@@ -183,15 +585,33 @@ int32_t shmemi_team_finalize()
         aclrtFree(reinterpret_cast<void *>(g_state.core_sync_pool));
         g_state.core_sync_pool = 0;
     }
-    if (g_shmem_team_pool != nullptr) {
-        free(g_shmem_team_pool);
-        g_shmem_team_pool = nullptr;
+    if (g_team_split_buf != nullptr) {
+        shmem_free(g_team_split_buf);
+        g_team_split_buf = nullptr;
     }
+    if (g_state.team_epoch_pool != 0) {
+        aclrtFree(reinterpret_cast<void *>(g_state.team_epoch_pool));
+        g_state.team_epoch_pool = 0;
+    }
+    if (g_scratch_arena != nullptr) {
+        shmem_free(g_scratch_arena);
+        g_scratch_arena = nullptr;
+    }
+    g_scratch_granules = 0;
+    g_scratch_used.clear();
+    for (team_chunk *chunk : g_team_chunks) {
+        team_chunk_release(chunk);
+    }
+    g_team_chunks.clear();
+    std::fill(std::begin(g_team_free_words), std::end(g_team_free_words), 0);
+    g_team_free_summary = 0;
     return 0;
 }
 
-int32_t shmem_team_split_strided(shmem_team_t parent_team, int32_t pe_start, int32_t pe_stride, int32_t pe_size,
-                                 shmem_team_t *new_team)
+/* Create the team seen from mype without updating the device state. A strided parent gives a strided team, any
+   other parent lists the members of the new team in the member table. */
+static int32_t team_split_strided(shmem_team_t parent_team, int32_t pe_start, int32_t pe_stride, int32_t pe_size,
+                                  shmem_team_t *new_team)
 {
     if (new_team == nullptr) {
         SHM_LOG_ERROR("output team is null.");
@@ -204,64 +624,63 @@ int32_t shmem_team_split_strided(shmem_team_t parent_team, int32_t pe_start, int
         return SHMEM_INVALID_PARAM;
     }
 
-    shmemi_team_t my_team;
-    shmemi_team_t *src_team = &g_shmem_team_pool[parent_team];
+    shmemi_team_t *src_team = &team_host(parent_team);
 
-    if (pe_start >= SHMEM_MAX_RANKS || pe_stride >= SHMEM_MAX_RANKS || pe_size > SHMEM_MAX_RANKS) {
+    if (pe_start < 0 || pe_start >= src_team->size || pe_size <= 0 || pe_size > src_team->size || pe_stride < 1 ||
+        pe_stride >= SHMEM_MAX_RANKS) {
         SHM_LOG_ERROR("create team failed, input invalid, pe_start:" << pe_start << " pe_size:" << pe_size
                                                                      << " pe_stride:" << pe_stride << " parent:"
                                                                      << team_config2string(src_team));
         return SHMEM_INVALID_PARAM;
     }
 
-    int32_t global_pe = src_team->mype;
-    int32_t global_pe_start = src_team->start + pe_start * src_team->stride;
-    int32_t global_pe_stride = src_team->stride * pe_stride;
-    int32_t global_pe_end = global_pe_start + global_pe_stride * (pe_size - 1);
-
-    if (pe_start < 0 || pe_start >= src_team->size || pe_size <= 0 || pe_size > src_team->size || pe_stride < 1) {
-        SHM_LOG_ERROR("create team failed, input invalid, pe_start:" << pe_start << " pe_size:" << pe_size
-                                                                     << " pe_stride:" << pe_stride << " parent:"
-                                                                     << team_config2string(src_team));
-        return SHMEM_INVALID_PARAM;
-    }
-
-    if (global_pe_start >= shmem_n_pes() || global_pe_end >= shmem_n_pes()) {
-        SHM_LOG_ERROR("create team failed, large than world size, pe_start:"
+    if (pe_start + static_cast<int64_t>(pe_stride) * (pe_size - 1) >= src_team->size) {
+        SHM_LOG_ERROR("create team failed, large than parent size, pe_start:"
                       << pe_start << " pe_size:" << pe_size << " pe_stride:" << pe_stride
-                      << " world_size:" << shmem_n_pes() << " parent:" << team_config2string(src_team));
+                      << " parent:" << team_config2string(src_team));
         return SHMEM_INVALID_PARAM;
     }
 
-    my_team.mype = (global_pe - global_pe_start) / global_pe_stride;
-
-    if (global_pe < global_pe_start || (global_pe - global_pe_start) % global_pe_stride || my_team.mype >= pe_size) {
+    // membership is decided in the parent view
+    int32_t parent_pe = src_team->mype;
+    int32_t n = (parent_pe - pe_start) / pe_stride;
+    if (parent_pe < pe_start || (parent_pe - pe_start) % pe_stride || n >= pe_size) {
         SHM_LOG_INFO("This PE is not a member of the new team.");
         return 0;
     }
 
-    my_team.start = global_pe_start;
-    my_team.stride = global_pe_stride;
+    shmemi_team_t my_team = {};
+    my_team.mype = n;
     my_team.size = pe_size;
-
-    my_team.team_idx = first_free_idx_fetch();
-    if (my_team.team_idx == -1) {
-        SHM_LOG_ERROR("create team failed, team num is full!");
-        return SHMEM_INNER_ERROR;
+    my_team.start = team_global_pe(src_team, pe_start);
+    std::vector<int32_t> members;
+    if (src_team->stride > 0) {
+        my_team.stride = src_team->stride * pe_stride;
+    } else {
+        my_team.stride = 0;
+        for (int32_t i = 0; i < pe_size; i++) {
+            members.push_back(team_global_pe(src_team, pe_start + i * pe_stride));
+        }
     }
 
-    g_shmem_team_pool[my_team.team_idx] = my_team;
-    if (device_team_update(my_team.team_idx, &g_shmem_team_pool[my_team.team_idx]) != 0) {
-        shmem_team_destroy(my_team.team_idx);
-        SHM_LOG_ERROR("create team failed, malloc device state failed!");
-        return SHMEM_INNER_ERROR;
+    SHMEM_CHECK_RET(team_create(my_team, members.data()));
+    *new_team = my_team.team_idx;
+    return 0;
+}
+
+int32_t shmem_team_split_strided(shmem_team_t parent_team, int32_t pe_start, int32_t pe_stride, int32_t pe_size,
+                                 shmem_team_t *new_team)
+{
+    SHMEM_CHECK_RET(team_split_strided(parent_team, pe_start, pe_stride, pe_size, new_team));
+    if (*new_team == SHMEM_TEAM_INVALID) {
+        return 0;
     }
     if (update_device_state() != 0) {
-        shmem_team_destroy(my_team.team_idx);
+        shmem_team_destroy(*new_team);
+        *new_team = SHMEM_TEAM_INVALID;
         SHM_LOG_ERROR("create team failed, update state failed!");
         return SHMEM_INNER_ERROR;
     }
-    *new_team = my_team.team_idx;
     return 0;
 }
 
@@ -284,10 +703,8 @@ int shmem_team_split_2d(shmem_team_t parent_team, int x_range, shmem_team_t *x_t
         return SHMEM_INVALID_PARAM;
     }
 
-    shmemi_team_t *src_team = &g_shmem_team_pool[parent_team];
+    shmemi_team_t *src_team = &team_host(parent_team);
 
-    int32_t src_start = src_team->start;
-    int32_t src_stride = src_team->stride;
     int32_t src_size = src_team->size;
     int32_t x_team_counts = std::ceil(src_size / float(x_range));
     int32_t y_team_counts = x_range;
@@ -299,10 +716,11 @@ int shmem_team_split_2d(shmem_team_t parent_team, int x_range, shmem_team_t *x_t
     int start = 0;
     int errorCode = 0;
 
+    // each PE joins one x-axis and one y-axis team, both are published with a single state update
     for (int i = 0; i < x_team_counts; ++i) {
         shmem_team_t my_xteam;
         int x_size = (i == x_team_counts - 1 && src_size % x_range) ? src_size % x_range : x_range;
-        errorCode = shmem_team_split_strided(parent_team, start, 1, x_size, &my_xteam);
+        errorCode = team_split_strided(parent_team, start, 1, x_size, &my_xteam);
         if (errorCode != 0) {
             SHM_LOG_WARN("create x-axis team " << (i + 1) << " of " << x_team_counts << " failed");
         }
@@ -326,7 +744,7 @@ int shmem_team_split_2d(shmem_team_t parent_team, int x_range, shmem_team_t *x_t
         int y_range = src_size / x_range;
         int y_size = (remainder && i < remainder) ? y_range + 1 : y_range;
 
-        errorCode = shmem_team_split_strided(parent_team, start, x_range, y_size, &my_yteam);
+        errorCode = team_split_strided(parent_team, start, x_range, y_size, &my_yteam);
         if (errorCode != 0) {
             SHM_LOG_WARN("create y-axis team " << (i + 1) << " of " << y_team_counts << " failed");
         }
@@ -341,33 +759,106 @@ int shmem_team_split_2d(shmem_team_t parent_team, int x_range, shmem_team_t *x_t
             }
         }
     }
+
+    if (update_device_state() != 0) {
+        for (shmem_team_t *team : {x_team, y_team}) {
+            if (*team != SHMEM_TEAM_INVALID) {
+                team_release(*team);
+                *team = SHMEM_TEAM_INVALID;
+            }
+        }
+        SHM_LOG_ERROR("create 2d teams failed, update state failed!");
+        return SHMEM_INNER_ERROR;
+    }
     return 0;
 }
 
-int32_t shmem_team_translate_pe(shmem_team_t src_team, int32_t src_pe, shmem_team_t dest_team)
+int shmemx_team_split(shmem_team_t parent_team, int color, int key, shmem_team_t *new_team)
 {
-    if (!is_valid_team(src_team) || !is_valid_team(dest_team)) {
-        return -1;
+    if (new_team == nullptr) {
+        SHM_LOG_ERROR("output team is null.");
+        return SHMEM_INVALID_PARAM;
+    }
+
+    *new_team = SHMEM_TEAM_INVALID;
+    if (!is_valid_team(parent_team)) {
+        SHM_LOG_ERROR("input parent team is invalid!, team: " << parent_team);
+        return SHMEM_INVALID_PARAM;
+    }
+
+    // the exchange kernel ends with a barrier on the parent, every slot has landed once it completes
+    shmemi_team_t *src_team = &team_host(parent_team);
+    size_t info_size = 2 * src_team->size * sizeof(int32_t);
+    std::vector<int32_t> infos(2 * src_team->size);
+    SHMEM_CHECK_RET(shmemi_team_exchange_on_stream(parent_team, g_team_split_buf, color, key, nullptr));
+    SHMEM_CHECK_RET(aclrtSynchronizeStream(nullptr));
+    SHMEM_CHECK_RET(aclrtMemcpy(infos.data(), info_size, g_team_split_buf, info_size, ACL_MEMCPY_DEVICE_TO_HOST));
+
+    // no member may start the next split and overwrite the slots before all of them are read
+    SHMEM_CHECK_RET(shmemi_barrier_on_stream(parent_team, nullptr));
+    SHMEM_CHECK_RET(aclrtSynchronizeStream(nullptr));
+
+    if (color < 0) {
+        SHM_LOG_INFO("This PE is not a member of any new team.");
+        return 0;
+    }
+
+    // members are ordered by key, ties keep the parent order
+    std::vector<int32_t> parent_pes;
+    for (int32_t i = 0; i < src_team->size; i++) {
+        if (infos[2 * i] == color) {
+            parent_pes.push_back(i);
+        }
+    }
+    std::stable_sort(parent_pes.begin(), parent_pes.end(),
+                     [&infos](int32_t a, int32_t b) { return infos[2 * a + 1] < infos[2 * b + 1]; });
+
+    shmemi_team_t my_team = {};
+    my_team.size = static_cast<int32_t>(parent_pes.size());
+    std::vector<int32_t> members(my_team.size);
+    for (int32_t i = 0; i < my_team.size; i++) {
+        members[i] = team_global_pe(src_team, parent_pes[i]);
+        if (parent_pes[i] == src_team->mype) {
+            my_team.mype = i;
+        }
     }
 
-    shmemi_team_t *src_team_ptr = &g_shmem_team_pool[src_team];
-    shmemi_team_t *dest_team_ptr = &g_shmem_team_pool[dest_team];
+    // keep the member table for teams that are not strided
+    my_team.start = members[0];
+    my_team.stride = my_team.size > 1 ? members[1] - members[0] : 1;
+    for (int32_t i = 1; i < my_team.size && my_team.stride > 0; i++) {
+        if (members[i] - members[i - 1] != my_team.stride) {
+            my_team.stride = 0;
+        }
+    }
+    if (my_team.stride < 0) {
+        my_team.stride = 0;
+    }
+
+    SHMEM_CHECK_RET(team_create(my_team, members.data()));
+    if (update_device_state() != 0) {
+        shmem_team_destroy(my_team.team_idx);
+        SHM_LOG_ERROR("create team failed, update state failed!");
+        return SHMEM_INNER_ERROR;
+    }
+    *new_team = my_team.team_idx;
+    return 0;
+}
 
-    if (src_pe > src_team_ptr->size) {
+int32_t shmem_team_translate_pe(shmem_team_t src_team, int32_t src_pe, shmem_team_t dest_team)
+{
+    if (!is_valid_team(src_team) || !is_valid_team(dest_team)) {
         return -1;
     }
 
-    int32_t global_pe = src_team_ptr->start + src_pe * src_team_ptr->stride;
-    int32_t pe_start = dest_team_ptr->start;
-    int32_t pe_stride = dest_team_ptr->stride;
-    int32_t pe_size = dest_team_ptr->size;
+    shmemi_team_t *src_team_ptr = &team_host(src_team);
+    shmemi_team_t *dest_team_ptr = &team_host(dest_team);
 
-    int32_t n = (global_pe - pe_start) / pe_stride;
-    if (global_pe < pe_start || (global_pe - pe_start) % pe_stride || n >= pe_size) {
+    if (src_pe < 0 || src_pe >= src_team_ptr->size) {
         return -1;
     }
 
-    return n;
+    return team_pe(dest_team_ptr, team_global_pe(src_team_ptr, src_pe));
 }
 
 void shmem_team_destroy(shmem_team_t team)
@@ -377,8 +868,7 @@ void shmem_team_destroy(shmem_team_t team)
         return;
     }
 
-    device_team_destroy(team);
-    g_team_mask ^= 1ULL << team;
+    team_release(team);
     if (update_device_state() != SHMEM_SUCCESS) {
         SHM_LOG_WARN("update state failed when destroy team!");
     }
@@ -397,7 +887,7 @@ int32_t shmem_n_pes()
 int32_t shmem_team_my_pe(shmem_team_t team)
 {
     if (is_valid_team(team)) {
-        return g_shmem_team_pool[team].mype;
+        return team_host(team).mype;
     } else {
         return -1;
     }
@@ -406,7 +896,7 @@ int32_t shmem_team_my_pe(shmem_team_t team)
 int32_t shmem_team_n_pes(shmem_team_t team)
 {
     if (is_valid_team(team)) {
-        return g_shmem_team_pool[team].size;
+        return team_host(team).size;
     } else {
         return -1;
     }
@@ -416,9 +906,277 @@ int shmem_team_get_config(shmem_team_t team, shmem_team_config_t *config)
 {
     SHMEM_CHECK_RET(config == nullptr);
     if (is_valid_team(team)) {
-        config->num_contexts = 0;
+        config->num_contexts = shmemi_ctx_count(team);
         return 0;
     } else {
         return SHMEM_INVALID_PARAM;
     }
 }
+
+int shmemx_team_set_barrier_algo(shmem_team_t team, int algo)
+{
+    if (!is_valid_team(team)) {
+        SHM_LOG_ERROR("input team is invalid!, team: " << team);
+        return SHMEM_INVALID_PARAM;
+    }
+    shmemi_team_t *team_ptr = &team_host(team);
+    if (algo < SHMEMX_BARRIER_AUTO || algo >= SHMEMX_BARRIER_ALGO_NUM) {
+        SHM_LOG_ERROR("input barrier algo " << algo << " is invalid.");
+        return SHMEM_INVALID_PARAM;
+    }
+    if (algo != SHMEMX_BARRIER_AUTO && !team_barrier_algo_supported(team_ptr, algo)) {
+        SHM_LOG_ERROR("barrier algo " << algo << " can not span team " << team_config2string(team_ptr));
+        return SHMEM_INVALID_PARAM;
+    }
+
+    team_ptr->barrier_algo = (algo == SHMEMX_BARRIER_AUTO) ? team_barrier_algo_select(team_ptr) : algo;
+    return device_team_sync(team);
+}
+
+int shmemx_team_get_barrier_algo(shmem_team_t team, int *algo)
+{
+    SHM_ASSERT_RETURN(algo != nullptr, SHMEM_INVALID_PARAM);
+    if (!is_valid_team(team)) {
+        return SHMEM_INVALID_PARAM;
+    }
+    *algo = team_host(team).barrier_algo;
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_team_set_coll_algo(shmem_team_t team, int op, int algo)
+{
+    if (!is_valid_team(team)) {
+        return SHMEM_INVALID_PARAM;
+    }
+    shmemi_team_t *team_ptr = &team_host(team);
+    if (op < 0 || op >= SHMEMX_COLL_OP_NUM || algo < SHMEMX_COLL_AUTO || algo >= SHMEMX_COLL_ALGO_NUM) {
+        SHM_LOG_ERROR("input coll op " << op << " or algo " << algo << " is invalid.");
+        return SHMEM_INVALID_PARAM;
+    }
+    if (algo != SHMEMX_COLL_AUTO && !shmemi_coll_algo_supported(team_ptr, op, algo)) {
+        SHM_LOG_ERROR("coll algo " << algo << " can not run op " << op << " on team " << team_config2string(team_ptr));
+        return SHMEM_INVALID_PARAM;
+    }
+
+    if (algo == SHMEMX_COLL_AUTO) {
+        shmemi_coll_tune_team(team_ptr);
+    } else {
+        shmemi_coll_tune_t *tune = &team_ptr->coll_tune[op];
+        tune->range_num = 1;
+        tune->algo[0] = algo;
+        tune->max_bytes[0] = UINT64_MAX;
+    }
+    return device_team_sync(team);
+}
+
+int shmemx_team_get_coll_algo(shmem_team_t team, int op, size_t nbytes, int *algo)
+{
+    SHM_ASSERT_RETURN(algo != nullptr, SHMEM_INVALID_PARAM);
+    if (!is_valid_team(team) || op < 0 || op >= SHMEMX_COLL_OP_NUM) {
+        return SHMEM_INVALID_PARAM;
+    }
+    const shmemi_coll_tune_t *tune = &team_host(team).coll_tune[op];
+    int i = 0;
+    while (i + 1 < tune->range_num && nbytes > tune->max_bytes[i]) {
+        i++;
+    }
+    *algo = tune->algo[i];
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_coll_tune_set(shmem_team_t team, int op, size_t max_bytes, int algo)
+{
+    if (!is_valid_team(team)) {
+        return SHMEM_INVALID_PARAM;
+    }
+    shmemi_team_t *team_ptr = &team_host(team);
+    SHMEM_CHECK_RET(shmemi_coll_tune_add(team_ptr, op, max_bytes, algo));
+    return shmemx_team_set_coll_algo(team, op, SHMEMX_COLL_AUTO);
+}
+
+// Gather one value of every member of the team into infos, at even indexes.
+static int32_t team_scratch_exchange(shmem_team_t team, int32_t value, std::vector<int32_t> &infos)
+{
+    size_t info_size = 2 * team_host(team).size * sizeof(int32_t);
+    infos.resize(2 * team_host(team).size);
+    SHMEM_CHECK_RET(shmemi_team_exchange_on_stream(team, g_team_split_buf, value, 0, nullptr));
+    SHMEM_CHECK_RET(aclrtSynchronizeStream(nullptr));
+    SHMEM_CHECK_RET(aclrtMemcpy(infos.data(), info_size, g_team_split_buf, info_size, ACL_MEMCPY_DEVICE_TO_HOST));
+    // the buffer is reused by the next exchange
+    SHMEM_CHECK_RET(shmemi_barrier_on_stream(team, nullptr));
+    SHMEM_CHECK_RET(aclrtSynchronizeStream(nullptr));
+    return SHMEM_SUCCESS;
+}
+
+// Take the arena from the symmetric heap. shmem_malloc is collective over all PEs, so the team has to hold them all.
+static int32_t team_scratch_arena_reserve(shmem_team_t team)
+{
+    if (g_scratch_arena != nullptr) {
+        return SHMEM_SUCCESS;
+    }
+    if (team_host(team).size != g_state.npes) {
+        SHM_LOG_ERROR("team " << team << " holds " << team_host(team).size << " of " << g_state.npes << " PEs, the "
+                      "first scratch request takes the arena and has to come from a team of all PEs.");
+        return SHMEM_INVALID_PARAM;
+    }
+    uint64_t arena_size = g_host_state.options.scratch_arena_size;
+    if (arena_size == 0) {
+        SHM_LOG_ERROR("team scratch arena is disabled, set SHMEM_SCRATCH_ARENA_SIZE.");
+        return SHMEM_INVALID_PARAM;
+    }
+    g_scratch_arena = (uint8_t *)shmem_malloc(arena_size);
+    if (g_scratch_arena == nullptr) {
+        SHM_LOG_ERROR("malloc team scratch arena of " << arena_size << " bytes failed, the symmetric heap is short.");
+        return SHMEM_INNER_ERROR;
+    }
+    g_scratch_granules = static_cast<int32_t>(arena_size / SHMEM_TEAM_SCRATCH_GRANULE);
+    g_scratch_used.assign((g_scratch_granules + SCRATCH_WORD_BITS - 1) / SCRATCH_WORD_BITS, 0);
+    return SHMEM_SUCCESS;
+}
+
+/* Take num granules of the arena at the same offset on every member. Each member proposes the lowest run free on
+   it from the largest proposal of the previous round, until all proposals match. Proposals never decrease, so the
+   rounds end, usually after the first one. */
+static int32_t team_scratch_alloc(shmem_team_t team, uint64_t bytes)
+{
+    shmemi_team_t *team_ptr = &team_host(team);
+    SHMEM_CHECK_RET(team_scratch_arena_reserve(team));
+    int32_t num = static_cast<int32_t>(bytes / SHMEM_TEAM_SCRATCH_GRANULE);
+    std::vector<int32_t> infos;
+    int32_t from = 0;
+    while (true) {
+        SHMEM_CHECK_RET(team_scratch_exchange(team, scratch_fit(from, num), infos));
+
+        int32_t low = INT32_MAX;
+        int32_t high = -1;
+        for (int32_t i = 0; i < team_ptr->size; i++) {
+            low = std::min(low, infos[2 * i]);
+            high = std::max(high, infos[2 * i]);
+        }
+        if (low < 0) {
+            SHM_LOG_ERROR("team " << team << " scratch of " << bytes << " bytes does not fit in the arena of every "
+                          "member, raise SHMEM_SCRATCH_ARENA_SIZE or release the scratch of other teams.");
+            return SHMEM_INNER_ERROR;
+        }
+        if (low == high) {
+            break;
+        }
+        from = high;
+    }
+
+    uint8_t *scratch = g_scratch_arena + static_cast<uint64_t>(infos[0]) * SHMEM_TEAM_SCRATCH_GRANULE;
+    auto ret = aclrtMemset(scratch, bytes, 0, bytes);
+    if (ret != 0) {
+        SHM_LOG_ERROR("memset team scratch failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    scratch_granules_mark(infos[0], num, true);
+    team_ptr->scratch = reinterpret_cast<uint64_t>(scratch);
+    team_ptr->scratch_size = bytes;
+    g_team_scratch[team].allocations++;
+    if (device_team_sync(team) != SHMEM_SUCCESS) {
+        team_scratch_release(team);
+        return SHMEM_INNER_ERROR;
+    }
+
+    // no member may write flags into the scratch of a peer before the peer has cleared it
+    SHMEM_CHECK_RET(shmemi_barrier_on_stream(team, nullptr));
+    SHMEM_CHECK_RET(aclrtSynchronizeStream(nullptr));
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_team_set_scratch_size(shmem_team_t team, size_t size)
+{
+    if (!is_valid_team(team)) {
+        SHM_LOG_ERROR("input team is invalid!, team: " << team);
+        return SHMEM_INVALID_PARAM;
+    }
+    uint64_t arena_size = g_host_state.options.scratch_arena_size;
+    uint64_t target = (size == 0) ? g_host_state.options.team_scratch_size :
+                                    ALIGH_TO(static_cast<uint64_t>(size), SHMEM_TEAM_SCRATCH_GRANULE);
+    int32_t granules = static_cast<int32_t>(std::min<uint64_t>(target / SHMEM_TEAM_SCRATCH_GRANULE, INT32_MAX));
+
+    // collective, the members drop their scratch together or not at all, so it stays at the same offset on all
+    std::vector<int32_t> infos;
+    SHMEM_CHECK_RET(team_scratch_exchange(team, granules, infos));
+    for (int32_t i = 0; i < team_host(team).size; i++) {
+        if (infos[2 * i] != granules) {
+            SHM_LOG_ERROR("team " << team << " scratch size " << target << " bytes differs from the "
+                          << static_cast<uint64_t>(infos[2 * i]) * SHMEM_TEAM_SCRATCH_GRANULE
+                          << " bytes of member " << i << ", all members must pass the same size.");
+            return SHMEM_INVALID_PARAM;
+        }
+    }
+    if (target > arena_size) {
+        SHM_LOG_ERROR("team scratch of " << size << " bytes exceeds the arena of " << arena_size
+                      << " bytes, raise SHMEM_SCRATCH_ARENA_SIZE.");
+        return SHMEM_INVALID_PARAM;
+    }
+    g_team_scratch[team].target_size = target;
+
+    // a scratch of another size is dropped and taken again on next use
+    shmemi_team_t *team_ptr = &team_host(team);
+    if (team_ptr->scratch == 0 || team_ptr->scratch_size == target) {
+        return SHMEM_SUCCESS;
+    }
+    team_scratch_release(team);
+    return device_team_sync(team);
+}
+
+int shmemx_team_get_scratch(shmem_team_t team, size_t size, void **scratch)
+{
+    SHM_ASSERT_RETURN(scratch != nullptr, SHMEM_INVALID_PARAM);
+    *scratch = nullptr;
+    if (!is_valid_team(team)) {
+        SHM_LOG_ERROR("input team is invalid!, team: " << team);
+        return SHMEM_INVALID_PARAM;
+    }
+    shmemi_team_t *team_ptr = &team_host(team);
+    team_scratch_info &info = g_team_scratch[team];
+    info.peak_request = std::max<uint64_t>(info.peak_request, size);
+
+    // first use, every member gets here with the same size
+    if (team_ptr->scratch == 0) {
+        uint64_t bytes = std::max<uint64_t>({info.target_size, ALIGH_TO(static_cast<uint64_t>(size),
+                                             SHMEM_TEAM_SCRATCH_GRANULE), SHMEM_TEAM_SCRATCH_GRANULE});
+        if (team_scratch_alloc(team, bytes) != SHMEM_SUCCESS) {
+            info.failures++;
+            return SHMEM_INNER_ERROR;
+        }
+    }
+    if (size > team_ptr->scratch_size) {
+        info.failures++;
+        SHM_LOG_ERROR("team " << team << " scratch holds " << team_ptr->scratch_size << " bytes, " << size
+                      << " requested, raise it with shmemx_team_set_scratch_size.");
+        return SHMEM_INVALID_PARAM;
+    }
+    info.requests++;
+    *scratch = reinterpret_cast<void *>(team_ptr->scratch);
+    return SHMEM_SUCCESS;
+}
+
+int shmemx_team_scratch_stats(shmem_team_t team, shmemx_team_scratch_stats_t *stats)
+{
+    SHM_ASSERT_RETURN(stats != nullptr, SHMEM_INVALID_PARAM);
+    if (!is_valid_team(team)) {
+        return SHMEM_INVALID_PARAM;
+    }
+    const team_scratch_info &info = g_team_scratch[team];
+    int32_t epoch = 0;
+    auto ret = aclrtMemcpy(&epoch, sizeof(int32_t), team_epoch_row(team), sizeof(int32_t),
+                           ACL_MEMCPY_DEVICE_TO_HOST);
+    if (ret != 0) {
+        SHM_LOG_ERROR("memcpy team epoch failed, ret: " << ret);
+        return SHMEM_INNER_ERROR;
+    }
+    stats->size = team_host(team).scratch_size;
+    stats->target_size = info.target_size;
+    stats->peak_request = info.peak_request;
+    stats->requests = info.requests;
+    stats->failures = info.failures;
+    stats->allocations = info.allocations;
+    stats->epoch = static_cast<uint32_t>(epoch);
+    stats->arena_used = scratch_arena_used();
+    stats->arena_size = g_host_state.options.scratch_arena_size;
+    return SHMEM_SUCCESS;
+}
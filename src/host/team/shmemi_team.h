@@ -16,4 +16,12 @@ int32_t shmemi_team_init(int32_t rank, int32_t size);
 
 int32_t shmemi_team_finalize();
 
+int32_t shmemi_ctx_init();
+
+int32_t shmemi_ctx_finalize();
+
+int32_t shmemi_ctx_count(int32_t team);
+
+void shmemi_ctx_destroy_team(int32_t team);
+
 #endif  // SHMEMI_TEAM_H
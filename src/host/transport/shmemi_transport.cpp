@@ -7,6 +7,9 @@
  * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
  * See LICENSE in the root of the software repository for the full text of the License.
  */
+#include <vector>
+#include <algorithm>
+
 #include "shmemi_host_common.h"
 #include "dlfcn.h"
 
@@ -59,6 +62,7 @@ int32_t shmemi_transport_init(shmemi_device_host_state_t &g_state) {
     }
     g_host_state.choosen_transports[1].logical_dev_id = logicDeviceId;
     g_host_state.choosen_transports[1].dev_id = device_id;
+    g_host_state.choosen_transports[1].qp_num = g_host_state.options.roce_qp_num;
 
     // AllGather All pe's host info
     g_boot_handle.allgather((void *)&my_info, g_host_state.pe_info, sizeof(shmemi_transport_pe_info_t), &g_boot_handle);
@@ -104,6 +108,17 @@ int32_t shmemi_build_transport_map(shmemi_device_host_state_t &g_state) {
         g_state.topo_list[i] = static_cast<uint8_t>(local_map[i]);
     }
 
+    // one host table for every team, team descriptors only keep the hosts they span
+    std::vector<uint64_t> host_hashes;
+    for (int i = 0; i < g_state.npes; i++) {
+        uint64_t hash = g_host_state.pe_info[i].host_hash;
+        auto it = std::find(host_hashes.begin(), host_hashes.end(), hash);
+        g_state.pe_host[i] = static_cast<int16_t>(it - host_hashes.begin());
+        if (it == host_hashes.end()) {
+            host_hashes.push_back(hash);
+        }
+    }
+
     g_boot_handle.allgather(local_map, g_host_state.transport_map, g_state.npes * sizeof(int), &g_boot_handle);
 
     if (local_map) free(local_map);
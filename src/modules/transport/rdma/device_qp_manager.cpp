@@ -13,12 +13,13 @@
 using namespace shm;
 
 DeviceQpManager::DeviceQpManager(uint32_t deviceId, uint32_t rankId, uint32_t rankCount, sockaddr_in devNet,
-                                 hybm_role_type role) noexcept
+                                 hybm_role_type role, uint32_t aiQpNum) noexcept
     : deviceId_{deviceId},
       rankId_{rankId},
       rankCount_{rankCount},
       deviceAddress_{devNet},
-      rankRole_{role}
+      rankRole_{role},
+      aiQpNum_{aiQpNum == 0 ? 1U : (aiQpNum > MAX_AI_QP_PER_PEER ? MAX_AI_QP_PER_PEER : aiQpNum)}
 {
 }
 
@@ -206,7 +207,7 @@ void *DeviceQpManager::GetQpHandleWithRankId(uint32_t rankId) const noexcept
         return nullptr;
     }
 
-    return pos->second.qpHandles[CONN_QP_STARS];
+    return pos->second.qpHandles[CONN_QP_STARS][0];
 }
 
 bool DeviceQpManager::ReserveQpInfoSpace() noexcept
@@ -217,7 +218,7 @@ bool DeviceQpManager::ReserveQpInfoSpace() noexcept
 
     void *ptr = nullptr;
     auto oneQpSize = 2U * (sizeof(AiQpRMAWQ) + sizeof(AiQpRMACQ)) + sizeof(RdmaMemRegionInfo);
-    qpInfoSize_ = sizeof(AiQpRMAQueueInfo) + oneQpSize * rankCount_;
+    qpInfoSize_ = sizeof(AiQpRMAQueueInfo) + oneQpSize * rankCount_ * aiQpNum_;
     auto ret = aclrtMalloc(&ptr, qpInfoSize_, ACL_MEM_MALLOC_HUGE_FIRST);
     if (ret != 0) {
         SHM_LOG_ERROR("allocate device size: " << qpInfoSize_ << ", failed: " << ret);
@@ -437,29 +438,33 @@ int DeviceQpManager::WaitConnectionsReady(std::unordered_map<uint32_t, Connectio
 int DeviceQpManager::CreateQpWaitingReady(std::unordered_map<uint32_t, ConnectionChannel> &connections,
                                               ConnQpType qpType) noexcept
 {
+    auto qpCount = QpCount(qpType);
     for (auto it = connections.begin(); it != connections.end(); ++it) {
-        auto ret = CreateOneQp(qpType, it->second);
-        if (ret != 0) {
-            SHM_LOG_ERROR("create QP type:" << qpType << " to " << it->first << " failed: " << ret);
-            return SHMEM_INNER_ERROR;
-        }
-
-        for (auto pos = currentLocalMrs_.begin(); pos != currentLocalMrs_.end(); ++pos) {
-            HccpMrInfo info{};
-            info.addr = (void *)(ptrdiff_t)pos->second.address;
-            info.size = pos->second.size;
-            info.access = 7;
-            ret = DlHccpApi::RaMrReg(it->second.qpHandles[qpType], info);
+        for (uint32_t q = 0; q < qpCount; q++) {
+            auto ret = CreateOneQp(qpType, q, it->second);
             if (ret != 0) {
-                SHM_LOG_ERROR("register MR failed: " << ret);
+                SHM_LOG_ERROR("create QP type:" << qpType << " index:" << q << " to " << it->first
+                                                << " failed: " << ret);
                 return SHMEM_INNER_ERROR;
             }
-        }
 
-        ret = DlHccpApi::RaQpConnectAsync(it->second.qpHandles[qpType], it->second.socketFd);
-        if (ret != 0) {
-            SHM_LOG_ERROR("connect AI QP to " << it->first << " failed: " << ret);
-            return SHMEM_INNER_ERROR;
+            for (auto pos = currentLocalMrs_.begin(); pos != currentLocalMrs_.end(); ++pos) {
+                HccpMrInfo info{};
+                info.addr = (void *)(ptrdiff_t)pos->second.address;
+                info.size = pos->second.size;
+                info.access = 7;
+                ret = DlHccpApi::RaMrReg(it->second.qpHandles[qpType][q], info);
+                if (ret != 0) {
+                    SHM_LOG_ERROR("register MR failed: " << ret);
+                    return SHMEM_INNER_ERROR;
+                }
+            }
+
+            ret = DlHccpApi::RaQpConnectAsync(it->second.qpHandles[qpType][q], it->second.socketFd);
+            if (ret != 0) {
+                SHM_LOG_ERROR("connect AI QP index:" << q << " to " << it->first << " failed: " << ret);
+                return SHMEM_INNER_ERROR;
+            }
         }
     }
 
@@ -468,14 +473,16 @@ int DeviceQpManager::CreateQpWaitingReady(std::unordered_map<uint32_t, Connectio
     while (std::chrono::steady_clock::now() < timeout) {
         int connectingCount = 0;
         for (auto it = connections.begin(); it != connections.end(); ++it) {
-            int status = 0;
-            auto ret = DlHccpApi::RaGetQpStatus(it->second.qpHandles[qpType], status);
-            if (ret != 0) {
-                SHM_LOG_ERROR("get AI QP status to " << it->first << " failed: " << ret);
-                return SHMEM_INNER_ERROR;
-            }
-            if (status != 1) {
-                connectingCount++;
+            for (uint32_t q = 0; q < qpCount; q++) {
+                int status = 0;
+                auto ret = DlHccpApi::RaGetQpStatus(it->second.qpHandles[qpType][q], status);
+                if (ret != 0) {
+                    SHM_LOG_ERROR("get AI QP status to " << it->first << " failed: " << ret);
+                    return SHMEM_INNER_ERROR;
+                }
+                if (status != 1) {
+                    connectingCount++;
+                }
             }
         }
         if (connectingCount == 0) {
@@ -486,7 +493,12 @@ int DeviceQpManager::CreateQpWaitingReady(std::unordered_map<uint32_t, Connectio
     return SHMEM_INNER_ERROR;
 }
 
-int DeviceQpManager::CreateOneQp(ConnQpType qpType, ConnectionChannel &channel) noexcept
+uint32_t DeviceQpManager::QpCount(ConnQpType qpType) const noexcept
+{
+    return qpType == CONN_QP_AI_CORE ? aiQpNum_ : 1U;
+}
+
+int DeviceQpManager::CreateOneQp(ConnQpType qpType, uint32_t qpIdx, ConnectionChannel &channel) noexcept
 {
     int ret;
     if (qpType == CONN_QP_AI_CORE) {
@@ -501,9 +513,9 @@ int DeviceQpManager::CreateOneQp(ConnQpType qpType, ConnectionChannel &channel)
         attr.qp_attr.cap.max_recv_sge = MAX_RECV_SGE;
         attr.qp_attr.qp_type = IBV_QPT_RC;
         attr.data_plane_flag.bs.cq_cstm = CALLER_POLL_CQ_CSTM;
-        ret = DlHccpApi::RaQpAiCreate(rdmaHandle_, attr, channel.aiQpInfo, channel.qpHandles[qpType]);
+        ret = DlHccpApi::RaQpAiCreate(rdmaHandle_, attr, channel.aiQpInfo[qpIdx], channel.qpHandles[qpType][qpIdx]);
     } else {
-        ret = DlHccpApi::RaQpCreate(rdmaHandle_, 0, QP_MODE, channel.qpHandles[qpType]);
+        ret = DlHccpApi::RaQpCreate(rdmaHandle_, 0, QP_MODE, channel.qpHandles[qpType][qpIdx]);
     }
     return ret;
 }
@@ -517,12 +529,13 @@ int DeviceQpManager::FillQpInfo(ConnQpType qpType) noexcept
     const uint32_t slevel = 4;
     std::vector<uint8_t> qpInfoBuffer(qpInfoSize_);
     auto copyInfo = (AiQpRMAQueueInfo *)(void *)qpInfoBuffer.data();
-    copyInfo->count = 1;
+    const uint32_t queueCount = rankCount_ * aiQpNum_;
+    copyInfo->count = aiQpNum_;
     copyInfo->sq = (AiQpRMAWQ *)(void *)(copyInfo + 1);
-    copyInfo->rq = (AiQpRMAWQ *)(void *)(copyInfo->sq + rankCount_);
-    copyInfo->scq = (AiQpRMACQ *)(void *)(copyInfo->rq + rankCount_);
-    copyInfo->rcq = (AiQpRMACQ *)(void *)(copyInfo->scq + rankCount_);
-    copyInfo->mr = (RdmaMemRegionInfo *)(void *)(copyInfo->rcq + rankCount_);
+    copyInfo->rq = (AiQpRMAWQ *)(void *)(copyInfo->sq + queueCount);
+    copyInfo->scq = (AiQpRMACQ *)(void *)(copyInfo->rq + queueCount);
+    copyInfo->rcq = (AiQpRMACQ *)(void *)(copyInfo->scq + queueCount);
+    copyInfo->mr = (RdmaMemRegionInfo *)(void *)(copyInfo->rcq + queueCount);
     for (auto it = currentRanksInfo_.begin(); it != currentRanksInfo_.end(); ++it) {
         copyInfo->mr[it->first].size = it->second.mr.size;
         copyInfo->mr[it->first].addr = it->second.mr.address;
@@ -545,26 +558,31 @@ int DeviceQpManager::FillQpInfo(ConnQpType qpType) noexcept
             return SHMEM_INNER_ERROR;
         }
 
-        CopyAiWQInfo(copyInfo->sq[it->first], pos->second.aiQpInfo.data_plane_info.sq, DBMode::HW_DB, slevel);
-        CopyAiWQInfo(copyInfo->rq[it->first], pos->second.aiQpInfo.data_plane_info.rq, DBMode::SW_DB, slevel);
-        CopyAiCQInfo(copyInfo->scq[it->first], pos->second.aiQpInfo.data_plane_info.scq, DBMode::HW_DB);
-        CopyAiCQInfo(copyInfo->rcq[it->first], pos->second.aiQpInfo.data_plane_info.rcq, DBMode::SW_DB);
+        // queues are laid out as [rank][qp], see SHMEMAIVRDMAInfo
+        for (uint32_t q = 0; q < aiQpNum_; q++) {
+            auto &plane = pos->second.aiQpInfo[q].data_plane_info;
+            auto index = it->first * aiQpNum_ + q;
+            CopyAiWQInfo(copyInfo->sq[index], plane.sq, DBMode::HW_DB, slevel);
+            CopyAiWQInfo(copyInfo->rq[index], plane.rq, DBMode::SW_DB, slevel);
+            CopyAiCQInfo(copyInfo->scq[index], plane.scq, DBMode::HW_DB);
+            CopyAiCQInfo(copyInfo->rcq[index], plane.rcq, DBMode::SW_DB);
+        }
     }
 
     auto pointer = (ptrdiff_t)(void *)(qpInfo_);
     pointer += sizeof(AiQpRMAQueueInfo);
     copyInfo->sq = (AiQpRMAWQ *)(void *)(pointer);
 
-    pointer += sizeof(AiQpRMAWQ) * rankCount_;
+    pointer += sizeof(AiQpRMAWQ) * queueCount;
     copyInfo->rq = (AiQpRMAWQ *)(void *)(pointer);
 
-    pointer += sizeof(AiQpRMAWQ) * rankCount_;
+    pointer += sizeof(AiQpRMAWQ) * queueCount;
     copyInfo->scq = (AiQpRMACQ *)(void *)(pointer);
 
-    pointer += sizeof(AiQpRMACQ) * rankCount_;
+    pointer += sizeof(AiQpRMACQ) * queueCount;
     copyInfo->rcq = (AiQpRMACQ *)(void *)(pointer);
 
-    pointer += sizeof(AiQpRMACQ) * rankCount_;
+    pointer += sizeof(AiQpRMACQ) * queueCount;
     copyInfo->mr = (RdmaMemRegionInfo *)(void *)pointer;
 
     auto ret = aclrtMemcpy(qpInfo_, qpInfoSize_, copyInfo, qpInfoSize_, ACL_MEMCPY_HOST_TO_DEVICE);
@@ -639,20 +657,22 @@ void DeviceQpManager::CloseConnections(std::unordered_map<uint32_t, ConnectionCh
 {
     std::vector<HccpSocketCloseInfo> socketCloseInfos;
     for (auto it = connections.begin(); it != connections.end(); ++it) {
-        if (it->second.qpHandles[CONN_QP_AI_CORE] != nullptr) {
-            auto ret = DlHccpApi::RaQpDestroy(it->second.qpHandles[CONN_QP_AI_CORE]);
-            if (ret != 0) {
-                SHM_LOG_WARN("destroy AI QP to server: " << it->first << " failed: " << ret);
+        for (uint32_t q = 0; q < aiQpNum_; q++) {
+            if (it->second.qpHandles[CONN_QP_AI_CORE][q] != nullptr) {
+                auto ret = DlHccpApi::RaQpDestroy(it->second.qpHandles[CONN_QP_AI_CORE][q]);
+                if (ret != 0) {
+                    SHM_LOG_WARN("destroy AI QP " << q << " to server: " << it->first << " failed: " << ret);
+                }
+                it->second.qpHandles[CONN_QP_AI_CORE][q] = nullptr;
             }
-            it->second.qpHandles[CONN_QP_AI_CORE] = nullptr;
         }
 
-        if (it->second.qpHandles[CONN_QP_STARS] != nullptr) {
-            auto ret = DlHccpApi::RaQpDestroy(it->second.qpHandles[CONN_QP_STARS]);
+        if (it->second.qpHandles[CONN_QP_STARS][0] != nullptr) {
+            auto ret = DlHccpApi::RaQpDestroy(it->second.qpHandles[CONN_QP_STARS][0]);
             if (ret != 0) {
                 SHM_LOG_WARN("destroy stars QP to server: " << it->first << " failed: " << ret);
             }
-            it->second.qpHandles[CONN_QP_STARS] = nullptr;
+            it->second.qpHandles[CONN_QP_STARS][0] = nullptr;
         }
 
         if (it->second.socketFd != nullptr) {
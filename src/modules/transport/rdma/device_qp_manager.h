@@ -20,7 +20,7 @@
 class DeviceQpManager {
 public:
     DeviceQpManager(uint32_t deviceId, uint32_t rankId, uint32_t rankCount, sockaddr_in devNet,
-                    hybm_role_type role) noexcept;
+                    hybm_role_type role, uint32_t aiQpNum = 1) noexcept;
     ~DeviceQpManager() noexcept;
 
     int SetRemoteRankInfo(const std::unordered_map<uint32_t, ConnectRankInfo> &ranks) noexcept;
@@ -41,6 +41,7 @@ protected:
     const uint32_t rankId_;
     const uint32_t rankCount_;
     const hybm_role_type rankRole_;
+    const uint32_t aiQpNum_;
     sockaddr_in deviceAddress_;
     void *serverSocketHandle_{nullptr};
 
@@ -51,12 +52,14 @@ private:
         CONN_QP_COUNT
     };
 
+    static constexpr uint32_t MAX_AI_QP_PER_PEER = 8;  // keep in line with SHMEM_MAX_ROCE_QP_NUM
+
     struct ConnectionChannel {
         in_addr remoteIp;
         void *socketHandle;
         void *socketFd{nullptr};
-        void *qpHandles[CONN_QP_COUNT]{};
-        HccpAiQpInfo aiQpInfo{};
+        void *qpHandles[CONN_QP_COUNT][MAX_AI_QP_PER_PEER]{};
+        HccpAiQpInfo aiQpInfo[MAX_AI_QP_PER_PEER]{};
         int qpStatus{-1};
 
         explicit ConnectionChannel(const in_addr ip) : ConnectionChannel{ip, nullptr} {}
@@ -69,7 +72,8 @@ private:
     int GenerateWhiteList() noexcept;
     int WaitConnectionsReady(std::unordered_map<uint32_t, ConnectionChannel> &connections) noexcept;
     int CreateQpWaitingReady(std::unordered_map<uint32_t, ConnectionChannel> &connections, ConnQpType qpType) noexcept;
-    int CreateOneQp(ConnQpType qpType, ConnectionChannel &channel) noexcept;
+    uint32_t QpCount(ConnQpType qpType) const noexcept;
+    int CreateOneQp(ConnQpType qpType, uint32_t qpIdx, ConnectionChannel &channel) noexcept;
     int FillQpInfo(ConnQpType qpType) noexcept;
     void CopyAiWQInfo(struct AiQpRMAWQ &dest, const struct ai_data_plane_wq &src, DBMode dbMode, uint32_t sl) noexcept;
     void CopyAiCQInfo(struct AiQpRMACQ &dest, const ai_data_plane_cq &source, DBMode dbMode) noexcept;
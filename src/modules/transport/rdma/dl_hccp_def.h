@@ -561,6 +561,7 @@ struct TransportOptions {
     int nic;
     int32_t dev_id;
     int32_t logic_dev_id;
+    uint32_t qpNum;
 };
 
 struct TransportMemoryRegion {
@@ -71,7 +71,7 @@ public:
         deviceAddr.sin_family = AF_INET;
         deviceAddr.sin_addr = deviceIp_;
         deviceAddr.sin_port = devicePort_;
-        qpManager_ = new DeviceQpManager(deviceId_, rankId_, rankCount_, deviceAddr, HYBM_ROLE_PEER);
+        qpManager_ = new DeviceQpManager(deviceId_, rankId_, rankCount_, deviceAddr, HYBM_ROLE_PEER, options.qpNum);
 
         return 0;
     }
@@ -75,6 +75,7 @@ int shmemi_rdma_init(shmemi_transport *t, shmemi_device_host_state_t *state) {
     options.nic = 10002;
     options.dev_id = t->dev_id;
     options.logic_dev_id = t->logical_dev_id;
+    options.qpNum = t->qp_num;
     manager->OpenDevice(options);
 
     TransportMemoryRegion mr;
@@ -7,11 +7,11 @@
 # INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
 # See LICENSE in the root of the software repository for the full text of the License.
 #
-import multiprocessing
 import pytest
 import numpy as np
 import os
 import subprocess
+import shutil
 import socket
 from contextlib import closing
 import hashlib
@@ -109,17 +109,18 @@ def find_free_port():
 
 
 def run_fusion_matmul_allreduce_kernel(
-        rank, case_params, ipport, base_device_id, executable_path, test_data_dir
+        case_params, ipport, base_device_id, executable_path, test_data_dir
 ):
-    """The function to be executed by each rank's process."""
+    """Launches every rank of the case with mpirun, matching scripts/run.sh."""
     world_size = case_params["world_size"]
     m, k, n = case_params["m"], case_params["k"], case_params["n"]
 
-    # Launch the C++ executable
+    # Launch the C++ executable, the rank is taken from MPI_COMM_WORLD
     cmd = [
-        executable_path,
+        "mpirun",
+        "-np",
         str(world_size),
-        str(rank),
+        executable_path,
         ipport,
         str(base_device_id),
         str(m),
@@ -139,10 +140,10 @@ def run_fusion_matmul_allreduce_kernel(
     if proc.returncode != 0:
         # This allows pytest to show the logs on failure
         with open(log_path, "r") as f:
-            print(f"--- RANK {rank} LOGS ---")
+            print("--- MPIRUN LOGS ---")
             print(f.read())
         pytest.fail(
-            f"Rank {rank} failed with exit code {proc.returncode}", pytrace=False
+            f"mpirun failed with exit code {proc.returncode}", pytrace=False
         )
 
 
@@ -151,6 +152,8 @@ def test_fusion_matmul_allreduce(case_params):
     """Main test function for matmul_allreduce kernel."""
     if not os.path.exists(EXECUTABLE_PATH):
         pytest.skip(f"Executable not found at {EXECUTABLE_PATH}, run build.sh first.")
+    if shutil.which("mpirun") is None:
+        pytest.skip("mpirun not found, matmul_allreduce is launched through MPI.")
 
     os.makedirs(TEST_DATA_DIR, exist_ok=True)
 
@@ -232,27 +235,10 @@ def test_fusion_matmul_allreduce(case_params):
     # pack CPU input & output.
     case_params[case_hash] = {"A": all_A[i], "B": all_B[i], "gt": gt}
 
-    # Run ranks in parallel
-    ctx = multiprocessing.get_context("spawn")
-    processes = []
-    for rank_id in range(world_size):
-        p = ctx.Process(
-            target=run_fusion_matmul_allreduce_kernel,
-            args=(
-                rank_id,
-                case_params,
-                ipport,
-                base_device_id,
-                EXECUTABLE_PATH,
-                data_dir,
-            ),
-        )
-        processes.append(p)
-        p.start()
-
-    for p in processes:
-        p.join()
-        assert p.exitcode == 0
+    # Run all ranks under one mpirun
+    run_fusion_matmul_allreduce_kernel(
+        case_params, ipport, base_device_id, EXECUTABLE_PATH, data_dir
+    )
 
     shmem_output_path = os.path.join(data_dir, "shmem_output.bin")
     shmem_result_data = np.fromfile(shmem_output_path, dtype=numpy_dtype)
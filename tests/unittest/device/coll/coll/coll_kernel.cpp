@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+#include "shmem_api.h"
+
+// gather src into gather_dst, then reduce src in place
+extern "C" SHMEM_GLOBAL void coll_device(uint64_t config, GM_ADDR src, GM_ADDR gather_dst, uint64_t nelems)
+{
+    shmemx_set_ffts_config(config);
+    shmem_int32_allgather(SHMEM_TEAM_WORLD, (__gm__ int32_t *)gather_dst, (__gm__ int32_t *)src, nelems);
+    shmem_int32_sum_allreduce(SHMEM_TEAM_WORLD, (__gm__ int32_t *)src, (__gm__ int32_t *)src, nelems);
+}
+
+void coll_device_do(void *stream, uint64_t config, uint8_t *src, uint8_t *gather_dst, uint64_t nelems)
+{
+    coll_device<<<4, nullptr, stream>>>(config, src, gather_dst, nelems);
+}
+
+// sum allreduce of src into dst from one block, whose cores own several QPs each and rotate over as many lanes
+extern "C" SHMEM_GLOBAL void coll_allreduce_one_block(uint64_t config, GM_ADDR dst, GM_ADDR src, uint64_t nelems)
+{
+    shmemx_set_ffts_config(config);
+    shmem_int32_sum_allreduce(SHMEM_TEAM_WORLD, (__gm__ int32_t *)dst, (__gm__ int32_t *)src, nelems);
+}
+
+void coll_allreduce_one_block_do(void *stream, uint64_t config, uint8_t *dst, uint8_t *src, uint64_t nelems)
+{
+    coll_allreduce_one_block<<<1, nullptr, stream>>>(config, dst, src, nelems);
+}
+
+// reduce num blocks of half at a stride of nelems from src into dst with op, a shmemi_reduce_op_t
+extern "C" SHMEM_GLOBAL void coll_reduce_local(GM_ADDR dst, GM_ADDR src, int num, uint64_t nelems, int op)
+{
+    auto dest = (__gm__ half *)dst;
+    auto source = (__gm__ half *)src;
+    switch (op) {
+        case SHMEMI_REDUCE_SUM:
+            shmemx_half_sum_reduce_local(dest, source, num, nelems, nelems);
+            break;
+        case SHMEMI_REDUCE_MAX:
+            shmemx_half_max_reduce_local(dest, source, num, nelems, nelems);
+            break;
+        case SHMEMI_REDUCE_MIN:
+            shmemx_half_min_reduce_local(dest, source, num, nelems, nelems);
+            break;
+        default:
+            shmemx_half_prod_reduce_local(dest, source, num, nelems, nelems);
+            break;
+    }
+}
+
+void coll_reduce_local_do(void *stream, uint8_t *dst, uint8_t *src, int num, uint64_t nelems, int op)
+{
+    coll_reduce_local<<<4, nullptr, stream>>>(dst, src, num, nelems, op);
+}
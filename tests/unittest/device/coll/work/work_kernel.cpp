@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+#include "shmem_api.h"
+
+// submits an allgather of nbytes per PE to the work queue from one core and waits for it
+extern "C" SHMEM_GLOBAL void work_device(uint64_t config, GM_ADDR src, GM_ADDR gather_dst, uint64_t nbytes)
+{
+    shmemx_set_ffts_config(config);
+    if ASCEND_IS_AIC {
+        return;
+    }
+    if (AscendC::GetBlockIdx() != 0) {
+        return;
+    }
+    shmemx_work_desc_t desc = {};
+    desc.op = SHMEMX_WORK_ALLGATHER;
+    desc.team = SHMEM_TEAM_WORLD;
+    desc.dest = (uint64_t)gather_dst;
+    desc.source = (uint64_t)src;
+    desc.size = nbytes;
+    shmemx_work_wait(shmemx_work_submit(desc));
+}
+
+void work_device_do(void *stream, uint64_t config, uint8_t *src, uint8_t *gather_dst, uint64_t nbytes)
+{
+    work_device<<<1, nullptr, stream>>>(config, src, gather_dst, nbytes);
+}
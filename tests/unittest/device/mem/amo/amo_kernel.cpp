@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+#include "shmem_api.h"
+
+// layout of gva: [0] counter for fetch_add, [1] word for compare_swap, [2] word for fetch_or
+#define AMO_KERNEL(NAME, TYPE)                                                                                   \
+    extern "C" SHMEM_GLOBAL void NAME##_amo(uint64_t config, GM_ADDR gva, GM_ADDR dev, int rank_id)             \
+    {                                                                                                            \
+        shmemx_set_ffts_config(config);                                                                          \
+        auto addr = (__gm__ TYPE *)gva;                                                                          \
+        auto fetched = (__gm__ TYPE *)dev;                                                                       \
+                                                                                                                 \
+        shmem_barrier_all();                                                                                     \
+        if ASCEND_IS_AIV {                                                                                       \
+            if (AscendC::GetBlockIdx() == 0) {                                                                   \
+                fetched[0] = shmem_##NAME##_atomic_fetch_add(addr, (TYPE)1, 0);                                  \
+                fetched[1] = shmem_##NAME##_atomic_compare_swap(addr + 1, (TYPE)0, (TYPE)(rank_id + 1), 0);      \
+                fetched[2] = shmem_##NAME##_atomic_fetch_or(addr + 2, (TYPE)1 << (rank_id % 32), 0);             \
+                dcci_cachelines((__gm__ uint8_t *)fetched, 3 * sizeof(TYPE));                                    \
+            }                                                                                                    \
+        }                                                                                                        \
+        shmem_barrier_all();                                                                                     \
+        if ASCEND_IS_AIV {                                                                                       \
+            if (AscendC::GetBlockIdx() == 0) {                                                                   \
+                fetched[3] = shmem_##NAME##_atomic_fetch(addr, 0);                                               \
+                dcci_cachelines((__gm__ uint8_t *)fetched, 4 * sizeof(TYPE));                                    \
+            }                                                                                                    \
+        }                                                                                                        \
+        shmem_barrier_all();                                                                                     \
+    }                                                                                                            \
+                                                                                                                 \
+    void NAME##_amo_do(void *stream, uint64_t config, uint8_t *gva, uint8_t *dev, int rank_id)                   \
+    {                                                                                                            \
+        NAME##_amo<<<1, nullptr, stream>>>(config, gva, dev, rank_id);                                           \
+    }
+
+SHMEM_AMO_TYPE_FUNC(AMO_KERNEL);
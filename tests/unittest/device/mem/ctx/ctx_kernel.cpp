@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "kernel_operator.h"
+#include "shmem_api.h"
+
+// Each rank puts its src to the next rank through ctx, and gets the previous rank's src through SHMEM_CTX_DEFAULT.
+extern "C" SHMEM_GLOBAL void ctx_put_get(uint64_t config, GM_ADDR gva, GM_ADDR src, GM_ADDR dev, int ctx,
+                                         uint32_t elem_size)
+{
+    shmemx_set_ffts_config(config);
+    auto gva_gm = (__gm__ float *)gva;
+    auto src_gm = (__gm__ float *)src;
+    auto dev_gm = (__gm__ float *)dev;
+    int my_pe = shmem_my_pe();
+    int n_pes = shmem_n_pes();
+
+    if ASCEND_IS_AIV {
+        if (AscendC::GetBlockIdx() == 0) {
+            shmem_ctx_put_float_mem_nbi(ctx, gva_gm, src_gm, elem_size, (my_pe + 1) % n_pes);
+            shmem_ctx_quiet(ctx);
+        }
+    }
+    shmem_barrier_all();
+    if ASCEND_IS_AIV {
+        if (AscendC::GetBlockIdx() == 0) {
+            shmem_ctx_getmem(SHMEM_CTX_DEFAULT, dev_gm, src_gm, elem_size * sizeof(float), (my_pe + n_pes - 1) % n_pes);
+        }
+    }
+    shmem_barrier_all();
+}
+
+void ctx_put_get_do(void *stream, uint64_t config, uint8_t *gva, uint8_t *src, uint8_t *dev, int ctx,
+                    uint32_t elem_size)
+{
+    ctx_put_get<<<1, nullptr, stream>>>(config, gva, src, dev, ctx, elem_size);
+}
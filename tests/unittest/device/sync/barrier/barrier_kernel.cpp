@@ -78,6 +78,26 @@ extern "C" SHMEM_GLOBAL void increase_vec_odd_team(uint64_t config, GM_ADDR addr
 #endif
 }
 
+extern "C" SHMEM_GLOBAL void increase_split(uint64_t config, GM_ADDR addr, int rank_id, int rank_size, int use_test) {
+    shmemx_set_ffts_config(config);
+
+#ifdef __DAV_C220_VEC__
+    uint64_t val = shmemi_load((__gm__ uint64_t *)addr);
+
+    shmemx_barrier_arrive(SHMEM_TEAM_WORLD);
+    if (use_test) {
+        while (!shmemx_barrier_test(SHMEM_TEAM_WORLD)) {
+        }
+    } else {
+        shmemx_barrier_wait(SHMEM_TEAM_WORLD);
+    }
+
+    GM_ADDR remote = shmemi_ptr(addr, (rank_id + 1) % rank_size);
+    shmemi_store((__gm__ uint64_t *)remote, val + 1);
+    shmemx_barrier_all_vec();
+#endif
+}
+
 void increase_do(void* stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size) {
     increase<<<16, nullptr, stream>>>(config, addr, rank_id, rank_size);
 }
@@ -92,4 +112,8 @@ void increase_do_odd_team(void* stream, uint64_t config, uint8_t *addr, int rank
 
 void increase_vec_do_odd_team(void* stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size, shmem_team_t team_id) {
     increase_vec_odd_team<<<16, nullptr, stream>>>(config, addr, rank_id, rank_size, team_id);
-}
\ No newline at end of file
+}
+
+void increase_split_do(void* stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size, int use_test) {
+    increase_split<<<16, nullptr, stream>>>(config, addr, rank_id, rank_size, use_test);
+}
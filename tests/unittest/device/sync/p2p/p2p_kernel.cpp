@@ -45,4 +45,90 @@ extern "C" SHMEM_GLOBAL void p2p_chain(uint64_t config, GM_ADDR addr, int rank_i
 
 void p2p_chain_do(void *stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size) {
     p2p_chain<<<1, nullptr, stream>>>(config, addr, rank_id, rank_size);
+}
+
+constexpr int WAIT_VEC_NFLAGS = 16;
+constexpr int WAIT_VEC_MASKED_ANY = 4;
+
+/*
+    Results of p2p_wait_vec, one int64_t each, checked by the host:
+    before any flag is written: test_all, test_any, test_some on all flags == 1;
+    after the previous pe set the even flags to 1, odd entries of status set:
+    test_all masked, test_all unmasked, wait_until_any with [0, WAIT_VEC_MASKED_ANY) also masked, wait_until_some
+    count then its indices, test_some of the flags still 0, wait_until_any and wait_until_some with every entry
+    masked, test_any != 0, the internal wait_until_all over the even flags with stride 2 and backoff.
+*/
+extern "C" SHMEM_GLOBAL void p2p_wait_vec(uint64_t config, GM_ADDR addr, GM_ADDR result, int rank_id, int rank_size) {
+    shmemx_set_ffts_config(config);
+    auto flags = (__gm__ int32_t *)addr;
+    auto res = (__gm__ int64_t *)result;
+    int next = (rank_id + 1) % rank_size;
+    int status[WAIT_VEC_NFLAGS];
+    int all_masked[WAIT_VEC_NFLAGS];
+    size_t indices[WAIT_VEC_NFLAGS];
+    for (int i = 0; i < WAIT_VEC_NFLAGS; i++) {
+        status[i] = i % 2;
+        all_masked[i] = 1;
+    }
+    int n = 0;
+
+#ifdef __DAV_C220_VEC__
+    if (AscendC::GetBlockIdx() == 0) {
+        // nothing is written yet, the test_* calls must return rather than block
+        res[n++] = shmem_int32_test_all(flags, WAIT_VEC_NFLAGS, nullptr, SHMEM_CMP_EQ, 1);
+        res[n++] = static_cast<int64_t>(shmem_int32_test_any(flags, WAIT_VEC_NFLAGS, nullptr, SHMEM_CMP_EQ, 1));
+        res[n++] = static_cast<int64_t>(shmem_int32_test_some(flags, WAIT_VEC_NFLAGS, indices, nullptr,
+                                                              SHMEM_CMP_EQ, 1));
+    }
+#endif
+
+    shmem_barrier_all();
+
+#ifdef __DAV_C220_VEC__
+    if (AscendC::GetBlockIdx() == 0) {
+        for (int i = 0; i < WAIT_VEC_NFLAGS; i += 2) {
+            shmemx_signal_op(flags + i, 1, SHMEM_SIGNAL_SET, next);
+        }
+
+        // odd flags stay 0, so this only returns if status masks them
+        shmem_int32_wait_until_all(flags, WAIT_VEC_NFLAGS, status, SHMEM_CMP_EQ, 1);
+        res[n++] = shmem_int32_test_all(flags, WAIT_VEC_NFLAGS, status, SHMEM_CMP_EQ, 1);
+        res[n++] = shmem_int32_test_all(flags, WAIT_VEC_NFLAGS, nullptr, SHMEM_CMP_EQ, 1);
+
+        int any_status[WAIT_VEC_NFLAGS];
+        for (int i = 0; i < WAIT_VEC_NFLAGS; i++) {
+            any_status[i] = (i < WAIT_VEC_MASKED_ANY) ? 1 : status[i];
+        }
+        res[n++] = static_cast<int64_t>(shmem_int32_wait_until_any(flags, WAIT_VEC_NFLAGS, any_status,
+                                                                    SHMEM_CMP_EQ, 1));
+
+        size_t num = shmem_int32_wait_until_some(flags, WAIT_VEC_NFLAGS, indices, status, SHMEM_CMP_EQ, 1);
+        res[n++] = static_cast<int64_t>(num);
+        for (size_t i = 0; i < WAIT_VEC_NFLAGS / 2; i++) {
+            res[n++] = i < num ? static_cast<int64_t>(indices[i]) : -1;
+        }
+        res[n++] = static_cast<int64_t>(shmem_int32_test_some(flags, WAIT_VEC_NFLAGS, indices, nullptr,
+                                                              SHMEM_CMP_EQ, 0));
+
+        // every element excluded, these return at once
+        res[n++] = static_cast<int64_t>(shmem_int32_wait_until_any(flags, WAIT_VEC_NFLAGS, all_masked,
+                                                                    SHMEM_CMP_EQ, 1));
+        res[n++] = static_cast<int64_t>(shmem_int32_wait_until_some(flags, WAIT_VEC_NFLAGS, indices, all_masked,
+                                                                     SHMEM_CMP_EQ, 1));
+        res[n++] = static_cast<int64_t>(shmem_int32_test_any(flags, WAIT_VEC_NFLAGS, nullptr, SHMEM_CMP_NE, 0));
+
+        // cache-line sweep with a stride and exponential backoff, the even flags are already set
+        shmemi_wait_until_all(flags, WAIT_VEC_NFLAGS / 2, nullptr, SHMEM_CMP_EQ, 1, 2, SHMEMI_WAIT_BACKOFF_MIN * 8);
+        // a cap below the first delay backs off by the cap from the first empty sweep
+        shmemi_wait_until_all(flags, WAIT_VEC_NFLAGS / 2, nullptr, SHMEM_CMP_EQ, 1, 2, SHMEMI_WAIT_BACKOFF_MIN / 4);
+        res[n++] = 1;
+        dcci_cachelines((__gm__ uint8_t *)res, n * sizeof(int64_t));
+    }
+#endif
+
+    shmem_barrier_all();
+}
+
+void p2p_wait_vec_do(void *stream, uint64_t config, uint8_t *addr, uint8_t *result, int rank_id, int rank_size) {
+    p2p_wait_vec<<<1, nullptr, stream>>>(config, addr, result, rank_id, rank_size);
 }
\ No newline at end of file
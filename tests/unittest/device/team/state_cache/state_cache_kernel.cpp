@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+// RMA in this translation unit reads the per-core state snapshot taken by shmemx_state_cache_init
+#define SHMEM_DEVICE_STATE_CACHE
+#include "kernel_operator.h"
+#include "shmem_api.h"
+
+// the first cacheline receives the put of the previous PE, then a cacheline per core with the snapshot view and
+// the state version read from GM
+extern "C" __global__ __aicore__ void device_state_cache_test(GM_ADDR gva, int32_t value)
+{
+    shmemx_state_cache_init();
+    int mype = shmem_my_pe();
+    int npes = shmem_n_pes();
+    auto out = (__gm__ int64_t *)(gva + (AscendC::GetBlockIdx() + 1) * SCALAR_DATA_CACHELINE_SIZE);
+    out[0] = mype;
+    out[1] = npes;
+    out[2] = (int64_t)shmem_ptr(gva, (mype + 1) % npes);
+    out[3] = (int64_t)shmemx_state_version();
+    dcci_cacheline((__gm__ uint8_t *)out);
+    if (AscendC::GetBlockIdx() == 0) {
+        shmem_int32_p((__gm__ int32_t *)gva, value, (mype + 1) % npes);
+    }
+}
+
+void get_state_cache(uint32_t block_dim, void* stream, uint8_t* gva, int32_t value)
+{
+    device_state_cache_test<<<block_dim, nullptr, stream>>>(gva, value);
+}
@@ -49,4 +49,31 @@ extern "C" __global__ __aicore__ void device_state_test(GM_ADDR gva, int team_id
 void get_device_state(uint32_t block_dim, void* stream, uint8_t* gva, shmem_team_t team_id)
 {
     device_state_test<<<block_dim, nullptr, stream>>>(gva, (int)team_id);
-}
\ No newline at end of file
+}
+
+extern "C" __global__ __aicore__ void device_state_version_test(GM_ADDR gva)
+{
+    *(__gm__ uint64_t *)gva = shmemx_state_version();
+    dcci_cacheline((__gm__ uint8_t *)gva);
+}
+
+void get_state_version(void* stream, uint8_t* gva)
+{
+    device_state_version_test<<<1, nullptr, stream>>>(gva);
+}
+
+// a cacheline per core, two epochs of the team then its scratch address and size
+extern "C" __global__ __aicore__ void device_team_scratch_test(GM_ADDR gva, int team_id)
+{
+    auto out = (__gm__ int64_t *)gva + AscendC::GetBlockIdx() * SCALAR_DATA_CACHELINE_SIZE / sizeof(int64_t);
+    out[0] = shmemx_team_epoch_next((shmem_team_t)team_id);
+    out[1] = shmemx_team_epoch_next((shmem_team_t)team_id);
+    out[2] = (int64_t)shmemx_team_scratch((shmem_team_t)team_id);
+    out[3] = (int64_t)shmemx_team_scratch_size((shmem_team_t)team_id);
+    dcci_cacheline((__gm__ uint8_t *)out);
+}
+
+void get_team_scratch(uint32_t block_dim, void* stream, uint8_t* gva, shmem_team_t team_id)
+{
+    device_team_scratch_test<<<block_dim, nullptr, stream>>>(gva, (int)team_id);
+}
@@ -0,0 +1,749 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+#include "bfloat16.h"
+#include "fp16_t.h"
+#include "shmemi_host_common.h"
+#include "unittest_main_test.h"
+
+// not a multiple of the 32 bytes split among cores, so that the tails are covered
+constexpr size_t COLL_NELEMS = 4099;
+
+extern void coll_device_do(void *stream, uint64_t config, uint8_t *src, uint8_t *gather_dst, uint64_t nelems);
+extern void coll_allreduce_one_block_do(void *stream, uint64_t config, uint8_t *dst, uint8_t *src, uint64_t nelems);
+extern void coll_reduce_local_do(void *stream, uint8_t *dst, uint8_t *src, int num, uint64_t nelems, int op);
+
+template <typename T>
+static std::vector<T> coll_read(T *ptr, size_t nelems)
+{
+    std::vector<T> host(nelems);
+    EXPECT_EQ(aclrtMemcpy(host.data(), nelems * sizeof(T), ptr, nelems * sizeof(T), ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    return host;
+}
+
+template <typename T>
+static void coll_write(T *ptr, const std::vector<T> &host)
+{
+    EXPECT_EQ(aclrtMemcpy(ptr, host.size() * sizeof(T), host.data(), host.size() * sizeof(T),
+                          ACL_MEMCPY_HOST_TO_DEVICE), 0);
+}
+
+static void test_shmem_coll(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    size_t n = COLL_NELEMS;
+    int32_t *src = (int32_t *)shmem_malloc(n * n_ranks * sizeof(int32_t));
+    int32_t *dst = (int32_t *)shmem_malloc(n * n_ranks * sizeof(int32_t));
+    float *fsrc = (float *)shmem_malloc(n * sizeof(float));
+    ASSERT_NE(src, nullptr);
+    ASSERT_NE(dst, nullptr);
+    ASSERT_NE(fsrc, nullptr);
+
+    // allgather
+    std::vector<int32_t> input(n * n_ranks);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = rank_id * 100000 + (int32_t)i;
+    }
+    coll_write(src, input);
+    shmem_barrier_all();
+    ASSERT_EQ(shmem_int32_allgather_on_stream(SHMEM_TEAM_WORLD, dst, src, n, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    auto out = coll_read(dst, n * n_ranks);
+    for (int pe = 0; pe < n_ranks; pe++) {
+        EXPECT_EQ(out[pe * n], pe * 100000);
+        EXPECT_EQ(out[pe * n + n - 1], pe * 100000 + (int32_t)(n - 1));
+    }
+
+    // broadcast from the last PE
+    ASSERT_EQ(shmem_int32_broadcast_on_stream(SHMEM_TEAM_WORLD, dst, src, n, n_ranks - 1, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    out = coll_read(dst, n);
+    EXPECT_EQ(out[0], (n_ranks - 1) * 100000);
+    EXPECT_EQ(out[n - 1], (n_ranks - 1) * 100000 + (int32_t)(n - 1));
+
+    // alltoall, block j of PE i lands in block i of PE j
+    ASSERT_EQ(shmem_int32_alltoall_on_stream(SHMEM_TEAM_WORLD, dst, src, n, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    out = coll_read(dst, n * n_ranks);
+    for (int pe = 0; pe < n_ranks; pe++) {
+        EXPECT_EQ(out[pe * n], pe * 100000 + (int32_t)(rank_id * n));
+    }
+
+    // max reduce_scatter, the largest PE wins every block
+    ASSERT_EQ(shmem_int32_max_reduce_scatter_on_stream(SHMEM_TEAM_WORLD, dst, src, n, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    out = coll_read(dst, n);
+    EXPECT_EQ(out[0], (n_ranks - 1) * 100000 + (int32_t)(rank_id * n));
+    EXPECT_EQ(out[n - 1], (n_ranks - 1) * 100000 + (int32_t)(rank_id * n + n - 1));
+
+    // float sum allreduce in place
+    std::vector<float> finput(n);
+    for (size_t i = 0; i < n; i++) {
+        finput[i] = (float)(rank_id + 1) + (float)(i % 7);
+    }
+    coll_write(fsrc, finput);
+    shmem_barrier_all();
+    ASSERT_EQ(shmem_float_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, fsrc, fsrc, n, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    auto fout = coll_read(fsrc, n);
+    float rank_sum = (float)(n_ranks * (n_ranks + 1) / 2);
+    for (size_t i = 0; i < n; i += 997) {
+        EXPECT_FLOAT_EQ(fout[i], rank_sum + (float)(n_ranks * (i % 7)));
+    }
+
+    // device API, allgather then int32 sum allreduce in place
+    coll_write(src, input);
+    shmem_barrier_all();
+    coll_device_do(stream, shmemx_get_ffts_config(), (uint8_t *)src, (uint8_t *)dst, n);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    out = coll_read(dst, n * n_ranks);
+    EXPECT_EQ(out[(n_ranks - 1) * n], (n_ranks - 1) * 100000);
+    out = coll_read(src, n);
+    EXPECT_EQ(out[1], 100000 * n_ranks * (n_ranks - 1) / 2 + n_ranks);
+
+    // an invalid team is rejected on the host
+    EXPECT_EQ(shmem_int32_allgather_on_stream(SHMEM_TEAM_INVALID, dst, src, n, stream), SHMEM_INVALID_PARAM);
+
+    shmem_free(fsrc);
+    shmem_free(dst);
+    shmem_free(src);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+// every algorithm able to run on the world team gives the same results as the tuned choice
+static void test_shmem_coll_algo(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    size_t n = COLL_NELEMS;
+    int32_t *src = (int32_t *)shmem_malloc(n * n_ranks * sizeof(int32_t));
+    int32_t *dst = (int32_t *)shmem_malloc(n * n_ranks * sizeof(int32_t));
+    ASSERT_NE(src, nullptr);
+    ASSERT_NE(dst, nullptr);
+    std::vector<int32_t> input(n);
+    for (size_t i = 0; i < n; i++) {
+        input[i] = rank_id * 100000 + (int32_t)i;
+    }
+
+    int algo = SHMEMX_COLL_AUTO;
+    EXPECT_EQ(shmemx_team_get_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, n * sizeof(int32_t), &algo), 0);
+    EXPECT_NE(algo, SHMEMX_COLL_AUTO);
+    EXPECT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLTOALL, SHMEMX_COLL_RING),
+              SHMEM_INVALID_PARAM);
+    EXPECT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_OP_NUM, SHMEMX_COLL_ONE_SHOT),
+              SHMEM_INVALID_PARAM);
+
+    for (algo = SHMEMX_COLL_ONE_SHOT; algo < SHMEMX_COLL_ALGO_NUM; algo++) {
+        if (shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLGATHER, algo) == 0) {
+            coll_write(src, input);
+            shmem_barrier_all();
+            ASSERT_EQ(shmem_int32_allgather_on_stream(SHMEM_TEAM_WORLD, dst, src, n, stream), 0);
+            ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+            auto out = coll_read(dst, n * n_ranks);
+            for (int pe = 0; pe < n_ranks; pe++) {
+                EXPECT_EQ(out[pe * n + n - 1], pe * 100000 + (int32_t)(n - 1)) << "allgather algo " << algo;
+            }
+        }
+        if (shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_BROADCAST, algo) == 0) {
+            coll_write(src, input);
+            shmem_barrier_all();
+            ASSERT_EQ(shmem_int32_broadcast_on_stream(SHMEM_TEAM_WORLD, dst, src, n, n_ranks / 2, stream), 0);
+            ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+            auto out = coll_read(dst, n);
+            EXPECT_EQ(out[n - 1], (n_ranks / 2) * 100000 + (int32_t)(n - 1)) << "broadcast algo " << algo;
+        }
+        if (shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, algo) == 0) {
+            coll_write(src, input);
+            shmem_barrier_all();
+            ASSERT_EQ(shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, src, src, n, stream), 0);
+            ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+            auto out = coll_read(src, n);
+            for (size_t i = 0; i < n; i += 1024) {
+                EXPECT_EQ(out[i], 100000 * n_ranks * (n_ranks - 1) / 2 + n_ranks * (int32_t)i)
+                    << "allreduce algo " << algo;
+            }
+        }
+    }
+    for (int op = 0; op < SHMEMX_COLL_OP_NUM; op++) {
+        EXPECT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, op, SHMEMX_COLL_AUTO), 0);
+    }
+
+    // a tuning row applies to the team at once
+    EXPECT_EQ(shmemx_coll_tune_set(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLTOALL, SIZE_MAX, SHMEMX_COLL_ONE_SHOT), 0);
+    EXPECT_EQ(shmemx_team_get_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLTOALL, 1, &algo), 0);
+    EXPECT_EQ(algo, SHMEMX_COLL_ONE_SHOT);
+
+    shmem_free(dst);
+    shmem_free(src);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+// back-to-back low-latency allreduces, interleaved with a sub-team, flip the buffers without any reset in between
+static void test_shmem_coll_ll(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    shmem_team_t team_even = SHMEM_TEAM_INVALID;
+    shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 2, (n_ranks + 1) / 2, &team_even);
+    int even_size = (n_ranks + 1) / 2;
+
+    size_t n = COLL_NELEMS;
+    int32_t *src = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+    int32_t *dst = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+    int32_t *sub = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+    ASSERT_NE(src, nullptr);
+    ASSERT_NE(dst, nullptr);
+    ASSERT_NE(sub, nullptr);
+    std::vector<int32_t> input(n);
+    for (size_t i = 0; i < n; i++) {
+        input[i] = rank_id + (int32_t)(i % 100);
+    }
+
+    for (int algo = SHMEMX_COLL_LL_ONE_SHOT; algo <= SHMEMX_COLL_LL_TWO_SHOT; algo++) {
+        ASSERT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, algo), 0);
+        if (team_even != SHMEM_TEAM_INVALID) {
+            ASSERT_EQ(shmemx_team_set_coll_algo(team_even, SHMEMX_COLL_ALLREDUCE, algo), 0);
+        }
+        coll_write(src, input);
+        shmem_barrier_all();
+        // world, sub-team, then world twice more, in place the last time, all queued on the stream
+        ASSERT_EQ(shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dst, src, n, stream), 0);
+        if (team_even != SHMEM_TEAM_INVALID) {
+            ASSERT_EQ(shmem_int32_max_allreduce_on_stream(team_even, sub, src, n, stream), 0);
+        }
+        ASSERT_EQ(shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, src, dst, n, stream), 0);
+        ASSERT_EQ(shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, src, src, n, stream), 0);
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+
+        auto out = coll_read(dst, n);
+        auto twice = coll_read(src, n);
+        for (size_t i = 0; i < n; i += 511) {
+            int32_t sum = n_ranks * (n_ranks - 1) / 2 + n_ranks * (int32_t)(i % 100);
+            EXPECT_EQ(out[i], sum) << "ll algo " << algo;
+            EXPECT_EQ(twice[i], n_ranks * n_ranks * sum) << "ll algo " << algo;
+        }
+        if (team_even != SHMEM_TEAM_INVALID) {
+            auto max = coll_read(sub, n);
+            EXPECT_EQ(max[n - 1], 2 * (even_size - 1) + (int32_t)((n - 1) % 100)) << "ll algo " << algo;
+        }
+    }
+
+    // beyond the data slots the call falls back to the barrier-based variant
+    size_t big = SHMEM_COLL_LL_SLOT_SIZE * SHMEM_COLL_LL_MAX_PES / sizeof(int32_t) + 1;
+    int32_t *big_buf = (int32_t *)shmem_malloc(big * sizeof(int32_t));
+    ASSERT_NE(big_buf, nullptr);
+    coll_write(big_buf, std::vector<int32_t>(big, rank_id));
+    shmem_barrier_all();
+    ASSERT_EQ(shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, big_buf, big_buf, big, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    auto out = coll_read(big_buf, big);
+    EXPECT_EQ(out[0], n_ranks * (n_ranks - 1) / 2);
+    EXPECT_EQ(out[big - 1], n_ranks * (n_ranks - 1) / 2);
+
+    EXPECT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLGATHER, SHMEMX_COLL_LL_ONE_SHOT),
+              SHMEM_INVALID_PARAM);
+    EXPECT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, SHMEMX_COLL_AUTO), 0);
+
+    shmem_free(big_buf);
+    shmem_free(sub);
+    shmem_free(dst);
+    shmem_free(src);
+    if (team_even != SHMEM_TEAM_INVALID) {
+        shmem_team_destroy(team_even);
+    }
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+static void test_shmem_coll_pipe(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    shmem_team_t team_even = SHMEM_TEAM_INVALID;
+    shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 2, (n_ranks + 1) / 2, &team_even);
+    int even_size = (n_ranks + 1) / 2;
+    ASSERT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, SHMEMX_COLL_PIPE_RING), 0);
+    if (team_even != SHMEM_TEAM_INVALID) {
+        ASSERT_EQ(shmemx_team_set_coll_algo(team_even, SHMEMX_COLL_ALLREDUCE, SHMEMX_COLL_PIPE_RING), 0);
+    }
+
+    // one unit per core, then several units per core rotating over the lanes
+    for (size_t n : {COLL_NELEMS, (size_t)4 * 1024 * 1024 + 13}) {
+        int32_t *src = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+        int32_t *dst = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+        int32_t *sub = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+        ASSERT_NE(src, nullptr);
+        ASSERT_NE(dst, nullptr);
+        ASSERT_NE(sub, nullptr);
+        std::vector<int32_t> input(n);
+        for (size_t i = 0; i < n; i++) {
+            input[i] = rank_id + (int32_t)(i % 100);
+        }
+        coll_write(src, input);
+        shmem_barrier_all();
+        // world, sub-team, world again, then in place which falls back to ring, all queued on the stream
+        ASSERT_EQ(shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dst, src, n, stream), 0);
+        if (team_even != SHMEM_TEAM_INVALID) {
+            ASSERT_EQ(shmem_int32_max_allreduce_on_stream(team_even, sub, src, n, stream), 0);
+        }
+        ASSERT_EQ(shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, src, dst, n, stream), 0);
+        ASSERT_EQ(shmem_int32_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, src, src, n, stream), 0);
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+
+        auto out = coll_read(dst, n);
+        auto twice = coll_read(src, n);
+        for (size_t i = 0; i < n; i += n / 97 + 1) {
+            int32_t sum = n_ranks * (n_ranks - 1) / 2 + n_ranks * (int32_t)(i % 100);
+            EXPECT_EQ(out[i], sum) << "pipe ring nelems " << n;
+            EXPECT_EQ(twice[i], n_ranks * n_ranks * sum) << "pipe ring nelems " << n;
+        }
+        EXPECT_EQ(out[n - 1], n_ranks * (n_ranks - 1) / 2 + n_ranks * (int32_t)((n - 1) % 100));
+        if (team_even != SHMEM_TEAM_INVALID) {
+            auto max = coll_read(sub, n);
+            EXPECT_EQ(max[n - 1], 2 * (even_size - 1) + (int32_t)((n - 1) % 100)) << "pipe ring nelems " << n;
+        }
+
+        // a one-block device launch, the only one giving a core more than one lane over RoCE
+        coll_write(src, input);
+        shmem_barrier_all();
+        coll_allreduce_one_block_do(stream, shmemx_get_ffts_config(), (uint8_t *)dst, (uint8_t *)src, n);
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+        auto one_block = coll_read(dst, n);
+        for (size_t i = 0; i < n; i += n / 97 + 1) {
+            EXPECT_EQ(one_block[i], n_ranks * (n_ranks - 1) / 2 + n_ranks * (int32_t)(i % 100))
+                << "pipe ring one block nelems " << n;
+        }
+        EXPECT_EQ(one_block[n - 1], n_ranks * (n_ranks - 1) / 2 + n_ranks * (int32_t)((n - 1) % 100));
+        shmem_free(sub);
+        shmem_free(dst);
+        shmem_free(src);
+    }
+
+    EXPECT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLGATHER, SHMEMX_COLL_PIPE_RING),
+              SHMEM_INVALID_PARAM);
+    EXPECT_EQ(shmemx_team_set_coll_algo(SHMEM_TEAM_WORLD, SHMEMX_COLL_ALLREDUCE, SHMEMX_COLL_AUTO), 0);
+    if (team_even != SHMEM_TEAM_INVALID) {
+        shmem_team_destroy(team_even);
+    }
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+// elements member i sends to member j, zero for a third of the pairs
+static uint32_t alltoallv_count(int i, int j)
+{
+    return (uint32_t)((i + 2 * j) % 3) * 129;
+}
+
+static int32_t alltoallv_value(int i, int j, uint32_t k)
+{
+    return i * 1000000 + j * 10000 + (int32_t)k;
+}
+
+static void test_shmem_coll_alltoallv(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    const uint32_t max_count = 2 * 129;
+    const size_t stride = 200;  // cuts the largest blocks
+    size_t n = (size_t)max_count * n_ranks;
+    int32_t *src = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+    int32_t *reversed = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+    int32_t *packed = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+    int32_t *strided = (int32_t *)shmem_malloc(stride * n_ranks * sizeof(int32_t));
+    int32_t *from_reversed = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+    uint32_t *meta = (uint32_t *)shmem_malloc((4 * n_ranks + 2) * sizeof(uint32_t));
+    uint64_t *offsets_out = (uint64_t *)shmem_malloc(2 * n_ranks * sizeof(uint64_t));
+    ASSERT_NE(src, nullptr);
+    ASSERT_NE(reversed, nullptr);
+    ASSERT_NE(packed, nullptr);
+    ASSERT_NE(strided, nullptr);
+    ASSERT_NE(from_reversed, nullptr);
+    ASSERT_NE(meta, nullptr);
+    ASSERT_NE(offsets_out, nullptr);
+    uint32_t *send_counts = meta;
+    uint32_t *send_offsets = meta + n_ranks;
+    uint32_t *recv_counts = meta + 2 * n_ranks;
+    uint32_t *strided_counts = meta + 3 * n_ranks;
+    uint32_t *truncated = meta + 4 * n_ranks;
+    uint32_t *strided_truncated = meta + 4 * n_ranks + 1;
+    uint64_t *recv_offsets = offsets_out;
+    uint64_t *strided_offsets = offsets_out + n_ranks;
+
+    // the same blocks packed in team order in src and in reverse team order in reversed
+    std::vector<uint32_t> counts(n_ranks);
+    std::vector<uint32_t> offsets(n_ranks);
+    std::vector<int32_t> input;
+    std::vector<int32_t> input_reversed;
+    for (int j = 0; j < n_ranks; j++) {
+        counts[j] = alltoallv_count(rank_id, j);
+        for (uint32_t k = 0; k < counts[j]; k++) {
+            input.push_back(alltoallv_value(rank_id, j, k));
+        }
+    }
+    for (int j = n_ranks - 1; j >= 0; j--) {
+        offsets[j] = (uint32_t)input_reversed.size();
+        for (uint32_t k = 0; k < counts[j]; k++) {
+            input_reversed.push_back(alltoallv_value(rank_id, j, k));
+        }
+    }
+    input.resize(n, -1);
+    input_reversed.resize(n, -1);
+    coll_write(src, input);
+    coll_write(reversed, input_reversed);
+    coll_write(send_counts, counts);
+    coll_write(send_offsets, offsets);
+    shmem_barrier_all();
+
+    // back to back on the stream, the flags of a call are reset before the next one sets them
+    ASSERT_EQ(shmemx_int32_alltoallv_on_stream(SHMEM_TEAM_WORLD, packed, 0, src, send_counts, nullptr, recv_counts,
+                                               recv_offsets, truncated, stream), 0);
+    ASSERT_EQ(shmemx_int32_alltoallv_on_stream(SHMEM_TEAM_WORLD, strided, stride, src, send_counts, nullptr,
+                                               strided_counts, strided_offsets, strided_truncated, stream), 0);
+    ASSERT_EQ(shmemx_int32_alltoallv_on_stream(SHMEM_TEAM_WORLD, from_reversed, 0, reversed, send_counts,
+                                               send_offsets, nullptr, nullptr, nullptr, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+
+    auto out = coll_read(packed, n);
+    auto out_strided = coll_read(strided, stride * n_ranks);
+    auto out_reversed = coll_read(from_reversed, n);
+    auto info = coll_read(meta, 4 * (size_t)n_ranks + 2);
+    auto info_offsets = coll_read(offsets_out, 2 * (size_t)n_ranks);
+    uint64_t offset = 0;
+    uint32_t cut_blocks = 0;
+    for (int i = 0; i < n_ranks; i++) {
+        uint32_t count = alltoallv_count(i, rank_id);
+        uint32_t cut = count < stride ? count : (uint32_t)stride;
+        cut_blocks += count > stride ? 1 : 0;
+        EXPECT_EQ(info[2 * n_ranks + i], count) << "from " << i;
+        EXPECT_EQ(info_offsets[i], offset) << "from " << i;
+        EXPECT_EQ(info[3 * n_ranks + i], cut) << "from " << i;
+        EXPECT_EQ(info_offsets[n_ranks + i], (uint64_t)i * stride) << "from " << i;
+        if (count > 0) {
+            EXPECT_EQ(out[offset], alltoallv_value(i, rank_id, 0)) << "from " << i;
+            EXPECT_EQ(out[offset + count - 1], alltoallv_value(i, rank_id, count - 1)) << "from " << i;
+            EXPECT_EQ(out_reversed[offset + count - 1], alltoallv_value(i, rank_id, count - 1)) << "from " << i;
+            EXPECT_EQ(out_strided[i * stride + cut - 1], alltoallv_value(i, rank_id, cut - 1)) << "from " << i;
+        }
+        offset += count;
+    }
+    EXPECT_EQ(info[4 * n_ranks], 0u);
+    EXPECT_EQ(info[4 * n_ranks + 1], cut_blocks);
+
+    shmem_free(offsets_out);
+    shmem_free(meta);
+    shmem_free(from_reversed);
+    shmem_free(strided);
+    shmem_free(packed);
+    shmem_free(reversed);
+    shmem_free(src);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+static float quant_value(int pe, size_t i)
+{
+    return (float)((pe + 1) * ((int)(i % 97) - 48)) / 16;
+}
+
+static void test_shmem_coll_quant(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    size_t n = COLL_NELEMS;
+    std::vector<float> input(n);
+    for (size_t i = 0; i < n; i++) {
+        input[i] = quant_value(rank_id, i);
+    }
+    // a quantization step of the largest absolute sum, every PE adds at most half a step of its own block
+    float sum_absmax = 48.0f * n_ranks * (n_ranks + 1) / 2 / 16;
+
+    float *src = (float *)shmem_malloc(n * sizeof(float));
+    float *dst = (float *)shmem_malloc(n * n_ranks * sizeof(float));
+    float *error = (float *)shmem_malloc(n * sizeof(float));
+    // bfloat16 takes the larger work buffer
+    shmemx_quant_config_t config = {SHMEMX_QUANT_BF16, 64, 0, 0};
+    size_t work_size = shmemx_quant_work_size(n, &config);
+    config.format = SHMEMX_QUANT_INT8;
+    EXPECT_LT(shmemx_quant_work_size(n, &config), work_size);
+    void *work = shmem_malloc(work_size);
+    ASSERT_NE(src, nullptr);
+    ASSERT_NE(dst, nullptr);
+    ASSERT_NE(error, nullptr);
+    ASSERT_NE(work, nullptr);
+    config.work = (uint64_t)work;
+    coll_write(src, input);
+    shmem_barrier_all();
+
+    for (int format = SHMEMX_QUANT_BF16; format < SHMEMX_QUANT_FORMAT_NUM; format++) {
+        config.format = format;
+        float step = format == SHMEMX_QUANT_INT8 ? sum_absmax / 127 : sum_absmax / 128;
+        ASSERT_EQ(shmemx_float_sum_allreduce_quant_on_stream(SHMEM_TEAM_WORLD, dst, src, n, &config, stream), 0);
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+        auto out = coll_read(dst, n);
+        for (size_t i = 0; i < n; i += 37) {
+            float sum = 0;
+            for (int pe = 0; pe < n_ranks; pe++) {
+                sum += quant_value(pe, i);
+            }
+            EXPECT_NEAR(out[i], sum, 2 * step) << "format " << format << " element " << i;
+        }
+
+        ASSERT_EQ(shmemx_float_allgather_quant_on_stream(SHMEM_TEAM_WORLD, dst, src, n, &config, stream), 0);
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+        out = coll_read(dst, n * n_ranks);
+        for (int pe = 0; pe < n_ranks; pe++) {
+            float pe_step = 48.0f * (pe + 1) / 16 / 127;
+            EXPECT_NEAR(out[pe * n + n - 1], quant_value(pe, n - 1), pe_step) << "format " << format;
+            EXPECT_NEAR(out[pe * n + 5], quant_value(pe, 5), pe_step) << "format " << format;
+        }
+    }
+
+    // error feedback, what the own block lost is left in the error buffer
+    config.format = SHMEMX_QUANT_INT8;
+    config.error = (uint64_t)error;
+    coll_write(error, std::vector<float>(n, 0.0f));
+    ASSERT_EQ(shmemx_float_allgather_quant_on_stream(SHMEM_TEAM_WORLD, dst, src, n, &config, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    auto out = coll_read(dst, n * n_ranks);
+    auto residual = coll_read(error, n);
+    for (size_t i = 0; i < n; i += 41) {
+        EXPECT_NEAR(out[rank_id * n + i] + residual[i], input[i], 1e-4) << "element " << i;
+    }
+
+    // without a work buffer the scratch of the team is taken on first use
+    shmemx_quant_config_t scratch_config = {SHMEMX_QUANT_INT8, 64, 0, 0};
+    ASSERT_EQ(shmemx_float_allgather_quant_on_stream(SHMEM_TEAM_WORLD, dst, src, n, &scratch_config, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    out = coll_read(dst, n * n_ranks);
+    for (int pe = 0; pe < n_ranks; pe++) {
+        EXPECT_NEAR(out[pe * n + 5], quant_value(pe, 5), 48.0f * (pe + 1) / 16 / 127) << "scratch";
+    }
+    shmemx_team_scratch_stats_t stats;
+    ASSERT_EQ(shmemx_team_scratch_stats(SHMEM_TEAM_WORLD, &stats), 0);
+    EXPECT_EQ(stats.requests, 1);
+    EXPECT_GE(stats.size, shmemx_quant_work_size(n, &scratch_config));
+
+    // invalid configurations are rejected on the host
+    shmemx_quant_config_t bad = config;
+    bad.block_size = 48;
+    EXPECT_EQ(shmemx_quant_work_size(n, &bad), 0);
+    EXPECT_EQ(shmemx_float_sum_allreduce_quant_on_stream(SHMEM_TEAM_WORLD, dst, src, n, &bad, stream),
+              SHMEM_INVALID_PARAM);
+    bad = config;
+    bad.format = SHMEMX_QUANT_FORMAT_NUM;
+    EXPECT_EQ(shmemx_float_allgather_quant_on_stream(SHMEM_TEAM_WORLD, dst, src, n, &bad, stream),
+              SHMEM_INVALID_PARAM);
+    EXPECT_EQ(shmemx_float_allgather_quant_on_stream(SHMEM_TEAM_WORLD, dst, src, n, nullptr, stream),
+              SHMEM_INVALID_PARAM);
+
+    shmem_free(work);
+    shmem_free(error);
+    shmem_free(dst);
+    shmem_free(src);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+// bit pattern of a host op::fp16_t or op::bfloat16, as carried by shmem_half_t and shmem_bfloat16_t
+template <typename T>
+static uint16_t fp16_bits(T value)
+{
+    uint16_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// half and bfloat16 through the typed host RMA, the host collectives and the local vector reductions
+static void test_shmem_coll_low_precision(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    size_t n = COLL_NELEMS;
+    int next = (rank_id + 1) % n_ranks;
+    int prev = (rank_id + n_ranks - 1) % n_ranks;
+    auto *src = (shmem_bfloat16_t *)shmem_malloc(n * sizeof(shmem_bfloat16_t));
+    auto *dst = (shmem_bfloat16_t *)shmem_malloc((n * n_ranks + 1) * sizeof(shmem_bfloat16_t));
+    ASSERT_NE(src, nullptr);
+    ASSERT_NE(dst, nullptr);
+    coll_write(src, std::vector<shmem_bfloat16_t>(n, fp16_bits(op::bfloat16((float)(rank_id + 1)))));
+    shmem_barrier_all();
+
+    // typed put to the next PE and get back from it
+    shmem_put_bfloat16_mem(dst, src, n, next);
+    ASSERT_EQ(aclrtSynchronizeStream(g_state_host.default_stream), 0);
+    shmem_barrier_all();
+    auto out = coll_read(dst, n);
+    EXPECT_EQ(out[0], fp16_bits(op::bfloat16((float)(prev + 1))));
+    EXPECT_EQ(out[n - 1], fp16_bits(op::bfloat16((float)(prev + 1))));
+    EXPECT_EQ(shmem_bfloat16_g(dst, next), fp16_bits(op::bfloat16((float)(rank_id + 1))));
+
+    // a single half element, put by its bits
+    shmem_half_t *half_elem = (shmem_half_t *)dst + n * n_ranks;
+    shmem_half_p(half_elem, fp16_bits(op::fp16_t(0.5f)), next);
+    ASSERT_EQ(aclrtSynchronizeStream(g_state_host.default_stream), 0);
+    shmem_barrier_all();
+    EXPECT_EQ(shmem_half_g(half_elem, prev), fp16_bits(op::fp16_t(0.5f)));
+
+    // host collectives
+    ASSERT_EQ(shmem_bfloat16_allgather_on_stream(SHMEM_TEAM_WORLD, dst, src, n, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    out = coll_read(dst, n * n_ranks);
+    for (int pe = 0; pe < n_ranks; pe++) {
+        EXPECT_EQ(out[pe * n + n - 1], fp16_bits(op::bfloat16((float)(pe + 1))));
+    }
+    ASSERT_EQ(shmem_bfloat16_sum_allreduce_on_stream(SHMEM_TEAM_WORLD, dst, src, n, stream), 0);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    out = coll_read(dst, n);
+    EXPECT_EQ(out[0], fp16_bits(op::bfloat16((float)(n_ranks * (n_ranks + 1) / 2))));
+    EXPECT_EQ(out[n - 1], fp16_bits(op::bfloat16((float)(n_ranks * (n_ranks + 1) / 2))));
+
+    /* local half sum of 16 blocks, 1024 then fifteen 0.5. Accumulated in half every 0.5 is lost to rounding,
+       accumulated in float 1031.5 is rounded once to 1032. */
+    constexpr int sum_blocks = 16;
+    void *blocks = nullptr;
+    void *result = nullptr;
+    ASSERT_EQ(aclrtMalloc(&blocks, sum_blocks * n * sizeof(shmem_half_t), ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    ASSERT_EQ(aclrtMalloc(&result, n * sizeof(shmem_half_t), ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    std::vector<shmem_half_t> input(sum_blocks * n, fp16_bits(op::fp16_t(0.5f)));
+    std::fill(input.begin(), input.begin() + n, fp16_bits(op::fp16_t(1024.0f)));
+    coll_write((shmem_half_t *)blocks, input);
+    coll_reduce_local_do(stream, (uint8_t *)result, (uint8_t *)blocks, sum_blocks, n, SHMEMI_REDUCE_SUM);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    auto half_out = coll_read((shmem_half_t *)result, n);
+    EXPECT_EQ(half_out[0], fp16_bits(op::fp16_t(1032.0f)));
+    EXPECT_EQ(half_out[n - 1], fp16_bits(op::fp16_t(1032.0f)));
+
+    // blocks 1, 2, 3, 4 for the other operations, the result written over the first block
+    static const int ops[] = {SHMEMI_REDUCE_MAX, SHMEMI_REDUCE_MIN, SHMEMI_REDUCE_PROD};
+    static const float expected[] = {4.0f, 1.0f, 24.0f};
+    for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); k++) {
+        for (int b = 0; b < 4; b++) {
+            std::fill(input.begin() + b * n, input.begin() + (b + 1) * n, fp16_bits(op::fp16_t((float)(b + 1))));
+        }
+        coll_write((shmem_half_t *)blocks, std::vector<shmem_half_t>(input.begin(), input.begin() + 4 * n));
+        coll_reduce_local_do(stream, (uint8_t *)blocks, (uint8_t *)blocks, 4, n, ops[k]);
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+        half_out = coll_read((shmem_half_t *)blocks, n);
+        EXPECT_EQ(half_out[0], fp16_bits(op::fp16_t(expected[k]))) << "op " << ops[k];
+        EXPECT_EQ(half_out[n - 1], fp16_bits(op::fp16_t(expected[k]))) << "op " << ops[k];
+    }
+
+    EXPECT_EQ(aclrtFree(result), 0);
+    EXPECT_EQ(aclrtFree(blocks), 0);
+    shmem_free(dst);
+    shmem_free(src);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestCollFunc, TestShmemColl)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 64;
+    test_mutil_task(test_shmem_coll, local_mem_size, process_count);
+}
+
+TEST(TestCollFunc, TestShmemCollAlgo)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 64;
+    test_mutil_task(test_shmem_coll_algo, local_mem_size, process_count);
+}
+
+TEST(TestCollFunc, TestShmemCollLowLatency)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 64;
+    test_mutil_task(test_shmem_coll_ll, local_mem_size, process_count);
+}
+
+TEST(TestCollFunc, TestShmemCollPipeRing)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 64;
+    test_mutil_task(test_shmem_coll_pipe, local_mem_size, process_count);
+}
+
+TEST(TestCollFunc, TestShmemCollAlltoallv)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 64;
+    test_mutil_task(test_shmem_coll_alltoallv, local_mem_size, process_count);
+}
+
+TEST(TestCollFunc, TestShmemCollQuant)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 256;
+    test_mutil_task(test_shmem_coll_quant, local_mem_size, process_count);
+}
+
+TEST(TestCollFunc, TestShmemCollLowPrecision)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 64;
+    test_mutil_task(test_shmem_coll_low_precision, local_mem_size, process_count);
+}
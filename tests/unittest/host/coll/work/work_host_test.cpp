@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+#include "unittest_main_test.h"
+
+// not a multiple of the 32 bytes split among cores, so that the tails are covered
+constexpr size_t WORK_NELEMS = 1027;
+constexpr uint32_t WORK_BLOCK_DIM = 2;
+constexpr uint32_t WORK_DEPTH = 4;
+
+extern void work_device_do(void *stream, uint64_t config, uint8_t *src, uint8_t *gather_dst, uint64_t nbytes);
+
+template <typename T>
+static std::vector<T> work_read(T *ptr, size_t nelems)
+{
+    std::vector<T> host(nelems);
+    EXPECT_EQ(aclrtMemcpy(host.data(), nelems * sizeof(T), ptr, nelems * sizeof(T), ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    return host;
+}
+
+template <typename T>
+static void work_write(T *ptr, const std::vector<T> &host)
+{
+    EXPECT_EQ(aclrtMemcpy(ptr, host.size() * sizeof(T), host.data(), host.size() * sizeof(T),
+                          ACL_MEMCPY_HOST_TO_DEVICE), 0);
+}
+
+static void test_shmem_work_queue(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    size_t n = WORK_NELEMS;
+    int32_t *src = (int32_t *)shmem_malloc(n * sizeof(int32_t));
+    int32_t *dst = (int32_t *)shmem_malloc(n * n_ranks * sizeof(int32_t));
+    int32_t *flags = (int32_t *)shmem_malloc(2 * sizeof(int32_t));
+    ASSERT_NE(src, nullptr);
+    ASSERT_NE(dst, nullptr);
+    ASSERT_NE(flags, nullptr);
+    std::vector<int32_t> input(n);
+    for (size_t i = 0; i < n; i++) {
+        input[i] = rank_id * 100000 + (int32_t)i;
+    }
+    work_write(src, input);
+    work_write(flags, std::vector<int32_t>(2, 0));
+    shmem_barrier_all();
+
+    // a depth that is not a power of two and a second start are rejected
+    EXPECT_EQ(shmemx_work_queue_start(3, WORK_BLOCK_DIM, 0), SHMEM_INVALID_PARAM);
+    ASSERT_EQ(shmemx_work_queue_start(WORK_DEPTH, WORK_BLOCK_DIM, SHMEMX_WORK_QUEUE_DEVICE_PRODUCERS), 0);
+    EXPECT_EQ(shmemx_work_queue_start(WORK_DEPTH, WORK_BLOCK_DIM, 0), SHMEM_INVALID_PARAM);
+
+    // put with signal to the right neighbour
+    int right = (rank_id + 1) % n_ranks;
+    shmemx_work_desc_t desc = {};
+    desc.op = SHMEMX_WORK_PUT_SIGNAL;
+    desc.pe = right;
+    desc.dest = (uint64_t)dst;
+    desc.source = (uint64_t)src;
+    desc.size = n * sizeof(int32_t);
+    desc.sig_addr = (uint64_t)&flags[0];
+    desc.sig_op = SHMEM_SIGNAL_SET;
+    desc.signal = 1;
+    uint64_t ticket = 0;
+    ASSERT_EQ(shmemx_work_submit(&desc, &ticket), 0);
+    ASSERT_EQ(shmemx_work_wait(ticket), 0);
+    shmem_barrier_all();
+    int left = (rank_id + n_ranks - 1) % n_ranks;
+    auto out = work_read(dst, n);
+    EXPECT_EQ(out[0], left * 100000);
+    EXPECT_EQ(out[n - 1], left * 100000 + (int32_t)(n - 1));
+    EXPECT_EQ(work_read(flags, 1)[0], 1);
+
+    // more sum allreduces than slots, the last one sets the completion flag
+    desc = {};
+    desc.op = SHMEMX_WORK_ALLREDUCE;
+    desc.team = SHMEM_TEAM_WORLD;
+    desc.dtype = SHMEMX_WORK_INT32;
+    desc.reduce_op = SHMEMI_REDUCE_SUM;
+    desc.dest = (uint64_t)dst;
+    desc.source = (uint64_t)src;
+    desc.size = n;
+    for (uint32_t i = 0; i < 2 * WORK_DEPTH; i++) {
+        if (i + 1 == 2 * WORK_DEPTH) {
+            desc.done_flag = (uint64_t)&flags[1];
+            desc.done_value = 7;
+        }
+        ASSERT_EQ(shmemx_work_submit(&desc, &ticket), 0);
+    }
+    ASSERT_EQ(shmemx_work_wait(ticket), 0);
+    int done = 0;
+    EXPECT_EQ(shmemx_work_test(ticket, &done), 0);
+    EXPECT_EQ(done, 1);
+    EXPECT_EQ(work_read(flags, 2)[1], 7);
+    out = work_read(dst, n);
+    EXPECT_EQ(out[1], 100000 * n_ranks * (n_ranks - 1) / 2 + n_ranks);
+
+    // device producer, allgather submitted by a kernel
+    work_device_do(stream, shmemx_get_ffts_config(), (uint8_t *)src, (uint8_t *)dst, n * sizeof(int32_t));
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    out = work_read(dst, n * n_ranks);
+    for (int pe = 0; pe < n_ranks; pe++) {
+        EXPECT_EQ(out[pe * n], pe * 100000);
+        EXPECT_EQ(out[pe * n + n - 1], pe * 100000 + (int32_t)(n - 1));
+    }
+
+    // invalid descriptors are rejected on the host
+    desc = {};
+    desc.op = SHMEMX_WORK_PUT;
+    desc.pe = n_ranks;
+    EXPECT_EQ(shmemx_work_submit(&desc, &ticket), SHMEM_INVALID_PARAM);
+    desc.op = SHMEMX_WORK_BARRIER;
+    desc.team = SHMEM_TEAM_INVALID;
+    EXPECT_EQ(shmemx_work_submit(&desc, &ticket), SHMEM_INVALID_PARAM);
+    desc.op = SHMEMX_WORK_OP_NUM;
+    EXPECT_EQ(shmemx_work_submit(&desc, &ticket), SHMEM_INVALID_PARAM);
+
+    EXPECT_EQ(shmemx_work_queue_stop(), 0);
+    EXPECT_EQ(shmemx_work_queue_stop(), SHMEM_INVALID_PARAM);
+    desc.op = SHMEMX_WORK_NOP;
+    EXPECT_EQ(shmemx_work_submit(&desc, &ticket), SHMEM_INVALID_PARAM);
+
+    shmem_free(flags);
+    shmem_free(dst);
+    shmem_free(src);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestWorkQueue, TestShmemWorkQueue)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 64;
+    test_mutil_task(test_shmem_work_queue, local_mem_size, process_count);
+}
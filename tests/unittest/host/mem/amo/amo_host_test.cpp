@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+#include "unittest_main_test.h"
+
+constexpr int AMO_WORDS = 4;
+
+#define AMO_DO(NAME, TYPE) \
+    extern void NAME##_amo_do(void *stream, uint64_t config, uint8_t *gva, uint8_t *dev, int rank_id)
+
+SHMEM_AMO_TYPE_FUNC(AMO_DO);
+
+#define TEST_DEVICE_AMO(NAME, TYPE)                                                                              \
+    static void test_##NAME##_device_amo(int rank_id, int n_ranks, uint64_t local_mem_size)                      \
+    {                                                                                                            \
+        aclrtStream stream;                                                                                      \
+        test_init(rank_id, n_ranks, local_mem_size, &stream);                                                    \
+        ASSERT_NE(stream, nullptr);                                                                              \
+                                                                                                                 \
+        TYPE *addr = (TYPE *)shmem_malloc(AMO_WORDS * sizeof(TYPE));                                             \
+        ASSERT_EQ(aclrtMemset(addr, AMO_WORDS * sizeof(TYPE), 0, AMO_WORDS * sizeof(TYPE)), 0);                  \
+        void *dev_ptr;                                                                                           \
+        ASSERT_EQ(aclrtMalloc(&dev_ptr, AMO_WORDS * sizeof(TYPE), ACL_MEM_MALLOC_NORMAL_ONLY), 0);               \
+        shmem_barrier_all();                                                                                     \
+                                                                                                                 \
+        NAME##_amo_do(stream, shmemx_get_ffts_config(), (uint8_t *)addr, (uint8_t *)dev_ptr, rank_id);           \
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);                                                            \
+                                                                                                                 \
+        TYPE fetched[AMO_WORDS];                                                                                 \
+        ASSERT_EQ(aclrtMemcpy(fetched, sizeof(fetched), dev_ptr, sizeof(fetched), ACL_MEMCPY_DEVICE_TO_HOST), 0); \
+        EXPECT_LT(fetched[0], (TYPE)n_ranks);                                                                    \
+        EXPECT_LE(fetched[1], (TYPE)n_ranks);                                                                    \
+        EXPECT_EQ(fetched[2] & ((TYPE)1 << (rank_id % 32)), (TYPE)0);                                            \
+        EXPECT_EQ(fetched[3], (TYPE)n_ranks);                                                                    \
+                                                                                                                 \
+        if (rank_id == 0) {                                                                                      \
+            TYPE result[AMO_WORDS];                                                                              \
+            ASSERT_EQ(aclrtMemcpy(result, sizeof(result), addr, sizeof(result), ACL_MEMCPY_DEVICE_TO_HOST), 0);  \
+            EXPECT_EQ(result[0], (TYPE)n_ranks);                                                                 \
+            EXPECT_GE(result[1], (TYPE)1);                                                                       \
+            EXPECT_LE(result[1], (TYPE)n_ranks);                                                                 \
+        }                                                                                                        \
+        shmem_barrier_all();                                                                                     \
+                                                                                                                 \
+        /* host wrappers */                                                                                      \
+        TYPE old = shmem_##NAME##_atomic_fetch_add(addr, (TYPE)1, 0);                                            \
+        EXPECT_GE(old, (TYPE)n_ranks);                                                                           \
+        shmem_##NAME##_atomic_add(addr, (TYPE)1, 0);                                                             \
+        ASSERT_EQ(aclrtSynchronizeStream(g_state_host.default_stream), 0);                                       \
+        shmem_barrier_all();                                                                                     \
+        EXPECT_EQ(shmem_##NAME##_atomic_fetch(addr, 0), (TYPE)(n_ranks * 3));                                    \
+        shmem_barrier_all();                                                                                     \
+                                                                                                                 \
+        /* on the stream of the caller, the fetched value lands in device memory */                              \
+        ASSERT_EQ(shmemx_##NAME##_atomic_fetch_add_on_stream(addr, (TYPE)1, 0, (TYPE *)dev_ptr, stream), 0);     \
+        ASSERT_EQ(shmemx_##NAME##_atomic_add_on_stream(addr, (TYPE)1, 0, stream), 0);                            \
+        EXPECT_EQ(shmemx_##NAME##_atomic_add_on_stream(addr, (TYPE)1, n_ranks, stream), SHMEM_INVALID_PARAM);    \
+        ASSERT_EQ(aclrtSynchronizeStream(stream), 0);                                                            \
+        TYPE streamed = 0;                                                                                       \
+        ASSERT_EQ(aclrtMemcpy(&streamed, sizeof(TYPE), dev_ptr, sizeof(TYPE), ACL_MEMCPY_DEVICE_TO_HOST), 0);    \
+        EXPECT_GE(streamed, (TYPE)(n_ranks * 3));                                                                \
+        shmem_barrier_all();                                                                                     \
+        EXPECT_EQ(shmem_##NAME##_atomic_fetch(addr, 0), (TYPE)(n_ranks * 5));                                    \
+                                                                                                                 \
+        ASSERT_EQ(aclrtFree(dev_ptr), 0);                                                                        \
+        shmem_free(addr);                                                                                        \
+        int32_t dev_id = rank_id % test_gnpu_num + test_first_npu;                                               \
+        test_finalize(stream, dev_id);                                                                           \
+        if (::testing::Test::HasFailure()) {                                                                     \
+            exit(1);                                                                                             \
+        }                                                                                                        \
+    }                                                                                                            \
+                                                                                                                 \
+    TEST(TEST_AMO_API, test_##NAME##_device_amo)                                                                 \
+    {                                                                                                            \
+        const int32_t process_count = test_gnpu_num;                                                             \
+        uint64_t local_mem_size = 1024UL * 1024UL * 16;                                                          \
+        test_mutil_task(test_##NAME##_device_amo, local_mem_size, process_count);                                \
+    }
+
+SHMEM_AMO_TYPE_FUNC(TEST_DEVICE_AMO);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmem_api.h"
+#include "shmemi_host_common.h"
+#include "unittest_main_test.h"
+
+constexpr uint32_t CTX_ELEMS = 1024;
+
+extern void ctx_put_get_do(void *stream, uint64_t config, uint8_t *gva, uint8_t *src, uint8_t *dev, int ctx,
+                           uint32_t elem_size);
+
+static void test_ctx_put_get(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    shmem_ctx_t ctx = SHMEM_CTX_INVALID;
+    ASSERT_EQ(shmem_ctx_create(0, &ctx), 0);
+    ASSERT_NE(ctx, SHMEM_CTX_INVALID);
+    ASSERT_NE(ctx, SHMEM_CTX_DEFAULT);
+    shmem_team_t team = SHMEM_TEAM_INVALID;
+    ASSERT_EQ(shmem_ctx_get_team(ctx, &team), 0);
+    EXPECT_EQ(team, SHMEM_TEAM_WORLD);
+    shmem_team_config_t config;
+    ASSERT_EQ(shmem_team_get_config(SHMEM_TEAM_WORLD, &config), 0);
+    EXPECT_EQ(config.num_contexts, 2);
+
+    size_t bytes = CTX_ELEMS * sizeof(float);
+    std::vector<float> input(CTX_ELEMS);
+    for (uint32_t i = 0; i < CTX_ELEMS; i++) {
+        input[i] = (float)(rank_id * CTX_ELEMS + i);
+    }
+    float *gva = (float *)shmem_malloc(bytes);
+    float *src = (float *)shmem_malloc(bytes);
+    ASSERT_NE(gva, nullptr);
+    ASSERT_NE(src, nullptr);
+    ASSERT_EQ(aclrtMemcpy(src, bytes, input.data(), bytes, ACL_MEMCPY_HOST_TO_DEVICE), 0);
+    void *dev_ptr;
+    ASSERT_EQ(aclrtMalloc(&dev_ptr, bytes, ACL_MEM_MALLOC_NORMAL_ONLY), 0);
+    shmem_barrier_all();
+
+    ctx_put_get_do(stream, shmemx_get_ffts_config(), (uint8_t *)gva, (uint8_t *)src, (uint8_t *)dev_ptr, ctx,
+                   CTX_ELEMS);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+
+    int prev = (rank_id + n_ranks - 1) % n_ranks;
+    std::vector<float> put_result(CTX_ELEMS);
+    std::vector<float> get_result(CTX_ELEMS);
+    ASSERT_EQ(aclrtMemcpy(put_result.data(), bytes, gva, bytes, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    ASSERT_EQ(aclrtMemcpy(get_result.data(), bytes, dev_ptr, bytes, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    for (uint32_t i = 0; i < CTX_ELEMS; i++) {
+        EXPECT_EQ(put_result[i], (float)(prev * CTX_ELEMS + i));
+        EXPECT_EQ(get_result[i], (float)(prev * CTX_ELEMS + i));
+    }
+
+    shmem_ctx_destroy(ctx);
+    ASSERT_EQ(shmem_team_get_config(SHMEM_TEAM_WORLD, &config), 0);
+    EXPECT_EQ(config.num_contexts, 1);
+    EXPECT_NE(shmem_ctx_get_team(ctx, &team), 0);
+
+    ASSERT_EQ(aclrtFree(dev_ptr), 0);
+    shmem_free(src);
+    shmem_free(gva);
+    int32_t dev_id = rank_id % test_gnpu_num + test_first_npu;
+    test_finalize(stream, dev_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+static void test_ctx_team_destroy(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    shmem_team_t team = SHMEM_TEAM_INVALID;
+    ASSERT_EQ(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team), 0);
+    ASSERT_NE(team, SHMEM_TEAM_INVALID);
+
+    std::vector<shmem_ctx_t> ctxs;
+    shmem_ctx_t ctx = SHMEM_CTX_INVALID;
+    while (shmem_team_create_ctx(team, SHMEM_CTX_PRIVATE, &ctx) == 0) {
+        ctxs.push_back(ctx);
+    }
+    EXPECT_EQ(ctx, SHMEM_CTX_INVALID);
+    EXPECT_EQ(ctxs.size(), (size_t)(SHMEM_MAX_CTXS - 1));
+
+    shmem_team_config_t config;
+    ASSERT_EQ(shmem_team_get_config(team, &config), 0);
+    EXPECT_EQ(config.num_contexts, SHMEM_MAX_CTXS - 1);
+
+    shmem_team_destroy(team);
+    for (auto c : ctxs) {
+        EXPECT_NE(shmem_ctx_get_team(c, &team), 0);
+    }
+    EXPECT_EQ(shmem_ctx_create(0, &ctx), 0);
+    shmem_ctx_destroy(ctx);
+
+    int32_t dev_id = rank_id % test_gnpu_num + test_first_npu;
+    test_finalize(stream, dev_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TEST_CTX_API, test_ctx_put_get)
+{
+    const int32_t process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 16;
+    test_mutil_task(test_ctx_put_get, local_mem_size, process_count);
+}
+
+TEST(TEST_CTX_API, test_ctx_team_destroy)
+{
+    const int32_t process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 16;
+    test_mutil_task(test_ctx_team_destroy, local_mem_size, process_count);
+}
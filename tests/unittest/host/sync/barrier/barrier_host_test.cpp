@@ -19,6 +19,9 @@
 
 constexpr int32_t SHMEM_BARRIER_TEST_NUM = 3;
 
+extern void increase_split_do(void *stream, uint64_t config, uint8_t *addr, int rank_id, int rank_size,
+                              int use_test);
+
 static void test_barrier_black_box(int32_t rank_id, int32_t n_ranks, uint64_t local_mem_size)
 {
     int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
@@ -126,6 +129,102 @@ static void test_barrier_black_box_odd_team(int32_t rank_id, int32_t n_ranks, ui
     }
 }
 
+static void test_barrier_black_box_algos(int32_t rank_id, int32_t n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    int algo = SHMEMX_BARRIER_AUTO;
+    ASSERT_EQ(shmemx_team_get_barrier_algo(SHMEM_TEAM_WORLD, &algo), 0);
+    ASSERT_NE(algo, SHMEMX_BARRIER_AUTO);
+    ASSERT_EQ(shmemx_team_set_barrier_algo(SHMEM_TEAM_WORLD, SHMEMX_BARRIER_ALGO_NUM), SHMEM_INVALID_PARAM);
+
+    uint64_t *addr_dev = (uint64_t *)shmem_malloc(sizeof(uint64_t));
+    ASSERT_EQ(aclrtMemset(addr_dev, sizeof(uint64_t), 0, sizeof(uint64_t)), 0);
+    uint64_t *addr_host;
+    ASSERT_EQ(aclrtMallocHost((void **)&addr_host, sizeof(uint64_t)), 0);
+
+    uint64_t expected = 0;
+    for (int32_t algo_id = SHMEMX_BARRIER_DISSEM; algo_id < SHMEMX_BARRIER_ALGO_NUM; algo_id++) {
+        ASSERT_EQ(shmemx_team_set_barrier_algo(SHMEM_TEAM_WORLD, algo_id), 0);
+        ASSERT_EQ(shmemx_team_get_barrier_algo(SHMEM_TEAM_WORLD, &algo), 0);
+        ASSERT_EQ(algo, algo_id);
+        for (int32_t i = 1; i <= SHMEM_BARRIER_TEST_NUM; i++) {
+            std::cout << "[TEST] barriers test blackbox rank_id: " << rank_id << " algo: " << algo_id
+                      << " time: " << i << std::endl;
+            increase_do(stream, shmemx_get_ffts_config(), (uint8_t *)addr_dev, rank_id, n_ranks);
+            ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+            ASSERT_EQ(aclrtMemcpy(addr_host, sizeof(uint64_t), addr_dev, sizeof(uint64_t), ACL_MEMCPY_DEVICE_TO_HOST),
+                      0);
+            ASSERT_EQ((*addr_host), ++expected);
+            shm::shmemi_control_barrier_all();
+        }
+    }
+    ASSERT_EQ(shmemx_team_set_barrier_algo(SHMEM_TEAM_WORLD, SHMEMX_BARRIER_AUTO), 0);
+
+    ASSERT_EQ(aclrtFreeHost(addr_host), 0);
+    shmem_free(addr_dev);
+
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+static void test_barrier_black_box_split(int32_t rank_id, int32_t n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    uint64_t *addr_dev = (uint64_t *)shmem_malloc(sizeof(uint64_t));
+    ASSERT_EQ(aclrtMemset(addr_dev, sizeof(uint64_t), 0, sizeof(uint64_t)), 0);
+    uint64_t *addr_host;
+    ASSERT_EQ(aclrtMallocHost((void **)&addr_host, sizeof(uint64_t)), 0);
+
+    uint64_t expected = 0;
+    for (int32_t use_test = 0; use_test <= 1; use_test++) {
+        for (int32_t i = 1; i <= SHMEM_BARRIER_TEST_NUM; i++) {
+            std::cout << "[TEST] split barriers test blackbox rank_id: " << rank_id << " use_test: " << use_test
+                      << " time: " << i << std::endl;
+            increase_split_do(stream, shmemx_get_ffts_config(), (uint8_t *)addr_dev, rank_id, n_ranks, use_test);
+            ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+            ASSERT_EQ(aclrtMemcpy(addr_host, sizeof(uint64_t), addr_dev, sizeof(uint64_t), ACL_MEMCPY_DEVICE_TO_HOST),
+                      0);
+            ASSERT_EQ((*addr_host), ++expected);
+            shm::shmemi_control_barrier_all();
+        }
+    }
+
+    // stream-ordered split barrier, only synchronized once both halves are enqueued
+    for (int32_t i = 1; i <= SHMEM_BARRIER_TEST_NUM; i++) {
+        ASSERT_EQ(shmemx_barrier_arrive_on_stream(SHMEM_TEAM_WORLD, stream), 0);
+        ASSERT_EQ(shmemx_barrier_wait_on_stream(SHMEM_TEAM_WORLD, stream), 0);
+    }
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+    ASSERT_EQ(shmemx_barrier_arrive_on_stream(SHMEM_TEAM_INVALID, stream), SHMEM_INVALID_PARAM);
+
+    // enqueued barrier, completion observed through an event
+    aclrtEvent event;
+    ASSERT_EQ(aclrtCreateEvent(&event), 0);
+    shmem_barrier_all_on_stream(stream);
+    ASSERT_EQ(shmemx_barrier_on_stream_event(SHMEM_TEAM_WORLD, stream, event), 0);
+    ASSERT_EQ(aclrtSynchronizeEvent(event), 0);
+    ASSERT_EQ(aclrtDestroyEvent(event), 0);
+    ASSERT_EQ(shmemx_barrier_on_stream_event(SHMEM_TEAM_INVALID, stream, nullptr), SHMEM_INVALID_PARAM);
+
+    ASSERT_EQ(aclrtFreeHost(addr_host), 0);
+    shmem_free(addr_dev);
+
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
 TEST(TEST_SYNC_API, test_barrier_black_box)
 {
     const int32_t process_count = test_gnpu_num;
@@ -139,3 +238,17 @@ TEST(TEST_SYNC_API, test_barrier_black_box_odd_team)
     uint64_t local_mem_size = 1024UL * 1024UL * 16;
     test_mutil_task(test_barrier_black_box_odd_team, local_mem_size, process_count);
 }
+
+TEST(TEST_SYNC_API, test_barrier_black_box_algos)
+{
+    const int32_t process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 16;
+    test_mutil_task(test_barrier_black_box_algos, local_mem_size, process_count);
+}
+
+TEST(TEST_SYNC_API, test_barrier_black_box_split)
+{
+    const int32_t process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 16;
+    test_mutil_task(test_barrier_black_box_split, local_mem_size, process_count);
+}
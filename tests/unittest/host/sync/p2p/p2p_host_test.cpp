@@ -9,6 +9,7 @@
  */
 #include <iostream>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "acl/acl.h"
@@ -17,6 +18,12 @@
 #include "unittest_main_test.h"
 #include "p2p_kernel.h"
 
+constexpr int32_t P2P_WAIT_VEC_NFLAGS = 16;
+constexpr size_t P2P_WAIT_VEC_NRESULTS = 20;
+
+extern void p2p_wait_vec_do(void *stream, uint64_t config, uint8_t *addr, uint8_t *result, int rank_id,
+                            int rank_size);
+
 static void test_p2p(int rank_id, int rank_size, uint64_t local_mem_size)
 {
     aclrtStream stream;
@@ -40,4 +47,58 @@ TEST(TEST_SYNC_API, test_p2p)
     const int32_t process_count = test_gnpu_num;
     uint64_t local_mem_size = 1024UL * 1024UL * 16;
     test_mutil_task(test_p2p, local_mem_size, process_count);
+}
+
+static void test_p2p_wait_vec(int rank_id, int rank_size, uint64_t local_mem_size)
+{
+    aclrtStream stream;
+    test_init(rank_id, rank_size, local_mem_size, &stream);
+
+    size_t flags_size = P2P_WAIT_VEC_NFLAGS * sizeof(int32_t);
+    size_t result_size = P2P_WAIT_VEC_NRESULTS * sizeof(int64_t);
+    int32_t *flags_dev = (int32_t *)shmem_malloc(flags_size);
+    int64_t *result_dev = (int64_t *)shmem_malloc(result_size);
+    ASSERT_EQ(aclrtMemset(flags_dev, flags_size, 0, flags_size), 0);
+    ASSERT_EQ(aclrtMemset(result_dev, result_size, 0xff, result_size), 0);
+    p2p_wait_vec_do(stream, shmemx_get_ffts_config(), (uint8_t *)flags_dev, (uint8_t *)result_dev, rank_id,
+                    rank_size);
+    ASSERT_EQ(aclrtSynchronizeStream(stream), 0);
+
+    std::vector<int64_t> result(P2P_WAIT_VEC_NRESULTS);
+    ASSERT_EQ(aclrtMemcpy(result.data(), result_size, result_dev, result_size, ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    // test_* before any flag is set: none satisfied, and they returned instead of blocking
+    EXPECT_EQ(result[0], 0);
+    EXPECT_EQ(result[1], -1);
+    EXPECT_EQ(result[2], 0);
+    // even flags set by the previous pe, odd ones masked by status
+    EXPECT_EQ(result[3], 1);
+    EXPECT_EQ(result[4], 0);
+    EXPECT_EQ(result[5], 4);
+    EXPECT_EQ(result[6], P2P_WAIT_VEC_NFLAGS / 2);
+    for (int32_t i = 0; i < P2P_WAIT_VEC_NFLAGS / 2; i++) {
+        EXPECT_EQ(result[7 + i], 2 * i);
+    }
+    EXPECT_EQ(result[15], P2P_WAIT_VEC_NFLAGS / 2);
+    // every entry masked
+    EXPECT_EQ(result[16], -1);
+    EXPECT_EQ(result[17], 0);
+    EXPECT_EQ(result[18], 0);
+    // strided sweep with backoff returned
+    EXPECT_EQ(result[19], 1);
+
+    shmem_free(result_dev);
+    shmem_free(flags_dev);
+
+    int32_t dev_id = rank_id % test_gnpu_num + test_first_npu;
+    test_finalize(stream, dev_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TEST_SYNC_API, test_p2p_wait_vec)
+{
+    const int32_t process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 16;
+    test_mutil_task(test_p2p_wait_vec, local_mem_size, process_count);
 }
\ No newline at end of file
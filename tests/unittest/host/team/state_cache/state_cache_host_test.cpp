@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 1.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <iostream>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "acl/acl.h"
+#include "shmemi_host_common.h"
+#include "unittest_main_test.h"
+
+extern void get_state_cache(uint32_t block_dim, void* stream, uint8_t* gva, int32_t value);
+
+// Launches the cached kernel and checks the snapshot of every core against the host view of the state.
+static void test_check_state_cache(aclrtStream stream, uint8_t *gva, int rank_id, int n_ranks, uint32_t block_dim,
+                                   int32_t value)
+{
+    const size_t row = SCALAR_DATA_CACHELINE_SIZE / sizeof(int64_t);
+    std::vector<int64_t> out((block_dim + 1) * row);
+    get_state_cache(block_dim, stream, gva, value);
+    EXPECT_EQ(aclrtSynchronizeStream(stream), 0);
+    shmem_barrier_all();
+    EXPECT_EQ(aclrtMemcpy(out.data(), out.size() * sizeof(int64_t), gva, out.size() * sizeof(int64_t),
+                          ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    // the next launch puts into the first cacheline again
+    shmem_barrier_all();
+
+    int64_t peer_gva = (int64_t)shmem_ptr(gva, (rank_id + 1) % n_ranks);
+    for (uint32_t core = 1; core <= block_dim; core++) {
+        EXPECT_EQ(out[core * row], rank_id) << "core " << core - 1;
+        EXPECT_EQ(out[core * row + 1], n_ranks) << "core " << core - 1;
+        EXPECT_EQ(out[core * row + 2], peer_gva) << "core " << core - 1;
+        EXPECT_EQ((uint64_t)out[core * row + 3], shmemx_state_version()) << "core " << core - 1;
+    }
+    // the put of the previous PE went through the snapshot too
+    EXPECT_EQ(*(int32_t *)out.data(), value);
+}
+
+void test_shmem_state_cache(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    const uint32_t block_dim = 4;
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    uint8_t *gva = (uint8_t *)shmem_malloc((block_dim + 1) * SCALAR_DATA_CACHELINE_SIZE);
+    ASSERT_NE(gva, nullptr);
+    test_check_state_cache(stream, gva, rank_id, n_ranks, block_dim, 1);
+
+    // the block-local snapshot outlives the kernel, a launch after a published change has to take it again
+    shmem_team_t team;
+    uint64_t version = shmemx_state_version();
+    ASSERT_EQ(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team), 0);
+    EXPECT_GT(shmemx_state_version(), version);
+    test_check_state_cache(stream, gva, rank_id, n_ranks, block_dim, 2);
+
+    // and after the team is gone, on a single core
+    shmem_team_destroy(team);
+    test_check_state_cache(stream, gva, rank_id, n_ranks, 1, 3);
+
+    shmem_free(gva);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestTeamApi, TestShmemStateCache)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    test_mutil_task(test_shmem_state_cache, local_mem_size, process_count);
+}
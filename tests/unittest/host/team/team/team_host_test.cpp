@@ -10,6 +10,8 @@
 #include <iostream>
 #include <cstdlib>
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <gtest/gtest.h>
 
 #include "acl/acl.h"
@@ -20,6 +22,8 @@
 #include <gtest/gtest.h>
 using namespace std;
 
+extern void get_state_version(void* stream, uint8_t* gva);
+
 static int32_t test_get_device_state(aclrtStream stream, uint8_t *gva, uint32_t rank_id, uint32_t rank_size,
                                      shmem_team_t team_id, int stride)
 {
@@ -183,4 +187,278 @@ TEST(TestTeamApi, TestShmemTeamConfig)
     const int process_count = test_gnpu_num;
     uint64_t local_mem_size = 1024UL * 1024UL * 1024;
     test_mutil_task(test_shmem_team_config, local_mem_size, process_count);
-}
\ No newline at end of file
+}
+
+void test_shmem_team_split(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    // pairs of ranks alternate colors, and keys reverse the order, so members are not strided
+    int color = (rank_id / 2) % 2;
+    std::vector<int> members;
+    for (int i = n_ranks - 1; i >= 0; i--) {
+        if ((i / 2) % 2 == color) {
+            members.push_back(i);
+        }
+    }
+    int team_size = members.size();
+    int team_my_pe = std::find(members.begin(), members.end(), rank_id) - members.begin();
+
+    shmem_team_t team_split;
+    ASSERT_EQ(shmemx_team_split(SHMEM_TEAM_WORLD, color, -rank_id, &team_split), 0);
+    ASSERT_NE(team_split, SHMEM_TEAM_INVALID);
+    EXPECT_EQ(shmem_team_n_pes(team_split), team_size);
+    EXPECT_EQ(shmem_team_my_pe(team_split), team_my_pe);
+    for (int i = 0; i < team_size; i++) {
+        EXPECT_EQ(shmem_team_translate_pe(team_split, i, SHMEM_TEAM_WORLD), members[i]);
+        EXPECT_EQ(shmem_team_translate_pe(SHMEM_TEAM_WORLD, members[i], team_split), i);
+    }
+    EXPECT_EQ(shmem_team_translate_pe(team_split, team_size, SHMEM_TEAM_WORLD), -1);
+
+    // splitting a team of arbitrary members keeps the member table
+    shmem_team_t team_sub;
+    ASSERT_EQ(shmem_team_split_strided(team_split, 0, 1, team_size, &team_sub), 0);
+    ASSERT_NE(team_sub, SHMEM_TEAM_INVALID);
+    EXPECT_EQ(shmem_team_my_pe(team_sub), team_my_pe);
+    EXPECT_EQ(shmem_team_translate_pe(team_sub, team_size - 1, SHMEM_TEAM_WORLD), members[team_size - 1]);
+
+    // a negative color joins no team, while every PE still takes part
+    shmem_team_t team_none;
+    EXPECT_EQ(shmemx_team_split(SHMEM_TEAM_WORLD, -1, rank_id, &team_none), 0);
+    EXPECT_EQ(team_none, SHMEM_TEAM_INVALID);
+
+    // device view of the member table
+    int *y_host;
+    EXPECT_EQ(aclrtMallocHost((void **)(&y_host), 5 * sizeof(int)), 0);
+    void *ptr = shmem_malloc(1024);
+    get_device_state(1, stream, (uint8_t *)ptr, team_split);
+    EXPECT_EQ(aclrtSynchronizeStream(stream), 0);
+    EXPECT_EQ(aclrtMemcpy(y_host, 5 * sizeof(int), ptr, 5 * sizeof(int), ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    EXPECT_EQ(y_host[0], n_ranks);
+    EXPECT_EQ(y_host[1], rank_id);
+    EXPECT_EQ(y_host[2], team_my_pe);
+    EXPECT_EQ(y_host[3], team_size);
+    EXPECT_EQ(y_host[4], members[team_size - 1]);
+    EXPECT_EQ(aclrtFreeHost(y_host), 0);
+    shmem_free(ptr);
+
+    shmem_team_destroy(team_sub);
+    shmem_team_destroy(team_split);
+
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestTeamApi, TestShmemTeamSplit)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    test_mutil_task(test_shmem_team_split, local_mem_size, process_count);
+}
+
+void test_shmem_team_pool_grow(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    const int max_teams = 64;
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    setenv("SHMEM_MAX_TEAMS", std::to_string(max_teams).c_str(), 1);
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    unsetenv("SHMEM_MAX_TEAMS");
+    ASSERT_NE(stream, nullptr);
+
+    // SHMEM_TEAM_WORLD holds slot 0, the pool grows past the first chunk and stops at max_teams
+    std::vector<shmem_team_t> teams;
+    shmem_team_t team;
+    while (shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team) == 0) {
+        ASSERT_NE(team, SHMEM_TEAM_INVALID);
+        teams.push_back(team);
+    }
+    ASSERT_EQ(static_cast<int>(teams.size()), max_teams - 1);
+    for (size_t i = 0; i < teams.size(); i++) {
+        EXPECT_EQ(teams[i], static_cast<shmem_team_t>(i + 1));
+        EXPECT_EQ(shmem_team_n_pes(teams[i]), n_ranks);
+    }
+
+    // teams in the grown chunk synchronize like the others
+    shmem_barrier_on_stream(teams.back(), stream);
+    EXPECT_EQ(aclrtSynchronizeStream(stream), 0);
+
+    // a released slot is the lowest free one
+    shmem_team_t freed = teams[SHMEM_TEAM_POOL_CHUNK];
+    shmem_team_destroy(freed);
+    EXPECT_EQ(shmem_team_n_pes(freed), -1);
+    ASSERT_EQ(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team), 0);
+    EXPECT_EQ(team, freed);
+
+    for (shmem_team_t t : teams) {
+        shmem_team_destroy(t);
+    }
+
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestTeamApi, TestShmemTeamPoolGrow)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    test_mutil_task(test_shmem_team_pool_grow, local_mem_size, process_count);
+}
+
+void test_shmem_state_version(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    uint64_t *ptr = (uint64_t *)shmem_malloc(sizeof(uint64_t));
+    uint64_t device_version = 0;
+    uint64_t version = shmemx_state_version();
+    EXPECT_GT(version, 0);
+
+    // every published change moves the version, and kernels see the host value
+    shmem_team_t team;
+    ASSERT_EQ(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team), 0);
+    EXPECT_GT(shmemx_state_version(), version);
+    version = shmemx_state_version();
+    get_state_version(stream, (uint8_t *)ptr);
+    EXPECT_EQ(aclrtSynchronizeStream(stream), 0);
+    EXPECT_EQ(aclrtMemcpy(&device_version, sizeof(uint64_t), ptr, sizeof(uint64_t), ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    EXPECT_EQ(device_version, version);
+
+    shmem_team_destroy(team);
+    EXPECT_GT(shmemx_state_version(), version);
+
+    shmem_free(ptr);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestTeamApi, TestShmemStateVersion)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    test_mutil_task(test_shmem_state_version, local_mem_size, process_count);
+}
+
+void test_shmem_team_scratch(int rank_id, int n_ranks, uint64_t local_mem_size)
+{
+    const uint64_t mb = 1024UL * 1024UL;
+    const uint32_t block_dim = 2;
+    int32_t device_id = rank_id % test_gnpu_num + test_first_npu;
+    aclrtStream stream;
+    test_init(rank_id, n_ranks, local_mem_size, &stream);
+    ASSERT_NE(stream, nullptr);
+
+    shmem_team_t team_a;
+    shmem_team_t team_b;
+    ASSERT_EQ(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team_a), 0);
+    ASSERT_EQ(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team_b), 0);
+
+    // nothing is taken before first use
+    shmemx_team_scratch_stats_t stats;
+    ASSERT_EQ(shmemx_team_scratch_stats(team_a, &stats), 0);
+    EXPECT_EQ(stats.size, 0);
+    EXPECT_EQ(stats.target_size, SHMEM_TEAM_SCRATCH_DEFAULT_SIZE);
+    EXPECT_EQ(stats.arena_used, 0);
+    EXPECT_EQ(stats.arena_size, SHMEM_SCRATCH_ARENA_DEFAULT_SIZE);
+
+    // first use takes the size set for the team, zeroed, and teams do not share granules
+    void *scratch_a = nullptr;
+    void *scratch_b = nullptr;
+    ASSERT_EQ(shmemx_team_get_scratch(team_a, mb, &scratch_a), 0);
+    ASSERT_NE(scratch_a, nullptr);
+    ASSERT_EQ(shmemx_team_get_scratch(team_b, 0, &scratch_b), 0);
+    ASSERT_NE(scratch_b, nullptr);
+    uint64_t distance = (uint64_t)std::abs((int64_t)scratch_a - (int64_t)scratch_b);
+    EXPECT_GE(distance, SHMEM_TEAM_SCRATCH_DEFAULT_SIZE);
+    std::vector<int32_t> head(16, -1);
+    EXPECT_EQ(aclrtMemcpy(head.data(), 16 * sizeof(int32_t), scratch_a, 16 * sizeof(int32_t),
+                          ACL_MEMCPY_DEVICE_TO_HOST), 0);
+    EXPECT_EQ(std::count(head.begin(), head.end(), 0), 16);
+    ASSERT_EQ(shmemx_team_scratch_stats(team_a, &stats), 0);
+    EXPECT_EQ(stats.size, SHMEM_TEAM_SCRATCH_DEFAULT_SIZE);
+    EXPECT_EQ(stats.requests, 1);
+    EXPECT_EQ(stats.allocations, 1);
+    EXPECT_EQ(stats.arena_used, 2 * SHMEM_TEAM_SCRATCH_DEFAULT_SIZE);
+
+    // a larger request is refused until the team is resized
+    void *scratch = nullptr;
+    EXPECT_EQ(shmemx_team_get_scratch(team_a, 8 * mb, &scratch), SHMEM_INVALID_PARAM);
+    EXPECT_EQ(scratch, nullptr);
+    EXPECT_EQ(shmemx_team_set_scratch_size(team_a, SHMEM_SCRATCH_ARENA_DEFAULT_SIZE + 1), SHMEM_INVALID_PARAM);
+    // resizing is collective, members passing different sizes all fail and keep their scratch
+    if (n_ranks > 1) {
+        EXPECT_EQ(shmemx_team_set_scratch_size(team_a, (rank_id + 1) * mb), SHMEM_INVALID_PARAM);
+        ASSERT_EQ(shmemx_team_scratch_stats(team_a, &stats), 0);
+        EXPECT_EQ(stats.size, SHMEM_TEAM_SCRATCH_DEFAULT_SIZE);
+        EXPECT_EQ(stats.target_size, SHMEM_TEAM_SCRATCH_DEFAULT_SIZE);
+    }
+    ASSERT_EQ(shmemx_team_set_scratch_size(team_a, 8 * mb), 0);
+    ASSERT_EQ(shmemx_team_get_scratch(team_a, 8 * mb, &scratch_a), 0);
+    ASSERT_EQ(shmemx_team_scratch_stats(team_a, &stats), 0);
+    EXPECT_EQ(stats.size, 8 * mb);
+    EXPECT_EQ(stats.peak_request, 8 * mb);
+    EXPECT_EQ(stats.requests, 2);
+    EXPECT_EQ(stats.failures, 1);
+    EXPECT_EQ(stats.allocations, 2);
+    EXPECT_EQ(stats.arena_used, 8 * mb + SHMEM_TEAM_SCRATCH_DEFAULT_SIZE);
+
+    // device view, every core counts its own epochs from 1
+    const size_t row = SCALAR_DATA_CACHELINE_SIZE / sizeof(int64_t);
+    int64_t *ptr = (int64_t *)shmem_malloc(block_dim * SCALAR_DATA_CACHELINE_SIZE);
+    std::vector<int64_t> out(block_dim * row);
+    for (int call = 0; call < 2; call++) {
+        get_team_scratch(block_dim, stream, (uint8_t *)ptr, team_a);
+        EXPECT_EQ(aclrtSynchronizeStream(stream), 0);
+        EXPECT_EQ(aclrtMemcpy(out.data(), out.size() * sizeof(int64_t), ptr, out.size() * sizeof(int64_t),
+                              ACL_MEMCPY_DEVICE_TO_HOST), 0);
+        for (uint32_t core = 0; core < block_dim; core++) {
+            EXPECT_EQ(out[core * row], 2 * call + 1);
+            EXPECT_EQ(out[core * row + 1], 2 * call + 2);
+            EXPECT_EQ(out[core * row + 2], (int64_t)scratch_a);
+            EXPECT_EQ(out[core * row + 3], 8 * mb);
+        }
+    }
+    ASSERT_EQ(shmemx_team_scratch_stats(team_a, &stats), 0);
+    EXPECT_EQ(stats.epoch, 4);
+    shmem_free(ptr);
+
+    // a destroyed team gives its granules back, and a new team in its slot starts from epoch 0
+    shmem_team_destroy(team_a);
+    ASSERT_EQ(shmemx_team_scratch_stats(team_b, &stats), 0);
+    EXPECT_EQ(stats.arena_used, SHMEM_TEAM_SCRATCH_DEFAULT_SIZE);
+    ASSERT_EQ(shmem_team_split_strided(SHMEM_TEAM_WORLD, 0, 1, n_ranks, &team_a), 0);
+    ASSERT_EQ(shmemx_team_scratch_stats(team_a, &stats), 0);
+    EXPECT_EQ(stats.epoch, 0);
+    EXPECT_EQ(stats.size, 0);
+    EXPECT_EQ(stats.requests, 0);
+
+    shmem_team_destroy(team_a);
+    shmem_team_destroy(team_b);
+    std::cerr << "[TEST] begin to exit...... rank_id: " << rank_id << std::endl;
+    test_finalize(stream, device_id);
+    if (::testing::Test::HasFailure()) {
+        exit(1);
+    }
+}
+
+TEST(TestTeamApi, TestShmemTeamScratch)
+{
+    const int process_count = test_gnpu_num;
+    uint64_t local_mem_size = 1024UL * 1024UL * 1024;
+    test_mutil_task(test_shmem_team_scratch, local_mem_size, process_count);
+}
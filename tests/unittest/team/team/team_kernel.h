@@ -3,4 +3,6 @@
 
 void get_device_state(uint32_t block_dim, void* stream, uint8_t* gva, shmem_team_t team_id);
 
+void get_team_scratch(uint32_t block_dim, void* stream, uint8_t* gva, shmem_team_t team_id);
+
 #endif
\ No newline at end of file